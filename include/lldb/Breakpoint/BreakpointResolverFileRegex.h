@@ -12,6 +12,9 @@
 
 // C Includes
 // C++ Includes
+#include <string>
+#include <vector>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointResolver.h"
@@ -34,6 +37,15 @@ public:
     virtual
     ~BreakpointResolverFileRegex ();
 
+    // Both of these gather the compile units that pass the filter first
+    // and then search all of their source files at once.
+    virtual void
+    ResolveBreakpoint (SearchFilter &filter);
+
+    virtual void
+    ResolveBreakpointInModules (SearchFilter &filter,
+                                ModuleList &modules);
+
     virtual Searcher::CallbackReturn
     SearchCallback (SearchFilter &filter,
                     SymbolContext &context,
@@ -57,7 +69,20 @@ public:
 
 protected:
     friend class Breakpoint;
+
+    void
+    SearchCompUnits (SearchFilter &filter);
+
+    void
+    AddLocationsForLines (SearchFilter &filter,
+                          CompileUnit *cu,
+                          const FileSpec &cu_file_spec,
+                          const std::vector<uint32_t> &line_matches);
+
     RegularExpression m_regex; // This is the line expression that we are looking for.
+    std::string m_regex_literal;    // A string every matching line must contain, or empty if we couldn't work one out
+    bool m_gathering_comp_units;    // True while a search is collecting compile units into m_comp_units
+    std::vector<CompileUnit *> m_comp_units;
 
 private:
     DISALLOW_COPY_AND_ASSIGN(BreakpointResolverFileRegex);
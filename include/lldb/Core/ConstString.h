@@ -375,6 +375,27 @@ public:
     void
     SetCString (const char *cstr);
 
+    //------------------------------------------------------------------
+    /// Set the C string values of many objects at once.
+    ///
+    /// Uniques \a count C strings in the global string pool while
+    /// taking the string pool lock only once, which is much faster
+    /// than calling SetCString() for each string when many threads are
+    /// creating strings at the same time.
+    ///
+    /// @param[in] cstrs
+    ///     An array of \a count NULL terminated C strings. NULL entries
+    ///     result in empty objects.
+    ///
+    /// @param[in] count
+    ///     The number of entries in \a cstrs and \a const_strs.
+    ///
+    /// @param[out] const_strs
+    ///     An array of \a count objects that get the uniqued strings.
+    //------------------------------------------------------------------
+    static void
+    SetCStrings (const char * const *cstrs, size_t count, ConstString *const_strs);
+
     //------------------------------------------------------------------
     /// Set the C string value and its mangled counterpart.
     ///
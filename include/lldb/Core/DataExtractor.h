@@ -31,6 +31,11 @@ namespace lldb_private {
 /// Each object can have a unique position in the shared data and extract
 /// data from different offsets.
 ///
+/// The accessors that take an offset pointer are instantiated for both
+/// uint32_t and uint64_t offsets. Data that is smaller than 4GB can
+/// keep using 32 bit offsets, while larger data (like the .debug_info
+/// section of a big statically linked binary) needs 64 bit offsets.
+///
 /// @see DataBuffer
 //----------------------------------------------------------------------
 class DataExtractor
@@ -86,7 +91,7 @@ public:
     /// @param[in] addr_size
     ///     A new address byte size value.
     //------------------------------------------------------------------
-    DataExtractor (const void* data, uint32_t data_length, lldb::ByteOrder byte_order, uint8_t addr_size);
+    DataExtractor (const void* data, uint64_t data_length, lldb::ByteOrder byte_order, uint8_t addr_size);
 
     //------------------------------------------------------------------
     /// Construct with shared data.
@@ -130,7 +135,7 @@ public:
     /// @param[in] length
     ///     The length in bytes of the subset of data.
     //------------------------------------------------------------------
-    DataExtractor (const DataExtractor& data, uint32_t offset, uint32_t length);
+    DataExtractor (const DataExtractor& data, uint64_t offset, uint64_t length);
 
     DataExtractor (const DataExtractor& rhs);
     //------------------------------------------------------------------
@@ -332,7 +337,7 @@ public:
     ///     if there aren't enough bytes at the specified offset.
     //------------------------------------------------------------------
     size_t
-    ExtractBytes (uint32_t offset, uint32_t length, lldb::ByteOrder dst_byte_order, void *dst) const;
+    ExtractBytes (uint64_t offset, uint32_t length, lldb::ByteOrder dst_byte_order, void *dst) const;
 
     //------------------------------------------------------------------
     /// Extract an address from \a *offset_ptr.
@@ -352,8 +357,9 @@ public:
     /// @return
     ///     The extracted address value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint64_t
-    GetAddress (uint32_t *offset_ptr) const;
+    GetAddress (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Get the current address size.
@@ -404,8 +410,9 @@ public:
     ///     offset plus the length of the C string is out of bounds,
     ///     NULL will be returned.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     const char *
-    GetCStr (uint32_t *offset_ptr) const;
+    GetCStr (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Extract \a length bytes from \a *offset_ptr.
@@ -430,8 +437,9 @@ public:
     ///     A pointer to the bytes in this object's data if the offset
     ///     and length are valid, or NULL otherwise.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     const void*
-    GetData (uint32_t *offset_ptr, uint32_t length) const;
+    GetData (OffsetType *offset_ptr, uint32_t length) const;
     
     //------------------------------------------------------------------
     /// Copy \a dst_len bytes from \a *offset_ptr and ensure the copied
@@ -473,7 +481,7 @@ public:
     ///     anything goes wrong.
     //------------------------------------------------------------------
     uint32_t
-    CopyByteOrderedData (uint32_t src_offset, 
+    CopyByteOrderedData (uint64_t src_offset, 
                          uint32_t src_len,
                          void *dst, 
                          uint32_t dst_len, 
@@ -534,14 +542,17 @@ public:
     /// @return
     ///     The floating value that was extracted, or zero on failure.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     float
-    GetFloat (uint32_t *offset_ptr) const;
+    GetFloat (OffsetType *offset_ptr) const;
 
+    template <typename OffsetType>
     double
-    GetDouble (uint32_t *offset_ptr) const;
+    GetDouble (OffsetType *offset_ptr) const;
 
+    template <typename OffsetType>
     long double
-    GetLongDouble (uint32_t *offset_ptr) const;
+    GetLongDouble (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Extract a GNU encoded pointer value from \a *offset_ptr.
@@ -571,8 +582,9 @@ public:
     /// @return
     ///     The extracted GNU encoded pointer value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint64_t
-    GetGNUEHPointer (uint32_t *offset_ptr, uint32_t eh_ptr_enc, lldb::addr_t pc_rel_addr, lldb::addr_t text_addr, lldb::addr_t data_addr);
+    GetGNUEHPointer (OffsetType *offset_ptr, uint32_t eh_ptr_enc, lldb::addr_t pc_rel_addr, lldb::addr_t text_addr, lldb::addr_t data_addr);
 
     //------------------------------------------------------------------
     /// Extract an integer of size \a byte_size from \a *offset_ptr.
@@ -597,8 +609,9 @@ public:
     /// @return
     ///     The integer value that was extracted, or zero on failure.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint32_t
-    GetMaxU32 (uint32_t *offset_ptr, uint32_t byte_size) const;
+    GetMaxU32 (OffsetType *offset_ptr, uint32_t byte_size) const;
 
     //------------------------------------------------------------------
     /// Extract an unsigned integer of size \a byte_size from \a
@@ -626,8 +639,9 @@ public:
     ///     The unsigned integer value that was extracted, or zero on
     ///     failure.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint64_t
-    GetMaxU64 (uint32_t *offset_ptr, uint32_t byte_size) const;
+    GetMaxU64 (OffsetType *offset_ptr, uint32_t byte_size) const;
 
     //------------------------------------------------------------------
     /// Extract an signed integer of size \a byte_size from \a *offset_ptr.
@@ -654,8 +668,9 @@ public:
     ///     The sign extended signed integer value that was extracted,
     ///     or zero on failure.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     int64_t
-    GetMaxS64 (uint32_t *offset_ptr, uint32_t size) const;
+    GetMaxS64 (OffsetType *offset_ptr, uint32_t size) const;
 
     //------------------------------------------------------------------
     /// Extract an unsigned integer of size \a byte_size from \a
@@ -693,8 +708,9 @@ public:
     ///     The unsigned bitfield integer value that was extracted, or
     ///     zero on failure.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint64_t
-    GetMaxU64Bitfield (uint32_t *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const;
+    GetMaxU64Bitfield (OffsetType *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const;
 
     //------------------------------------------------------------------
     /// Extract an signed integer of size \a byte_size from \a
@@ -732,8 +748,9 @@ public:
     ///     The signed bitfield integer value that was extracted, or
     ///     zero on failure.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     int64_t
-    GetMaxS64Bitfield (uint32_t *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const;
+    GetMaxS64Bitfield (OffsetType *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const;
 
     //------------------------------------------------------------------
     /// Extract an pointer from \a *offset_ptr.
@@ -753,8 +770,9 @@ public:
     /// @return
     ///     The extracted pointer value as a 64 integer.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint64_t
-    GetPointer (uint32_t *offset_ptr) const;
+    GetPointer (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Get the current byte order value.
@@ -785,25 +803,30 @@ public:
     /// @return
     ///     The extracted uint8_t value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint8_t
-    GetU8 ( uint32_t *offset_ptr) const;
+    GetU8 (OffsetType *offset_ptr) const;
 
+    template <typename OffsetType>
     uint8_t
-    GetU8_unchecked (uint32_t *offset_ptr) const
+    GetU8_unchecked (OffsetType *offset_ptr) const
     {
         uint8_t val = m_start[*offset_ptr];
         *offset_ptr += 1;
         return val;
     }
     
+    template <typename OffsetType>
     uint16_t
-    GetU16_unchecked (uint32_t *offset_ptr) const;
+    GetU16_unchecked (OffsetType *offset_ptr) const;
 
+    template <typename OffsetType>
     uint32_t
-    GetU32_unchecked (uint32_t *offset_ptr) const;
+    GetU32_unchecked (OffsetType *offset_ptr) const;
 
+    template <typename OffsetType>
     uint64_t
-    GetU64_unchecked (uint32_t *offset_ptr) const;
+    GetU64_unchecked (OffsetType *offset_ptr) const;
     //------------------------------------------------------------------
     /// Extract \a count uint8_t values from \a *offset_ptr.
     ///
@@ -829,8 +852,9 @@ public:
     ///     \a dst if all values were properly extracted and copied,
     ///     NULL otherise.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     void *
-    GetU8 ( uint32_t *offset_ptr, void *dst, uint32_t count) const;
+    GetU8 (OffsetType *offset_ptr, void *dst, uint32_t count) const;
 
     //------------------------------------------------------------------
     /// Extract a uint16_t value from \a *offset_ptr.
@@ -848,8 +872,9 @@ public:
     /// @return
     ///     The extracted uint16_t value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint16_t
-    GetU16 (uint32_t *offset_ptr) const;
+    GetU16 (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Extract \a count uint16_t values from \a *offset_ptr.
@@ -876,8 +901,9 @@ public:
     ///     \a dst if all values were properly extracted and copied,
     ///     NULL otherise.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     void *
-    GetU16 (uint32_t *offset_ptr, void *dst, uint32_t count) const;
+    GetU16 (OffsetType *offset_ptr, void *dst, uint32_t count) const;
 
     //------------------------------------------------------------------
     /// Extract a uint32_t value from \a *offset_ptr.
@@ -895,8 +921,9 @@ public:
     /// @return
     ///     The extracted uint32_t value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint32_t
-    GetU32 (uint32_t *offset_ptr) const;
+    GetU32 (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Extract \a count uint32_t values from \a *offset_ptr.
@@ -923,8 +950,9 @@ public:
     ///     \a dst if all values were properly extracted and copied,
     ///     NULL otherise.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     void *
-    GetU32 (uint32_t *offset_ptr, void *dst, uint32_t count) const;
+    GetU32 (OffsetType *offset_ptr, void *dst, uint32_t count) const;
 
     //------------------------------------------------------------------
     /// Extract a uint64_t value from \a *offset_ptr.
@@ -942,8 +970,9 @@ public:
     /// @return
     ///     The extracted uint64_t value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint64_t
-    GetU64 (uint32_t *offset_ptr) const;
+    GetU64 (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Extract \a count uint64_t values from \a *offset_ptr.
@@ -970,8 +999,9 @@ public:
     ///     \a dst if all values were properly extracted and copied,
     ///     NULL otherise.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     void *
-    GetU64 ( uint32_t *offset_ptr, void *dst, uint32_t count) const;
+    GetU64 (OffsetType *offset_ptr, void *dst, uint32_t count) const;
 
     //------------------------------------------------------------------
     /// Extract a signed LEB128 value from \a *offset_ptr.
@@ -991,8 +1021,9 @@ public:
     /// @return
     ///     The extracted signed integer value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     int64_t
-    GetSLEB128 (uint32_t *offset_ptr) const;
+    GetSLEB128 (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Extract a unsigned LEB128 value from \a *offset_ptr.
@@ -1012,8 +1043,9 @@ public:
     /// @return
     ///     The extracted unsigned integer value.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint64_t
-    GetULEB128 (uint32_t *offset_ptr) const;
+    GetULEB128 (OffsetType *offset_ptr) const;
 
     lldb::DataBufferSP &
     GetSharedDataBuffer ()
@@ -1036,7 +1068,7 @@ public:
     ///     NULL otherwise.
     //------------------------------------------------------------------
     const char *
-    PeekCStr (uint32_t offset) const;
+    PeekCStr (uint64_t offset) const;
 
     //------------------------------------------------------------------
     /// Peek at a bytes at \a offset.
@@ -1050,7 +1082,7 @@ public:
     ///     otherwise.
     //------------------------------------------------------------------
     const uint8_t*
-    PeekData (uint32_t offset, uint32_t length) const;
+    PeekData (uint64_t offset, uint64_t length) const;
 
     //------------------------------------------------------------------
     /// Set the address byte size.
@@ -1088,8 +1120,8 @@ public:
     /// @return
     ///     The number of bytes that this object now contains.
     //------------------------------------------------------------------
-    uint32_t
-    SetData (const void *bytes, uint32_t length, lldb::ByteOrder byte_order);
+    size_t
+    SetData (const void *bytes, uint64_t length, lldb::ByteOrder byte_order);
 
     //------------------------------------------------------------------
     /// Adopt a subset of \a data.
@@ -1117,8 +1149,8 @@ public:
     /// @return
     ///     The number of bytes that this object now contains.
     //------------------------------------------------------------------
-    uint32_t
-    SetData (const DataExtractor& data, uint32_t offset, uint32_t length);
+    size_t
+    SetData (const DataExtractor& data, uint64_t offset, uint64_t length);
 
     //------------------------------------------------------------------
     /// Adopt a subset of shared data in \a data_sp.
@@ -1145,8 +1177,8 @@ public:
     /// @return
     ///     The number of bytes that this object now contains.
     //------------------------------------------------------------------
-    uint32_t
-    SetData (const lldb::DataBufferSP& data_sp, uint32_t offset = 0, uint32_t length = UINT32_MAX);
+    size_t
+    SetData (const lldb::DataBufferSP& data_sp, uint64_t offset = 0, uint64_t length = UINT64_MAX);
 
     //------------------------------------------------------------------
     /// Set the byte_order value.
@@ -1181,8 +1213,9 @@ public:
     /// @return
     //      The number of bytes consumed during the extraction.
     //------------------------------------------------------------------
+    template <typename OffsetType>
     uint32_t
-    Skip_LEB128 (uint32_t *offset_ptr) const;
+    Skip_LEB128 (OffsetType *offset_ptr) const;
 
     //------------------------------------------------------------------
     /// Test the validity of \a offset.
@@ -1192,7 +1225,7 @@ public:
     ///     object, \b false otherwise.
     //------------------------------------------------------------------
     bool
-    ValidOffset (uint32_t offset) const
+    ValidOffset (uint64_t offset) const
     {
         return offset < GetByteSize();
     }
@@ -1205,7 +1238,7 @@ public:
     ///     length bytes available at that offset, \b false otherwise.
     //------------------------------------------------------------------
     bool
-    ValidOffsetForDataOfSize (uint32_t offset, uint32_t length) const;
+    ValidOffsetForDataOfSize (uint64_t offset, uint64_t length) const;
 
     size_t
     Copy (DataExtractor& dest_data) const;
@@ -150,12 +150,19 @@ public:
         return m_frame_format.c_str();
     }
 
+    const CompiledFormatString &
+    GetCompiledFrameFormat() const
+    {
+        return m_compiled_frame_format;
+    }
+
     bool
     SetFrameFormat(const char *frame_format)
     {
         if (frame_format && frame_format[0])
         {
             m_frame_format.assign (frame_format);
+            m_compiled_frame_format.Compile (frame_format);
             return true;
         }
         return false;
@@ -167,12 +174,19 @@ public:
         return m_thread_format.c_str();
     }
 
+    const CompiledFormatString &
+    GetCompiledThreadFormat() const
+    {
+        return m_compiled_thread_format;
+    }
+
     bool
     SetThreadFormat(const char *thread_format)
     {
         if (thread_format && thread_format[0])
         {
             m_thread_format.assign (thread_format);
+            m_compiled_thread_format.Compile (thread_format);
             return true;
         }
         return false;
@@ -243,6 +257,8 @@ private:
     std::string m_prompt;
     std::string m_frame_format;
     std::string m_thread_format;
+    CompiledFormatString m_compiled_frame_format;   // m_frame_format parsed for Debugger::FormatPrompt()
+    CompiledFormatString m_compiled_thread_format;  // m_thread_format parsed for Debugger::FormatPrompt()
     lldb::ScriptLanguage m_script_lang;
     bool m_use_external_editor;
     bool m_auto_confirm_on;
@@ -463,6 +479,16 @@ public:
                   const char **end,
                   ValueObject* valobj = NULL);
 
+    // Same as above, but runs a format string that was already parsed
+    // into a CompiledFormatString.
+    static bool
+    FormatPrompt (const CompiledFormatString &format,
+                  const SymbolContext *sc,
+                  const ExecutionContext *exe_ctx,
+                  const Address *addr,
+                  Stream &s,
+                  ValueObject* valobj = NULL);
+
 
     void
     CleanUpInputReaders ();
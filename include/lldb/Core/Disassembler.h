@@ -169,6 +169,26 @@ public:
     void
     Append (lldb::InstructionSP &inst_sp);
 
+    //------------------------------------------------------------------
+    /// Find the first branch instruction at or after \a start.
+    ///
+    /// @return
+    ///     The index of the branch, or UINT32_MAX if there are no more
+    ///     branches in the list.
+    //------------------------------------------------------------------
+    uint32_t
+    GetIndexOfNextBranchInstruction (uint32_t start) const;
+
+    //------------------------------------------------------------------
+    /// Find the instruction that starts at \a load_addr.
+    ///
+    /// @return
+    ///     The index of the instruction, or UINT32_MAX if no instruction
+    ///     starts at that address.
+    //------------------------------------------------------------------
+    uint32_t
+    GetIndexOfInstructionAtLoadAddress (lldb::addr_t load_addr, Target &target) const;
+
     void
     Dump (Stream *s,
           bool show_address,
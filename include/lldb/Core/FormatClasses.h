@@ -31,6 +31,7 @@ struct PyObject;
 #include <unistd.h>
 
 // C++ Includes
+#include <map>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,7 @@ struct PyObject;
 
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Interpreter/ScriptInterpreterPython.h"
+#include "lldb/Symbol/ClangASTType.h"
 
 namespace lldb_private {
 
@@ -363,6 +365,175 @@ public:
 };
 
 #endif // #ifndef LLDB_DISABLE_PYTHON
+
+//----------------------------------------------------------------------
+// Synthetic children implemented natively in LLDB. The front end is
+// produced by a plain factory function, so this works regardless of
+// whether Python is available.
+//----------------------------------------------------------------------
+class CXXSyntheticChildren : public SyntheticChildren
+{
+public:
+    typedef SyntheticChildrenFrontEnd* (*CreateFrontEndCallback) (lldb::ValueObjectSP);
+    
+    CXXSyntheticChildren(bool casc,
+                         bool skipptr,
+                         bool skipref,
+                         const char *description,
+                         CreateFrontEndCallback callback) :
+    SyntheticChildren(casc, skipptr, skipref),
+    m_description(description ? description : ""),
+    m_create_callback(callback)
+    {
+    }
+    
+    bool
+    IsScripted()
+    {
+        return false;
+    }
+    
+    std::string
+    GetDescription();
+    
+    virtual SyntheticChildrenFrontEnd::SharedPointer
+    GetFrontEnd(lldb::ValueObjectSP backend)
+    {
+        if (m_create_callback == NULL || backend.get() == NULL)
+            return SyntheticChildrenFrontEnd::SharedPointer();
+        return SyntheticChildrenFrontEnd::SharedPointer(m_create_callback(backend));
+    }
+    
+private:
+    std::string m_description;
+    CreateFrontEndCallback m_create_callback;
+};
+
+//----------------------------------------------------------------------
+// Front ends for the GNU libstdc++ containers. These know the layout of
+// the container implementation, read the control structures straight out
+// of process memory and cache what they learn until the next Update().
+//----------------------------------------------------------------------
+class LibstdcppVectorSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+{
+public:
+    LibstdcppVectorSyntheticFrontEnd (lldb::ValueObjectSP be);
+    
+    virtual
+    ~LibstdcppVectorSyntheticFrontEnd ()
+    {
+    }
+    
+    virtual uint32_t
+    CalculateNumChildren ();
+    
+    virtual lldb::ValueObjectSP
+    GetChildAtIndex (uint32_t idx, bool can_create);
+    
+    virtual uint32_t
+    GetIndexOfChildWithName (const ConstString &name);
+    
+    virtual void
+    Update ();
+    
+    static SyntheticChildrenFrontEnd *
+    CreateInstance (lldb::ValueObjectSP backend);
+    
+private:
+    lldb::ValueObjectSP m_start_sp;
+    ClangASTType m_element_type;
+    uint32_t m_element_size;
+    uint32_t m_num_elements;
+};
+
+class LibstdcppListSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+{
+public:
+    LibstdcppListSyntheticFrontEnd (lldb::ValueObjectSP be);
+    
+    virtual
+    ~LibstdcppListSyntheticFrontEnd ()
+    {
+    }
+    
+    virtual uint32_t
+    CalculateNumChildren ();
+    
+    virtual lldb::ValueObjectSP
+    GetChildAtIndex (uint32_t idx, bool can_create);
+    
+    virtual uint32_t
+    GetIndexOfChildWithName (const ConstString &name);
+    
+    virtual void
+    Update ();
+    
+    static SyntheticChildrenFrontEnd *
+    CreateInstance (lldb::ValueObjectSP backend);
+    
+private:
+    void
+    FetchNodes ();
+    
+    lldb::addr_t m_head_addr;
+    uint32_t m_data_offset;
+    ClangASTType m_element_type;
+    std::vector<lldb::addr_t> m_nodes;  // Addresses of the nodes in list order
+    bool m_nodes_fetched;
+};
+
+class LibstdcppMapSyntheticFrontEnd : public SyntheticChildrenFrontEnd
+{
+public:
+    LibstdcppMapSyntheticFrontEnd (lldb::ValueObjectSP be);
+    
+    virtual
+    ~LibstdcppMapSyntheticFrontEnd ()
+    {
+    }
+    
+    virtual uint32_t
+    CalculateNumChildren ();
+    
+    virtual lldb::ValueObjectSP
+    GetChildAtIndex (uint32_t idx, bool can_create);
+    
+    virtual uint32_t
+    GetIndexOfChildWithName (const ConstString &name);
+    
+    virtual void
+    Update ();
+    
+    static SyntheticChildrenFrontEnd *
+    CreateInstance (lldb::ValueObjectSP backend);
+    
+private:
+    struct TreeNode
+    {
+        lldb::addr_t parent;
+        lldb::addr_t left;
+        lldb::addr_t right;
+    };
+    
+    bool
+    ReadTreeNode (lldb::addr_t node_addr, TreeNode &node);
+    
+    lldb::addr_t
+    IncrementNode (lldb::addr_t node_addr);
+    
+    bool
+    FetchNodes (uint32_t count);
+    
+    typedef std::map<lldb::addr_t, TreeNode> TreeNodeMap;
+    
+    lldb::addr_t m_header_addr;
+    uint32_t m_data_offset;
+    uint32_t m_num_elements;
+    ClangASTType m_element_type;
+    std::vector<lldb::addr_t> m_nodes;  // Addresses of the nodes in key order
+    TreeNodeMap m_tree_nodes;           // Node links read so far
+};
+
 class SyntheticArrayView : public SyntheticChildren
 {
 public:
@@ -566,6 +737,110 @@ private:
 };
 
 
+//----------------------------------------------------------------------
+// A format string, as used by string summaries and by the frame-format
+// and thread-format settings, parsed once into a flat list of operations
+// that Debugger::FormatPrompt() can run repeatedly without scanning or
+// copying the text again.
+//----------------------------------------------------------------------
+class CompiledFormatString
+{
+public:
+    enum OpKind
+    {
+        eOpLiteral,     // Write "length" bytes from the literal pool
+        eOpVariable,    // Expand a "${...}" variable
+        eOpScope,       // Run the ops up to "scope_end" and keep the output only if all variables expanded
+        eOpAbort        // The enclosing scope was not terminated, fail it
+    };
+
+    struct Op
+    {
+        OpKind kind;
+        uint32_t offset;            // Literal: offset in the literal pool, variable: offset of the name in the format
+        uint32_t length;            // Literal: byte size, variable: length of the name up to the closing '}'
+        uint32_t scope_end;         // Scope: index of the first op after the scope
+        bool unconditional;         // Literal: written even if an earlier variable failed to expand
+        uint32_t percent_offset;    // Variable: offset of the '%' format descriptor in the name, or UINT32_MAX
+        lldb::Format custom_format; // Variable: the format named by the descriptor
+        bool has_display;           // Variable: true if the descriptor selects a display style
+        ValueObject::ValueObjectRepresentationStyle display;
+        uint32_t expr_path_offset;  // Variable: offset of the "${var...}" expression path in the literal pool, or UINT32_MAX
+    };
+
+    CompiledFormatString ();
+
+    CompiledFormatString (const char *format);
+
+    void
+    Compile (const char *format);
+
+    const char *
+    GetFormat () const
+    {
+        return m_format.c_str();
+    }
+
+    bool
+    IsEmpty () const
+    {
+        return m_format.empty();
+    }
+
+    size_t
+    GetNumOps () const
+    {
+        return m_ops.size();
+    }
+
+    const Op &
+    GetOpAtIndex (size_t idx) const
+    {
+        return m_ops[idx];
+    }
+
+    const char *
+    GetLiteral (const Op &op) const
+    {
+        return m_literals.data() + op.offset;
+    }
+
+    const char *
+    GetVariableName (const Op &op) const
+    {
+        return m_format.c_str() + op.offset;
+    }
+
+    const char *
+    GetExpressionPath (const Op &op) const
+    {
+        if (op.expr_path_offset == UINT32_MAX)
+            return NULL;
+        return m_literals.c_str() + op.expr_path_offset;
+    }
+
+    // Parse the part of a variable after the '%' (e.g. "x" in "${var%x}").
+    // Returns true if the descriptor selected a display style.
+    static bool
+    ParseFormatDescriptor (const char *format_name,
+                           lldb::Format &custom_format,
+                           ValueObject::ValueObjectRepresentationStyle &val_obj_display);
+
+private:
+    const char *
+    CompileScope (const char *p);
+
+    void
+    AppendLiteral (const char *bytes, size_t length, bool unconditional);
+
+    void
+    AppendVariable (const char *var_name_begin, const char *var_name_end);
+
+    std::string m_format;
+    std::string m_literals;     // Unescaped literal text followed by NULL terminated expression paths
+    std::vector<Op> m_ops;
+};
+
 struct SummaryFormat
 {
     uint32_t m_my_revision;
@@ -638,6 +913,7 @@ struct SummaryFormat
 struct StringSummaryFormat : public SummaryFormat
 {
     std::string m_format;
+    CompiledFormatString m_compiled_format;
     
     StringSummaryFormat(bool casc = false,
                         bool skipptr = false,
@@ -406,6 +406,12 @@ public:
         m_demangled.SetCString (name);
     }
 
+    void
+    SetDemangledName (const ConstString &name)
+    {
+        m_demangled = name;
+    }
+
     void
     SetMangledName (const char *name)
     {
@@ -171,6 +171,27 @@ public:
     bool
     operator < (const RegularExpression& rhs) const;
 
+    //------------------------------------------------------------------
+    /// Get a string that any string matched by this regular expression
+    /// must contain.
+    ///
+    /// This is worked out conservatively from the expression text and
+    /// can be used to quickly rule out strings before running the full
+    /// regular expression on them.
+    ///
+    /// @param[out] literal
+    ///     The longest run of literal characters that every match has
+    ///     to contain.
+    ///
+    /// @return
+    ///     \b true if a non-empty literal was found, \b false if the
+    ///     expression is invalid, not an extended regular expression,
+    ///     is case insensitive, uses alternation or if every character
+    ///     might be optional.
+    //------------------------------------------------------------------
+    bool
+    GetRequiredLiteral (std::string &literal) const;
+
 private:
     //------------------------------------------------------------------
     // Member variables
@@ -183,6 +204,102 @@ private:
     
 };
 
+//----------------------------------------------------------------------
+/// @class RegularExpressionIndex RegularExpression.h "lldb/Core/RegularExpression.h"
+/// @brief A trigram index for matching a regular expression against a
+///        large collection of strings.
+///
+/// Each string is identified by a caller supplied ID. The index records
+/// which strings contain each (hashed) three character sequence so that
+/// a regular expression with a long enough required literal (see
+/// RegularExpression::GetRequiredLiteral()) only needs to be run on the
+/// strings that contain all of its trigrams.
+///
+/// The posting lists are delta encoded, so the index typically uses a
+/// byte or two per trigram of each string.
+//----------------------------------------------------------------------
+class RegularExpressionIndex
+{
+public:
+    RegularExpressionIndex ();
+
+    ~RegularExpressionIndex ();
+
+    void
+    Clear ();
+
+    bool
+    IsEmpty () const
+    {
+        return m_buckets.empty();
+    }
+
+    //------------------------------------------------------------------
+    /// Prepare the index for about \a num_strings strings. Must be
+    /// called before Append().
+    //------------------------------------------------------------------
+    void
+    Reserve (size_t num_strings);
+
+    //------------------------------------------------------------------
+    /// Add a string to the index. IDs must be appended in increasing
+    /// order.
+    //------------------------------------------------------------------
+    void
+    Append (uint32_t id, const char *cstr);
+
+    //------------------------------------------------------------------
+    /// Release any extra memory after all strings have been appended.
+    //------------------------------------------------------------------
+    void
+    Finalize ();
+
+    //------------------------------------------------------------------
+    /// Find the IDs of the strings that might match \a regex.
+    ///
+    /// @param[in] regex
+    ///     The regular expression that is going to be run.
+    ///
+    /// @param[out] ids
+    ///     The candidate IDs in increasing order. The caller still
+    ///     needs to run \a regex on each of them.
+    ///
+    /// @return
+    ///     \b true if \a ids was filled in, \b false if the index
+    ///     can't narrow down the search for \a regex and every string
+    ///     must be checked.
+    //------------------------------------------------------------------
+    bool
+    FindCandidates (const RegularExpression &regex, std::vector<uint32_t> &ids) const;
+
+    //------------------------------------------------------------------
+    /// Collections with fewer strings than this aren't worth indexing.
+    //------------------------------------------------------------------
+    static size_t
+    GetMinimumStringCount ();
+
+protected:
+    struct Bucket
+    {
+        Bucket () :
+            last_id (0),
+            count (0),
+            deltas ()
+        {
+        }
+
+        uint32_t last_id;
+        uint32_t count;
+        std::vector<uint8_t> deltas;
+    };
+
+    uint32_t
+    GetBucketIndex (const char *trigram) const;
+
+    std::vector<Bucket> m_buckets;
+    uint32_t m_bucket_bits;
+};
+
 } // namespace lldb_private
 
 #endif  // #if defined(__cplusplus)
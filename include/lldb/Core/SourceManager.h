@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <list>
 #include <map>
 #include <vector>
 
@@ -19,6 +20,7 @@
 // Project includes
 #include "lldb/lldb-private.h"
 #include "lldb/Host/FileSpec.h"
+#include "lldb/Host/Mutex.h"
 
 namespace lldb_private {
 
@@ -69,9 +71,18 @@ public:
         bool
         CalculateLineOffsets (uint32_t line = UINT32_MAX);
 
+        void
+        UpdateIfNeeded ();
+
+        void
+        ReadFileContents ();
+
         FileSpec m_file_spec_orig;  // The original file spec that was used (can be different from m_file_spec)
         FileSpec m_file_spec;       // The actualy file spec being used (if the target has source mappings, this might be different from m_file_spec_orig)
         TimeValue m_mod_time;       // Keep the modification time that this file data is valid for
+        TimeValue m_check_time;     // The last time we checked m_mod_time against the file
+        int m_watch_descriptor;     // Handle used to get notified of changes to m_file_spec, or -1
+        uint32_t m_watch_generation;
         lldb::DataBufferSP m_data_sp;
         typedef std::vector<uint32_t> LineOffsets;
         LineOffsets m_offsets;
@@ -85,17 +96,23 @@ public:
 
    // The SourceFileCache class separates the source manager from the cache of source files, so the 
    // cache can be stored in the Debugger, but the source managers can be per target.     
+    // The cache holds a bounded number of files and drops the least recently used one when it is full.
+    // Files are keyed on the path after the target's source path remapping, and the cache may be used
+    // by several threads at once.
     class SourceFileCache
     {
     public:
-        SourceFileCache () {};
+        SourceFileCache () : m_mutex (Mutex::eMutexTypeNormal), m_file_list (), m_file_cache () {};
         ~SourceFileCache() {};
         
-        void AddSourceFile (const FileSP &file_sp);
-        FileSP FindSourceFile (const FileSpec &file_spec) const;
+        void AddSourceFile (const FileSpec &file_spec, const FileSP &file_sp);
+        FileSP FindSourceFile (const FileSpec &file_spec);
         
     protected:
-        typedef std::map <FileSpec, FileSP> FileCache;
+        typedef std::list <std::pair<FileSpec, FileSP> > FileList;  // Most recently used first
+        typedef std::map <FileSpec, FileList::iterator> FileCache;
+        Mutex m_mutex;
+        FileList m_file_list;
         FileCache m_file_cache;
     };
 #endif
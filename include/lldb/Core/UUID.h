@@ -22,7 +22,8 @@ namespace lldb_private {
 class UUID
 {
 public:
-    typedef uint8_t ValueType[16];
+    // Most UUIDs are 16 bytes, but some Linux build-ids (SHA1) are 20.
+    typedef uint8_t ValueType[20];
 
     //------------------------------------------------------------------
     // Constructors and Destructors
@@ -45,25 +46,26 @@ public:
     const void *
     GetBytes() const;
 
-    static size_t
-    GetByteSize();
+    size_t
+    GetByteSize() const;
 
     bool
     IsValid () const;
 
-    void
-    SetBytes (const void *uuid_bytes);
+    bool
+    SetBytes (const void *uuid_bytes, uint32_t num_uuid_bytes = 16);
 
     char *
     GetAsCString (char *dst, size_t dst_len) const;
 
     size_t
-    SetfromCString (const char *c_str);
+    SetfromCString (const char *c_str, uint32_t num_uuid_bytes = 16);
 
 protected:
     //------------------------------------------------------------------
     // Classes that inherit from UUID can see and modify these
     //------------------------------------------------------------------
+    uint32_t m_num_uuid_bytes; // Should be 16 or 20
     ValueType m_uuid;
 };
 
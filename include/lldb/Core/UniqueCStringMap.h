@@ -64,6 +64,12 @@ public:
         T value;
     };
 
+    UniqueCStringMap () :
+        m_map (),
+        m_regex_index ()
+    {
+    }
+
     //------------------------------------------------------------------
     // Call this function multiple times to add a bunch of entries to
     // this map, then later call UniqueCStringMap<T>::Sort() before doing
@@ -72,18 +78,21 @@ public:
     void
     Append (const char *unique_cstr, const T& value)
     {
+        ClearRegexIndex ();
         m_map.push_back (typename UniqueCStringMap<T>::Entry(unique_cstr, value));
     }
 
     void
     Append (const Entry &e)
     {
+        ClearRegexIndex ();
         m_map.push_back (e);
     }
 
     void
     Clear ()
     {
+        ClearRegexIndex ();
         m_map.clear();
     }
 
@@ -94,6 +103,7 @@ public:
     void
     Insert (const char *unique_cstr, const T& value)
     {
+        ClearRegexIndex ();
         typename UniqueCStringMap<T>::Entry e(unique_cstr, value);
         m_map.insert (std::upper_bound (m_map.begin(), m_map.end(), e), e);
     }
@@ -101,6 +111,7 @@ public:
     void
     Insert (const Entry &e)
     {
+        ClearRegexIndex ();
         m_map.insert (std::upper_bound (m_map.begin(), m_map.end(), e), e);
     }
 
@@ -210,11 +221,46 @@ public:
         return values.size() - start_size;
     }
     
+    //------------------------------------------------------------------
+    // Get the values for all names that match "regex". Large maps build
+    // a trigram index of their unique names the first time this is
+    // called so that only the names that could match need to be run
+    // through the regular expression.
+    //
+    // The caller is responsible for ensuring that the collection does
+    // not change, and isn't searched from another thread, during this
+    // call.
+    //------------------------------------------------------------------
     size_t
     GetValues (const RegularExpression& regex, std::vector<T> &values) const
     {
         const size_t start_size = values.size();
 
+        if (m_map.size() >= RegularExpressionIndex::GetMinimumStringCount())
+        {
+            if (m_regex_index.IsEmpty())
+                BuildRegexIndex ();
+
+            std::vector<uint32_t> candidates;
+            if (m_regex_index.FindCandidates (regex, candidates))
+            {
+                const size_t num_entries = m_map.size();
+                const size_t num_candidates = candidates.size();
+                for (size_t i = 0; i < num_candidates; ++i)
+                {
+                    const char *cstring = m_map[candidates[i]].cstring;
+                    if (regex.Execute (cstring))
+                    {
+                        // Only the first entry of each run of identical
+                        // names is in the index.
+                        for (size_t idx = candidates[i]; idx < num_entries && m_map[idx].cstring == cstring; ++idx)
+                            values.push_back (m_map[idx].value);
+                    }
+                }
+                return values.size() - start_size;
+            }
+        }
+
         const_iterator pos, end = m_map.end();
         for (pos = m_map.begin(); pos != end; ++pos)
         {
@@ -271,6 +317,7 @@ public:
     void
     Sort ()
     {
+        ClearRegexIndex ();
         std::sort (m_map.begin(), m_map.end());
     }
     
@@ -296,7 +343,29 @@ protected:
     typedef std::vector<Entry> collection;
     typedef typename collection::iterator iterator;
     typedef typename collection::const_iterator const_iterator;
+
+    void
+    ClearRegexIndex ()
+    {
+        if (!m_regex_index.IsEmpty())
+            m_regex_index.Clear();
+    }
+
+    void
+    BuildRegexIndex () const
+    {
+        const size_t num_entries = m_map.size();
+        m_regex_index.Reserve (num_entries);
+        for (size_t i = 0; i < num_entries; ++i)
+        {
+            if (i == 0 || m_map[i].cstring != m_map[i - 1].cstring)
+                m_regex_index.Append (i, m_map[i].cstring);
+        }
+        m_regex_index.Finalize ();
+    }
+
     collection m_map;
+    mutable RegularExpressionIndex m_regex_index; // Built on demand by GetValues (const RegularExpression&, ...)
 };
 
 
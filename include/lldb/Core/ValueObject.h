@@ -1056,6 +1056,64 @@ public:
 protected:
     typedef ClusterManager<ValueObject> ValueObjectManager;
 
+    //------------------------------------------------------------------
+    // The children of a value object, kept in fixed-size pages that are
+    // only allocated once a child in their range is created. A value with
+    // a million children costs nothing until some of them are looked at,
+    // and looking at the last one allocates a single page rather than a
+    // million slots.
+    //------------------------------------------------------------------
+    class ChildrenPages
+    {
+    public:
+        enum
+        {
+            kPageSize = 128
+        };
+        
+        ChildrenPages () :
+            m_count (0),
+            m_pages ()
+        {
+        }
+        
+        uint32_t
+        GetCount () const
+        {
+            return m_count;
+        }
+        
+        // Changes the number of children and drops any pages that lie
+        // entirely past the new end.
+        void
+        SetCount (uint32_t count);
+        
+        ValueObject *
+        GetChildAtIndex (uint32_t idx) const;
+        
+        void
+        SetChildAtIndex (uint32_t idx, ValueObject *valobj);
+        
+        bool
+        HasPageForIndex (uint32_t idx) const
+        {
+            return m_pages.find (idx / kPageSize) != m_pages.end();
+        }
+        
+        void
+        Clear ()
+        {
+            m_count = 0;
+            m_pages.clear();
+        }
+        
+    private:
+        typedef std::map<uint32_t, std::vector<ValueObject *> > PageMap;
+        
+        uint32_t m_count;
+        PageMap m_pages;
+    };
+
     //------------------------------------------------------------------
     // Classes that inherit from ValueObject can see and modify these
     //------------------------------------------------------------------
@@ -1080,7 +1138,8 @@ protected:
                                         // as a shared pointer to any of them has been handed out.  Shared pointers to
                                         // value objects must always be made with the GetSP method.
 
-    std::vector<ValueObject *>           m_children;
+    ChildrenPages                        m_children;
+    ChildrenPages                        m_synthetic_array_members; // "[N]" members made by GetSyntheticArrayMember() for N >= 0
     std::map<ConstString, ValueObject *> m_synthetic_children;
     
     ValueObject*                         m_dynamic_value;
@@ -1175,6 +1234,19 @@ protected:
     AddSyntheticChild (const ConstString &key,
                        ValueObject *valobj);
     
+    void
+    AddSyntheticArrayMember (int32_t index,
+                             ValueObject *valobj);
+    
+    lldb::ValueObjectSP
+    GetSyntheticArrayMemberIfCreated (int32_t index) const;
+    
+    // Reads the target memory behind the page of array elements that
+    // contains "idx" into the process memory cache with a single read,
+    // so the children created for that page don't each go to the process.
+    void
+    PrefetchChildrenPage (uint32_t idx, bool synthetic_array_member);
+    
     DataExtractor &
     GetDataExtractor ();
     
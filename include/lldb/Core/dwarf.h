@@ -25,19 +25,21 @@ typedef uint8_t     dw_form_t;
 typedef uint16_t    dw_tag_t;
 typedef uint64_t    dw_addr_t;      // Dwarf address define that must be big enough for any addresses in the compile units that get parsed
 
-#ifdef DWARFUTILS_DWARF64
-#define DWARF_REF_ADDR_SIZE     8
-typedef uint64_t    dw_offset_t;    // Dwarf Debug Information Entry offset for any offset into the file
-#else
+// dw_offset_t holds any offset into a DWARF section (DIE, compile unit and
+// table offsets). Sections are still walked with 32 bit offsets when they
+// are smaller than 4GB (see DW_SECTION_NEEDS_64BIT_OFFSETS), but offsets
+// are always stored with 64 bits so DIEs past 4GB can be used.
 #define DWARF_REF_ADDR_SIZE     4
-typedef uint32_t    dw_offset_t;    // Dwarf Debug Information Entry offset for any offset into the file
-#endif
+typedef uint64_t    dw_offset_t;    // Dwarf Debug Information Entry offset for any offset into the file
 
 /* Constants */
 #define DW_INVALID_ADDRESS                  (~(dw_addr_t)0)
 #define DW_INVALID_OFFSET                   (~(dw_offset_t)0)
 #define DW_INVALID_INDEX                    0xFFFFFFFFul
 
+// True if offsets into a section of BYTE_SIZE bytes need 64 bits
+#define DW_SECTION_NEEDS_64BIT_OFFSETS(byte_size)   ((uint64_t)(byte_size) > 0xFFFFFFFFull)
+
 // #define DW_ADDR_none 0x0
 
 #define DW_EH_PE_MASK_ENCODING 0x0F
@@ -48,7 +48,8 @@ public:
         m_lookups_enabled (false),
         m_target (target),
         m_ast_context (NULL),
-        m_active_lookups ()
+        m_active_lookups (),
+        m_num_completed_types (0)
     {
         m_ast_importer = m_target->GetClangASTImporter();
     }
@@ -138,6 +139,18 @@ public:
     virtual void 
     CompleteType (clang::ObjCInterfaceDecl *Class);
     
+    //------------------------------------------------------------------
+    /// Get the number of types the parser asked this source to complete.
+    ///
+    /// @return
+    ///     The number of CompleteType() calls so far.
+    //------------------------------------------------------------------
+    uint32_t
+    GetNumCompletedTypes () const
+    {
+        return m_num_completed_types;
+    }
+    
     //------------------------------------------------------------------
     /// Called on entering a translation unit.  Tells Clang by calling
     /// setHasExternalVisibleStorage() and setHasExternalLexicalStorage()
@@ -360,6 +373,7 @@ protected:
 	clang::ASTContext                  *m_ast_context;      ///< The AST context requests are coming in for.
     ClangASTImporter                   *m_ast_importer;     ///< The target's AST importer.
     std::set<const char *>              m_active_lookups;
+    uint32_t                            m_num_completed_types; ///< The number of CompleteType() requests from the parser.
 };
 
 //----------------------------------------------------------------------
@@ -107,6 +107,35 @@ public:
     void 
     DidParse ();
     
+    //------------------------------------------------------------------
+    /// [Used by ClangUserExpression] Determine whether the struct can be
+    /// materialized again for a later run of the same code.  This is not
+    /// possible if the expression uses persistent variables other than
+    /// its result, because their offsets in the struct are shared with
+    /// every other expression that uses them.
+    ///
+    /// @return
+    ///     True if WillReuse() can be called; false otherwise.
+    //------------------------------------------------------------------
+    bool
+    CanReuse ();
+
+    //------------------------------------------------------------------
+    /// [Used by ClangUserExpression] Prepare to materialize the struct
+    /// for another run of the expression in a new execution context.
+    /// The result gets a new persistent variable, so that the results
+    /// of earlier runs are left untouched.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context the expression will run in.  Its frame
+    ///     must be stopped in the block the expression was parsed in.
+    ///
+    /// @return
+    ///     True on success; false if the expression must be parsed again.
+    //------------------------------------------------------------------
+    bool
+    WillReuse (ExecutionContext &exe_ctx);
+
     //------------------------------------------------------------------
     /// [Used by IRForTarget] Get a new result variable name of the form
     ///     $n, where n is a natural number starting with 0.
@@ -725,6 +754,7 @@ private:
             m_struct_size(0),
             m_struct_laid_out(false),
             m_result_name(),
+            m_result_flags(0),
             m_object_pointer_type(NULL, NULL)
         {
         }
@@ -733,6 +763,7 @@ private:
         size_t                      m_struct_size;              ///< The size of the struct in bytes.
         bool                        m_struct_laid_out;          ///< True if the struct has been laid out and the layout is valid (that is, no new fields have been added since).
         ConstString                 m_result_name;              ///< The name of the result variable ($1, for example)
+        uint16_t                    m_result_flags;             ///< The flags the result variable was created with, for creating the result of a later run
         TypeFromUser                m_object_pointer_type;      ///< The type of the "this" variable, if one exists
     };
     
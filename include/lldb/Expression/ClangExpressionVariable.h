@@ -282,6 +282,34 @@ public:
         return false;
     }
 
+    //----------------------------------------------------------------------
+    /// Replaces a variable in the list, keeping its position.
+    ///
+    /// @param[in] var_sp
+    ///     The variable to replace.
+    ///
+    /// @param[in] new_var_sp
+    ///     The variable to put in its place.
+    ///
+    /// @return
+    ///     True if the variable was found and replaced; false otherwise.
+    //----------------------------------------------------------------------
+    bool
+    ReplaceVariable (const lldb::ClangExpressionVariableSP &var_sp,
+                     const lldb::ClangExpressionVariableSP &new_var_sp)
+    {
+        const size_t size = m_variables.size();
+        for (size_t index = 0; index < size; ++index)
+        {
+            if (m_variables[index].get() == var_sp.get())
+            {
+                m_variables[index] = new_var_sp;
+                return true;
+            }
+        }
+        return false;
+    }
+
     //----------------------------------------------------------------------
     /// Finds a variable by name in the list.
     ///
@@ -105,7 +105,34 @@ public:
            TypeFromUser desired_type,
            lldb_private::ExecutionPolicy execution_policy,
            bool keep_result_in_memory);
-    
+
+    //------------------------------------------------------------------
+    /// Determine whether the JIT compiled code for the expression can
+    /// be executed again later, so that the expression is worth keeping
+    /// in the target's expression cache.
+    ///
+    /// @return
+    ///     True if PrepareToReuse() can succeed; false otherwise.
+    //------------------------------------------------------------------
+    bool
+    CanBeReused ();
+
+    //------------------------------------------------------------------
+    /// Prepare an expression that has already been parsed and JIT
+    /// compiled to be executed again, without parsing it again.
+    ///
+    /// @param[in] exe_ctx
+    ///     The execution context to execute the expression in.  Its
+    ///     frame must be stopped in the block that the expression was
+    ///     parsed in.
+    ///
+    /// @return
+    ///     True if Execute() can be called; false if the expression
+    ///     has to be parsed again.
+    //------------------------------------------------------------------
+    bool
+    PrepareToReuse (ExecutionContext &exe_ctx);
+
     //------------------------------------------------------------------
     /// Execute the parsed expression
     ///
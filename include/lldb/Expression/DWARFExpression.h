@@ -10,6 +10,8 @@
 #ifndef liblldb_DWARFExpression_h_
 #define liblldb_DWARFExpression_h_
 
+#include <vector>
+
 #include "lldb/lldb-private.h"
 #include "lldb/Core/ClangForward.h"
 #include "lldb/Core/Address.h"
@@ -380,6 +382,69 @@ protected:
                  uint32_t &offset, 
                  uint32_t &len);
 
+    //------------------------------------------------------------------
+    /// A location expression decoded ahead of time.  Most variable
+    /// locations are a single DW_OP_fbreg, DW_OP_bregN, DW_OP_regN or
+    /// DW_OP_addr opcode, and those are evaluated straight from the
+    /// decoded operands without running the interpreter.
+    //------------------------------------------------------------------
+    struct CompiledExpression
+    {
+        enum Kind
+        {
+            eKindGeneral,           // Anything else, run the interpreter
+            eKindFrameBase,         // DW_OP_fbreg(value)
+            eKindRegisterOffset,    // DW_OP_bregN/DW_OP_bregx(reg_num, value)
+            eKindRegister,          // DW_OP_regN/DW_OP_regx(reg_num)
+            eKindFileAddress        // DW_OP_addr(value)
+        };
+
+        uint32_t offset;            // Offset of the opcodes in m_data
+        uint32_t length;            // Length of the opcodes in m_data
+        Kind kind;
+        uint32_t reg_num;
+        uint64_t value;
+    };
+
+    struct CompiledLocationListEntry
+    {
+        lldb::addr_t lo_pc;         // As found in m_data, before any slide
+        lldb::addr_t hi_pc;
+        CompiledExpression expr;
+    };
+
+    struct CompiledLocation
+    {
+        CompiledExpression expr;    // The single expression when this isn't a location list
+        std::vector<CompiledLocationListEntry> loclist; // Non-empty location list entries in list order
+        bool loclist_is_sorted;     // Entries ascend without overlapping, so they can be binary searched
+    };
+
+    typedef lldb::SharedPtr<CompiledLocation>::Type CompiledLocationSP;
+
+    const CompiledLocation &
+    GetCompiledLocation () const;
+
+    const CompiledExpression *
+    FindCompiledLocationListEntry (lldb::addr_t loclist_base_addr, lldb::addr_t pc) const;
+
+    static void
+    CompileExpression (const DataExtractor& opcodes, 
+                       uint32_t offset, 
+                       uint32_t length, 
+                       CompiledExpression &expr);
+
+    bool
+    EvaluateCompiled (const CompiledExpression &expr,
+                      ExecutionContext *exe_ctx,
+                      clang::ASTContext *ast_context,
+                      ClangExpressionVariableList *expr_locals,
+                      ClangExpressionDeclMap *decl_map,
+                      RegisterContext *reg_ctx,
+                      const Value* initial_value_ptr,
+                      Value& result,
+                      Error *error_ptr) const;
+
     //------------------------------------------------------------------
     /// Classes that inherit from DWARFExpression can see and modify these
     //------------------------------------------------------------------
@@ -389,6 +454,7 @@ protected:
     lldb::addr_t m_loclist_slide;               ///< A value used to slide the location list offsets so that 
                                                 ///< they are relative to the object that owns the location list
                                                 ///< (the function for frame base and variable location lists)
+    mutable CompiledLocationSP m_compiled_sp;   ///< The decoded form of m_data, built the first time we are evaluated
 
 };
 
@@ -88,10 +88,25 @@ public:
                         lldb_private::TypeFromParser result_type,
                         llvm::Function &llvm_function,
                         llvm::Module &llvm_module);
+    
+    //------------------------------------------------------------------
+    /// Report whether the last run wrote to the process's memory
+    ///
+    /// @return
+    ///     True if the interpreter changed memory in the process, in
+    ///     which case the expression must not be run again in the JIT
+    ///     even if the interpreter failed.
+    //------------------------------------------------------------------
+    bool
+    WroteProcessMemory () const
+    {
+        return m_wrote_process_memory;
+    }
 private:
     /// Flags
     lldb_private::ClangExpressionDeclMap &m_decl_map;       ///< The DeclMap containing the Decls 
     lldb_private::Stream *m_error_stream;
+    bool m_wrote_process_memory;                            ///< True once the interpreter wrote to the process
     
     bool
     supportsFunction (llvm::Function &llvm_function);
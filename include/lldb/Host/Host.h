@@ -87,6 +87,16 @@ public:
     static size_t
     GetPageSize();
 
+    //------------------------------------------------------------------
+    /// Get the number of CPUs that are currently online.
+    ///
+    /// @return
+    ///     The number of online CPUs on the host system, always at
+    ///     least 1.
+    //------------------------------------------------------------------
+    static uint32_t
+    GetNumberCPUS ();
+
     //------------------------------------------------------------------
     /// Returns the endianness of the host system.
     ///
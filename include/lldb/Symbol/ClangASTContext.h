@@ -537,6 +537,13 @@ public:
                      std::string& name,
                      uint32_t *bit_offset_ptr);
 
+    // Returns the type of template argument "idx" when "clang_type" is a
+    // class template specialization and that argument is a type, else NULL.
+    static lldb::clang_type_t
+    GetTemplateArgumentType (clang::ASTContext *ast,
+                             lldb::clang_type_t clang_type,
+                             uint32_t idx);
+
     static uint32_t
     GetNumPointeeChildren (lldb::clang_type_t clang_type);
 
@@ -34,14 +34,17 @@ public:
     typedef void (*CompleteTagDeclCallback)(void *baton, clang::TagDecl *);
     typedef void (*CompleteObjCInterfaceDeclCallback)(void *baton, clang::ObjCInterfaceDecl *);
     typedef void (*FindExternalVisibleDeclsByNameCallback)(void *baton, const clang::DeclContext *DC, clang::DeclarationName Name, llvm::SmallVectorImpl <clang::NamedDecl *> *results);
+    typedef void (*FindExternalLexicalDeclsCallback)(void *baton, const clang::DeclContext *DC, bool (*isKindWeWant)(clang::Decl::Kind), llvm::SmallVectorImpl <clang::Decl *> *results);
 
     ClangExternalASTSourceCallbacks (CompleteTagDeclCallback tag_decl_callback,
                                      CompleteObjCInterfaceDeclCallback objc_decl_callback,
                                      FindExternalVisibleDeclsByNameCallback find_by_name_callback,
+                                     FindExternalLexicalDeclsCallback find_lexical_callback,
                                      void *callback_baton) :
         m_callback_tag_decl (tag_decl_callback),
         m_callback_objc_decl (objc_decl_callback),
         m_callback_find_by_name (find_by_name_callback),
+        m_callback_find_lexical (find_lexical_callback),
         m_callback_baton (callback_baton)
     {
     }
@@ -96,12 +99,7 @@ public:
 	virtual clang::ExternalLoadResult 
     FindExternalLexicalDecls (const clang::DeclContext *decl_ctx,
                               bool (*isKindWeWant)(clang::Decl::Kind),
-                              llvm::SmallVectorImpl<clang::Decl*> &decls)
-    {
-        // This is used to support iterating through an entire lexical context,
-        // which isn't something the debugger should ever need to do.
-        return clang::ELR_Failure;
-    }
+                              llvm::SmallVectorImpl<clang::Decl*> &decls);
     
     virtual clang::DeclContextLookupResult 
     FindExternalVisibleDeclsByName (const clang::DeclContext *decl_ctx,
@@ -117,11 +115,13 @@ public:
     SetExternalSourceCallbacks (CompleteTagDeclCallback tag_decl_callback,
                                 CompleteObjCInterfaceDeclCallback objc_decl_callback,
                                 FindExternalVisibleDeclsByNameCallback find_by_name_callback,
+                                FindExternalLexicalDeclsCallback find_lexical_callback,
                                 void *callback_baton)
     {
         m_callback_tag_decl = tag_decl_callback;
         m_callback_objc_decl = objc_decl_callback;
         m_callback_find_by_name = find_by_name_callback;
+        m_callback_find_lexical = find_lexical_callback;
         m_callback_baton = callback_baton;    
     }
 
@@ -133,6 +133,7 @@ public:
             m_callback_tag_decl = NULL;
             m_callback_objc_decl = NULL;
             m_callback_find_by_name = NULL;
+            m_callback_find_lexical = NULL;
         }
     }
 
@@ -143,6 +144,7 @@ protected:
     CompleteTagDeclCallback                 m_callback_tag_decl;
     CompleteObjCInterfaceDeclCallback       m_callback_objc_decl;
     FindExternalVisibleDeclsByNameCallback  m_callback_find_by_name;
+    FindExternalLexicalDeclsCallback        m_callback_find_lexical;
     void *                                  m_callback_baton;
 };
 
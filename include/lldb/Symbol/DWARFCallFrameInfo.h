@@ -80,20 +80,26 @@ private:
 
     typedef lldb::SharedPtr<CIE>::Type CIESP;
 
+    // A compact index entry for one FDE.  The index is kept sorted by
+    // start address so lookups are a binary search over a flat array.
     struct FDEEntry
     {
-        AddressRange bounds;   // function bounds
+        lldb::addr_t start;    // function start file address
+        uint32_t size;         // function size in bytes
         dw_offset_t offset;    // offset to this FDE within the Section
 
-        FDEEntry () : bounds (), offset (0) { }
+        FDEEntry () : start (LLDB_INVALID_ADDRESS), size (0), offset (0) { }
+
+        bool
+        Contains (lldb::addr_t file_addr) const
+        {
+            return start <= file_addr && file_addr < start + size;
+        }
 
         inline bool
         operator<(const DWARFCallFrameInfo::FDEEntry& b) const
         {
-            if (bounds.GetBaseAddress().GetOffset() < b.bounds.GetBaseAddress().GetOffset())
-                return true;
-            else
-                return false;
+            return start < b.start;
         }
     };
 
@@ -109,7 +115,19 @@ private:
     GetFDEIndex ();
 
     bool
-    FDEToUnwindPlan (uint32_t offset, Address startaddr, UnwindPlan& unwind_plan);
+    ParseFDEBounds (dw_offset_t fde_offset, FDEEntry& fde_entry);
+
+    bool
+    GetEHFrameHdr ();
+
+    bool
+    GetFDEEntryFromEHFrameHdr (lldb::addr_t file_addr, FDEEntry& fde_entry);
+
+    void
+    GetCFIData ();
+
+    bool
+    FDEToUnwindPlan (dw_offset_t offset, Address startaddr, UnwindPlan& unwind_plan);
 
     const CIE* 
     GetCIE(dw_offset_t cie_offset);
@@ -126,10 +144,18 @@ private:
     std::vector<FDEEntry>       m_fde_index;
     bool                        m_fde_index_initialized;  // only scan the section for FDEs once
 
+    // The binary search table from .eh_frame_hdr, when the linker made one,
+    // is used in place of m_fde_index so the FDEs never need to be scanned.
+    DataExtractor               m_eh_frame_hdr_data;
+    lldb::addr_t                m_eh_frame_hdr_addr;      // file address of .eh_frame_hdr
+    uint32_t                    m_eh_frame_hdr_table_offset;
+    uint32_t                    m_eh_frame_hdr_fde_count;
+    bool                        m_eh_frame_hdr_initialized;
+
     bool                        m_is_eh_frame;
 
     CIESP
-    ParseCIE (const uint32_t cie_offset);
+    ParseCIE (const dw_offset_t cie_offset);
 
 };
 
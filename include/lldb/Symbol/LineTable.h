@@ -179,6 +179,26 @@ public:
                                  bool append,
                                  SymbolContextList &sc_list);
 
+    //------------------------------------------------------------------
+    /// Index the line table rows for one file by line.
+    ///
+    /// Callers that look up many lines of the same file can binary
+    /// search the result instead of calling
+    /// FindLineEntryIndexByFileIndex() once per line.
+    ///
+    /// @param[in] file_idx
+    ///     The file index to match.
+    ///
+    /// @param[out] line_index
+    ///     Filled in with a (line, line table index) pair for every
+    ///     non-terminal row in \a file_idx, sorted by line and then by
+    ///     line table index.
+    //------------------------------------------------------------------
+    typedef std::vector<std::pair<uint32_t, uint32_t> > LineIndex;
+
+    void
+    GetLineIndexForFileIndex (uint32_t file_idx, LineIndex &line_index) const;
+
     //------------------------------------------------------------------
     /// Get the line entry from the line table at index \a idx.
     ///
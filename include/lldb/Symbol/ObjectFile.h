@@ -289,6 +289,56 @@ public:
     virtual Symtab *
     GetSymtab () = 0;
 
+    //------------------------------------------------------------------
+    /// Find symbols by exact name without parsing the symbol table.
+    ///
+    /// Object file formats that contain a hashed name lookup table can
+    /// override this to answer single name lookups before GetSymtab()
+    /// has been called, so the symbol table parsing is deferred until
+    /// something needs to iterate over all of the symbols.
+    ///
+    /// @param[in] name
+    ///     The exact name of the symbol to look up.
+    ///
+    /// @param[in] symbol_type
+    ///     The type of the symbols to find. Lookups for types the
+    ///     table does not cover, such as eSymbolTypeAny, return \b false.
+    ///
+    /// @param[out] symbols
+    ///     The matching symbols are appended to this list. They are
+    ///     owned by the object file and are not the same objects as
+    ///     the symbols GetSymtab() later creates for the same entries.
+    ///
+    /// @return
+    ///     Returns \b true if \a symbols holds every match, \b false if
+    ///     the caller needs to search the symbol table instead.
+    //------------------------------------------------------------------
+    virtual bool
+    FindSymbolsWithNameAndType (const ConstString &name,
+                                lldb::SymbolType symbol_type,
+                                std::vector<Symbol *> &symbols)
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    /// Tells if FindSymbolsWithNameAndType() can answer lookups.
+    ///
+    /// Object files that return \b true only have the exported code
+    /// and data symbols the lookup table covers, so callers that only
+    /// need to know what kinds of symbols exist can avoid parsing the
+    /// symbol table.
+    ///
+    /// @return
+    ///     Returns \b true if code and data symbols can be looked up by
+    ///     name before GetSymtab() has been called.
+    //------------------------------------------------------------------
+    virtual bool
+    HasSymbolNameLookupTable ()
+    {
+        return false;
+    }
+
     //------------------------------------------------------------------
     /// Gets the UUID for this object file.
     ///
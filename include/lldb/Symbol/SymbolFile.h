@@ -50,7 +50,9 @@ public:
     SymbolFile(ObjectFile* obj_file) :
         m_obj_file(obj_file),
         m_abilities(0),
-        m_calculated_abilities(false)
+        m_calculated_abilities(false),
+        m_num_types_parsed(0),
+        m_num_types_completed(0)
     {
     }
 
@@ -147,6 +149,18 @@ public:
 
     ObjectFile*             GetObjectFile() { return m_obj_file; }
     const ObjectFile*       GetObjectFile() const { return m_obj_file; }
+
+    //------------------------------------------------------------------
+    /// Type parsing statistics.
+    ///
+    /// The number of types this symbol file has created from its debug
+    /// information and the number of those whose definitions have been
+    /// completed. Types are created as forward declarations and only
+    /// completed when something needs their members, so these show
+    /// how much debug information an operation pulled in.
+    //------------------------------------------------------------------
+    virtual uint32_t        GetNumTypesParsed () const { return m_num_types_parsed; }
+    virtual uint32_t        GetNumTypesCompleted () const { return m_num_types_completed; }
     
     // Special error functions that can do printf style formatting that will prepend the message with
     // something appropriate for this symbol file (like the architecture, path and object name). This
@@ -159,6 +173,8 @@ protected:
     ObjectFile*             m_obj_file; // The object file that symbols can be extracted from.
     uint32_t                m_abilities;
     bool                    m_calculated_abilities;
+    uint32_t                m_num_types_parsed;     // Types created from the debug information
+    uint32_t                m_num_types_completed;  // Types whose definitions have been completed
 private:
     DISALLOW_COPY_AND_ASSIGN (SymbolFile);
 };
@@ -84,6 +84,10 @@ public:
     
             void        Finalize ()
                         {
+                            // Object files may have changed the symbols through
+                            // the pointer returned by Resize()
+                            ClearSymbolColumns ();
+
                             // Shrink to fit the symbols so we don't waste memory
                             if (m_symbols.capacity() > m_symbols.size())
                             {
@@ -104,14 +108,34 @@ protected:
 
             void        InitNameIndexes ();
             void        InitAddressIndexes ();
+            void        InitRegexIndex ();
+            void        InitSymbolColumns () const;
+            void        ClearSymbolColumns ();
+            bool        GetRegexCandidates (const RegularExpression &regex, std::vector<uint32_t>& candidates);
+
+    // Layout of each byte in m_symbol_attrs: the symbol type in the low
+    // bits (every lldb::SymbolType fits in eSymbolTypeMask) and flags above
+    enum
+    {
+        eSymbolTypeMask     = 0x1fu,
+        eSymbolBitDebug     = (1u << 5),
+        eSymbolBitExternal  = (1u << 6),
+        eSymbolBitAddress   = (1u << 7)    // Symbol has a section offset address
+    };
 
     ObjectFile *        m_objfile;
     collection          m_symbols;
     std::vector<uint32_t> m_addr_indexes;
     UniqueCStringMap<uint32_t> m_name_to_index;
+    RegularExpressionIndex m_regex_index; // Trigram index of the symbol names for regex searches
+    // One byte per symbol holding the attributes that scans filter on,
+    // indexed like m_symbols, so scans read the symbols' types in order
+    // instead of whole Symbol objects. Built on demand by InitSymbolColumns().
+    mutable std::vector<uint8_t> m_symbol_attrs;
     mutable Mutex       m_mutex; // Provide thread safety for this symbol table
     bool                m_addr_indexes_computed:1,
                         m_name_indexes_computed:1;
+    mutable bool        m_symbol_columns_computed;
 private:
 
     bool
@@ -147,6 +171,30 @@ private:
         return false;
     }
 
+    static bool
+    CheckSymbolType (uint8_t symbol_attrs, lldb::SymbolType symbol_type)
+    {
+        return symbol_type == lldb::eSymbolTypeAny || (symbol_attrs & eSymbolTypeMask) == symbol_type;
+    }
+
+    static bool
+    CheckSymbolBits (uint8_t symbol_bits, Debug symbol_debug_type, Visibility symbol_visibility)
+    {
+        switch (symbol_debug_type)
+        {
+        case eDebugNo:  if (symbol_bits & eSymbolBitDebug) return false; break;
+        case eDebugYes: if ((symbol_bits & eSymbolBitDebug) == 0) return false; break;
+        case eDebugAny: break;
+        }
+
+        switch (symbol_visibility)
+        {
+        case eVisibilityAny:        return true;
+        case eVisibilityExtern:     return (symbol_bits & eSymbolBitExternal) != 0;
+        case eVisibilityPrivate:    return (symbol_bits & eSymbolBitExternal) == 0;
+        }
+        return false;
+    }
 
     DISALLOW_COPY_AND_ASSIGN (Symtab);
 };
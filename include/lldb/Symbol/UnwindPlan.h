@@ -328,6 +328,15 @@ public:
         void
         Dump (Stream& s, const UnwindPlan* unwind_plan, Thread* thread, lldb::addr_t base_addr) const;
 
+        // Append this row to the binary stream "s" so it can be read back
+        // with Decode().  Rows with registers described by DWARF expressions
+        // refer to bytes owned by someone else and can't be encoded.
+        bool
+        Encode (Stream& s) const;
+
+        bool
+        Decode (const DataExtractor& data, uint32_t *offset_ptr);
+
         bool
         operator == (const Row &rhs) const
         {
@@ -450,6 +459,18 @@ public:
     const RegisterInfo *
     GetRegisterInfo (Thread* thread, uint32_t reg_num) const;
 
+    // Serialize this plan to the binary stream "s".  The valid address
+    // range is recorded relative to "func_base" so that a plan can be
+    // saved in one session and restored in another where the module has
+    // been loaded at a different address.  Returns false if the plan
+    // can't be represented, in which case the contents of "s" are
+    // undefined.
+    bool
+    Encode (Stream& s, const Address& func_base) const;
+
+    bool
+    Decode (const DataExtractor& data, uint32_t *offset_ptr, const Address& func_base);
+
 private:
 
     
@@ -12,8 +12,10 @@
 #define liblldb_UnwindTable_h
 
 #include <map>
+#include <string>
 
 #include "lldb/lldb-private.h"
+#include "lldb/Host/Mutex.h"
 
 namespace lldb_private {
 
@@ -33,12 +35,35 @@ public:
     lldb::FuncUnwindersSP
     GetFuncUnwindersContainingAddress (const Address& addr, SymbolContext &sc);
 
+    // Profiling a function's assembly to build its non call site UnwindPlan
+    // is expensive, so those plans can also be saved on disk keyed by the
+    // ObjectFile's UUID and the function's file address and size.  Later
+    // debug sessions reload them from there instead of profiling again.
+    // The cache lives in the directory named by the
+    // "target.unwind-plan-cache-path" setting and is off when it is empty.
+    bool
+    GetCachedNonCallSiteUnwindPlan (const AddressRange& range, UnwindPlan& unwind_plan);
+
+    void
+    CacheNonCallSiteUnwindPlan (const AddressRange& range, const UnwindPlan& unwind_plan);
+
 private:
     void
     Dump (Stream &s);
     
     void Initialize ();
 
+    bool
+    LoadUnwindPlanCache ();
+
+    struct CachedUnwindPlan
+    {
+        lldb::addr_t byte_size;     // Size of the function the plan was made for
+        uint32_t data_offset;       // Offset of the encoded plan in m_cache_data_sp
+        uint32_t data_length;       // Length of the encoded plan
+    };
+
+    typedef std::map<lldb::addr_t, CachedUnwindPlan> CachedUnwindPlanMap;
     typedef std::map<lldb::addr_t, lldb::FuncUnwindersSP> collection;
     typedef collection::iterator iterator;
     typedef collection::const_iterator const_iterator;
@@ -51,6 +76,13 @@ private:
     UnwindAssembly* m_assembly_profiler;
 
     DWARFCallFrameInfo* m_eh_frame;
+
+    Mutex               m_cache_mutex;
+    bool                m_cache_loaded;
+    std::string         m_cache_dir;        // The cache directory setting m_cache_path was made from
+    std::string         m_cache_path;       // Empty if this ObjectFile can't be cached
+    lldb::DataBufferSP  m_cache_data_sp;
+    CachedUnwindPlanMap m_cached_plans;
     
     DISALLOW_COPY_AND_ASSIGN (UnwindTable);
 };
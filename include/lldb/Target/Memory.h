@@ -48,6 +48,11 @@ namespace lldb_private {
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        size_t
+        Prefetch (lldb::addr_t addr,
+                  size_t size,
+                  Error &error);
         
         uint32_t
         GetMemoryCacheLineSize() const
@@ -438,6 +438,29 @@ namespace lldb_private {
         {
             return false;
         }
+
+        //------------------------------------------------------------------
+        /// Return a multi-word command object that can be used to expose
+        /// plug-in specific commands.
+        ///
+        /// This object will be used to resolve plug-in commands and can be
+        /// triggered by a call to:
+        ///
+        ///     (lldb) platform plugin <subcommand> [<subcommand-args>]
+        ///
+        /// @param[in] interpreter
+        ///     The command interpreter the command object will be used
+        ///     with.
+        ///
+        /// @return
+        ///     A CommandObject (usually a CommandObjectMultiword) owned by
+        ///     the platform, or NULL if the plug-in has no commands.
+        //------------------------------------------------------------------
+        virtual CommandObject *
+        GetPluginCommandObject (CommandInterpreter &interpreter)
+        {
+            return NULL;
+        }
                 
     protected:
         bool m_is_host;
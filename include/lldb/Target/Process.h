@@ -1527,6 +1527,25 @@ public:
               bool plugin_specified_by_name) = 0;
 
 
+    //------------------------------------------------------------------
+    /// Return a multi-word command object that can be used to expose
+    /// plug-in specific commands.
+    ///
+    /// This object will be used to resolve plug-in commands and can be
+    /// triggered by a call to:
+    ///
+    ///     (lldb) process plugin <subcommand> [<subcommand-args>]
+    ///
+    /// @return
+    ///     A CommandObject (usually a CommandObjectMultiword) owned by
+    ///     the process, or NULL if the plug-in has no commands.
+    //------------------------------------------------------------------
+    virtual CommandObject *
+    GetPluginCommandObject()
+    {
+        return NULL;
+    }
+
     //------------------------------------------------------------------
     /// This object is about to be destroyed, do any necessary cleanup.
     ///
@@ -2361,6 +2380,30 @@ public:
                 size_t size,
                 Error &error);
 
+    //------------------------------------------------------------------
+    /// Read a range of memory into the memory cache ahead of its use.
+    ///
+    /// Any part of the range that isn't cached yet is read from the
+    /// process in as few reads as possible, instead of one cache line
+    /// at a time as ReadMemory() would do. This is only a hint: nothing
+    /// is copied out, and a failed prefetch leaves the error for the
+    /// later ReadMemory() call to report.
+    ///
+    /// @param[in] vm_addr
+    ///     A virtual load address that indicates where to start reading
+    ///     memory from.
+    ///
+    /// @param[in] size
+    ///     The number of bytes to read.
+    ///
+    /// @return
+    ///     The number of bytes that were added to the memory cache.
+    //------------------------------------------------------------------
+    size_t
+    PrefetchMemory (lldb::addr_t vm_addr,
+                    size_t size,
+                    Error &error);
+
     //------------------------------------------------------------------
     /// Read a NULL terminated C string from memory
     ///
@@ -2675,6 +2718,52 @@ public:
     Error
     DeallocateMemory (lldb::addr_t ptr);
 
+    //------------------------------------------------------------------
+    /// Check if this process can step over breakpoints out of line.
+    ///
+    /// Displaced stepping copies the instruction under a breakpoint
+    /// into scratch memory and single steps the copy, so the breakpoint
+    /// can stay inserted and the other threads can keep running.
+    /// Scratch memory is allocated while resuming, so plug-ins should
+    /// only return  true if they can allocate memory without running
+    /// code in the inferior.
+    ///
+    /// @return
+    ///      true if PrepareDisplacedStep() may be used,  false
+    ///     otherwise.
+    //------------------------------------------------------------------
+    virtual bool
+    SupportsDisplacedStepping ()
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    /// Relocate the instruction at  insn_addr into newly allocated
+    /// scratch memory so it can be single stepped there.
+    ///
+    /// @param[in] insn_addr
+    ///     The load address of the instruction to displace.
+    ///
+    /// @param[out] displaced_insn
+    ///     Filled in with the scratch address and the fixups that must
+    ///     be applied once the step completes.
+    ///
+    /// @return
+    ///      true if the instruction was written to scratch memory,
+    ///      false if the caller must step over the breakpoint in
+    ///     place.
+    //------------------------------------------------------------------
+    bool
+    PrepareDisplacedStep (lldb::addr_t insn_addr, 
+                          DisplacedInstruction &displaced_insn);
+
+    //------------------------------------------------------------------
+    /// Release the scratch memory used by PrepareDisplacedStep().
+    //------------------------------------------------------------------
+    void
+    ReleaseDisplacedStep (const DisplacedInstruction &displaced_insn);
+
     //------------------------------------------------------------------
     /// Get any available STDOUT.
     ///
@@ -2756,15 +2845,84 @@ public:
     virtual Error
     DisableSoftwareBreakpoint (BreakpointSite *bp_site);
 
+    typedef std::vector<BreakpointSite *> BreakpointSiteCollection;
+
+    //------------------------------------------------------------------
+    /// Enable or disable a group of breakpoint sites at once.
+    ///
+    /// The default implementations call EnableBreakpoint() or
+    /// DisableBreakpoint() for each site. Process plug-ins that can
+    /// insert or remove many breakpoints with fewer round trips should
+    /// override these.
+    ///
+    /// @param[in] bp_sites
+    ///     The breakpoint sites to enable or disable. Sites that are
+    ///     already in the requested state are skipped.
+    ///
+    /// @return
+    ///     An error describing the first site that failed. Sites that
+    ///     could be enabled or disabled are still enabled or disabled
+    ///     when an error is returned.
+    //------------------------------------------------------------------
+    virtual Error
+    EnableBreakpoints (const BreakpointSiteCollection &bp_sites);
+
+    virtual Error
+    DisableBreakpoints (const BreakpointSiteCollection &bp_sites);
+
+    // Batched versions of EnableSoftwareBreakpoint and
+    // DisableSoftwareBreakpoint. The sites are grouped by memory page and
+    // each group is read once, patched locally, written back with a single
+    // memory write and verified with a single read.
+    Error
+    EnableSoftwareBreakpoints (const BreakpointSiteCollection &bp_sites);
+
+    Error
+    DisableSoftwareBreakpoints (const BreakpointSiteCollection &bp_sites);
+
+    //------------------------------------------------------------------
+    /// Defer enabling and disabling breakpoint sites.
+    ///
+    /// Between a call to BeginBreakpointSiteBatch() and the matching
+    /// EndBreakpointSiteBatch(), CreateBreakpointSite() adds new sites
+    /// without inserting them, and sites that lose their last owner are
+    /// not removed yet. EndBreakpointSiteBatch() then inserts and removes
+    /// them all with EnableBreakpoints() and DisableBreakpoints(). Calls
+    /// can be nested, only the outermost EndBreakpointSiteBatch() does
+    /// any work.
+    ///
+    /// @return
+    ///     An error if any of the deferred sites could not be enabled or
+    ///     disabled. Sites that could not be enabled are removed from
+    ///     their owners.
+    //------------------------------------------------------------------
+    void
+    BeginBreakpointSiteBatch ();
+
+    Error
+    EndBreakpointSiteBatch ();
+
     BreakpointSiteList &
     GetBreakpointSiteList();
 
     const BreakpointSiteList &
     GetBreakpointSiteList() const;
 
+    //------------------------------------------------------------------
+    /// Mark all breakpoint sites as disabled without touching the
+    /// process memory. Used when the process is going away.
+    //------------------------------------------------------------------
     void
     DisableAllBreakpointSites ();
 
+    //------------------------------------------------------------------
+    /// Restore the original opcodes of all enabled breakpoint sites with
+    /// one call to DisableBreakpoints(). Used before detaching, when the
+    /// process will keep running without us.
+    //------------------------------------------------------------------
+    Error
+    RemoveAllBreakpointSitesFromMemory ();
+
     Error
     ClearBreakpointSiteByID (lldb::user_id_t break_id);
 
@@ -3104,9 +3262,13 @@ protected:
     Listener                    &m_listener;
     BreakpointSiteList          m_breakpoint_site_list; ///< This is the list of breakpoint locations we intend
                                                         ///< to insert in the target.
+    uint32_t                    m_bp_site_batch_depth;  ///< Nesting depth of BeginBreakpointSiteBatch() calls.
+    std::vector<lldb::BreakpointSiteSP> m_bp_sites_to_enable;  ///< Sites created during a batch that still need to be inserted.
+    std::vector<lldb::BreakpointSiteSP> m_bp_sites_to_remove;  ///< Sites that lost their last owner during a batch.
     std::auto_ptr<DynamicLoader> m_dyld_ap;
     std::auto_ptr<DynamicCheckerFunctions>  m_dynamic_checkers_ap; ///< The functions used by the expression parser to validate data that expressions use.
     std::auto_ptr<OperatingSystem>     m_os_ap;
+    std::auto_ptr<UnwindAssembly>      m_displaced_step_assembly_ap; ///< Used to relocate instructions for displaced stepping.
     UnixSignals                 m_unix_signals;         /// This is the current signal set for this process.
     lldb::ABISP                 m_abi_sp;
     lldb::InputReaderSP         m_process_input_reader;
@@ -12,6 +12,8 @@
 
 // C Includes
 // C++ Includes
+#include <map>
+#include <string>
 
 // Other libraries and framework includes
 // Project includes
@@ -103,6 +105,12 @@ public:
     {
         return m_breakpoints_use_platform_avoid;
     }
+
+    bool
+    GetUseFastStepping ()
+    {
+        return m_use_fast_stepping;
+    }
     
     
     const Args &
@@ -228,6 +236,7 @@ protected:
     uint32_t m_max_children_display;
     uint32_t m_max_strlen_length;
     OptionValueBoolean m_breakpoints_use_platform_avoid;
+    OptionValueBoolean m_use_fast_stepping;
     typedef std::map<std::string, std::string> dictionary;
     Args m_run_args;
     dictionary m_env_vars;
@@ -279,6 +288,18 @@ public:
     static void
     SetDefaultArchitecture (const ArchSpec &arch);
 
+    //------------------------------------------------------------------
+    /// Get the directory named by the "target.unwind-plan-cache-path"
+    /// setting, where unwind plans made by profiling a function's
+    /// assembly are saved for later sessions.
+    ///
+    /// @return
+    ///     The directory path, or an empty string if the cache is
+    ///     disabled (the default).
+    //------------------------------------------------------------------
+    static std::string
+    GetUnwindPlanCachePath ();
+
     void
     UpdateInstanceName ();
 
@@ -827,6 +848,61 @@ public:
         return m_persistent_variables;
     }
 
+    //------------------------------------------------------------------
+    /// Expression evaluation statistics.
+    ///
+    /// The number of expressions that were evaluated in the debugger,
+    /// either as constants or by the IR interpreter, and the number
+    /// that were JIT compiled and run in the process.  Only the
+    /// latter resume the inferior.
+    //------------------------------------------------------------------
+    uint32_t
+    GetNumExpressionsInterpreted () const
+    {
+        return m_num_expressions_interpreted;
+    }
+
+    uint32_t
+    GetNumExpressionsJITed () const
+    {
+        return m_num_expressions_jited;
+    }
+
+    void
+    ExpressionWasInterpreted ()
+    {
+        ++m_num_expressions_interpreted;
+    }
+
+    void
+    ExpressionWasJITed ()
+    {
+        ++m_num_expressions_jited;
+    }
+
+    //------------------------------------------------------------------
+    /// Remove a JIT compiled expression from the expression cache.
+    ///
+    /// The expression is taken out of the cache while it runs, so that
+    /// an evaluation of the same expression nested inside it compiles
+    /// its own copy.  Hand it back with AddCachedUserExpression() once
+    /// it has completed.
+    ///
+    /// @param[in] key
+    ///     The expression text and the context it was parsed in, as
+    ///     built by ClangUserExpression.
+    ///
+    /// @return
+    ///     The cached expression, or an empty shared pointer if there
+    ///     is none or the module list has changed since it was cached.
+    //------------------------------------------------------------------
+    lldb::SharedPtr<ClangUserExpression>::Type
+    TakeCachedUserExpression (const std::string &key);
+
+    void
+    AddCachedUserExpression (const std::string &key,
+                             const lldb::SharedPtr<ClangUserExpression>::Type &expr_sp);
+
     //------------------------------------------------------------------
     // Target Stop Hooks
     //------------------------------------------------------------------
@@ -1020,6 +1096,12 @@ public:
         {
             return m_default_architecture;
         }
+
+        const std::string &
+        GetUnwindPlanCachePath () const
+        {
+            return m_unwind_plan_cache_path;
+        }
     protected:
         
         lldb::InstanceSettingsSP
@@ -1029,6 +1111,7 @@ public:
         
         // Class-wide settings.
         ArchSpec m_default_architecture;
+        std::string m_unwind_plan_cache_path;
         
         DISALLOW_COPY_AND_ASSIGN (SettingsController);
     };
@@ -1059,6 +1142,13 @@ protected:
     std::auto_ptr<ClangASTSource> m_scratch_ast_source_ap;
     std::auto_ptr<ClangASTImporter> m_ast_importer_ap;
     ClangPersistentVariables m_persistent_variables;      ///< These are the persistent variables associated with this process for the expression parser.
+    typedef std::map<std::string, lldb::SharedPtr<ClangUserExpression>::Type> UserExpressionCache;
+    UserExpressionCache m_user_expression_cache;            ///< JIT compiled expressions that can be run again, keyed by their text and context.
+    uint32_t        m_user_expression_cache_generation;     ///< The value of m_modules_generation when the expressions in the cache were compiled.
+    Mutex           m_user_expression_cache_mutex;
+    uint32_t        m_modules_generation;                   ///< Incremented each time the module list changes.
+    uint32_t        m_num_expressions_interpreted;          ///< Expressions evaluated without running the process.
+    uint32_t        m_num_expressions_jited;                ///< Expressions JIT compiled and run in the process.
 
     SourceManager m_source_manager;
 
@@ -16,6 +16,7 @@
 // Project includes
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadPlan.h"
+#include "lldb/Target/UnwindAssembly.h"
 
 namespace lldb_private {
 
@@ -39,11 +40,20 @@ public:
 
 protected:
 
+    bool
+    PrepareDisplacedStepIfNeeded ();
+
+    void
+    FinishDisplacedStep ();
+
 private:
 
     lldb::addr_t m_breakpoint_addr;
     lldb::user_id_t m_breakpoint_site_id;
     bool m_auto_continue;
+    bool m_displaced;           // Step a relocated copy of the instruction and leave the breakpoint inserted
+    bool m_displaced_pc_set;    // The PC currently points at the relocated copy
+    DisplacedInstruction m_displaced_insn;
 
     DISALLOW_COPY_AND_ASSIGN (ThreadPlanStepOverBreakpoint);
 
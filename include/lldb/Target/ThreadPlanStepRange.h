@@ -52,9 +52,19 @@ protected:
     bool FrameIsOlder();
     bool InSymbol();
     void DumpRanges (Stream *s);
+    void ClearRanges ();
+
+    // Rather than single stepping every instruction in the range we run to
+    // a breakpoint on the next branch, then single step the branch.
+    InstructionList *GetInstructionsForAddress (lldb::addr_t addr, size_t &range_index, size_t &insn_offset);
+    bool SetNextBranchBreakpoint ();
+    void ClearNextBranchBreakpoint ();
+    bool NextRangeBreakpointExplainsStop (lldb::StopInfoSP stop_info_sp);
     
     SymbolContext m_addr_context;
     std::vector<AddressRange> m_address_ranges;
+    std::vector<lldb::DisassemblerSP> m_instruction_ranges; // The disassembly of each of m_address_ranges, filled in lazily
+    lldb::BreakpointSP m_next_branch_bp_sp;
     lldb::RunMode m_stop_others;
     uint32_t m_stack_depth;
     StackID m_stack_id;    // Use the stack ID so we can tell step out from step in.
@@ -16,6 +16,22 @@
 
 namespace lldb_private {
 
+//------------------------------------------------------------------
+// An instruction that has been relocated so that it can be single
+// stepped at a scratch address instead of at its original address.
+//------------------------------------------------------------------
+struct DisplacedInstruction
+{
+    enum { kMaxByteSize = 32 };
+
+    lldb::addr_t orig_addr;     // Address of the original instruction
+    lldb::addr_t scratch_addr;  // Address the relocated copy will execute at
+    uint8_t bytes[kMaxByteSize];// The relocated instruction bytes
+    uint32_t byte_size;         // Number of valid bytes in "bytes"
+    bool pc_relative_branch;    // The PC after the step is relative to scratch_addr and must be rebased
+    bool pushes_return_addr;    // The instruction is a call; the pushed return address must be rewritten
+};
+
 class UnwindAssembly :
    public PluginInterface
 {
@@ -43,6 +59,15 @@ public:
                           Thread* thread, 
                           Address& first_non_prologue_insn) = 0;
 
+    // Relocate the instruction at "insn_addr" so it behaves the same when
+    // executed at "scratch_addr". Returns false if the instruction can't
+    // be moved (the default for architectures that don't support it).
+    virtual bool
+    GetDisplacedInstruction (Target& target,
+                             lldb::addr_t insn_addr,
+                             lldb::addr_t scratch_addr,
+                             DisplacedInstruction &displaced_insn);
+
 protected:
     UnwindAssembly (const ArchSpec &arch);
     ArchSpec m_arch;
@@ -73,6 +73,7 @@ class   DataExtractor;
 class   Debugger;
 class   Declaration;
 class   Disassembler;
+struct  DisplacedInstruction;
 class   DynamicLoader;
 class   EmulateInstruction;
 class   Error;
@@ -92,6 +93,7 @@ class   InlineFunctionInfo;
 class   InputReader;
 class   InstanceSettings;
 class   Instruction;
+class   InstructionList;
 class   LanguageRuntime;
 class   LineTable;
 class   Listener;
@@ -1048,7 +1048,10 @@ SBTarget::AddModule (const char *path,
             module_file_spec.SetFile(path, false);
 
         if (uuid_cstr)
-            module_uuid.SetfromCString(uuid_cstr);
+        {
+            if (module_uuid.SetfromCString(uuid_cstr, 20) == 0)
+                module_uuid.SetfromCString(uuid_cstr, 16);
+        }
 
         if (triple)
             module_arch.SetTriple (triple, m_opaque_sp->GetPlatform ().get());
@@ -25,6 +25,7 @@
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/ThreadSpec.h"
 #include "lldb/lldb-private-log.h"
@@ -34,6 +35,45 @@ using namespace lldb;
 using namespace lldb_private;
 using namespace llvm;
 
+namespace {
+
+    //------------------------------------------------------------------
+    // Defers inserting and removing breakpoint sites in the target's
+    // process until the end of the current scope so the sites for all
+    // the locations of a breakpoint can be written to memory in bulk.
+    //------------------------------------------------------------------
+    class BreakpointSiteBatch
+    {
+    public:
+        BreakpointSiteBatch (Target &target) :
+            m_process_sp (target.GetProcessSP())
+        {
+            if (m_process_sp)
+                m_process_sp->BeginBreakpointSiteBatch();
+        }
+
+        ~BreakpointSiteBatch ()
+        {
+            if (m_process_sp)
+            {
+                // Sites that failed to be inserted have already been removed
+                // from their owners, so all that is left to do is report it.
+                Error error (m_process_sp->EndBreakpointSiteBatch());
+                if (error.Fail())
+                {
+                    LogSP log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+                    if (log)
+                        log->Printf ("Breakpoint: failed to write batched breakpoint sites: %s", error.AsCString());
+                }
+            }
+        }
+
+    private:
+        ProcessSP m_process_sp;
+    };
+
+}
+
 const ConstString &
 Breakpoint::GetEventIdentifier ()
 {
@@ -136,6 +176,7 @@ void
 Breakpoint::SetEnabled (bool enable)
 {
     m_options.SetEnabled(enable);
+    BreakpointSiteBatch bp_site_batch (m_target);
     if (enable)
         m_locations.ResolveAllBreakpointSites();
     else
@@ -237,6 +278,7 @@ Breakpoint::GetOptions ()
 void
 Breakpoint::ResolveBreakpoint ()
 {
+    BreakpointSiteBatch bp_site_batch (m_target);
     if (m_resolver_sp)
         m_resolver_sp->ResolveBreakpoint(*m_filter_sp);
 }
@@ -244,6 +286,7 @@ Breakpoint::ResolveBreakpoint ()
 void
 Breakpoint::ResolveBreakpointInModules (ModuleList &module_list)
 {
+    BreakpointSiteBatch bp_site_batch (m_target);
     if (m_resolver_sp)
         m_resolver_sp->ResolveBreakpointInModules(*m_filter_sp, module_list);
 }
@@ -251,6 +294,7 @@ Breakpoint::ResolveBreakpointInModules (ModuleList &module_list)
 void
 Breakpoint::ClearAllBreakpointSites ()
 {
+    BreakpointSiteBatch bp_site_batch (m_target);
     m_locations.ClearAllBreakpointSites();
 }
 
@@ -261,6 +305,7 @@ Breakpoint::ClearAllBreakpointSites ()
 void
 Breakpoint::ModulesChanged (ModuleList &module_list, bool load)
 {
+    BreakpointSiteBatch bp_site_batch (m_target);
     if (load)
     {
         // The logic for handling new modules is:
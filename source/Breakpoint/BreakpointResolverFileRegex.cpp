@@ -10,19 +10,142 @@
 #include "lldb/Breakpoint/BreakpointResolverFileRegex.h"
 
 // C Includes
+#include <string.h>
+
 // C++ Includes
+#include <algorithm>
+#include <map>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Core/DataBuffer.h"
 #include "lldb/Core/SourceManager.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/StreamString.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/Mutex.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/LineTable.h"
 #include "lldb/Target/Target.h"
 #include "lldb/lldb-private-log.h"
 
 using namespace lldb;
 using namespace lldb_private;
 
+// Returns the start of the line after the one that starts at "s", using the
+// same line ending rules as SourceManager::File.
+static inline const char *
+GetNextLine (const char *s, const char *end, bool has_carriage_returns)
+{
+    if (!has_carriage_returns)
+    {
+        const char *newline = (const char *)::memchr (s, '\n', end - s);
+        return newline ? newline + 1 : end;
+    }
+    for (; s < end; ++s)
+    {
+        const char ch = *s;
+        if (ch == '\n' || ch == '\r')
+        {
+            if (s + 1 < end && (s[1] == '\n' || s[1] == '\r') && s[1] != ch)
+                ++s;
+            return s + 1;
+        }
+    }
+    return end;
+}
+
+static void
+FindLinesMatchingRegex (const FileSpec &file_spec,
+                        const RegularExpression &regex,
+                        const std::string &literal,
+                        std::vector<uint32_t> &line_matches)
+{
+    // Read the file rather than memory mapping it: a source file that is
+    // truncated while it is mapped would crash us with SIGBUS.
+    DataBufferSP data_sp (file_spec.ReadFileContents ());
+    if (!data_sp || data_sp->GetByteSize() == 0)
+        return;
+
+    const char *start = (const char *)data_sp->GetBytes();
+    const char *end = start + data_sp->GetByteSize();
+    const bool has_carriage_returns = ::memchr (start, '\r', end - start) != NULL;
+
+    std::string line;
+    uint32_t line_no = 1;
+    const char *line_start = start;
+    while (line_start < end)
+    {
+        if (!literal.empty())
+        {
+            // Skip ahead to the line with the next occurrence of the literal
+            const char *hit = (const char *)::memmem (line_start, end - line_start, literal.data(), literal.size());
+            if (hit == NULL)
+                break;
+            for (;;)
+            {
+                const char *next_line = GetNextLine (line_start, end, has_carriage_returns);
+                if (hit < next_line)
+                    break;
+                line_start = next_line;
+                ++line_no;
+            }
+        }
+        const char *next_line = GetNextLine (line_start, end, has_carriage_returns);
+        line.assign (line_start, next_line - line_start);
+        if (regex.Execute (line.c_str()))
+            line_matches.push_back (line_no);
+        line_start = next_line;
+        ++line_no;
+    }
+}
+
+namespace {
+
+// The source files to search, shared by all the search threads.
+struct SourceFileSearch
+{
+    SourceFileSearch (const RegularExpression &regex, const std::string &literal) :
+        mutex (Mutex::eMutexTypeNormal),
+        regex (regex),
+        literal (literal),
+        next_file_idx (0),
+        file_specs (),
+        line_matches ()
+    {
+    }
+
+    Mutex mutex;
+    const RegularExpression &regex;
+    const std::string &literal;
+    size_t next_file_idx;
+    std::vector<FileSpec> file_specs;
+    std::vector<std::vector<uint32_t> > line_matches;
+};
+
+}
+
+static lldb::thread_result_t
+SearchSourceFilesThread (lldb::thread_arg_t arg)
+{
+    SourceFileSearch *search = (SourceFileSearch *)arg;
+    // RegularExpression::Execute() isn't safe to share between threads
+    RegularExpression regex (search->regex);
+    while (1)
+    {
+        size_t file_idx;
+        {
+            Mutex::Locker locker (search->mutex);
+            file_idx = search->next_file_idx++;
+        }
+        if (file_idx >= search->file_specs.size())
+            break;
+        FindLinesMatchingRegex (search->file_specs[file_idx], regex, search->literal, search->line_matches[file_idx]);
+    }
+    return NULL;
+}
+
 //----------------------------------------------------------------------
 // BreakpointResolverFileRegex:
 //----------------------------------------------------------------------
@@ -32,14 +155,37 @@ BreakpointResolverFileRegex::BreakpointResolverFileRegex
     RegularExpression &regex
 ) :
     BreakpointResolver (bkpt, BreakpointResolver::FileLineResolver),
-    m_regex (regex)
+    m_regex (regex),
+    m_regex_literal (),
+    m_gathering_comp_units (false),
+    m_comp_units ()
 {
+    // Lines that don't contain this can be skipped without running the regex
+    m_regex.GetRequiredLiteral (m_regex_literal);
 }
 
 BreakpointResolverFileRegex::~BreakpointResolverFileRegex ()
 {
 }
 
+void
+BreakpointResolverFileRegex::ResolveBreakpoint (SearchFilter &filter)
+{
+    m_gathering_comp_units = true;
+    BreakpointResolver::ResolveBreakpoint (filter);
+    m_gathering_comp_units = false;
+    SearchCompUnits (filter);
+}
+
+void
+BreakpointResolverFileRegex::ResolveBreakpointInModules (SearchFilter &filter, ModuleList &modules)
+{
+    m_gathering_comp_units = true;
+    BreakpointResolver::ResolveBreakpointInModules (filter, modules);
+    m_gathering_comp_units = false;
+    SearchCompUnits (filter);
+}
+
 Searcher::CallbackReturn
 BreakpointResolverFileRegex::SearchCallback
 (
@@ -51,31 +197,126 @@ BreakpointResolverFileRegex::SearchCallback
 {
 
     assert (m_breakpoint != NULL);
-    if (!context.target_sp)
+    if (!context.target_sp || context.comp_unit == NULL)
         return eCallbackReturnContinue;
-        
+
+    m_comp_units.push_back (context.comp_unit);
+
+    // If we weren't called from one of our ResolveBreakpoint functions there
+    // won't be anyone to search what we gathered, so do it now.
+    if (!m_gathering_comp_units)
+        SearchCompUnits (filter);
+
+    return Searcher::eCallbackReturnContinue;
+}
+
+void
+BreakpointResolverFileRegex::SearchCompUnits (SearchFilter &filter)
+{
+    if (m_comp_units.empty())
+        return;
+
+    Target &target = m_breakpoint->GetTarget();
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    // Work out which file on disk to search for each compile unit, and
+    // search each one only once even if many compile units share it.
+    SourceFileSearch search (m_regex, m_regex_literal);
+    std::vector<size_t> cu_file_indexes;
+    std::map<FileSpec, size_t> file_index_map;
+    const size_t num_comp_units = m_comp_units.size();
+    for (size_t i = 0; i < num_comp_units; ++i)
+    {
+        FileSpec file_spec (*static_cast<FileSpec *>(m_comp_units[i]));
+        if (!file_spec.Exists())
+        {
+            ConstString new_path;
+            if (target.GetSourcePathMap().RemapPath (file_spec.GetDirectory(), new_path))
+            {
+                char resolved_path[PATH_MAX];
+                ::snprintf (resolved_path, PATH_MAX, "%s/%s", new_path.AsCString(), file_spec.GetFilename().AsCString());
+                file_spec.SetFile (resolved_path, true);
+            }
+        }
+        std::map<FileSpec, size_t>::const_iterator pos = file_index_map.find (file_spec);
+        if (pos == file_index_map.end())
+        {
+            pos = file_index_map.insert (std::make_pair (file_spec, search.file_specs.size())).first;
+            search.file_specs.push_back (file_spec);
+        }
+        cu_file_indexes.push_back (pos->second);
+    }
+    search.line_matches.resize (search.file_specs.size());
+
+    if (log)
+        log->Printf ("Searching %zu source files for \"%s\" (prefilter \"%s\")", 
+                     search.file_specs.size(), 
+                     m_regex.GetText(), 
+                     m_regex_literal.c_str());
+
+    // Search the files in parallel, the calling thread is one of the workers
+    const size_t num_threads = std::min<size_t> (Host::GetNumberCPUS(), search.file_specs.size());
+    std::vector<lldb::thread_t> threads;
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        char thread_name[64];
+        ::snprintf (thread_name, sizeof(thread_name), "<lldb.breakpoint.source-regex-%zu>", i);
+        lldb::thread_t thread = Host::ThreadCreate (thread_name, SearchSourceFilesThread, &search, NULL);
+        if (IS_VALID_LLDB_HOST_THREAD(thread))
+            threads.push_back (thread);
+    }
+    SearchSourceFilesThread (&search);
+    for (size_t i = 0; i < threads.size(); ++i)
+        Host::ThreadJoin (threads[i], NULL, NULL);
+
+    for (size_t i = 0; i < num_comp_units; ++i)
+    {
+        const std::vector<uint32_t> &line_matches = search.line_matches[cu_file_indexes[i]];
+        if (!line_matches.empty())
+            AddLocationsForLines (filter, m_comp_units[i], *static_cast<FileSpec *>(m_comp_units[i]), line_matches);
+    }
+    m_comp_units.clear();
+}
+
+void
+BreakpointResolverFileRegex::AddLocationsForLines (SearchFilter &filter,
+                                                   CompileUnit *cu,
+                                                   const FileSpec &cu_file_spec,
+                                                   const std::vector<uint32_t> &line_matches)
+{
+    LineTable *line_table = cu->GetLineTable();
+    if (line_table == NULL)
+        return;
+
     LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
 
-    CompileUnit *cu = context.comp_unit;
-    FileSpec cu_file_spec = *(static_cast<FileSpec *>(cu));
-    std::vector<uint32_t> line_matches;
-    context.target_sp->GetSourceManager().FindLinesMatchingRegex(cu_file_spec, m_regex, 1, UINT32_MAX, line_matches); 
-    uint32_t num_matches = line_matches.size();
-    for (int i = 0; i < num_matches; i++)
+    // All the line table entries actually point to the version of the Compile
+    // Unit that is in the support files (the one at 0 was artifically added.)
+    // So prefer the one further on in the support files if it exists...
+    FileSpecList &support_files = cu->GetSupportFiles();
+    uint32_t file_idx = support_files.FindFileIndex (1, support_files.GetFileSpecAtIndex(0), true);
+    if (file_idx == UINT32_MAX)
+        file_idx = 0;
+
+    LineTable::LineIndex line_index;
+    line_table->GetLineIndexForFileIndex (file_idx, line_index);
+
+    const size_t num_matches = line_matches.size();
+    for (size_t i = 0; i < num_matches; i++)
     {
-        uint32_t start_idx = 0;
-        bool exact = false;
-        while (1)
+        // Use every row for the line if there are any, otherwise the first
+        // row of the closest line after it.
+        const uint32_t line = line_matches[i];
+        LineTable::LineIndex::const_iterator pos = std::lower_bound (line_index.begin(), line_index.end(), std::make_pair (line, 0u));
+        if (pos == line_index.end())
+            continue;
+        const uint32_t found_line = pos->first;
+        for (; pos != line_index.end() && pos->first == found_line; ++pos)
         {
             LineEntry line_entry;
-        
-            // Cycle through all the line entries that might match this one:
-            start_idx = cu->FindLineEntry (start_idx, line_matches[i], NULL, exact, &line_entry);
-            if (start_idx == UINT32_MAX)
-                break;
-            exact = true;
-            start_idx++;
-            
+            if (!line_table->GetLineEntryAtIndex (pos->second, line_entry))
+                continue;
+
             Address line_start = line_entry.range.GetBaseAddress();
             if (line_start.IsValid())
             {
@@ -94,7 +335,7 @@ BreakpointResolverFileRegex::SearchCallback
                     log->Printf ("Breakpoint at file address 0x%llx for %s:%d didn't pass filter.\n",
                                  line_start.GetFileAddress(),
                                  cu_file_spec.GetFilename().AsCString("<Unknown>"),
-                                 line_matches[i]);
+                                 line);
                 }
             }
             else
@@ -103,14 +344,13 @@ BreakpointResolverFileRegex::SearchCallback
                     log->Printf ("error: Unable to set breakpoint at file address 0x%llx for %s:%d\n",
                                  line_start.GetFileAddress(),
                                  cu_file_spec.GetFilename().AsCString("<Unknown>"),
-                                 line_matches[i]);
+                                 line);
             }
-
+            // Only an exact line gets more than one location
+            if (found_line != line)
+                break;
         }
     }
-    assert (m_breakpoint != NULL);        
-
-    return Searcher::eCallbackReturnContinue;
 }
 
 Searcher::Depth
@@ -870,6 +870,48 @@ private:
     DISALLOW_COPY_AND_ASSIGN (CommandObjectPlatformProcess);
 };
 
+//----------------------------------------------------------------------
+// "platform plugin <subcommand> ..."
+//----------------------------------------------------------------------
+class CommandObjectPlatformPlugin : public CommandObject
+{
+public:
+    CommandObjectPlatformPlugin (CommandInterpreter &interpreter) :
+        CommandObject (interpreter,
+                       "platform plugin",
+                       "Send a custom command to the currently selected platform plug-in.",
+                       "platform plugin <subcommand> [<subcommand-options>]",
+                       0)
+    {
+    }
+
+    virtual
+    ~CommandObjectPlatformPlugin ()
+    {
+    }
+
+    virtual bool
+    Execute (Args& args, CommandReturnObject &result)
+    {
+        PlatformSP platform_sp (m_interpreter.GetDebugger().GetPlatformList().GetSelectedPlatform());
+        if (!platform_sp)
+        {
+            result.AppendError ("no platform is currently selected\n");
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        CommandObject *plugin_cmd = platform_sp->GetPluginCommandObject(m_interpreter);
+        if (plugin_cmd == NULL)
+        {
+            result.AppendErrorWithFormat ("the '%s' platform plug-in has no commands\n", platform_sp->GetShortPluginName());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+        return plugin_cmd->ExecuteWithOptions (args, result);
+    }
+};
+
 //----------------------------------------------------------------------
 // CommandObjectPlatform constructor
 //----------------------------------------------------------------------
@@ -877,7 +919,7 @@ CommandObjectPlatform::CommandObjectPlatform(CommandInterpreter &interpreter) :
     CommandObjectMultiword (interpreter,
                             "platform",
                             "A set of commands to manage and create platforms.",
-                            "platform [connect|disconnect|info|list|status|select] ...")
+                            "platform [connect|disconnect|info|list|plugin|status|select] ...")
 {
     LoadSubCommand ("select", CommandObjectSP (new CommandObjectPlatformSelect  (interpreter)));
     LoadSubCommand ("list"  , CommandObjectSP (new CommandObjectPlatformList    (interpreter)));
@@ -885,6 +927,7 @@ CommandObjectPlatform::CommandObjectPlatform(CommandInterpreter &interpreter) :
     LoadSubCommand ("connect", CommandObjectSP (new CommandObjectPlatformConnect  (interpreter)));
     LoadSubCommand ("disconnect", CommandObjectSP (new CommandObjectPlatformDisconnect  (interpreter)));
     LoadSubCommand ("process", CommandObjectSP (new CommandObjectPlatformProcess  (interpreter)));
+    LoadSubCommand ("plugin", CommandObjectSP (new CommandObjectPlatformPlugin  (interpreter)));
 }
 
 
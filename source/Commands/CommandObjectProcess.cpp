@@ -1306,6 +1306,50 @@ public:
     }
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectProcessPlugin
+//-------------------------------------------------------------------------
+#pragma mark CommandObjectProcessPlugin
+
+class CommandObjectProcessPlugin : public CommandObject
+{
+public:
+    CommandObjectProcessPlugin (CommandInterpreter &interpreter) :
+        CommandObject (interpreter,
+                       "process plugin",
+                       "Send a custom command to the current process plug-in.",
+                       "process plugin <subcommand> [<subcommand-options>]",
+                       0)
+    {
+    }
+
+    ~CommandObjectProcessPlugin ()
+    {
+    }
+
+    bool
+    Execute (Args& command,
+             CommandReturnObject &result)
+    {
+        Process *process = m_interpreter.GetExecutionContext().GetProcessPtr();
+        if (process == NULL)
+        {
+            result.AppendError ("No process.");
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        CommandObject *plugin_cmd = process->GetPluginCommandObject();
+        if (plugin_cmd == NULL)
+        {
+            result.AppendErrorWithFormat ("the '%s' process plug-in has no commands\n", process->GetShortPluginName());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+        return plugin_cmd->ExecuteWithOptions (command, result);
+    }
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectProcessHandle
 //-------------------------------------------------------------------------
@@ -1634,6 +1678,7 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess (CommandInterpreter
     LoadSubCommand ("status",      CommandObjectSP (new CommandObjectProcessStatus    (interpreter)));
     LoadSubCommand ("interrupt",   CommandObjectSP (new CommandObjectProcessInterrupt (interpreter)));
     LoadSubCommand ("kill",        CommandObjectSP (new CommandObjectProcessKill      (interpreter)));
+    LoadSubCommand ("plugin",      CommandObjectSP (new CommandObjectProcessPlugin    (interpreter)));
 }
 
 CommandObjectMultiwordProcess::~CommandObjectMultiwordProcess ()
@@ -7,6 +7,9 @@
 //
 //===----------------------------------------------------------------------===//
 #include "lldb/Core/ConstString.h"
+
+#include <vector>
+
 #include "lldb/Core/Stream.h"
 #include "lldb/Host/Mutex.h"
 #include "llvm/ADT/StringMap.h"
@@ -99,6 +102,24 @@ public:
         return NULL;
     }
 
+    void
+    GetConstCStrings (const char * const *cstrs, size_t count, const char **ccstrs)
+    {
+        // Unique all of the strings while holding the lock once instead of
+        // locking for each string.
+        Mutex::Locker locker (m_mutex);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (cstrs[i])
+            {
+                StringPoolEntryType& entry = m_string_map.GetOrCreateValue (llvm::StringRef (cstrs[i]), (StringPoolValueType)NULL);
+                ccstrs[i] = entry.getKeyData();
+            }
+            else
+                ccstrs[i] = NULL;
+        }
+    }
+
     const char *
     GetConstCStringAndSetMangledCounterPart (const char *demangled_cstr, const char *mangled_ccstr)
     {
@@ -288,6 +309,16 @@ ConstString::SetTrimmedCStringWithLength (const char *cstr, size_t cstr_len)
     m_string = StringPool().GetConstTrimmedCStringWithLength (cstr, cstr_len);
 }
 
+void
+ConstString::SetCStrings (const char * const *cstrs, size_t count, ConstString *const_strs)
+{
+    std::vector<const char *> ccstrs (count);
+    if (count > 0)
+        StringPool().GetConstCStrings (cstrs, count, &ccstrs[0]);
+    for (size_t i = 0; i < count; ++i)
+        const_strs[i].m_string = ccstrs[i];
+}
+
 size_t
 ConstString::StaticMemorySize()
 {
@@ -36,35 +36,35 @@ using namespace lldb;
 using namespace lldb_private;
 
 static inline uint16_t 
-ReadInt16(const unsigned char* ptr, unsigned offset) 
+ReadInt16(const unsigned char* ptr, size_t offset) 
 {
     return *(uint16_t *)(ptr + offset);
 }
 static inline uint32_t
-ReadInt32 (const unsigned char* ptr, unsigned offset) 
+ReadInt32 (const unsigned char* ptr, size_t offset) 
 {
     return *(uint32_t *)(ptr + offset);
 }
 
 static inline uint64_t 
-ReadInt64(const unsigned char* ptr, unsigned offset) 
+ReadInt64(const unsigned char* ptr, size_t offset) 
 {
     return *(uint64_t *)(ptr + offset);
 }
 
 static inline uint16_t
-ReadSwapInt16(const unsigned char* ptr, unsigned offset) 
+ReadSwapInt16(const unsigned char* ptr, size_t offset) 
 {
     return llvm::ByteSwap_16(*(uint16_t *)(ptr + offset));
 }
 
 static inline uint32_t
-ReadSwapInt32 (const unsigned char* ptr, unsigned offset) 
+ReadSwapInt32 (const unsigned char* ptr, size_t offset) 
 {
     return llvm::ByteSwap_32(*(uint32_t *)(ptr + offset));
 }
 static inline uint64_t 
-ReadSwapInt64(const unsigned char* ptr, unsigned offset) 
+ReadSwapInt64(const unsigned char* ptr, size_t offset) 
 {
   return llvm::ByteSwap_64(*(uint64_t *)(ptr + offset));
 }
@@ -86,7 +86,7 @@ DataExtractor::DataExtractor () :
 // This constructor allows us to use data that is owned by someone else.
 // The data must stay around as long as this object is valid.
 //----------------------------------------------------------------------
-DataExtractor::DataExtractor (const void* data, uint32_t length, ByteOrder endian, uint8_t addr_size) :
+DataExtractor::DataExtractor (const void* data, uint64_t length, ByteOrder endian, uint8_t addr_size) :
     m_start     ((uint8_t*)data),
     m_end       ((uint8_t*)data + length),
     m_byte_order(endian),
@@ -119,7 +119,7 @@ DataExtractor::DataExtractor (const DataBufferSP& data_sp, ByteOrder endian, uin
 // as any object contains a reference to that data. The endian
 // swap and address size settings are copied from "data".
 //----------------------------------------------------------------------
-DataExtractor::DataExtractor (const DataExtractor& data, uint32_t offset, uint32_t length) :
+DataExtractor::DataExtractor (const DataExtractor& data, uint64_t offset, uint64_t length) :
     m_start(NULL),
     m_end(NULL),
     m_byte_order(data.m_byte_order),
@@ -128,7 +128,7 @@ DataExtractor::DataExtractor (const DataExtractor& data, uint32_t offset, uint32
 {
     if (data.ValidOffset(offset))
     {
-        uint32_t bytes_available = data.GetByteSize() - offset;
+        uint64_t bytes_available = data.GetByteSize() - offset;
         if (length > bytes_available)
             length = bytes_available;
         SetData(data, offset, length);
@@ -211,7 +211,7 @@ DataExtractor::GetSharedDataOffset () const
 // into the data that is in this object.
 //------------------------------------------------------------------
 bool
-DataExtractor::ValidOffsetForDataOfSize (uint32_t offset, uint32_t length) const
+DataExtractor::ValidOffsetForDataOfSize (uint64_t offset, uint64_t length) const
 {
     size_t size = GetByteSize();
     if (offset >= size)
@@ -242,8 +242,8 @@ DataExtractor::ValidOffsetForDataOfSize (uint32_t offset, uint32_t length) const
 // reference to that data will be released. Is SWAP is set to true,
 // any data extracted will be endian swapped.
 //----------------------------------------------------------------------
-uint32_t
-DataExtractor::SetData (const void *bytes, uint32_t length, ByteOrder endian)
+size_t
+DataExtractor::SetData (const void *bytes, uint64_t length, ByteOrder endian)
 {
     m_byte_order = endian;
     m_data_sp.reset();
@@ -274,8 +274,8 @@ DataExtractor::SetData (const void *bytes, uint32_t length, ByteOrder endian)
 // refers to those bytes. The address size and endian swap settings
 // are copied from the current values in "data".
 //----------------------------------------------------------------------
-uint32_t
-DataExtractor::SetData (const DataExtractor& data, uint32_t data_offset, uint32_t data_length)
+size_t
+DataExtractor::SetData (const DataExtractor& data, uint64_t data_offset, uint64_t data_length)
 {
     m_addr_size = data.m_addr_size;
     // If "data" contains shared pointer to data, then we can use that
@@ -309,8 +309,8 @@ DataExtractor::SetData (const DataExtractor& data, uint32_t data_offset, uint32_
 // around as long as it is needed. The address size and endian swap
 // settings will remain unchanged from their current settings.
 //----------------------------------------------------------------------
-uint32_t
-DataExtractor::SetData (const DataBufferSP& data_sp, uint32_t data_offset, uint32_t data_length)
+size_t
+DataExtractor::SetData (const DataBufferSP& data_sp, uint64_t data_offset, uint64_t data_length)
 {
     m_start = m_end = NULL;
 
@@ -333,7 +333,7 @@ DataExtractor::SetData (const DataBufferSP& data_sp, uint32_t data_offset, uint3
         }
     }
 
-    uint32_t new_size = GetByteSize();
+    size_t new_size = GetByteSize();
 
     // Don't hold a shared pointer to the data buffer if we don't share
     // any valid bytes in the shared buffer.
@@ -349,8 +349,9 @@ DataExtractor::SetData (const DataBufferSP& data_sp, uint32_t data_offset, uint3
 //
 // RETURNS the byte that was extracted, or zero on failure.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint8_t
-DataExtractor::GetU8 (uint32_t *offset_ptr) const
+DataExtractor::GetU8 (OffsetType *offset_ptr) const
 {
     uint8_t val = 0;
     if ( m_start < m_end )
@@ -370,10 +371,11 @@ DataExtractor::GetU8 (uint32_t *offset_ptr) const
 // all the requested bytes, or NULL when the data is not available in
 // the buffer due to being out of bounds, or unsufficient data.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 void *
-DataExtractor::GetU8 (uint32_t *offset_ptr, void *dst, uint32_t count) const
+DataExtractor::GetU8 (OffsetType *offset_ptr, void *dst, uint32_t count) const
 {
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
 
     if ((count > 0) && ValidOffsetForDataOfSize(offset, count) )
     {
@@ -393,11 +395,12 @@ DataExtractor::GetU8 (uint32_t *offset_ptr, void *dst, uint32_t count) const
 //
 // RETURNS the uint16_t that was extracted, or zero on failure.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint16_t
-DataExtractor::GetU16 (uint32_t *offset_ptr) const
+DataExtractor::GetU16 (OffsetType *offset_ptr) const
 {
     uint16_t val = 0;
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
     if ( ValidOffsetForDataOfSize(offset, sizeof(val)) )
     {
         if (m_byte_order != lldb::endian::InlHostByteOrder())
@@ -411,8 +414,9 @@ DataExtractor::GetU16 (uint32_t *offset_ptr) const
     return val;
 }
 
+template <typename OffsetType>
 uint16_t
-DataExtractor::GetU16_unchecked (uint32_t *offset_ptr) const
+DataExtractor::GetU16_unchecked (OffsetType *offset_ptr) const
 {
     uint16_t val = (m_byte_order == lldb::endian::InlHostByteOrder()) ? 
                         ReadInt16 (m_start, *offset_ptr) :
@@ -421,8 +425,9 @@ DataExtractor::GetU16_unchecked (uint32_t *offset_ptr) const
     return val;
 }
 
+template <typename OffsetType>
 uint32_t
-DataExtractor::GetU32_unchecked (uint32_t *offset_ptr) const
+DataExtractor::GetU32_unchecked (OffsetType *offset_ptr) const
 {
     uint32_t val = (m_byte_order == lldb::endian::InlHostByteOrder()) ? 
                         ReadInt32 (m_start, *offset_ptr) :
@@ -431,8 +436,9 @@ DataExtractor::GetU32_unchecked (uint32_t *offset_ptr) const
     return val;
 }
 
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetU64_unchecked (uint32_t *offset_ptr) const
+DataExtractor::GetU64_unchecked (OffsetType *offset_ptr) const
 {
     uint64_t val = (m_byte_order == lldb::endian::InlHostByteOrder()) ? 
                         ReadInt64 (m_start, *offset_ptr) :
@@ -451,12 +457,13 @@ DataExtractor::GetU64_unchecked (uint32_t *offset_ptr) const
 // all the requested bytes, or NULL when the data is not available
 // in the buffer due to being out of bounds, or unsufficient data.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 void *
-DataExtractor::GetU16 (uint32_t *offset_ptr, void *void_dst, uint32_t count) const
+DataExtractor::GetU16 (OffsetType *offset_ptr, void *void_dst, uint32_t count) const
 {
     uint16_t *dst = (uint16_t *)void_dst;
     const size_t value_size = sizeof(*dst);
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
 
     if ((count > 0) && ValidOffsetForDataOfSize(offset, value_size * count) )
     {
@@ -487,11 +494,12 @@ DataExtractor::GetU16 (uint32_t *offset_ptr, void *void_dst, uint32_t count) con
 //
 // RETURNS the uint32_t that was extracted, or zero on failure.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint32_t
-DataExtractor::GetU32 (uint32_t *offset_ptr) const
+DataExtractor::GetU32 (OffsetType *offset_ptr) const
 {
     uint32_t val = 0;
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
 
     if ( ValidOffsetForDataOfSize(offset, sizeof(val)) )
     {
@@ -515,12 +523,13 @@ DataExtractor::GetU32 (uint32_t *offset_ptr) const
 // all the requested bytes, or NULL when the data is not available
 // in the buffer due to being out of bounds, or unsufficient data.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 void *
-DataExtractor::GetU32 (uint32_t *offset_ptr, void *void_dst, uint32_t count) const
+DataExtractor::GetU32 (OffsetType *offset_ptr, void *void_dst, uint32_t count) const
 {
     uint32_t *dst = (uint32_t *)void_dst;
     const size_t value_size = sizeof(*dst);
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
 
     if ((count > 0) && ValidOffsetForDataOfSize(offset, value_size * count))
     {
@@ -552,11 +561,12 @@ DataExtractor::GetU32 (uint32_t *offset_ptr, void *void_dst, uint32_t count) con
 //
 // RETURNS the uint64_t that was extracted, or zero on failure.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetU64 (uint32_t *offset_ptr) const
+DataExtractor::GetU64 (OffsetType *offset_ptr) const
 {
     uint64_t val = 0;
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
     if ( ValidOffsetForDataOfSize(offset, sizeof(val)) )
     {
         if (m_byte_order != lldb::endian::InlHostByteOrder())
@@ -577,12 +587,13 @@ DataExtractor::GetU64 (uint32_t *offset_ptr) const
 // read succeeds and increment the offset pointed to by offset_ptr, else
 // return false and leave the offset pointed to by offset_ptr unchanged.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 void *
-DataExtractor::GetU64 (uint32_t *offset_ptr, void *void_dst, uint32_t count) const
+DataExtractor::GetU64 (OffsetType *offset_ptr, void *void_dst, uint32_t count) const
 {
     uint64_t *dst = (uint64_t *)void_dst;
     const size_t value_size = sizeof(uint64_t);
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
 
     if ((count > 0) && ValidOffsetForDataOfSize(offset, value_size * count))
     {
@@ -618,8 +629,9 @@ DataExtractor::GetU64 (uint32_t *offset_ptr, void *void_dst, uint32_t count) con
 //
 // RETURNS the integer value that was extracted, or zero on failure.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint32_t
-DataExtractor::GetMaxU32 (uint32_t *offset_ptr, uint32_t byte_size) const
+DataExtractor::GetMaxU32 (OffsetType *offset_ptr, uint32_t byte_size) const
 {
     switch (byte_size)
     {
@@ -643,8 +655,9 @@ DataExtractor::GetMaxU32 (uint32_t *offset_ptr, uint32_t byte_size) const
 //
 // RETURNS the integer value that was extracted, or zero on failure.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetMaxU64 (uint32_t *offset_ptr, uint32_t size) const
+DataExtractor::GetMaxU64 (OffsetType *offset_ptr, uint32_t size) const
 {
     switch (size)
     {
@@ -659,8 +672,9 @@ DataExtractor::GetMaxU64 (uint32_t *offset_ptr, uint32_t size) const
     return 0;
 }
 
+template <typename OffsetType>
 int64_t
-DataExtractor::GetMaxS64 (uint32_t *offset_ptr, uint32_t size) const
+DataExtractor::GetMaxS64 (OffsetType *offset_ptr, uint32_t size) const
 {
     switch (size)
     {
@@ -675,8 +689,9 @@ DataExtractor::GetMaxS64 (uint32_t *offset_ptr, uint32_t size) const
     return 0;
 }
 
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetMaxU64Bitfield (uint32_t *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const
+DataExtractor::GetMaxU64Bitfield (OffsetType *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const
 {
     uint64_t uval64 = GetMaxU64 (offset_ptr, size);
     if (bitfield_bit_size > 0)
@@ -691,8 +706,9 @@ DataExtractor::GetMaxU64Bitfield (uint32_t *offset_ptr, uint32_t size, uint32_t
     return uval64;
 }
 
+template <typename OffsetType>
 int64_t
-DataExtractor::GetMaxS64Bitfield (uint32_t *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const
+DataExtractor::GetMaxS64Bitfield (OffsetType *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const
 {
     int64_t sval64 = GetMaxS64 (offset_ptr, size);
     if (bitfield_bit_size > 0)
@@ -709,8 +725,9 @@ DataExtractor::GetMaxS64Bitfield (uint32_t *offset_ptr, uint32_t size, uint32_t
 }
 
 
+template <typename OffsetType>
 float
-DataExtractor::GetFloat (uint32_t *offset_ptr) const
+DataExtractor::GetFloat (OffsetType *offset_ptr) const
 {
     typedef float float_type;
     float_type val = 0.0;
@@ -735,8 +752,9 @@ DataExtractor::GetFloat (uint32_t *offset_ptr) const
     return val;
 }
 
+template <typename OffsetType>
 double
-DataExtractor::GetDouble (uint32_t *offset_ptr) const
+DataExtractor::GetDouble (OffsetType *offset_ptr) const
 {
     typedef double float_type;
     float_type val = 0.0;
@@ -762,8 +780,9 @@ DataExtractor::GetDouble (uint32_t *offset_ptr) const
 }
 
 
+template <typename OffsetType>
 long double
-DataExtractor::GetLongDouble (uint32_t *offset_ptr) const
+DataExtractor::GetLongDouble (OffsetType *offset_ptr) const
 {
     typedef long double float_type;
     float_type val = 0.0;
@@ -797,8 +816,9 @@ DataExtractor::GetLongDouble (uint32_t *offset_ptr) const
 //
 // RETURNS the address that was extracted, or zero on failure.
 //------------------------------------------------------------------
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetAddress (uint32_t *offset_ptr) const
+DataExtractor::GetAddress (OffsetType *offset_ptr) const
 {
     return GetMaxU64 (offset_ptr, m_addr_size);
 }
@@ -811,8 +831,9 @@ DataExtractor::GetAddress (uint32_t *offset_ptr) const
 //
 // RETURNS the pointer that was extracted, or zero on failure.
 //------------------------------------------------------------------
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetPointer (uint32_t *offset_ptr) const
+DataExtractor::GetPointer (OffsetType *offset_ptr) const
 {
     return GetMaxU64 (offset_ptr, m_addr_size);
 }
@@ -824,8 +845,9 @@ DataExtractor::GetPointer (uint32_t *offset_ptr) const
 // pointer encoding.
 //----------------------------------------------------------------------
 
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetGNUEHPointer (uint32_t *offset_ptr, uint32_t eh_ptr_enc, lldb::addr_t pc_rel_addr, lldb::addr_t text_addr, lldb::addr_t data_addr)//, BSDRelocs *data_relocs) const
+DataExtractor::GetGNUEHPointer (OffsetType *offset_ptr, uint32_t eh_ptr_enc, lldb::addr_t pc_rel_addr, lldb::addr_t text_addr, lldb::addr_t data_addr)//, BSDRelocs *data_relocs) const
 {
     if (eh_ptr_enc == DW_EH_PE_omit)
         return ULLONG_MAX;  // Value isn't in the buffer...
@@ -924,7 +946,7 @@ DataExtractor::GetGNUEHPointer (uint32_t *offset_ptr, uint32_t eh_ptr_enc, lldb:
 }
 
 size_t
-DataExtractor::ExtractBytes (uint32_t offset, uint32_t length, ByteOrder dst_byte_order, void *dst) const
+DataExtractor::ExtractBytes (uint64_t offset, uint32_t length, ByteOrder dst_byte_order, void *dst) const
 {
     const uint8_t *src = PeekData (offset, length);
     if (src)
@@ -947,7 +969,7 @@ DataExtractor::ExtractBytes (uint32_t offset, uint32_t length, ByteOrder dst_byt
 // and there are "length" bytes available, else NULL is returned.
 //----------------------------------------------------------------------
 const uint8_t*
-DataExtractor::PeekData (uint32_t offset, uint32_t length) const
+DataExtractor::PeekData (uint64_t offset, uint64_t length) const
 {
     if ( length > 0 && ValidOffsetForDataOfSize(offset, length) )
         return m_start + offset;
@@ -963,11 +985,12 @@ DataExtractor::PeekData (uint32_t offset, uint32_t length) const
 // Returns a pointer to the data if the offset and length are valid,
 // or NULL otherwise.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 const void*
-DataExtractor::GetData (uint32_t *offset_ptr, uint32_t length) const
+DataExtractor::GetData (OffsetType *offset_ptr, uint32_t length) const
 {
     const uint8_t* bytes = NULL;
-    register uint32_t offset = *offset_ptr;
+    register OffsetType offset = *offset_ptr;
     if ( length > 0 && ValidOffsetForDataOfSize(offset, length) )
     {
         bytes = m_start + offset;
@@ -978,7 +1001,7 @@ DataExtractor::GetData (uint32_t *offset_ptr, uint32_t length) const
 
 // Extract data and swap if needed when doing the copy
 uint32_t
-DataExtractor::CopyByteOrderedData (uint32_t src_offset, 
+DataExtractor::CopyByteOrderedData (uint64_t src_offset, 
                                     uint32_t src_len,
                                     void *dst_void_ptr, 
                                     uint32_t dst_len, 
@@ -1101,8 +1124,9 @@ DataExtractor::CopyByteOrderedData (uint32_t src_offset,
 // bytes, NULL will be returned and "offset_ptr" will not be
 // updated.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 const char*
-DataExtractor::GetCStr (uint32_t *offset_ptr) const
+DataExtractor::GetCStr (OffsetType *offset_ptr) const
 {
     const char *s = NULL;
     if ( m_start < m_end )
@@ -1129,7 +1153,7 @@ DataExtractor::GetCStr (uint32_t *offset_ptr) const
 // this object's data, else NULL is returned.
 //------------------------------------------------------------------
 const char *
-DataExtractor::PeekCStr (uint32_t offset) const
+DataExtractor::PeekCStr (uint64_t offset) const
 {
     if (ValidOffset (offset))
         return (const char*)m_start + offset;
@@ -1144,8 +1168,9 @@ DataExtractor::PeekCStr (uint32_t offset) const
 //
 // Returned the extracted integer value.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint64_t
-DataExtractor::GetULEB128 (uint32_t *offset_ptr) const
+DataExtractor::GetULEB128 (OffsetType *offset_ptr) const
 {
     const uint8_t *src = m_start + *offset_ptr;
     const uint8_t *end = m_end;
@@ -1166,7 +1191,7 @@ DataExtractor::GetULEB128 (uint32_t *offset_ptr) const
                 shift += 7;
             }
         }
-        *offset_ptr = (uint32_t)(src - m_start);
+        *offset_ptr = (OffsetType)(src - m_start);
         return result;
     }
     
@@ -1181,8 +1206,9 @@ DataExtractor::GetULEB128 (uint32_t *offset_ptr) const
 //
 // Returned the extracted integer value.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 int64_t
-DataExtractor::GetSLEB128 (uint32_t *offset_ptr) const
+DataExtractor::GetSLEB128 (OffsetType *offset_ptr) const
 {
     int64_t result = 0;
 
@@ -1222,8 +1248,9 @@ DataExtractor::GetSLEB128 (uint32_t *offset_ptr) const
 //
 // Returns the number of bytes consumed during the extraction.
 //----------------------------------------------------------------------
+template <typename OffsetType>
 uint32_t
-DataExtractor::Skip_LEB128 (uint32_t *offset_ptr) const
+DataExtractor::Skip_LEB128 (OffsetType *offset_ptr) const
 {
     uint32_t bytes_consumed = 0;
     if ( m_start < m_end )
@@ -1239,6 +1266,45 @@ DataExtractor::Skip_LEB128 (uint32_t *offset_ptr) const
     return bytes_consumed;
 }
 
+//----------------------------------------------------------------------
+// Instantiate the accessors that take an offset pointer for 32 and 64
+// bit offsets. Most sections are smaller than 4GB and keep using 32 bit
+// offsets, 64 bit offsets are needed for sections that are larger.
+//----------------------------------------------------------------------
+#define INSTANTIATE_OFFSET_ACCESSORS(OffsetType) \
+    template uint8_t     DataExtractor::GetU8 (OffsetType *offset_ptr) const; \
+    template void *      DataExtractor::GetU8 (OffsetType *offset_ptr, void *dst, uint32_t count) const; \
+    template uint16_t    DataExtractor::GetU16 (OffsetType *offset_ptr) const; \
+    template void *      DataExtractor::GetU16 (OffsetType *offset_ptr, void *dst, uint32_t count) const; \
+    template uint16_t    DataExtractor::GetU16_unchecked (OffsetType *offset_ptr) const; \
+    template uint32_t    DataExtractor::GetU32 (OffsetType *offset_ptr) const; \
+    template void *      DataExtractor::GetU32 (OffsetType *offset_ptr, void *dst, uint32_t count) const; \
+    template uint32_t    DataExtractor::GetU32_unchecked (OffsetType *offset_ptr) const; \
+    template uint64_t    DataExtractor::GetU64 (OffsetType *offset_ptr) const; \
+    template void *      DataExtractor::GetU64 (OffsetType *offset_ptr, void *dst, uint32_t count) const; \
+    template uint64_t    DataExtractor::GetU64_unchecked (OffsetType *offset_ptr) const; \
+    template uint32_t    DataExtractor::GetMaxU32 (OffsetType *offset_ptr, uint32_t byte_size) const; \
+    template uint64_t    DataExtractor::GetMaxU64 (OffsetType *offset_ptr, uint32_t size) const; \
+    template int64_t     DataExtractor::GetMaxS64 (OffsetType *offset_ptr, uint32_t size) const; \
+    template uint64_t    DataExtractor::GetMaxU64Bitfield (OffsetType *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const; \
+    template int64_t     DataExtractor::GetMaxS64Bitfield (OffsetType *offset_ptr, uint32_t size, uint32_t bitfield_bit_size, uint32_t bitfield_bit_offset) const; \
+    template float       DataExtractor::GetFloat (OffsetType *offset_ptr) const; \
+    template double      DataExtractor::GetDouble (OffsetType *offset_ptr) const; \
+    template long double DataExtractor::GetLongDouble (OffsetType *offset_ptr) const; \
+    template uint64_t    DataExtractor::GetAddress (OffsetType *offset_ptr) const; \
+    template uint64_t    DataExtractor::GetPointer (OffsetType *offset_ptr) const; \
+    template uint64_t    DataExtractor::GetGNUEHPointer (OffsetType *offset_ptr, uint32_t eh_ptr_enc, lldb::addr_t pc_rel_addr, lldb::addr_t text_addr, lldb::addr_t data_addr); \
+    template const void *DataExtractor::GetData (OffsetType *offset_ptr, uint32_t length) const; \
+    template const char *DataExtractor::GetCStr (OffsetType *offset_ptr) const; \
+    template uint64_t    DataExtractor::GetULEB128 (OffsetType *offset_ptr) const; \
+    template int64_t     DataExtractor::GetSLEB128 (OffsetType *offset_ptr) const; \
+    template uint32_t    DataExtractor::Skip_LEB128 (OffsetType *offset_ptr) const;
+
+INSTANTIATE_OFFSET_ACCESSORS(uint32_t)
+INSTANTIATE_OFFSET_ACCESSORS(uint64_t)
+
+#undef INSTANTIATE_OFFSET_ACCESSORS
+
 static uint32_t
 DumpAPInt (Stream *s, const DataExtractor &data, uint32_t offset, uint32_t byte_size, bool is_signed, unsigned radix)
 {
@@ -805,9 +805,29 @@ ScanFormatDescriptor (const char* var_name_begin,
                       const char** var_name_final,
                       const char** percent_position,
                       Format* custom_format,
-                      ValueObject::ValueObjectRepresentationStyle* val_obj_display)
+                      ValueObject::ValueObjectRepresentationStyle* val_obj_display,
+                      const CompiledFormatString::Op *compiled_op = NULL)
 {
     LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_TYPES));
+    if (compiled_op)
+    {
+        // The descriptor was parsed when the format string was compiled
+        if (compiled_op->percent_offset == UINT32_MAX)
+        {
+            *percent_position = NULL;
+            *var_name_final = var_name_end;
+        }
+        else
+        {
+            *percent_position = var_name_end - compiled_op->length + compiled_op->percent_offset;
+            *var_name_final = *percent_position;
+            *custom_format = compiled_op->custom_format;
+            if (compiled_op->has_display)
+                *val_obj_display = compiled_op->display;
+        }
+        return true;
+    }
+
     *percent_position = ::strchr(var_name_begin,'%');
     if (!*percent_position || *percent_position > var_name_end)
     {
@@ -818,43 +838,8 @@ ScanFormatDescriptor (const char* var_name_begin,
     else
     {
         *var_name_final = *percent_position;
-        char* format_name = new char[var_name_end-*var_name_final]; format_name[var_name_end-*var_name_final-1] = '\0';
-        memcpy(format_name, *var_name_final+1, var_name_end-*var_name_final-1);
-        if (log)
-            log->Printf("parsing %s as a format descriptor", format_name);
-        if ( !FormatManager::GetFormatFromCString(format_name,
-                                                  true,
-                                                  *custom_format) )
-        {
-            if (log)
-                log->Printf("%s is an unknown format", format_name);
-            // if this is an @ sign, print ObjC description
-            if (*format_name == '@')
-                *val_obj_display = ValueObject::eDisplayLanguageSpecific;
-            // if this is a V, print the value using the default format
-            else if (*format_name == 'V')
-                *val_obj_display = ValueObject::eDisplayValue;
-            // if this is an L, print the location of the value
-            else if (*format_name == 'L')
-                *val_obj_display = ValueObject::eDisplayLocation;
-            // if this is an S, print the summary after all
-            else if (*format_name == 'S')
-                *val_obj_display = ValueObject::eDisplaySummary;
-            else if (*format_name == '#')
-                *val_obj_display = ValueObject::eDisplayChildrenCount;
-            else if (*format_name == 'T')
-                *val_obj_display = ValueObject::eDisplayType;
-            else if (log)
-                log->Printf("%s is an error, leaving the previous value alone", format_name);
-        }
-        // a good custom format tells us to print the value using it
-        else
-        {
-            if (log)
-                log->Printf("will display value for this VO");
-            *val_obj_display = ValueObject::eDisplayValue;
-        }
-        delete format_name;
+        std::string format_name (*var_name_final+1, var_name_end);
+        CompiledFormatString::ParseFormatDescriptor (format_name.c_str(), *custom_format, *val_obj_display);
     }
     if (log)
         log->Printf("final format description outcome: custom_format = %d, val_obj_display = %d",
@@ -1007,17 +992,23 @@ ExpandIndexedExpression (ValueObject* valobj,
     return item;
 }
 
-bool
-Debugger::FormatPrompt 
-(
-    const char *format,
-    const SymbolContext *sc,
-    const ExecutionContext *exe_ctx,
-    const Address *addr,
-    Stream &s,
-    const char **end,
-    ValueObject* valobj
-)
+//----------------------------------------------------------------------
+// The format string interpreter behind both FormatPrompt() overloads.
+// If "compiled_op" is not NULL, "format" points at the "${" of that
+// variable in a CompiledFormatString: only that variable is expanded,
+// using the format descriptor and expression path that were parsed when
+// the format was compiled.
+//----------------------------------------------------------------------
+static bool
+FormatPromptImpl (const char *format,
+                  const CompiledFormatString::Op *compiled_op,
+                  const char *compiled_expr_path,
+                  const SymbolContext *sc,
+                  const ExecutionContext *exe_ctx,
+                  const Address *addr,
+                  Stream &s,
+                  const char **end,
+                  ValueObject *&valobj)
 {
     ValueObject* realvalobj = NULL; // makes it super-easy to parse pointers
     bool success = true;
@@ -1057,7 +1048,7 @@ Debugger::FormatPrompt
 
             ++p;  // Skip the '{'
             
-            if (FormatPrompt (p, sc, exe_ctx, addr, sub_strm, &p, valobj))
+            if (Debugger::FormatPrompt (p, sc, exe_ctx, addr, sub_strm, &p, valobj))
             {
                 // The stream had all it needed
                 s.Write(sub_strm.GetData(), sub_strm.GetSize());
@@ -1178,7 +1169,8 @@ Debugger::FormatPrompt
                                                           &var_name_final,
                                                           &percent_position,
                                                           &custom_format,
-                                                          &val_obj_display);
+                                                          &val_obj_display,
+                                                          compiled_op);
                                 }
                                     // this is ${var.something} or multiple .something nested
                                 else if (::strncmp (var_name_begin, "var", strlen("var")) == 0)
@@ -1190,7 +1182,8 @@ Debugger::FormatPrompt
                                                           &var_name_final,
                                                           &percent_position,
                                                           &custom_format,
-                                                          &val_obj_display);
+                                                          &val_obj_display,
+                                                          compiled_op);
                                     
                                     const char* open_bracket_position;
                                     const char* separator_position;
@@ -1206,14 +1199,18 @@ Debugger::FormatPrompt
                                                                     
                                     Error error;
                                                                         
-                                    std::auto_ptr<char> expr_path(new char[var_name_final-var_name_begin-1]);
-                                    ::memset(expr_path.get(), 0, var_name_final-var_name_begin-1);
-                                    memcpy(expr_path.get(), var_name_begin+3,var_name_final-var_name_begin-3);
+                                    std::string expr_path_str;
+                                    const char *expr_path = compiled_expr_path;
+                                    if (expr_path == NULL)
+                                    {
+                                        expr_path_str.assign (var_name_begin+3, var_name_final-var_name_begin-3);
+                                        expr_path = expr_path_str.c_str();
+                                    }
                                                                         
                                     if (log)
-                                        log->Printf("symbol to expand: %s",expr_path.get());
+                                        log->Printf("symbol to expand: %s",expr_path);
                                     
-                                    target = valobj->GetValueForExpressionPath(expr_path.get(),
+                                    target = valobj->GetValueForExpressionPath(expr_path,
                                                                              &first_unparsed,
                                                                              &reason_to_stop,
                                                                              &final_value_type,
@@ -1383,7 +1380,7 @@ Debugger::FormatPrompt
                                         if (!special_directions)
                                             var_success &= item->DumpPrintableRepresentation(s,val_obj_display, custom_format);
                                         else
-                                            var_success &= FormatPrompt(special_directions, sc, exe_ctx, addr, s, NULL, item);
+                                            var_success &= Debugger::FormatPrompt(special_directions, sc, exe_ctx, addr, s, NULL, item);
                                         
                                         if (--max_num_children == 0)
                                         {
@@ -2084,6 +2081,9 @@ Debugger::FormatPrompt
                             success = false;
                     }
                     p = var_name_end;
+                    // A compiled variable is expanded on its own
+                    if (compiled_op)
+                        break;
                 }
                 else
                     break;
@@ -2173,6 +2173,97 @@ Debugger::FormatPrompt
     return success;
 }
 
+bool
+Debugger::FormatPrompt 
+(
+    const char *format,
+    const SymbolContext *sc,
+    const ExecutionContext *exe_ctx,
+    const Address *addr,
+    Stream &s,
+    const char **end,
+    ValueObject* valobj
+)
+{
+    return FormatPromptImpl (format, NULL, NULL, sc, exe_ctx, addr, s, end, valobj);
+}
+
+// Run the ops [op_idx, op_end) of a compiled format. This follows the same
+// rules as the format string interpreter above: once a variable fails to
+// expand, the rest of the plain text in the scope is dropped and the scope
+// reports failure, while escapes are still written.
+static bool
+RunCompiledFormat (const CompiledFormatString &format,
+                   size_t op_idx,
+                   size_t op_end,
+                   const SymbolContext *sc,
+                   const ExecutionContext *exe_ctx,
+                   const Address *addr,
+                   Stream &s,
+                   ValueObject* valobj)
+{
+    bool success = true;
+    while (op_idx < op_end)
+    {
+        const CompiledFormatString::Op &op = format.GetOpAtIndex (op_idx);
+        switch (op.kind)
+        {
+        case CompiledFormatString::eOpLiteral:
+            if (success || op.unconditional)
+                s.Write (format.GetLiteral (op), op.length);
+            ++op_idx;
+            break;
+
+        case CompiledFormatString::eOpVariable:
+            // if we have already failed to parse, skip this variable
+            if (success)
+            {
+                // Step back over the "${" so the interpreter sees the whole variable
+                const char *var_text = format.GetVariableName (op) - 2;
+                if (!FormatPromptImpl (var_text, 
+                                       &op, 
+                                       format.GetExpressionPath (op), 
+                                       sc, 
+                                       exe_ctx, 
+                                       addr, 
+                                       s, 
+                                       NULL,
+                                       valobj))
+                    success = false;
+            }
+            ++op_idx;
+            break;
+
+        case CompiledFormatString::eOpScope:
+            {
+                StreamString sub_strm;
+                if (RunCompiledFormat (format, op_idx + 1, op.scope_end, sc, exe_ctx, addr, sub_strm, valobj))
+                    s.Write(sub_strm.GetData(), sub_strm.GetSize());
+                op_idx = op.scope_end;
+            }
+            break;
+
+        case CompiledFormatString::eOpAbort:
+            return false;
+        }
+    }
+    return success;
+}
+
+bool
+Debugger::FormatPrompt 
+(
+    const CompiledFormatString &format,
+    const SymbolContext *sc,
+    const ExecutionContext *exe_ctx,
+    const Address *addr,
+    Stream &s,
+    ValueObject* valobj
+)
+{
+    return RunCompiledFormat (format, 0, format.GetNumOps(), sc, exe_ctx, addr, s, valobj);
+}
+
 #pragma mark Debugger::SettingsController
 
 //--------------------------------------------------
@@ -2220,6 +2311,8 @@ DebuggerInstanceSettings::DebuggerInstanceSettings
     m_prompt (),
     m_frame_format (),
     m_thread_format (),    
+    m_compiled_frame_format (),
+    m_compiled_thread_format (),
     m_script_lang (),
     m_use_external_editor (false),
     m_auto_confirm_on (false)
@@ -2247,6 +2340,8 @@ DebuggerInstanceSettings::DebuggerInstanceSettings (const DebuggerInstanceSettin
     m_prompt (rhs.m_prompt),
     m_frame_format (rhs.m_frame_format),
     m_thread_format (rhs.m_thread_format),
+    m_compiled_frame_format (rhs.m_compiled_frame_format),
+    m_compiled_thread_format (rhs.m_compiled_thread_format),
     m_script_lang (rhs.m_script_lang),
     m_use_external_editor (rhs.m_use_external_editor),
     m_auto_confirm_on(rhs.m_auto_confirm_on)
@@ -2269,6 +2364,8 @@ DebuggerInstanceSettings::operator= (const DebuggerInstanceSettings &rhs)
         m_prompt = rhs.m_prompt;
         m_frame_format = rhs.m_frame_format;
         m_thread_format = rhs.m_thread_format;
+        m_compiled_frame_format = rhs.m_compiled_frame_format;
+        m_compiled_thread_format = rhs.m_compiled_thread_format;
         m_script_lang = rhs.m_script_lang;
         m_use_external_editor = rhs.m_use_external_editor;
         m_auto_confirm_on = rhs.m_auto_confirm_on;
@@ -2345,10 +2442,12 @@ DebuggerInstanceSettings::UpdateInstanceSettingsVariable (const ConstString &var
     else if (var_name == GetFrameFormatName())
     {
         UserSettingsController::UpdateStringVariable (op, m_frame_format, value, err);
+        m_compiled_frame_format.Compile (m_frame_format.c_str());
     }
     else if (var_name == GetThreadFormatName())
     {
         UserSettingsController::UpdateStringVariable (op, m_thread_format, value, err);
+        m_compiled_thread_format.Compile (m_thread_format.c_str());
     }
     else if (var_name == ScriptLangVarName())
     {
@@ -2499,6 +2598,8 @@ DebuggerInstanceSettings::CopyInstanceSettings (const InstanceSettingsSP &new_se
     }
     m_frame_format = new_debugger_settings->m_frame_format;
     m_thread_format = new_debugger_settings->m_thread_format;
+    m_compiled_frame_format = new_debugger_settings->m_compiled_frame_format;
+    m_compiled_thread_format = new_debugger_settings->m_compiled_thread_format;
     m_term_width = new_debugger_settings->m_term_width;
     m_script_lang = new_debugger_settings->m_script_lang;
     m_use_external_editor = new_debugger_settings->m_use_external_editor;
@@ -896,6 +896,34 @@ InstructionList::Append (lldb::InstructionSP &inst_sp)
         m_instructions.push_back(inst_sp);
 }
 
+uint32_t
+InstructionList::GetIndexOfNextBranchInstruction (uint32_t start) const
+{
+    const size_t num_instructions = m_instructions.size();
+    for (size_t i = start; i < num_instructions; ++i)
+    {
+        if (m_instructions[i]->DoesBranch())
+            return i;
+    }
+    return UINT32_MAX;
+}
+
+uint32_t
+InstructionList::GetIndexOfInstructionAtLoadAddress (lldb::addr_t load_addr, Target &target) const
+{
+    const size_t num_instructions = m_instructions.size();
+    for (size_t i = 0; i < num_instructions; ++i)
+    {
+        const lldb::addr_t inst_load_addr = m_instructions[i]->GetAddress().GetLoadAddress (&target);
+        if (inst_load_addr == load_addr)
+            return i;
+        // The instructions are in address order
+        if (inst_load_addr != LLDB_INVALID_ADDRESS && inst_load_addr > load_addr)
+            break;
+    }
+    return UINT32_MAX;
+}
+
 
 size_t
 Disassembler::ParseInstructions
@@ -23,6 +23,8 @@ struct PyObject;
 
 #endif  // #ifdef LLDB_DISABLE_PYTHON
 
+#include <stdlib.h>
+
 // C++ Includes
 #include <ostream>
 
@@ -32,11 +34,15 @@ struct PyObject;
 #include "lldb/lldb-public.h"
 #include "lldb/lldb-enumerations.h"
 
+#include "lldb/lldb-private-log.h"
+#include "lldb/Core/DataBufferHeap.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/FormatClasses.h"
+#include "lldb/Core/Log.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/ValueObjectConstResult.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Symbol/ClangASTContext.h"
 #include "lldb/Symbol/ClangASTType.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
@@ -55,6 +61,292 @@ ValueFormat::ValueFormat (lldb::Format f,
 {
 }
 
+CompiledFormatString::CompiledFormatString () :
+    m_format (),
+    m_literals (),
+    m_ops ()
+{
+}
+
+CompiledFormatString::CompiledFormatString (const char *format) :
+    m_format (),
+    m_literals (),
+    m_ops ()
+{
+    Compile (format);
+}
+
+void
+CompiledFormatString::Compile (const char *format)
+{
+    m_format.assign (format ? format : "");
+    m_literals.clear();
+    m_ops.clear();
+    CompileScope (m_format.c_str());
+}
+
+void
+CompiledFormatString::AppendLiteral (const char *bytes, size_t length, bool unconditional)
+{
+    if (length == 0)
+        return;
+    // Extend the previous literal if it is in the same pool run and is
+    // written under the same conditions.
+    if (!m_ops.empty())
+    {
+        Op &last_op = m_ops.back();
+        if (last_op.kind == eOpLiteral &&
+            last_op.unconditional == unconditional &&
+            last_op.offset + last_op.length == m_literals.size())
+        {
+            m_literals.append (bytes, length);
+            last_op.length += length;
+            return;
+        }
+    }
+    Op op;
+    op.kind = eOpLiteral;
+    op.offset = m_literals.size();
+    op.length = length;
+    op.scope_end = 0;
+    op.unconditional = unconditional;
+    op.percent_offset = UINT32_MAX;
+    op.custom_format = eFormatInvalid;
+    op.has_display = false;
+    op.display = ValueObject::eDisplaySummary;
+    op.expr_path_offset = UINT32_MAX;
+    m_literals.append (bytes, length);
+    m_ops.push_back (op);
+}
+
+void
+CompiledFormatString::AppendVariable (const char *var_name_begin, const char *var_name_end)
+{
+    Op op;
+    op.kind = eOpVariable;
+    op.offset = var_name_begin - m_format.c_str();
+    op.length = var_name_end - var_name_begin;
+    op.scope_end = 0;
+    op.unconditional = false;
+    op.percent_offset = UINT32_MAX;
+    op.custom_format = eFormatInvalid;
+    op.has_display = false;
+    op.display = ValueObject::eDisplaySummary;
+    op.expr_path_offset = UINT32_MAX;
+
+    const char *var_name_final = var_name_end;
+    const char *percent_position = ::strchr (var_name_begin, '%');
+    if (percent_position && percent_position < var_name_end)
+    {
+        var_name_final = percent_position;
+        op.percent_offset = percent_position - var_name_begin;
+        std::string format_name (percent_position + 1, var_name_end);
+        op.has_display = ParseFormatDescriptor (format_name.c_str(), op.custom_format, op.display);
+    }
+
+    // Value object paths ("${var.x}", "${*var.x}", "${svar[]}") get their
+    // expression path extracted now so it doesn't need to be copied out of
+    // the format on every use.
+    const char *var_path = var_name_begin;
+    if (*var_path == '*')
+        ++var_path;
+    if (*var_path == 's')
+        ++var_path;
+    if (::strncmp (var_path, "var", strlen("var")) == 0 &&
+        var_path[3] != '}' && var_path[3] != '%' &&
+        var_name_final >= var_path + 3)
+    {
+        op.expr_path_offset = m_literals.size();
+        m_literals.append (var_path + 3, var_name_final - var_path - 3);
+        m_literals.push_back ('\0');
+    }
+    m_ops.push_back (op);
+}
+
+// This mirrors the scanning done by Debugger::FormatPrompt(). Literal text
+// is unescaped into the literal pool once, and each "${...}" becomes a
+// variable op that points back into the format text.
+const char *
+CompiledFormatString::CompileScope (const char *p)
+{
+    for (; *p != '\0'; ++p)
+    {
+        size_t non_special_chars = ::strcspn (p, "${}\\");
+        if (non_special_chars > 0)
+        {
+            AppendLiteral (p, non_special_chars, false);
+            p += non_special_chars;
+        }
+
+        if (*p == '\0')
+        {
+            break;
+        }
+        else if (*p == '{')
+        {
+            const size_t scope_idx = m_ops.size();
+            Op op;
+            op.kind = eOpScope;
+            op.offset = 0;
+            op.length = 0;
+            op.scope_end = 0;
+            op.unconditional = false;
+            op.percent_offset = UINT32_MAX;
+            op.custom_format = eFormatInvalid;
+            op.has_display = false;
+            op.display = ValueObject::eDisplaySummary;
+            op.expr_path_offset = UINT32_MAX;
+            m_ops.push_back (op);
+
+            p = CompileScope (p + 1);
+            m_ops[scope_idx].scope_end = m_ops.size();
+            if (*p != '}')
+            {
+                op.kind = eOpAbort;
+                m_ops.push_back (op);
+                break;
+            }
+        }
+        else if (*p == '}')
+        {
+            // End of a enclosing scope
+            break;
+        }
+        else if (*p == '$')
+        {
+            ++p;
+            if (*p == '{')
+            {
+                ++p;
+                const char *var_name_begin = p;
+                const char *var_name_end = ::strchr (p, '}');
+
+                if (var_name_end && var_name_begin < var_name_end)
+                {
+                    AppendVariable (var_name_begin, var_name_end);
+                    p = var_name_end;
+                }
+                else
+                    break;
+            }
+            else if (*p == '\0')
+            {
+                break;
+            }
+            else
+            {
+                // We got a dollar sign with no '{' after it, it must just be a dollar sign
+                AppendLiteral (p, 1, true);
+            }
+        }
+        else if (*p == '\\')
+        {
+            ++p; // skip the slash
+            char ch = 0;
+            switch (*p)
+            {
+            case '\0': return p;
+            case 'a': ch = '\a'; break;
+            case 'b': ch = '\b'; break;
+            case 'f': ch = '\f'; break;
+            case 'n': ch = '\n'; break;
+            case 'r': ch = '\r'; break;
+            case 't': ch = '\t'; break;
+            case 'v': ch = '\v'; break;
+            case '0':
+                // 1 to 3 octal chars
+                {
+                    char oct_str[5] = { 0, 0, 0, 0, 0 };
+
+                    int i;
+                    for (i=0; (p[i] >= '0' && p[i] <= '7') && i<4; ++i)
+                        oct_str[i] = p[i];
+
+                    p += i - 1;
+                    unsigned long octal_value = ::strtoul (oct_str, NULL, 8);
+                    if (octal_value <= UINT8_MAX)
+                    {
+                        char octal_char = octal_value;
+                        AppendLiteral (&octal_char, 1, true);
+                    }
+                }
+                continue;
+
+            case 'x':
+                // hex number in the format 
+                if (isxdigit(p[1]))
+                {
+                    ++p;    // Skip the 'x'
+
+                    char hex_str[3] = { 0,0,0 };
+                    hex_str[0] = *p;
+                    if (isxdigit(p[1]))
+                    {
+                        ++p; // Skip the first of the two hex chars
+                        hex_str[1] = *p;
+                    }
+
+                    ch = strtoul (hex_str, NULL, 16);
+                }
+                else
+                {
+                    ch = 'x';
+                }
+                break;
+
+            default:
+                // Just desensitize any other character by just printing what
+                // came after the '\'
+                ch = *p;
+                break;
+            }
+            AppendLiteral (&ch, 1, true);
+        }
+    }
+    return p;
+}
+
+bool
+CompiledFormatString::ParseFormatDescriptor (const char *format_name,
+                                             lldb::Format &custom_format,
+                                             ValueObject::ValueObjectRepresentationStyle &val_obj_display)
+{
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_TYPES));
+    if (log)
+        log->Printf("parsing %s as a format descriptor", format_name);
+    if (FormatManager::GetFormatFromCString(format_name,
+                                           true,
+                                           custom_format))
+    {
+        // a good custom format tells us to print the value using it
+        if (log)
+            log->Printf("will display value for this VO");
+        val_obj_display = ValueObject::eDisplayValue;
+        return true;
+    }
+
+    if (log)
+        log->Printf("%s is an unknown format", format_name);
+    switch (*format_name)
+    {
+    // if this is an @ sign, print ObjC description
+    case '@': val_obj_display = ValueObject::eDisplayLanguageSpecific; return true;
+    // if this is a V, print the value using the default format
+    case 'V': val_obj_display = ValueObject::eDisplayValue; return true;
+    // if this is an L, print the location of the value
+    case 'L': val_obj_display = ValueObject::eDisplayLocation; return true;
+    // if this is an S, print the summary after all
+    case 'S': val_obj_display = ValueObject::eDisplaySummary; return true;
+    case '#': val_obj_display = ValueObject::eDisplayChildrenCount; return true;
+    case 'T': val_obj_display = ValueObject::eDisplayType; return true;
+    default:
+        if (log)
+            log->Printf("%s is an error, leaving the previous value alone", format_name);
+        break;
+    }
+    return false;
+}
+
 SummaryFormat::SummaryFormat(bool casc,
                              bool skipptr,
                              bool skipref,
@@ -83,7 +375,8 @@ StringSummaryFormat::StringSummaryFormat(bool casc,
                   nochildren,
                   novalue,
                   oneliner),
-    m_format(f)
+    m_format(f),
+    m_compiled_format(f.c_str())
 {
 }
 
@@ -133,7 +426,7 @@ StringSummaryFormat::FormatObject(lldb::ValueObjectSP object)
     }
     else
     {
-        if (Debugger::FormatPrompt(m_format.c_str(), &sc, &exe_ctx, &sc.line_entry.range.GetBaseAddress(), s, NULL, object.get()))
+        if (Debugger::FormatPrompt(m_compiled_format, &sc, &exe_ctx, &sc.line_entry.range.GetBaseAddress(), s, object.get()))
             return s.GetString();
         else
             return "";
@@ -295,6 +588,493 @@ SyntheticScriptProvider::GetDescription()
 
 #endif // #ifndef LLDB_DISABLE_PYTHON
 
+std::string
+CXXSyntheticChildren::GetDescription()
+{
+    StreamString sstr;
+    sstr.Printf("%s%s%s %s",
+                m_cascades ? "" : " (not cascading)",
+                m_skip_pointers ? " (skip pointers)" : "",
+                m_skip_references ? " (skip references)" : "",
+                m_description.c_str());
+    
+    return sstr.GetString();
+}
+
+// Container elements are named "[0]", "[1]", ... so map such a name back
+// to its index.
+static uint32_t
+ExtractIndexFromChildName (const ConstString &name)
+{
+    const char *name_cstr = name.GetCString();
+    if (name_cstr == NULL || name_cstr[0] != '[')
+        return UINT32_MAX;
+    char *end = NULL;
+    const unsigned long index = ::strtoul (name_cstr + 1, &end, 10);
+    if (end == name_cstr + 1 || end[0] != ']' || end[1] != '\0' || index >= UINT32_MAX)
+        return UINT32_MAX;
+    return index;
+}
+
+// Make a value of type "type" living at load address "addr", the same way
+// SBValue::CreateValueFromAddress() does it.
+static lldb::ValueObjectSP
+CreateValueObjectAtAddress (ValueObject &backend,
+                            const char *name,
+                            lldb::addr_t addr,
+                            const ClangASTType &type)
+{
+    lldb::ValueObjectSP valobj_sp;
+    if (addr == 0 || addr == LLDB_INVALID_ADDRESS || !type.IsValid())
+        return valobj_sp;
+    
+    lldb::ProcessSP process_sp(backend.GetUpdatePoint().GetProcessSP());
+    if (!process_sp)
+        return valobj_sp;
+    
+    lldb::clang_type_t pointer_type = ClangASTType::GetPointerType (type.GetASTContext(), type.GetOpaqueQualType());
+    if (pointer_type == NULL)
+        return valobj_sp;
+    
+    lldb::DataBufferSP buffer_sp(new DataBufferHeap(&addr, sizeof(addr)));
+    lldb::ValueObjectSP pointer_sp (ValueObjectConstResult::Create (backend.GetExecutionContextScope(),
+                                                                    type.GetASTContext(),
+                                                                    pointer_type,
+                                                                    ConstString(name),
+                                                                    buffer_sp,
+                                                                    lldb::endian::InlHostByteOrder(),
+                                                                    process_sp->GetAddressByteSize()));
+    if (!pointer_sp)
+        return valobj_sp;
+    
+    pointer_sp->GetValue().SetValueType(Value::eValueTypeLoadAddress);
+    Error error;
+    valobj_sp = pointer_sp->Dereference(error);
+    if (valobj_sp)
+        valobj_sp->SetName(ConstString(name));
+    return valobj_sp;
+}
+
+static lldb::ValueObjectSP
+GetChildAtNamePath (const lldb::ValueObjectSP &valobj_sp, const char *first, const char *second = NULL)
+{
+    lldb::ValueObjectSP child_sp;
+    if (valobj_sp)
+        child_sp = valobj_sp->GetChildMemberWithName(ConstString(first), true);
+    if (child_sp && second)
+        child_sp = child_sp->GetChildMemberWithName(ConstString(second), true);
+    return child_sp;
+}
+
+LibstdcppVectorSyntheticFrontEnd::LibstdcppVectorSyntheticFrontEnd (lldb::ValueObjectSP be) :
+    SyntheticChildrenFrontEnd(be),
+    m_start_sp(),
+    m_element_type(),
+    m_element_size(0),
+    m_num_elements(0)
+{
+    Update();
+}
+
+SyntheticChildrenFrontEnd *
+LibstdcppVectorSyntheticFrontEnd::CreateInstance (lldb::ValueObjectSP backend)
+{
+    return new LibstdcppVectorSyntheticFrontEnd (backend);
+}
+
+void
+LibstdcppVectorSyntheticFrontEnd::Update ()
+{
+    m_start_sp.reset();
+    m_element_type = ClangASTType();
+    m_element_size = 0;
+    m_num_elements = 0;
+    
+    lldb::ValueObjectSP impl_sp (GetChildAtNamePath (m_backend, "_M_impl"));
+    lldb::ValueObjectSP start_sp (GetChildAtNamePath (impl_sp, "_M_start"));
+    lldb::ValueObjectSP finish_sp (GetChildAtNamePath (impl_sp, "_M_finish"));
+    lldb::ValueObjectSP end_sp (GetChildAtNamePath (impl_sp, "_M_end_of_storage"));
+    if (!start_sp || !finish_sp || !end_sp)
+        return;
+    
+    lldb::clang_type_t element_type = ClangASTType::GetPointeeType (start_sp->GetClangType());
+    if (element_type == NULL)
+        return;
+    ClangASTType element_clang_type (start_sp->GetClangAST(), element_type);
+    const uint32_t element_size = element_clang_type.GetTypeByteSize();
+    if (element_size == 0)
+        return;
+    
+    // Before a vector has been constructed it contains garbage, so only
+    // trust the three pointers if they are non-NULL and correctly ordered
+    const uint64_t start = start_sp->GetValueAsUnsigned(0);
+    const uint64_t finish = finish_sp->GetValueAsUnsigned(0);
+    const uint64_t end = end_sp->GetValueAsUnsigned(0);
+    if (start == 0 || finish == 0 || end == 0 || start > finish || finish > end)
+        return;
+    
+    // Elements are addressed as offsets from _M_start
+    const uint64_t num_elements = (finish - start) / element_size;
+    if (num_elements * element_size > UINT32_MAX)
+        return;
+    
+    m_start_sp = start_sp;
+    m_element_type = element_clang_type;
+    m_element_size = element_size;
+    m_num_elements = num_elements;
+}
+
+uint32_t
+LibstdcppVectorSyntheticFrontEnd::CalculateNumChildren ()
+{
+    return m_num_elements;
+}
+
+lldb::ValueObjectSP
+LibstdcppVectorSyntheticFrontEnd::GetChildAtIndex (uint32_t idx, bool can_create)
+{
+    if (idx >= m_num_elements || !m_start_sp)
+        return lldb::ValueObjectSP();
+    
+    lldb::ValueObjectSP child_sp (m_start_sp->GetSyntheticChildAtOffset (idx * m_element_size, m_element_type, can_create));
+    if (child_sp)
+    {
+        char name[64];
+        ::snprintf (name, sizeof(name), "[%u]", idx);
+        child_sp->SetName (ConstString(name));
+    }
+    return child_sp;
+}
+
+uint32_t
+LibstdcppVectorSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromChildName (name);
+}
+
+LibstdcppListSyntheticFrontEnd::LibstdcppListSyntheticFrontEnd (lldb::ValueObjectSP be) :
+    SyntheticChildrenFrontEnd(be),
+    m_head_addr(LLDB_INVALID_ADDRESS),
+    m_data_offset(0),
+    m_element_type(),
+    m_nodes(),
+    m_nodes_fetched(false)
+{
+    Update();
+}
+
+SyntheticChildrenFrontEnd *
+LibstdcppListSyntheticFrontEnd::CreateInstance (lldb::ValueObjectSP backend)
+{
+    return new LibstdcppListSyntheticFrontEnd (backend);
+}
+
+void
+LibstdcppListSyntheticFrontEnd::Update ()
+{
+    m_head_addr = LLDB_INVALID_ADDRESS;
+    m_data_offset = 0;
+    m_element_type = ClangASTType();
+    m_nodes.clear();
+    m_nodes_fetched = false;
+    
+    lldb::ValueObjectSP node_sp (GetChildAtNamePath (m_backend, "_M_impl", "_M_node"));
+    if (!node_sp)
+        return;
+    
+    lldb::clang_type_t element_type = ClangASTContext::GetTemplateArgumentType (m_backend->GetClangAST(),
+                                                                                m_backend->GetClangType(),
+                                                                                0);
+    if (element_type == NULL)
+        return;
+    
+    AddressType address_type = eAddressTypeInvalid;
+    const lldb::addr_t head_addr = node_sp->GetAddressOf (true, &address_type);
+    if (head_addr == LLDB_INVALID_ADDRESS || address_type != eAddressTypeLoad)
+        return;
+    
+    // Each _List_node<T> is a _List_node_base followed by the element
+    m_head_addr = head_addr;
+    m_data_offset = node_sp->GetByteSize();
+    m_element_type = ClangASTType (m_backend->GetClangAST(), element_type);
+}
+
+// Walk the _M_next chain once, reading a single pointer per node, until it
+// comes back around to the list head. A corrupt or uninitialized list can
+// contain a cycle that never reaches the head; Brent's algorithm catches
+// that without having to remember every node visited.
+void
+LibstdcppListSyntheticFrontEnd::FetchNodes ()
+{
+    if (m_nodes_fetched)
+        return;
+    m_nodes_fetched = true;
+    
+    if (m_head_addr == LLDB_INVALID_ADDRESS)
+        return;
+    
+    lldb::ProcessSP process_sp (m_backend->GetUpdatePoint().GetProcessSP());
+    if (!process_sp)
+        return;
+    
+    Error error;
+    lldb::addr_t node_addr = process_sp->ReadPointerFromMemory (m_head_addr, error);
+    lldb::addr_t tortoise = m_head_addr;
+    uint32_t power = 1;
+    uint32_t lambda = 1;
+    
+    while (error.Success() && node_addr != m_head_addr)
+    {
+        if (node_addr == 0 || node_addr == LLDB_INVALID_ADDRESS)
+            break;
+        
+        m_nodes.push_back (node_addr);
+        
+        const lldb::addr_t next_addr = process_sp->ReadPointerFromMemory (node_addr, error);
+        if (power == lambda)
+        {
+            tortoise = node_addr;
+            power *= 2;
+            lambda = 0;
+        }
+        node_addr = next_addr;
+        ++lambda;
+        
+        if (node_addr == tortoise)
+        {
+            LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_TYPES));
+            if (log)
+                log->Printf ("std::list at 0x%16.16llx has a cycle that does not include the list head, not showing any elements",
+                             (uint64_t)m_head_addr);
+            m_nodes.clear();
+            break;
+        }
+    }
+}
+
+uint32_t
+LibstdcppListSyntheticFrontEnd::CalculateNumChildren ()
+{
+    FetchNodes();
+    return m_nodes.size();
+}
+
+lldb::ValueObjectSP
+LibstdcppListSyntheticFrontEnd::GetChildAtIndex (uint32_t idx, bool can_create)
+{
+    if (!can_create)
+        return lldb::ValueObjectSP();
+    
+    FetchNodes();
+    if (idx >= m_nodes.size())
+        return lldb::ValueObjectSP();
+    
+    char name[64];
+    ::snprintf (name, sizeof(name), "[%u]", idx);
+    return CreateValueObjectAtAddress (*m_backend, name, m_nodes[idx] + m_data_offset, m_element_type);
+}
+
+uint32_t
+LibstdcppListSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromChildName (name);
+}
+
+LibstdcppMapSyntheticFrontEnd::LibstdcppMapSyntheticFrontEnd (lldb::ValueObjectSP be) :
+    SyntheticChildrenFrontEnd(be),
+    m_header_addr(LLDB_INVALID_ADDRESS),
+    m_data_offset(0),
+    m_num_elements(0),
+    m_element_type(),
+    m_nodes(),
+    m_tree_nodes()
+{
+    Update();
+}
+
+SyntheticChildrenFrontEnd *
+LibstdcppMapSyntheticFrontEnd::CreateInstance (lldb::ValueObjectSP backend)
+{
+    return new LibstdcppMapSyntheticFrontEnd (backend);
+}
+
+void
+LibstdcppMapSyntheticFrontEnd::Update ()
+{
+    m_header_addr = LLDB_INVALID_ADDRESS;
+    m_data_offset = 0;
+    m_num_elements = 0;
+    m_element_type = ClangASTType();
+    m_nodes.clear();
+    m_tree_nodes.clear();
+    
+    lldb::ValueObjectSP tree_sp (GetChildAtNamePath (m_backend, "_M_t"));
+    lldb::ValueObjectSP impl_sp (GetChildAtNamePath (tree_sp, "_M_impl"));
+    lldb::ValueObjectSP header_sp (GetChildAtNamePath (impl_sp, "_M_header"));
+    lldb::ValueObjectSP count_sp (GetChildAtNamePath (impl_sp, "_M_node_count"));
+    lldb::ValueObjectSP root_sp (GetChildAtNamePath (header_sp, "_M_parent"));
+    if (!header_sp || !count_sp || !root_sp)
+        return;
+    
+    // _M_t is a _Rb_tree<Key, Value, ...> whose nodes hold a
+    // std::pair<const Key, T>, its second template argument
+    lldb::clang_type_t element_type = ClangASTContext::GetTemplateArgumentType (tree_sp->GetClangAST(),
+                                                                                tree_sp->GetClangType(),
+                                                                                1);
+    if (element_type == NULL)
+        return;
+    
+    AddressType address_type = eAddressTypeInvalid;
+    const lldb::addr_t header_addr = header_sp->GetAddressOf (true, &address_type);
+    if (header_addr == LLDB_INVALID_ADDRESS || address_type != eAddressTypeLoad)
+        return;
+    
+    m_header_addr = header_addr;
+    // Each _Rb_tree_node<Value> is a _Rb_tree_node_base followed by the element
+    m_data_offset = header_sp->GetByteSize();
+    m_element_type = ClangASTType (tree_sp->GetClangAST(), element_type);
+    if (root_sp->GetValueAsUnsigned(0) != 0)
+        m_num_elements = count_sp->GetValueAsUnsigned(0);
+}
+
+// Read the links of a _Rb_tree_node_base: an int color followed by the
+// parent, left and right pointers.
+bool
+LibstdcppMapSyntheticFrontEnd::ReadTreeNode (lldb::addr_t node_addr, TreeNode &node)
+{
+    TreeNodeMap::const_iterator pos = m_tree_nodes.find (node_addr);
+    if (pos != m_tree_nodes.end())
+    {
+        node = pos->second;
+        return true;
+    }
+    
+    if (node_addr == 0 || node_addr == LLDB_INVALID_ADDRESS)
+        return false;
+    
+    lldb::ProcessSP process_sp (m_backend->GetUpdatePoint().GetProcessSP());
+    if (!process_sp)
+        return false;
+    
+    const uint32_t addr_byte_size = process_sp->GetAddressByteSize();
+    const size_t node_byte_size = 4 * addr_byte_size;
+    uint8_t node_bytes[4 * sizeof(uint64_t)];
+    if (node_byte_size > sizeof(node_bytes))
+        return false;
+    
+    Error error;
+    if (process_sp->ReadMemory (node_addr, node_bytes, node_byte_size, error) != node_byte_size)
+        return false;
+    
+    DataExtractor data (node_bytes, node_byte_size, process_sp->GetByteOrder(), addr_byte_size);
+    uint32_t offset = addr_byte_size;
+    node.parent = data.GetAddress (&offset);
+    node.left = data.GetAddress (&offset);
+    node.right = data.GetAddress (&offset);
+    m_tree_nodes[node_addr] = node;
+    return true;
+}
+
+// The in-order successor of a node, as computed by _Rb_tree_increment() in
+// libstdc++. None of the loops can legitimately run more times than there
+// are elements in the tree, which bounds the walk over a corrupt tree.
+lldb::addr_t
+LibstdcppMapSyntheticFrontEnd::IncrementNode (lldb::addr_t node_addr)
+{
+    TreeNode x_node;
+    if (!ReadTreeNode (node_addr, x_node))
+        return LLDB_INVALID_ADDRESS;
+    
+    lldb::addr_t x = node_addr;
+    uint32_t steps = 0;
+    if (x_node.right != 0)
+    {
+        x = x_node.right;
+        if (!ReadTreeNode (x, x_node))
+            return LLDB_INVALID_ADDRESS;
+        while (x_node.left != 0)
+        {
+            if (++steps > m_num_elements)
+                return LLDB_INVALID_ADDRESS;
+            x = x_node.left;
+            if (!ReadTreeNode (x, x_node))
+                return LLDB_INVALID_ADDRESS;
+        }
+        return x;
+    }
+    
+    lldb::addr_t y = x_node.parent;
+    TreeNode y_node;
+    if (!ReadTreeNode (y, y_node))
+        return LLDB_INVALID_ADDRESS;
+    while (x == y_node.right)
+    {
+        if (++steps > m_num_elements)
+            return LLDB_INVALID_ADDRESS;
+        x = y;
+        x_node = y_node;
+        y = y_node.parent;
+        if (!ReadTreeNode (y, y_node))
+            return LLDB_INVALID_ADDRESS;
+    }
+    if (x_node.right != y)
+        x = y;
+    return x;
+}
+
+// Extend the in-order node list so that it holds at least "count" nodes,
+// resuming from wherever the previous call stopped.
+bool
+LibstdcppMapSyntheticFrontEnd::FetchNodes (uint32_t count)
+{
+    if (count > m_num_elements)
+        count = m_num_elements;
+    
+    if (m_nodes.empty() && count > 0)
+    {
+        // The header's _M_left is the leftmost (smallest) node
+        TreeNode header;
+        if (!ReadTreeNode (m_header_addr, header) || header.left == 0 || header.left == m_header_addr)
+            return false;
+        m_nodes.push_back (header.left);
+    }
+    
+    while (m_nodes.size() < count)
+    {
+        const lldb::addr_t next_addr = IncrementNode (m_nodes.back());
+        if (next_addr == LLDB_INVALID_ADDRESS || next_addr == 0 || next_addr == m_header_addr)
+            return false;
+        m_nodes.push_back (next_addr);
+    }
+    return true;
+}
+
+uint32_t
+LibstdcppMapSyntheticFrontEnd::CalculateNumChildren ()
+{
+    return m_num_elements;
+}
+
+lldb::ValueObjectSP
+LibstdcppMapSyntheticFrontEnd::GetChildAtIndex (uint32_t idx, bool can_create)
+{
+    if (!can_create || idx >= m_num_elements)
+        return lldb::ValueObjectSP();
+    
+    if (!FetchNodes (idx + 1))
+        return lldb::ValueObjectSP();
+    
+    char name[64];
+    ::snprintf (name, sizeof(name), "[%u]", idx);
+    return CreateValueObjectAtAddress (*m_backend, name, m_nodes[idx] + m_data_offset, m_element_type);
+}
+
+uint32_t
+LibstdcppMapSyntheticFrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    return ExtractIndexFromChildName (name);
+}
+
 int
 SyntheticArrayView::GetRealIndexForIndex(int i)
 {
@@ -617,23 +617,28 @@ FormatManager::FormatManager() :
     gnu_category_sp->GetSummaryNavigator()->Add(ConstString("std::basic_string<char,std::char_traits<char>,std::allocator<char> >"),
                                                 std_string_summary_sp);
     
-#ifndef LLDB_DISABLE_PYTHON
+    // The containers are walked by native front ends rather than by the
+    // Python providers in gnu_libstdcpp.py, which stay available for users
+    // who want to override these from their own category
     gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^(std::)?vector<.+>$")),
-                                     SyntheticChildrenSP(new SyntheticScriptProvider(true,
-                                                                                     false,
-                                                                                     false,
-                                                                                     "gnu_libstdcpp.StdVectorSynthProvider")));
+                                     SyntheticChildrenSP(new CXXSyntheticChildren(true,
+                                                                                  false,
+                                                                                  false,
+                                                                                  "libstdc++ std::vector synthetic children",
+                                                                                  LibstdcppVectorSyntheticFrontEnd::CreateInstance)));
     gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^(std::)?map<.+> >$")),
-                                     SyntheticChildrenSP(new SyntheticScriptProvider(true,
-                                                                                     false,
-                                                                                     false,
-                                                                                     "gnu_libstdcpp.StdMapSynthProvider")));
+                                     SyntheticChildrenSP(new CXXSyntheticChildren(true,
+                                                                                  false,
+                                                                                  false,
+                                                                                  "libstdc++ std::map synthetic children",
+                                                                                  LibstdcppMapSyntheticFrontEnd::CreateInstance)));
     gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^(std::)?list<.+>$")),
-                                     SyntheticChildrenSP(new SyntheticScriptProvider(true,
-                                                                                     false,
-                                                                                     false,
-                                                                                     "gnu_libstdcpp.StdListSynthProvider")));
-#endif
+                                     SyntheticChildrenSP(new CXXSyntheticChildren(true,
+                                                                                  false,
+                                                                                  false,
+                                                                                  "libstdc++ std::list synthetic children",
+                                                                                  LibstdcppListSyntheticFrontEnd::CreateInstance)));
+
     // DO NOT change the order of these calls, unless you WANT a change in the priority of these categories
     EnableCategory(m_system_category_name);
     EnableCategory(m_gnu_cpp_category_name);
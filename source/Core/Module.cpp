@@ -727,6 +727,12 @@ Module::FindFirstSymbolWithNameAndType (const ConstString &name, SymbolType symb
     ObjectFile *objfile = GetObjectFile();
     if (objfile)
     {
+        // Let the object file answer from its own name lookup table if it
+        // has one so we don't parse the whole symbol table for one name.
+        std::vector<Symbol *> symbols;
+        if (objfile->FindSymbolsWithNameAndType (name, symbol_type, symbols))
+            return symbols.empty() ? NULL : symbols.front();
+
         Symtab *symtab = objfile->GetSymtab();
         if (symtab)
             return symtab->FindFirstSymbolWithNameAndType (name, symbol_type, Symtab::eDebugAny, Symtab::eVisibilityAny);
@@ -768,6 +774,22 @@ Module::FindSymbolsWithNameAndType (const ConstString &name, SymbolType symbol_t
     ObjectFile *objfile = GetObjectFile ();
     if (objfile)
     {
+        std::vector<Symbol *> symbols;
+        if (objfile->FindSymbolsWithNameAndType (name, symbol_type, symbols))
+        {
+            if (!symbols.empty())
+            {
+                SymbolContext sc;
+                CalculateSymbolContext (&sc);
+                for (size_t i = 0; i < symbols.size(); ++i)
+                {
+                    sc.symbol = symbols[i];
+                    sc_list.Append (sc);
+                }
+            }
+            return sc_list.GetSize() - initial_size;
+        }
+
         Symtab *symtab = objfile->GetSymtab();
         if (symtab)
         {
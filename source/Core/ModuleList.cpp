@@ -11,10 +11,13 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Host/Host.h"
 #include "lldb/Host/Symbols.h"
 #include "lldb/Symbol/ClangNamespaceDecl.h"
 #include "lldb/Symbol/ObjectFile.h"
@@ -262,7 +265,55 @@ ModuleList::FindSymbolsWithNameAndType (const ConstString &name,
     return sc_list.GetSize() - initial_size;
 }
 
-    size_t
+    namespace {
+
+// The modules to search for symbols matching a regular expression, shared
+// by all the search threads.
+struct ModuleRegexSearch
+{
+    ModuleRegexSearch (const std::vector<ModuleSP> &modules,
+                       const RegularExpression &regex,
+                       SymbolType symbol_type) :
+        mutex (Mutex::eMutexTypeNormal),
+        modules (modules),
+        regex (regex),
+        symbol_type (symbol_type),
+        next_module_idx (0),
+        sc_lists (modules.size())
+    {
+    }
+
+    Mutex mutex;
+    const std::vector<ModuleSP> &modules;
+    const RegularExpression &regex;
+    SymbolType symbol_type;
+    size_t next_module_idx;
+    std::vector<SymbolContextList> sc_lists;
+};
+
+}
+
+static lldb::thread_result_t
+SearchModulesThread (lldb::thread_arg_t arg)
+{
+    ModuleRegexSearch *search = (ModuleRegexSearch *)arg;
+    // RegularExpression::Execute() isn't safe to share between threads
+    RegularExpression regex (search->regex);
+    while (1)
+    {
+        size_t module_idx;
+        {
+            Mutex::Locker locker (search->mutex);
+            module_idx = search->next_module_idx++;
+        }
+        if (module_idx >= search->modules.size())
+            break;
+        search->modules[module_idx]->FindSymbolsMatchingRegExAndType (regex, search->symbol_type, search->sc_lists[module_idx]);
+    }
+    return NULL;
+}
+
+size_t
 ModuleList::FindSymbolsMatchingRegExAndType (const RegularExpression &regex, 
                                              lldb::SymbolType symbol_type, 
                                              SymbolContextList &sc_list,
@@ -273,9 +324,43 @@ ModuleList::FindSymbolsMatchingRegExAndType (const RegularExpression &regex,
         sc_list.Clear();
     size_t initial_size = sc_list.GetSize();
     
-    collection::iterator pos, end = m_modules.end();
-    for (pos = m_modules.begin(); pos != end; ++pos)
-        (*pos)->FindSymbolsMatchingRegExAndType (regex, symbol_type, sc_list);
+    const size_t num_modules = m_modules.size();
+    const size_t num_threads = std::min<size_t> (Host::GetNumberCPUS(), num_modules);
+    if (num_threads <= 1)
+    {
+        collection::iterator pos, end = m_modules.end();
+        for (pos = m_modules.begin(); pos != end; ++pos)
+            (*pos)->FindSymbolsMatchingRegExAndType (regex, symbol_type, sc_list);
+        return sc_list.GetSize() - initial_size;
+    }
+
+    // Search the modules in parallel, each module gets its own result list
+    // so the results can be appended in module order afterwards.
+    ModuleRegexSearch search (m_modules, regex, symbol_type);
+    std::vector<lldb::thread_t> threads;
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        char thread_name[64];
+        ::snprintf (thread_name, sizeof(thread_name), "<lldb.module-list.regex-symbols-%zu>", i);
+        lldb::thread_t thread = Host::ThreadCreate (thread_name, SearchModulesThread, &search, NULL);
+        if (IS_VALID_LLDB_HOST_THREAD(thread))
+            threads.push_back (thread);
+    }
+    SearchModulesThread (&search);
+    for (size_t i = 0; i < threads.size(); ++i)
+        Host::ThreadJoin (threads[i], NULL, NULL);
+
+    for (size_t i = 0; i < num_modules; ++i)
+    {
+        const SymbolContextList &module_sc_list = search.sc_lists[i];
+        const uint32_t num_matches = module_sc_list.GetSize();
+        SymbolContext sc;
+        for (uint32_t j = 0; j < num_matches; ++j)
+        {
+            if (module_sc_list.GetContextAtIndex (j, sc))
+                sc_list.Append (sc);
+        }
+    }
     return sc_list.GetSize() - initial_size;
 }
 
@@ -785,6 +870,18 @@ ModuleList::GetSharedModule
     if (old_module_sp_ptr)
         old_module_sp_ptr->reset();
 
+    // When we are only given a UUID, any shared module with that UUID will
+    // do. A module that was asked for by path is always the module for that
+    // path, even if a file with the same UUID was loaded from elsewhere.
+    if (always_create == false && !in_file_spec && uuid_ptr && uuid_ptr->IsValid())
+    {
+        ModuleList matching_module_list;
+        if (shared_module_list.FindModules (NULL, &arch, uuid_ptr, object_name_ptr, matching_module_list) > 0)
+        {
+            module_sp = matching_module_list.GetModuleAtIndex(0);
+            return error;
+        }
+    }
 
     // First just try and get the file where it purports to be (path in
     // in_file_spec), then check and uuid.
@@ -8,8 +8,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/Core/RegularExpression.h"
+#include <ctype.h>
 #include <string.h>
 
+#include <algorithm>
+
 using namespace lldb_private;
 
 //----------------------------------------------------------------------
@@ -53,7 +56,12 @@ RegularExpression::RegularExpression(const char* re) :
     Compile(re);
 }
 
-RegularExpression::RegularExpression(const RegularExpression &rhs)
+RegularExpression::RegularExpression(const RegularExpression &rhs) :
+    m_re(),
+    m_comp_err (1),
+    m_preg(),
+    m_compile_flags(rhs.GetCompileFlags()),
+    m_matches()
 {
     memset(&m_preg,0,sizeof(m_preg));
     Compile(rhs.GetText(), rhs.GetCompileFlags());
@@ -221,3 +229,327 @@ RegularExpression::operator < (const RegularExpression& rhs) const
     return (m_re < rhs.m_re);
 }
 
+
+//----------------------------------------------------------------------
+// Work out a string that any string matching this extended regular
+// expression has to contain. We are conservative: anything we don't
+// fully understand just ends the current literal run, and alternation,
+// case insensitive matching or non-ASCII characters mean we give up.
+//----------------------------------------------------------------------
+bool
+RegularExpression::GetRequiredLiteral (std::string &literal) const
+{
+    literal.clear();
+    if (!IsValid() || 
+        (m_compile_flags & REG_EXTENDED) == 0 || 
+        (m_compile_flags & REG_ICASE) || 
+        m_re.find ('|') != std::string::npos)
+        return false;
+
+    std::string curr;
+    for (const char *p = m_re.c_str(); *p; ++p)
+    {
+        char ch = *p;
+        if ((unsigned char)ch >= 0x80)
+        {
+            literal.clear();
+            return false;
+        }
+
+        bool is_literal = false;
+        switch (ch)
+        {
+        case '\\':
+            // Escaped punctuation is a literal, anything else (\w, \b, ...)
+            // is a class or an assertion.
+            if (p[1] && ispunct ((unsigned char)p[1]))
+            {
+                ch = *++p;
+                is_literal = true;
+            }
+            else if (p[1])
+                ++p;
+            break;
+
+        case '*':
+        case '?':
+        case '{':
+            // The previous character may not be there at all
+            if (!curr.empty())
+                curr.erase (curr.size() - 1);
+            if (ch == '{')
+            {
+                while (p[1] && p[1] != '}')
+                    ++p;
+                if (p[1])
+                    ++p;
+            }
+            break;
+
+        case '[':
+            // Skip the bracket expression, a ']' right after the '[' or
+            // '[^' is part of the set.
+            ++p;
+            if (*p == '^')
+                ++p;
+            if (*p == ']')
+                ++p;
+            while (*p && *p != ']')
+            {
+                if (p[0] == '[' && (p[1] == ':' || p[1] == '.' || p[1] == '='))
+                {
+                    const char term = p[1];
+                    p += 2;
+                    while (*p && !(p[0] == term && p[1] == ']'))
+                        ++p;
+                    if (*p)
+                        ++p;
+                }
+                if (*p)
+                    ++p;
+            }
+            if (*p == '\0')
+            {
+                literal.clear();
+                return false;
+            }
+            break;
+
+        case '(':
+            {
+                // The group may be optional or repeated, so don't take
+                // anything from inside it.
+                int depth = 1;
+                while (depth > 0 && *++p)
+                {
+                    if (*p == '\\' && p[1])
+                        ++p;
+                    else if (*p == '(')
+                        ++depth;
+                    else if (*p == ')')
+                        --depth;
+                }
+                if (*p == '\0')
+                {
+                    literal.clear();
+                    return false;
+                }
+            }
+            break;
+
+        case '+':
+        case '.':
+        case '^':
+        case '$':
+        case ')':
+        case ']':
+        case '}':
+            break;
+
+        default:
+            is_literal = isprint ((unsigned char)ch);
+            break;
+        }
+
+        if (is_literal)
+        {
+            curr.push_back (ch);
+        }
+        else
+        {
+            if (curr.size() > literal.size())
+                literal = curr;
+            curr.clear();
+        }
+    }
+    if (curr.size() > literal.size())
+        literal = curr;
+    return !literal.empty();
+}
+
+//----------------------------------------------------------------------
+// RegularExpressionIndex
+//----------------------------------------------------------------------
+RegularExpressionIndex::RegularExpressionIndex () :
+    m_buckets (),
+    m_bucket_bits (0)
+{
+}
+
+RegularExpressionIndex::~RegularExpressionIndex ()
+{
+}
+
+void
+RegularExpressionIndex::Clear ()
+{
+    std::vector<Bucket> empty;
+    m_buckets.swap (empty);
+    m_bucket_bits = 0;
+}
+
+size_t
+RegularExpressionIndex::GetMinimumStringCount ()
+{
+    // Running the regular expression over a few thousand strings is quick
+    // enough that the index isn't worth its memory.
+    return 4096;
+}
+
+void
+RegularExpressionIndex::Reserve (size_t num_strings)
+{
+    Clear ();
+    // About one bucket per string, within reason
+    m_bucket_bits = 10;
+    while (m_bucket_bits < 18 && ((size_t)1 << m_bucket_bits) < num_strings)
+        ++m_bucket_bits;
+    m_buckets.resize (1u << m_bucket_bits);
+}
+
+uint32_t
+RegularExpressionIndex::GetBucketIndex (const char *trigram) const
+{
+    const uint32_t key = ((uint32_t)(uint8_t)trigram[0] << 16) |
+                         ((uint32_t)(uint8_t)trigram[1] <<  8) |
+                          (uint32_t)(uint8_t)trigram[2];
+    return (key * 2654435761u) >> (32 - m_bucket_bits);
+}
+
+void
+RegularExpressionIndex::Append (uint32_t id, const char *cstr)
+{
+    if (cstr == NULL || m_buckets.empty())
+        return;
+
+    const size_t len = strlen (cstr);
+    for (size_t i = 0; i + 3 <= len; ++i)
+    {
+        Bucket &bucket = m_buckets[GetBucketIndex (cstr + i)];
+        // Only record each string once per bucket
+        if (bucket.count > 0 && bucket.last_id == id)
+            continue;
+        uint32_t delta = bucket.count > 0 ? id - bucket.last_id : id;
+        // ULEB128 encode the delta from the previous ID in this bucket
+        do
+        {
+            uint8_t byte = delta & 0x7f;
+            delta >>= 7;
+            if (delta)
+                byte |= 0x80;
+            bucket.deltas.push_back (byte);
+        } while (delta);
+        bucket.last_id = id;
+        ++bucket.count;
+    }
+}
+
+void
+RegularExpressionIndex::Finalize ()
+{
+    const size_t num_buckets = m_buckets.size();
+    for (size_t i = 0; i < num_buckets; ++i)
+    {
+        std::vector<uint8_t> &deltas = m_buckets[i].deltas;
+        if (deltas.size() < deltas.capacity())
+        {
+            std::vector<uint8_t> temp (deltas.begin(), deltas.end());
+            deltas.swap (temp);
+        }
+    }
+}
+
+namespace {
+
+// Decodes the IDs of a bucket one at a time.
+class BucketIterator
+{
+public:
+    BucketIterator (const std::vector<uint8_t> &deltas) :
+        m_pos (deltas.empty() ? NULL : &deltas[0]),
+        m_end (m_pos + deltas.size()),
+        m_id (0)
+    {
+    }
+
+    bool
+    Next (uint32_t &id)
+    {
+        if (m_pos >= m_end)
+            return false;
+        uint32_t delta = 0;
+        uint32_t shift = 0;
+        while (m_pos < m_end)
+        {
+            const uint8_t byte = *m_pos++;
+            delta |= (uint32_t)(byte & 0x7f) << shift;
+            shift += 7;
+            if ((byte & 0x80) == 0)
+                break;
+        }
+        m_id += delta;
+        id = m_id;
+        return true;
+    }
+
+private:
+    const uint8_t *m_pos;
+    const uint8_t *m_end;
+    uint32_t m_id;
+};
+
+}
+
+bool
+RegularExpressionIndex::FindCandidates (const RegularExpression &regex, std::vector<uint32_t> &ids) const
+{
+    ids.clear();
+    if (m_buckets.empty())
+        return false;
+
+    std::string literal;
+    if (!regex.GetRequiredLiteral (literal) || literal.size() < 3)
+        return false;
+
+    // Collect the buckets for every trigram in the literal, fewest
+    // strings first.
+    std::vector<std::pair<uint32_t, uint32_t> > buckets;
+    for (size_t i = 0; i + 3 <= literal.size(); ++i)
+    {
+        const uint32_t bucket_idx = GetBucketIndex (literal.c_str() + i);
+        buckets.push_back (std::make_pair (m_buckets[bucket_idx].count, bucket_idx));
+    }
+    std::sort (buckets.begin(), buckets.end());
+    buckets.erase (std::unique (buckets.begin(), buckets.end()), buckets.end());
+
+    uint32_t id;
+    BucketIterator first (m_buckets[buckets[0].second].deltas);
+    ids.reserve (buckets[0].first);
+    while (first.Next (id))
+        ids.push_back (id);
+
+    // Narrow things down with the other buckets while decoding them is
+    // cheaper than running the regular expression on the candidates.
+    for (size_t i = 1; i < buckets.size() && !ids.empty(); ++i)
+    {
+        if (buckets[i].first / 32 > ids.size())
+            break;
+        BucketIterator pos (m_buckets[buckets[i].second].deltas);
+        size_t num_kept = 0;
+        size_t ids_idx = 0;
+        bool have_id = pos.Next (id);
+        while (have_id && ids_idx < ids.size())
+        {
+            if (id < ids[ids_idx])
+                have_id = pos.Next (id);
+            else
+            {
+                if (id == ids[ids_idx])
+                    ids[num_kept++] = id;
+                ++ids_idx;
+            }
+        }
+        ids.resize (num_kept);
+    }
+    return true;
+}
@@ -10,23 +10,174 @@
 #include "lldb/Core/SourceManager.h"
 
 // C Includes
+#include <string.h>
+#if defined (__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 // C++ Includes
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/DataBuffer.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Stream.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Symbol/ClangNamespaceDecl.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb_private;
 
+// How many files the debugger's source file cache holds on to
+static const size_t k_max_cached_source_files = 64;
+
+// When we get notified of changes to a file we still stat it this often in
+// case it lives on a file system (like NFS) where notifications don't see
+// changes made by other hosts.
+static const uint64_t k_source_file_stat_interval_nsec = 1000000000ull;
+
 static inline bool is_newline_char(char ch)
 {
     return ch == '\n' || ch == '\r';
 }
 
+#if defined (__linux__)
+
+//----------------------------------------------------------------------
+// Watches source files with inotify so we don't have to stat every file
+// each time we display some of its lines. Every event on a watch bumps
+// its generation, and files compare the generation they last saw.
+//----------------------------------------------------------------------
+class SourceFileWatcher
+{
+public:
+    static SourceFileWatcher &
+    GetWatcher ()
+    {
+        static SourceFileWatcher g_watcher;
+        return g_watcher;
+    }
+
+    int
+    AddWatch (const FileSpec &file_spec, uint32_t &generation)
+    {
+        Mutex::Locker locker (m_mutex);
+        if (m_fd < 0)
+            return -1;
+        char path[PATH_MAX];
+        if (file_spec.GetPath (path, sizeof(path)) == 0)
+            return -1;
+        const int wd = ::inotify_add_watch (m_fd, path, IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+        if (wd < 0)
+            return -1;
+        // Watching the same inode again hands back the same descriptor
+        Watch &watch = m_watches[wd];
+        ++watch.ref_count;
+        generation = watch.generation;
+        return wd;
+    }
+
+    void
+    RemoveWatch (int wd)
+    {
+        Mutex::Locker locker (m_mutex);
+        WatchMap::iterator pos = m_watches.find (wd);
+        if (pos != m_watches.end() && --pos->second.ref_count == 0)
+        {
+            ::inotify_rm_watch (m_fd, wd);
+            m_watches.erase (pos);
+        }
+    }
+
+    // Returns true if the file watched by "wd" may have changed since
+    // "generation", and updates "generation".
+    bool
+    FileChanged (int wd, uint32_t &generation)
+    {
+        Mutex::Locker locker (m_mutex);
+        ReadEvents ();
+        WatchMap::const_iterator pos = m_watches.find (wd);
+        if (pos == m_watches.end())
+            return true;
+        if (pos->second.generation == generation)
+            return false;
+        generation = pos->second.generation;
+        return true;
+    }
+
+private:
+    struct Watch
+    {
+        Watch () : ref_count (0), generation (0) {}
+        uint32_t ref_count;
+        uint32_t generation;
+    };
+    typedef std::map<int, Watch> WatchMap;
+
+    SourceFileWatcher () :
+        m_mutex (Mutex::eMutexTypeNormal),
+        m_fd (::inotify_init1 (IN_NONBLOCK | IN_CLOEXEC)),
+        m_watches ()
+    {
+    }
+
+    ~SourceFileWatcher ()
+    {
+        if (m_fd >= 0)
+            ::close (m_fd);
+    }
+
+    // Drain all pending events without blocking. Must be called with
+    // m_mutex locked.
+    void
+    ReadEvents ()
+    {
+        if (m_fd < 0)
+            return;
+        union
+        {
+            struct inotify_event event;
+            char bytes[4096];
+        } buf;
+        for (;;)
+        {
+            const ssize_t len = ::read (m_fd, buf.bytes, sizeof(buf.bytes));
+            if (len <= 0)
+                break;
+            for (ssize_t pos = 0; pos + (ssize_t)sizeof(struct inotify_event) <= len; )
+            {
+                const struct inotify_event *event = (const struct inotify_event *)(buf.bytes + pos);
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    // We lost events, so assume everything changed
+                    for (WatchMap::iterator wpos = m_watches.begin(); wpos != m_watches.end(); ++wpos)
+                        ++wpos->second.generation;
+                }
+                else
+                {
+                    WatchMap::iterator wpos = m_watches.find (event->wd);
+                    if (wpos != m_watches.end())
+                    {
+                        // The kernel drops the watch when the file goes away
+                        if (event->mask & IN_IGNORED)
+                            m_watches.erase (wpos);
+                        else
+                            ++wpos->second.generation;
+                    }
+                }
+                pos += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+
+    Mutex m_mutex;
+    int m_fd;
+    WatchMap m_watches;
+};
+
+#endif // #if defined (__linux__)
+
 
 //----------------------------------------------------------------------
 // SourceManager constructor
@@ -84,14 +235,28 @@ SourceManager::DisplaySourceLines
 SourceManager::FileSP
 SourceManager::GetFile (const FileSpec &file_spec)
 {
+    // The cache is shared by all targets, so look the file up by the path
+    // this target's source map turns it into, the same way File does.
+    FileSpec cache_file_spec (file_spec);
+    if (m_target && file_spec.GetDirectory() && !file_spec.Exists())
+    {
+        ConstString new_path;
+        if (m_target->GetSourcePathMap().RemapPath(file_spec.GetDirectory(), new_path))
+        {
+            char resolved_path[PATH_MAX];
+            ::snprintf(resolved_path, PATH_MAX, "%s/%s", new_path.AsCString(), file_spec.GetFilename().AsCString());
+            cache_file_spec.SetFile (resolved_path, true);
+        }
+    }
+
     FileSP file_sp;
-    file_sp = m_debugger->GetSourceFileCache().FindSourceFile (file_spec);
+    file_sp = m_debugger->GetSourceFileCache().FindSourceFile (cache_file_spec);
     // If file_sp is no good or it points to a non-existent file, reset it.
     if (!file_sp || !file_sp->GetFileSpec().Exists())
     {
         file_sp.reset (new File (file_spec, m_target));
 
-        m_debugger->GetSourceFileCache().AddSourceFile(file_sp);
+        m_debugger->GetSourceFileCache().AddSourceFile(cache_file_spec, file_sp);
     }
     return file_sp;
 }
@@ -287,6 +452,9 @@ SourceManager::File::File(const FileSpec &file_spec, Target *target) :
     m_file_spec_orig (file_spec),
     m_file_spec(file_spec),
     m_mod_time (file_spec.GetModificationTime()),
+    m_check_time (),
+    m_watch_descriptor (-1),
+    m_watch_generation (0),
     m_data_sp(),
     m_offsets()
 {
@@ -353,11 +521,62 @@ SourceManager::File::File(const FileSpec &file_spec, Target *target) :
     }
     
     if (m_mod_time.IsValid())
-        m_data_sp = m_file_spec.ReadFileContents ();
+        ReadFileContents ();
 }
 
 SourceManager::File::~File()
 {
+#if defined (__linux__)
+    if (m_watch_descriptor >= 0)
+        SourceFileWatcher::GetWatcher().RemoveWatch (m_watch_descriptor);
+#endif
+}
+
+void
+SourceManager::File::ReadFileContents ()
+{
+#if defined (__linux__)
+    // Start watching before reading so we can't miss a change made
+    // while we read.  The file may be a new inode after a change, so
+    // always set up a new watch.
+    SourceFileWatcher &watcher = SourceFileWatcher::GetWatcher();
+    if (m_watch_descriptor >= 0)
+        watcher.RemoveWatch (m_watch_descriptor);
+    m_watch_descriptor = watcher.AddWatch (m_file_spec, m_watch_generation);
+#endif
+    m_check_time = TimeValue::Now();
+
+    // Always read the file into the heap. The user may edit or truncate
+    // the file while we hold on to it, and touching a truncated mapping
+    // would crash us with SIGBUS.
+    m_offsets.clear();
+    m_data_sp = m_file_spec.ReadFileContents ();
+}
+
+void
+SourceManager::File::UpdateIfNeeded ()
+{
+#if defined (__linux__)
+    if (m_watch_descriptor >= 0)
+    {
+        // Nothing has touched the file since we read it, don't bother
+        // with a stat unless it has been a while since the last one.
+        if (!SourceFileWatcher::GetWatcher().FileChanged (m_watch_descriptor, m_watch_generation))
+        {
+            TimeValue now (TimeValue::Now());
+            if (m_check_time.IsValid() && now - m_check_time < k_source_file_stat_interval_nsec)
+                return;
+        }
+    }
+#endif
+    m_check_time = TimeValue::Now();
+
+    TimeValue curr_mod_time (m_file_spec.GetModificationTime());
+    if (curr_mod_time.IsValid() && m_mod_time != curr_mod_time)
+    {
+        m_mod_time = curr_mod_time;
+        ReadFileContents ();
+    }
 }
 
 uint32_t
@@ -391,17 +610,7 @@ SourceManager::File::LineIsValid (uint32_t line)
 size_t
 SourceManager::File::DisplaySourceLines (uint32_t line, uint32_t context_before, uint32_t context_after, Stream *s)
 {
-    // TODO: use host API to sign up for file modifications to anything in our
-    // source cache and only update when we determine a file has been updated.
-    // For now we check each time we want to display info for the file.
-    TimeValue curr_mod_time (m_file_spec.GetModificationTime());
-
-    if (curr_mod_time.IsValid() && m_mod_time != curr_mod_time)
-    {
-        m_mod_time = curr_mod_time;
-        m_data_sp = m_file_spec.ReadFileContents ();
-        m_offsets.clear();
-    }
+    UpdateIfNeeded ();
 
     // Sanity check m_data_sp before proceeding.
     if (!m_data_sp)
@@ -434,13 +643,7 @@ SourceManager::File::DisplaySourceLines (uint32_t line, uint32_t context_before,
 void
 SourceManager::File::FindLinesMatchingRegex (RegularExpression& regex, uint32_t start_line, uint32_t end_line, std::vector<uint32_t> &match_lines)
 {
-    TimeValue curr_mod_time (m_file_spec.GetModificationTime());
-    if (m_mod_time != curr_mod_time)
-    {
-        m_mod_time = curr_mod_time;
-        m_data_sp = m_file_spec.ReadFileContents ();
-        m_offsets.clear();
-    }
+    UpdateIfNeeded ();
     
     match_lines.clear();
     
@@ -512,19 +715,37 @@ SourceManager::File::CalculateLineOffsets (uint32_t line)
 
                 // Push a 1 at index zero to indicate the file has been completely indexed.
                 m_offsets.push_back(UINT32_MAX);
-                register const char *s;
-                for (s = start; s < end; ++s)
+                if (::memchr (start, '\r', end - start) == NULL)
                 {
-                    register char curr_ch = *s;
-                    if (is_newline_char (curr_ch))
+                    // Only '\n' line endings, so let memchr (which the C
+                    // library vectorizes) find each one.
+                    const char *s = start;
+                    while ((s = (const char *)::memchr (s, '\n', end - s)) != NULL)
                     {
-                        register char next_ch = s[1];
-                        if (is_newline_char (next_ch))
+                        ++s;
+                        m_offsets.push_back(s - start);
+                    }
+                }
+                else
+                {
+                    register const char *s;
+                    for (s = start; s < end; ++s)
+                    {
+                        register char curr_ch = *s;
+                        if (is_newline_char (curr_ch))
                         {
-                            if (curr_ch != next_ch)
-                                ++s;
+                            // Don't read past the end of the data
+                            if (s + 1 < end)
+                            {
+                                register char next_ch = s[1];
+                                if (is_newline_char (next_ch))
+                                {
+                                    if (curr_ch != next_ch)
+                                        ++s;
+                                }
+                            }
+                            m_offsets.push_back(s + 1 - start);
                         }
-                        m_offsets.push_back(s + 1 - start);
                     }
                 }
                 if (!m_offsets.empty())
@@ -568,26 +789,39 @@ SourceManager::File::GetLine (uint32_t line_no, std::string &buffer)
 }
 
 void 
-SourceManager::SourceFileCache::AddSourceFile (const FileSP &file_sp)
+SourceManager::SourceFileCache::AddSourceFile (const FileSpec &file_spec, const FileSP &file_sp)
 {
-    FileSpec file_spec;
+    Mutex::Locker locker (m_mutex);
     FileCache::iterator pos = m_file_cache.find(file_spec);
-    if (pos == m_file_cache.end())
-        m_file_cache[file_spec] = file_sp;
-    else
+    if (pos != m_file_cache.end())
+    {
+        m_file_list.erase (pos->second);
+        m_file_cache.erase (pos);
+    }
+
+    m_file_list.push_front (std::make_pair (file_spec, file_sp));
+    m_file_cache[file_spec] = m_file_list.begin();
+
+    // Drop the least recently used files.  Anyone still displaying one
+    // keeps it alive through their own shared pointer.
+    while (m_file_list.size() > k_max_cached_source_files)
     {
-        if (file_sp != pos->second)
-            m_file_cache[file_spec] = file_sp;
+        m_file_cache.erase (m_file_list.back().first);
+        m_file_list.pop_back();
     }
 }
 
 SourceManager::FileSP 
-SourceManager::SourceFileCache::FindSourceFile (const FileSpec &file_spec) const
+SourceManager::SourceFileCache::FindSourceFile (const FileSpec &file_spec)
 {
+    Mutex::Locker locker (m_mutex);
     FileSP file_sp;
-    FileCache::const_iterator pos = m_file_cache.find(file_spec);
+    FileCache::iterator pos = m_file_cache.find(file_spec);
     if (pos != m_file_cache.end())
-        file_sp = pos->second;
+    {
+        file_sp = pos->second->second;
+        // Move it to the front as the most recently used
+        m_file_list.splice (m_file_list.begin(), m_file_list, pos->second);
+    }
     return file_sp;
 }
-
@@ -20,29 +20,30 @@
 
 namespace lldb_private {
 
-UUID::UUID()
+UUID::UUID() : m_num_uuid_bytes(16)
 {
     ::memset (m_uuid, 0, sizeof(m_uuid));
 }
 
 UUID::UUID(const UUID& rhs)
 {
+    m_num_uuid_bytes = rhs.m_num_uuid_bytes;
     ::memcpy (m_uuid, rhs.m_uuid, sizeof (m_uuid));
 }
 
 UUID::UUID (const void *uuid_bytes, uint32_t num_uuid_bytes)
 {
-    if (uuid_bytes && num_uuid_bytes >= 16)
-        ::memcpy (m_uuid, uuid_bytes, sizeof (m_uuid));
-    else
-        ::memset (m_uuid, 0, sizeof(m_uuid));
+    SetBytes (uuid_bytes, num_uuid_bytes);
 }
 
 const UUID&
 UUID::operator=(const UUID& rhs)
 {
     if (this != &rhs)
+    {
+        m_num_uuid_bytes = rhs.m_num_uuid_bytes;
         ::memcpy (m_uuid, rhs.m_uuid, sizeof (m_uuid));
+    }
     return *this;
 }
 
@@ -53,6 +54,7 @@ UUID::~UUID()
 void
 UUID::Clear()
 {
+    m_num_uuid_bytes = 16;
     ::memset (m_uuid, 0, sizeof(m_uuid));
 }
 
@@ -66,53 +68,51 @@ char *
 UUID::GetAsCString (char *dst, size_t dst_len) const
 {
     const uint8_t *u = (const uint8_t *)GetBytes();
-    snprintf(dst, dst_len, "%2.2X%2.2X%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X",
-             u[0],u[1],u[2],u[3],u[4],u[5],u[6],u[7],u[8],u[9],u[10],u[11],u[12],u[13],u[14],u[15]);
+    if (m_num_uuid_bytes == 20)
+        snprintf(dst, dst_len, "%2.2X%2.2X%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X-%2.2X%2.2X%2.2X%2.2X",
+                 u[0],u[1],u[2],u[3],u[4],u[5],u[6],u[7],u[8],u[9],u[10],u[11],u[12],u[13],u[14],u[15],u[16],u[17],u[18],u[19]);
+    else
+        snprintf(dst, dst_len, "%2.2X%2.2X%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X",
+                 u[0],u[1],u[2],u[3],u[4],u[5],u[6],u[7],u[8],u[9],u[10],u[11],u[12],u[13],u[14],u[15]);
     return dst;
 }
 
 void
 UUID::Dump (Stream *s) const
 {
-    const uint8_t *u = (const uint8_t *)GetBytes();
-    s->Printf ("%2.2X%2.2X%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X-%2.2X%2.2X%2.2X%2.2X%2.2X%2.2X",
-              u[0],u[1],u[2],u[3],u[4],u[5],u[6],u[7],u[8],u[9],u[10],u[11],u[12],u[13],u[14],u[15]);
+    char uuid_cstr[64];
+    s->PutCString (GetAsCString (uuid_cstr, sizeof(uuid_cstr)));
 }
 
-void
-UUID::SetBytes (const void *uuid_bytes)
+bool
+UUID::SetBytes (const void *uuid_bytes, uint32_t num_uuid_bytes)
 {
-    if (uuid_bytes)
-        ::memcpy (m_uuid, uuid_bytes, sizeof (m_uuid));
-    else
-        ::memset (m_uuid, 0, sizeof(m_uuid));
+    ::memset (m_uuid, 0, sizeof(m_uuid));
+    if (uuid_bytes && (num_uuid_bytes == 16 || num_uuid_bytes == 20))
+    {
+        m_num_uuid_bytes = num_uuid_bytes;
+        ::memcpy (m_uuid, uuid_bytes, num_uuid_bytes);
+        return true;
+    }
+    m_num_uuid_bytes = 16;
+    return false;
 }
 
 size_t
-UUID::GetByteSize()
+UUID::GetByteSize() const
 {
-    return sizeof(UUID::ValueType);
+    return m_num_uuid_bytes;
 }
 
 bool
 UUID::IsValid () const
 {
-    return  m_uuid[0]  ||
-            m_uuid[1]  ||
-            m_uuid[2]  ||
-            m_uuid[3]  ||
-            m_uuid[4]  ||
-            m_uuid[5]  ||
-            m_uuid[6]  ||
-            m_uuid[7]  ||
-            m_uuid[8]  ||
-            m_uuid[9]  ||
-            m_uuid[10] ||
-            m_uuid[11] ||
-            m_uuid[12] ||
-            m_uuid[13] ||
-            m_uuid[14] ||
-            m_uuid[15];
+    for (uint32_t i = 0; i < m_num_uuid_bytes; ++i)
+    {
+        if (m_uuid[i])
+            return true;
+    }
+    return false;
 }
 
 static inline int
@@ -125,11 +125,14 @@ xdigit_to_int (char ch)
 }
 
 size_t
-UUID::SetfromCString (const char *cstr)
+UUID::SetfromCString (const char *cstr, uint32_t num_uuid_bytes)
 {
     if (cstr == NULL)
         return 0;
 
+    if (num_uuid_bytes != 16 && num_uuid_bytes != 20)
+        return 0;
+
     uint32_t uuid_byte_idx = 0;
     const char *p = cstr;
 
@@ -152,7 +155,7 @@ UUID::SetfromCString (const char *cstr)
 
             // Increment the byte that we are decoding within the UUID value
             // and break out if we are done
-            if (++uuid_byte_idx == 16)
+            if (++uuid_byte_idx == num_uuid_bytes)
                 break;
         }
         else if (*p == '-')
@@ -168,8 +171,12 @@ UUID::SetfromCString (const char *cstr)
     }
     // If we successfully decoded a UUID, return the amount of characters that
     // were consumed
-    if (uuid_byte_idx == 16)
+    if (uuid_byte_idx == num_uuid_bytes)
+    {
+        m_num_uuid_bytes = num_uuid_bytes;
+        ::memset (m_uuid + num_uuid_bytes, 0, sizeof(m_uuid) - num_uuid_bytes);
         return p - cstr;
+    }
 
     // Else return zero to indicate we were not able to parse a UUID value
     return 0;
@@ -180,35 +187,35 @@ UUID::SetfromCString (const char *cstr)
 bool
 lldb_private::operator == (const lldb_private::UUID &lhs, const lldb_private::UUID &rhs)
 {
-    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), lldb_private::UUID::GetByteSize()) == 0;
+    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), sizeof (lldb_private::UUID::ValueType)) == 0;
 }
 
 bool
 lldb_private::operator != (const lldb_private::UUID &lhs, const lldb_private::UUID &rhs)
 {
-    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), lldb_private::UUID::GetByteSize()) != 0;
+    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), sizeof (lldb_private::UUID::ValueType)) != 0;
 }
 
 bool
 lldb_private::operator <  (const lldb_private::UUID &lhs, const lldb_private::UUID &rhs)
 {
-    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), lldb_private::UUID::GetByteSize()) <  0;
+    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), sizeof (lldb_private::UUID::ValueType)) <  0;
 }
 
 bool
 lldb_private::operator <= (const lldb_private::UUID &lhs, const lldb_private::UUID &rhs)
 {
-    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), lldb_private::UUID::GetByteSize()) <= 0;
+    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), sizeof (lldb_private::UUID::ValueType)) <= 0;
 }
 
 bool
 lldb_private::operator >  (const lldb_private::UUID &lhs, const lldb_private::UUID &rhs)
 {
-    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), lldb_private::UUID::GetByteSize()) >  0;
+    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), sizeof (lldb_private::UUID::ValueType)) >  0;
 }
 
 bool
 lldb_private::operator >= (const lldb_private::UUID &lhs, const lldb_private::UUID &rhs)
 {
-    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), lldb_private::UUID::GetByteSize()) >= 0;
+    return ::memcmp (lhs.GetBytes(), rhs.GetBytes(), sizeof (lldb_private::UUID::ValueType)) >= 0;
 }
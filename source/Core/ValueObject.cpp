@@ -13,6 +13,8 @@
 #include <stdlib.h>
 
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 #include "llvm/Support/raw_ostream.h"
 #include "clang/AST/Type.h"
@@ -73,6 +75,7 @@ ValueObject::ValueObject (ValueObject &parent) :
     m_object_desc_str (),
     m_manager(parent.GetManager()),
     m_children (),
+    m_synthetic_array_members (),
     m_synthetic_children (),
     m_dynamic_value (NULL),
     m_synthetic_value(NULL),
@@ -119,6 +122,7 @@ ValueObject::ValueObject (ExecutionContextScope *exe_scope,
     m_object_desc_str (),
     m_manager(),
     m_children (),
+    m_synthetic_array_members (),
     m_synthetic_children (),
     m_dynamic_value (NULL),
     m_synthetic_value(NULL),
@@ -401,15 +405,22 @@ ValueObject::GetChildAtIndex (uint32_t idx, bool can_create)
     if (idx < GetNumChildren())
     {
         // Check if we have already made the child value object?
-        if (can_create && m_children[idx] == NULL)
+        ValueObject *child = m_children.GetChildAtIndex (idx);
+        if (can_create && child == NULL)
         {
+            // The first child made in a page of array elements brings the
+            // memory for the whole page in with it
+            if (!m_children.HasPageForIndex (idx))
+                PrefetchChildrenPage (idx, false);
+
             // No we haven't created the child at this index, so lets have our
             // subclass do it and cache the result for quick future access.
-            m_children[idx] = CreateChildAtIndex (idx, false, 0);
+            child = CreateChildAtIndex (idx, false, 0);
+            m_children.SetChildAtIndex (idx, child);
         }
         
-        if (m_children[idx] != NULL)
-            return m_children[idx]->GetSP();
+        if (child != NULL)
+            return child->GetSP();
     }
     return child_sp;
 }
@@ -476,13 +487,99 @@ ValueObject::GetNumChildren ()
     {
         SetNumChildren (CalculateNumChildren());
     }
-    return m_children.size();
+    return m_children.GetCount();
 }
 void
 ValueObject::SetNumChildren (uint32_t num_children)
 {
     m_children_count_valid = true;
-    m_children.resize(num_children);
+    m_children.SetCount(num_children);
+}
+
+void
+ValueObject::ChildrenPages::SetCount (uint32_t count)
+{
+    m_count = count;
+    
+    const uint32_t first_unused_page = (count + kPageSize - 1) / kPageSize;
+    m_pages.erase (m_pages.lower_bound (first_unused_page), m_pages.end());
+
+    // Clear the slots past the end of a partially used last page
+    if (count % kPageSize)
+    {
+        PageMap::iterator pos = m_pages.find (count / kPageSize);
+        if (pos != m_pages.end())
+            std::fill (pos->second.begin() + count % kPageSize, pos->second.end(), (ValueObject *)NULL);
+    }
+}
+
+ValueObject *
+ValueObject::ChildrenPages::GetChildAtIndex (uint32_t idx) const
+{
+    PageMap::const_iterator pos = m_pages.find (idx / kPageSize);
+    if (pos == m_pages.end())
+        return NULL;
+    return pos->second[idx % kPageSize];
+}
+
+void
+ValueObject::ChildrenPages::SetChildAtIndex (uint32_t idx, ValueObject *valobj)
+{
+    PageMap::iterator pos = m_pages.find (idx / kPageSize);
+    if (pos == m_pages.end())
+    {
+        if (valobj == NULL)
+            return;
+        pos = m_pages.insert (PageMap::value_type (idx / kPageSize, std::vector<ValueObject *>())).first;
+        pos->second.resize (kPageSize, NULL);
+    }
+    pos->second[idx % kPageSize] = valobj;
+}
+
+void
+ValueObject::PrefetchChildrenPage (uint32_t idx, bool synthetic_array_member)
+{
+    // Don't let one page of very large elements turn into a huge read
+    static const size_t g_max_prefetch_byte_size = 32 * 1024;
+
+    lldb::ProcessSP process_sp(m_update_point.GetProcessSP());
+    if (!process_sp || !process_sp->IsAlive())
+        return;
+
+    clang_type_t clang_type = GetClangType();
+    clang_type_t element_type = NULL;
+    const Flags type_flags (ClangASTContext::GetTypeInfo (clang_type, GetClangAST(), &element_type));
+    if (element_type == NULL)
+        return;
+
+    addr_t base_addr = LLDB_INVALID_ADDRESS;
+    AddressType address_type = eAddressTypeInvalid;
+    if (type_flags.Test (ClangASTContext::eTypeIsArray))
+    {
+        base_addr = GetAddressOf (true, &address_type);
+    }
+    else if (synthetic_array_member && type_flags.Test (ClangASTContext::eTypeIsPointer))
+    {
+        base_addr = GetPointerValue (&address_type);
+    }
+    if (base_addr == 0 || base_addr == LLDB_INVALID_ADDRESS || address_type != eAddressTypeLoad)
+        return;
+
+    const uint64_t element_size = ClangASTType::GetTypeByteSize (GetClangAST(), element_type);
+    if (element_size == 0)
+        return;
+
+    const uint32_t first_idx = idx - (idx % ChildrenPages::kPageSize);
+    uint64_t page_count = ChildrenPages::kPageSize;
+    if (!synthetic_array_member && first_idx + page_count > m_children.GetCount())
+        page_count = m_children.GetCount() - first_idx;
+
+    uint64_t byte_size = page_count * element_size;
+    if (byte_size > g_max_prefetch_byte_size)
+        byte_size = g_max_prefetch_byte_size;
+
+    Error error;
+    process_sp->PrefetchMemory (base_addr + first_idx * element_size, byte_size, error);
 }
 
 void
@@ -1543,6 +1640,38 @@ ValueObject::AddSyntheticChild (const ConstString &key, ValueObject *valobj)
     m_synthetic_children[key] = valobj;
 }
 
+// Non-negative array members live in the paged store, so looking one up
+// doesn't have to build and unique its "[N]" name first
+void
+ValueObject::AddSyntheticArrayMember (int32_t index, ValueObject *valobj)
+{
+    if (index >= 0)
+    {
+        m_synthetic_array_members.SetChildAtIndex (index, valobj);
+    }
+    else
+    {
+        char index_str[64];
+        snprintf(index_str, sizeof(index_str), "[%i]", index);
+        AddSyntheticChild (ConstString(index_str), valobj);
+    }
+}
+
+ValueObjectSP
+ValueObject::GetSyntheticArrayMemberIfCreated (int32_t index) const
+{
+    if (index >= 0)
+    {
+        ValueObject *valobj = m_synthetic_array_members.GetChildAtIndex (index);
+        if (valobj)
+            return valobj->GetSP();
+        return ValueObjectSP();
+    }
+    char index_str[64];
+    snprintf(index_str, sizeof(index_str), "[%i]", index);
+    return GetSyntheticChild (ConstString(index_str));
+}
+
 ValueObjectSP
 ValueObject::GetSyntheticChild (const ConstString &key) const
 {
@@ -1614,15 +1743,16 @@ ValueObject::GetSyntheticArrayMemberFromPointer (int32_t index, bool can_create)
     ValueObjectSP synthetic_child_sp;
     if (IsPointerType ())
     {
-        char index_str[64];
-        snprintf(index_str, sizeof(index_str), "[%i]", index);
-        ConstString index_const_str(index_str);
         // Check if we have already created a synthetic array member in this
         // valid object. If we have we will re-use it.
-        synthetic_child_sp = GetSyntheticChild (index_const_str);
+        synthetic_child_sp = GetSyntheticArrayMemberIfCreated (index);
         if (!synthetic_child_sp)
         {
+            char index_str[64];
+            snprintf(index_str, sizeof(index_str), "[%i]", index);
             ValueObject *synthetic_child;
+            if (index >= 0 && !m_synthetic_array_members.HasPageForIndex (index))
+                PrefetchChildrenPage (index, true);
             // We haven't made a synthetic array member for INDEX yet, so
             // lets make one and cache it for any future reference.
             synthetic_child = CreateChildAtIndex(0, true, index);
@@ -1630,7 +1760,7 @@ ValueObject::GetSyntheticArrayMemberFromPointer (int32_t index, bool can_create)
             // Cache the value if we got one back...
             if (synthetic_child)
             {
-                AddSyntheticChild(index_const_str, synthetic_child);
+                AddSyntheticArrayMember(index, synthetic_child);
                 synthetic_child_sp = synthetic_child->GetSP();
                 synthetic_child_sp->SetName(ConstString(index_str));
                 synthetic_child_sp->m_is_array_item_for_pointer = true;
@@ -1657,15 +1787,16 @@ ValueObject::GetSyntheticArrayMemberFromArray (int32_t index, bool can_create)
     ValueObjectSP synthetic_child_sp;
     if (IsArrayType ())
     {
-        char index_str[64];
-        snprintf(index_str, sizeof(index_str), "[%i]", index);
-        ConstString index_const_str(index_str);
         // Check if we have already created a synthetic array member in this
         // valid object. If we have we will re-use it.
-        synthetic_child_sp = GetSyntheticChild (index_const_str);
+        synthetic_child_sp = GetSyntheticArrayMemberIfCreated (index);
         if (!synthetic_child_sp)
         {
+            char index_str[64];
+            snprintf(index_str, sizeof(index_str), "[%i]", index);
             ValueObject *synthetic_child;
+            if (index >= 0 && !m_synthetic_array_members.HasPageForIndex (index))
+                PrefetchChildrenPage (index, true);
             // We haven't made a synthetic array member for INDEX yet, so
             // lets make one and cache it for any future reference.
             synthetic_child = CreateChildAtIndex(0, true, index);
@@ -1673,7 +1804,7 @@ ValueObject::GetSyntheticArrayMemberFromArray (int32_t index, bool can_create)
             // Cache the value if we got one back...
             if (synthetic_child)
             {
-                AddSyntheticChild(index_const_str, synthetic_child);
+                AddSyntheticArrayMember(index, synthetic_child);
                 synthetic_child_sp = synthetic_child->GetSP();
                 synthetic_child_sp->SetName(ConstString(index_str));
                 synthetic_child_sp->m_is_array_item_for_pointer = true;
@@ -164,6 +164,8 @@ ClangASTSource::CompleteType (TagDecl *tag_decl)
         dumper.ToLog(log, "      [CTD] ");
     }
     
+    ++m_num_completed_types;
+    
     if (!m_ast_importer->CompleteTagDecl (tag_decl))
     {
         // We couldn't complete the type.  Maybe there's a definition
@@ -292,6 +294,8 @@ ClangASTSource::CompleteType (clang::ObjCInterfaceDecl *interface_decl)
         dumper.ToLog(log, "      [COID] ");    
     }
     
+    ++m_num_completed_types;
+    
     m_ast_importer->CompleteObjCInterfaceDecl (interface_decl);
     
     if (log)
@@ -137,6 +137,83 @@ ClangExpressionDeclMap::DidParse()
     }
 }
 
+bool
+ClangExpressionDeclMap::CanReuse ()
+{
+    assert (m_struct_vars.get());
+
+    if (!m_parser_vars.get() || !m_struct_vars->m_struct_laid_out)
+        return false;
+
+    for (size_t member_index = 0, num_members = m_struct_members.GetSize();
+         member_index < num_members;
+         ++member_index)
+    {
+        ClangExpressionVariableSP member_sp(m_struct_members.GetVariableAtIndex(member_index));
+
+        if (!m_found_entities.ContainsVariable(member_sp) &&
+            member_sp->GetName() != m_struct_vars->m_result_name)
+            return false;
+    }
+
+    return true;
+}
+
+bool
+ClangExpressionDeclMap::WillReuse (ExecutionContext &exe_ctx)
+{
+    if (!CanReuse())
+        return false;
+
+    lldb::LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+
+    m_parser_vars->m_exe_ctx = &exe_ctx;
+
+    if (!m_struct_vars->m_result_name)
+        return true;
+
+    ClangExpressionVariableSP result_sp(m_struct_members.GetVariable(m_struct_vars->m_result_name));
+
+    // Expressions without a result have nothing else to set up
+    if (!result_sp)
+        return true;
+
+    if (!result_sp->m_jit_vars.get() ||
+        !m_parser_vars->m_persistent_vars ||
+        !m_parser_vars->m_target_info.IsValid())
+        return false;
+
+    ConstString new_result_name (m_parser_vars->m_persistent_vars->GetNextPersistentVariableName());
+
+    ClangExpressionVariableSP new_result_sp(m_parser_vars->m_persistent_vars->CreatePersistentVariable (exe_ctx.GetBestExecutionContextScope (),
+                                                                                                        new_result_name,
+                                                                                                        result_sp->GetTypeFromUser(),
+                                                                                                        m_parser_vars->m_target_info.byte_order,
+                                                                                                        m_parser_vars->m_target_info.address_byte_size));
+
+    if (!new_result_sp)
+        return false;
+
+    new_result_sp->m_flags = m_struct_vars->m_result_flags;
+
+    new_result_sp->EnableJITVars();
+    new_result_sp->m_jit_vars->m_alignment = result_sp->m_jit_vars->m_alignment;
+    new_result_sp->m_jit_vars->m_size = result_sp->m_jit_vars->m_size;
+    new_result_sp->m_jit_vars->m_offset = result_sp->m_jit_vars->m_offset;
+
+    if (!m_struct_members.ReplaceVariable(result_sp, new_result_sp))
+        return false;
+
+    m_struct_vars->m_result_name = new_result_name;
+
+    if (log)
+        log->Printf("Reusing the struct with result %s in place of %s",
+                    new_result_name.GetCString(),
+                    result_sp->GetName().GetCString());
+
+    return true;
+}
+
 // Interface for IRForTarget
 
 ClangExpressionDeclMap::TargetInfo 
@@ -495,7 +572,10 @@ ClangExpressionDeclMap::AddPersistentVariable
         var_sp->m_flags |= ClangExpressionVariable::EVIsLLDBAllocated;
         var_sp->m_flags |= ClangExpressionVariable::EVNeedsAllocation;
     }
-    
+
+    if (is_result)
+        m_struct_vars->m_result_flags = var_sp->m_flags;
+
     if (log)
         log->Printf("Created persistent variable with flags 0x%hx", var_sp->m_flags);
     
@@ -20,6 +20,7 @@
 
 #include "lldb/Core/ConstString.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/Module.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/ValueObjectConstResult.h"
@@ -30,6 +31,8 @@
 #include "lldb/Expression/ClangUserExpression.h"
 #include "lldb/Expression/ExpressionSourceCode.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Symbol/SymbolVendor.h"
 #include "lldb/Symbol/VariableList.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
@@ -246,6 +249,28 @@ ApplyUnicharHack(std::string &expr)
 #undef UNICHAR_HACK_FROM
 }
 
+// Sums the type parsing statistics of the symbol files that have already
+// been loaded for the target's modules.
+static void
+GetTypeStatistics (Target &target, uint32_t &num_types_parsed, uint32_t &num_types_completed)
+{
+    num_types_parsed = 0;
+    num_types_completed = 0;
+    ModuleList &images = target.GetImages();
+    const uint32_t num_modules = images.GetSize();
+    for (uint32_t i = 0; i < num_modules; ++i)
+    {
+        Module *module = images.GetModulePointerAtIndex(i);
+        SymbolVendor *sym_vendor = module ? module->GetSymbolVendor(false) : NULL;
+        SymbolFile *sym_file = sym_vendor ? sym_vendor->GetSymbolFile() : NULL;
+        if (sym_file)
+        {
+            num_types_parsed += sym_file->GetNumTypesParsed();
+            num_types_completed += sym_file->GetNumTypesCompleted();
+        }
+    }
+}
+
 bool
 ClangUserExpression::Parse (Stream &error_stream, 
                             ExecutionContext &exe_ctx,
@@ -319,11 +344,27 @@ ClangUserExpression::Parse (Stream &error_stream,
         return false;
     }
     
+    uint32_t num_types_parsed = 0;
+    uint32_t num_types_completed = 0;
+    if (log)
+        GetTypeStatistics (*target, num_types_parsed, num_types_completed);
+    
     Process *process = exe_ctx.GetProcessPtr();
     ClangExpressionParser parser(process, *this);
     
     unsigned num_errors = parser.Parse (error_stream);
     
+    if (log)
+    {
+        uint32_t total_types_parsed = 0;
+        uint32_t total_types_completed = 0;
+        GetTypeStatistics (*target, total_types_parsed, total_types_completed);
+        log->Printf("Parsing the expression completed %u types in its AST, and parsed %u and completed %u types from debug information",
+                    m_expr_decl_map->GetNumCompletedTypes(),
+                    total_types_parsed - num_types_parsed,
+                    total_types_completed - num_types_completed);
+    }
+    
     if (num_errors)
     {
         error_stream.Printf ("error: %d errors parsing expression\n", num_errors);
@@ -374,6 +415,32 @@ ClangUserExpression::Parse (Stream &error_stream,
     }
 }
 
+bool
+ClangUserExpression::CanBeReused ()
+{
+    if (m_evaluated_statically ||
+        m_jit_start_addr == LLDB_INVALID_ADDRESS ||
+        !m_jit_process_sp ||
+        !m_expr_decl_map.get())
+        return false;
+
+    return m_expr_decl_map->CanReuse();
+}
+
+bool
+ClangUserExpression::PrepareToReuse (ExecutionContext &exe_ctx)
+{
+    if (!CanBeReused())
+        return false;
+
+    // The JIT compiled code only exists in the process it was written to
+    Process *process = exe_ctx.GetProcessPtr();
+    if (process == NULL || process != m_jit_process_sp.get() || !process->IsAlive())
+        return false;
+
+    return m_expr_decl_map->WillReuse(exe_ctx);
+}
+
 bool
 ClangUserExpression::PrepareToExecuteJITExpression (Stream &error_stream,
                                                     ExecutionContext &exe_ctx,
@@ -634,6 +701,40 @@ ClangUserExpression::Execute (Stream &error_stream,
     }
 }
 
+// Builds the key for a compiled expression in the target's expression
+// cache.  The variables an expression uses are bound to the block it was
+// parsed in, so an expression is only reused in frames stopped in the
+// same block of the same function.
+static bool
+GetExpressionCacheKey (ExecutionContext &exe_ctx,
+                       lldb::LanguageType language,
+                       const char *expr_cstr,
+                       const char *expr_prefix,
+                       TypeFromUser desired_type,
+                       std::string &key)
+{
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    if (frame == NULL)
+        return false;
+    
+    const SymbolContext &sym_ctx (frame->GetSymbolContext(lldb::eSymbolContextFunction | 
+                                                          lldb::eSymbolContextBlock | 
+                                                          lldb::eSymbolContextSymbol));
+    
+    StreamString key_stream;
+    key_stream.Printf("%p %p %p %p %p %i\n%s\n%s",
+                      sym_ctx.function,
+                      sym_ctx.block,
+                      sym_ctx.symbol,
+                      desired_type.GetASTContext(),
+                      desired_type.GetOpaqueQualType(),
+                      language,
+                      expr_prefix ? expr_prefix : "",
+                      expr_cstr);
+    key.swap(key_stream.GetString());
+    return true;
+}
+
 ExecutionResults
 ClangUserExpression::Evaluate (ExecutionContext &exe_ctx,
                                lldb_private::ExecutionPolicy execution_policy,
@@ -679,23 +780,51 @@ ClangUserExpression::EvaluateWithError (ExecutionContext &exe_ctx,
     if (process == NULL || !process->CanJIT())
         execution_policy = eExecutionPolicyNever;
     
-    ClangUserExpressionSP user_expression_sp (new ClangUserExpression (expr_cstr, expr_prefix, language));
+    Target *target = exe_ctx.GetTargetPtr();
+    TypeFromUser desired_type (NULL, NULL);
+    std::string cache_key;
+    ClangUserExpressionSP user_expression_sp;
+    
+    // If this expression has been compiled for the same place in the program
+    // before, only its arguments need to be materialized again.
+    if (target &&
+        execution_policy != eExecutionPolicyNever &&
+        GetExpressionCacheKey (exe_ctx, language, expr_cstr, expr_prefix, desired_type, cache_key))
+    {
+        user_expression_sp = target->TakeCachedUserExpression (cache_key);
+        
+        if (user_expression_sp && !user_expression_sp->PrepareToReuse (exe_ctx))
+            user_expression_sp.reset();
+    }
 
     StreamString error_stream;
-        
-    if (log)
-        log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
     
-    const bool keep_expression_in_memory = true;
-    
-    if (!user_expression_sp->Parse (error_stream, exe_ctx, TypeFromUser(NULL, NULL), execution_policy, keep_expression_in_memory))
+    if (user_expression_sp)
     {
-        if (error_stream.GetString().empty())
-            error.SetErrorString ("expression failed to parse, unknown error");
-        else
-            error.SetErrorString (error_stream.GetString().c_str());
+        if (log)
+            log->Printf("== [ClangUserExpression::Evaluate] Reusing the compiled expression %s ==", expr_cstr);
     }
     else
+    {
+        user_expression_sp.reset (new ClangUserExpression (expr_cstr, expr_prefix, language));
+        
+        if (log)
+            log->Printf("== [ClangUserExpression::Evaluate] Parsing expression %s ==", expr_cstr);
+        
+        const bool keep_expression_in_memory = true;
+        
+        if (!user_expression_sp->Parse (error_stream, exe_ctx, desired_type, execution_policy, keep_expression_in_memory))
+        {
+            if (error_stream.GetString().empty())
+                error.SetErrorString ("expression failed to parse, unknown error");
+            else
+                error.SetErrorString (error_stream.GetString().c_str());
+            
+            user_expression_sp.reset();
+        }
+    }
+    
+    if (user_expression_sp)
     {
         lldb::ClangExpressionVariableSP expr_result;
 
@@ -704,6 +833,9 @@ ClangUserExpression::EvaluateWithError (ExecutionContext &exe_ctx,
             if (log)
                 log->Printf("== [ClangUserExpression::Evaluate] Expression evaluated as a constant ==");
             
+            if (target)
+                target->ExpressionWasInterpreted();
+            
             if (user_expression_sp->m_const_result)
                 result_valobj_sp = user_expression_sp->m_const_result->GetValueObject();
             else
@@ -726,6 +858,9 @@ ClangUserExpression::EvaluateWithError (ExecutionContext &exe_ctx,
             if (log)
                 log->Printf("== [ClangUserExpression::Evaluate] Executing expression ==");
 
+            if (target)
+                target->ExpressionWasJITed();
+
             execution_results = user_expression_sp->Execute (error_stream, 
                                                              exe_ctx, 
                                                              discard_on_error,
@@ -758,10 +893,18 @@ ClangUserExpression::EvaluateWithError (ExecutionContext &exe_ctx,
                     
                     error.SetError(ClangUserExpression::kNoResult, lldb::eErrorTypeGeneric);
                 }
+                
+                if (!cache_key.empty() && user_expression_sp->CanBeReused())
+                    target->AddCachedUserExpression (cache_key, user_expression_sp);
             }
         }
     }
     
+    if (log && target)
+        log->Printf("== [ClangUserExpression::Evaluate] The target has interpreted %u and JIT compiled %u expressions ==",
+                    target->GetNumExpressionsInterpreted(),
+                    target->GetNumExpressionsJITed());
+    
     if (result_valobj_sp.get() == NULL)
         result_valobj_sp = ValueObjectConstResult::Create (NULL, error);
 
@@ -221,14 +221,16 @@ DW_OP_value_to_name (uint32_t val)
 DWARFExpression::DWARFExpression() :
     m_data(),
     m_reg_kind (eRegisterKindDWARF),
-    m_loclist_slide (LLDB_INVALID_ADDRESS)
+    m_loclist_slide (LLDB_INVALID_ADDRESS),
+    m_compiled_sp ()
 {
 }
 
 DWARFExpression::DWARFExpression(const DWARFExpression& rhs) :
     m_data(rhs.m_data),
     m_reg_kind (rhs.m_reg_kind),
-    m_loclist_slide(rhs.m_loclist_slide)
+    m_loclist_slide(rhs.m_loclist_slide),
+    m_compiled_sp (rhs.m_compiled_sp)
 {
 }
 
@@ -236,7 +238,8 @@ DWARFExpression::DWARFExpression(const DWARFExpression& rhs) :
 DWARFExpression::DWARFExpression(const DataExtractor& data, uint32_t data_offset, uint32_t data_length) :
     m_data(data, data_offset, data_length),
     m_reg_kind (eRegisterKindDWARF),
-    m_loclist_slide(LLDB_INVALID_ADDRESS)
+    m_loclist_slide(LLDB_INVALID_ADDRESS),
+    m_compiled_sp ()
 {
 }
 
@@ -258,12 +261,14 @@ void
 DWARFExpression::SetOpcodeData (const DataExtractor& data)
 {
     m_data = data;
+    m_compiled_sp.reset();
 }
 
 void
 DWARFExpression::SetOpcodeData (const DataExtractor& data, uint32_t data_offset, uint32_t data_length)
 {
     m_data.SetData(data, data_offset, data_length);
+    m_compiled_sp.reset();
 }
 
 void
@@ -626,6 +631,7 @@ void
 DWARFExpression::SetLocationListSlide (addr_t slide)
 {
     m_loclist_slide = slide;
+    m_compiled_sp.reset();
 }
 
 int
@@ -1067,6 +1073,7 @@ DWARFExpression::Update_DW_OP_addr (lldb::addr_t file_addr)
             // pointer to the heap data so "m_data" will now correctly 
             // manage the heap data.
             m_data.SetData (DataBufferSP (head_data_ap.release()));
+            m_compiled_sp.reset();
             return true;
         }
         else
@@ -1178,6 +1185,220 @@ DWARFExpression::DumpLocationForAddress (Stream *s,
     return false;
 }
 
+void
+DWARFExpression::CompileExpression (const DataExtractor& opcodes, uint32_t offset, uint32_t length, CompiledExpression &expr)
+{
+    expr.offset = offset;
+    expr.length = length;
+    expr.kind = CompiledExpression::eKindGeneral;
+    expr.reg_num = LLDB_INVALID_REGNUM;
+    expr.value = 0;
+
+    if (length == 0 || !opcodes.ValidOffsetForDataOfSize (offset, length))
+        return;
+
+    CompiledExpression::Kind kind = CompiledExpression::eKindGeneral;
+    const uint8_t op = opcodes.GetU8 (&offset);
+    if (op >= DW_OP_reg0 && op <= DW_OP_reg31)
+    {
+        kind = CompiledExpression::eKindRegister;
+        expr.reg_num = op - DW_OP_reg0;
+    }
+    else if (op >= DW_OP_breg0 && op <= DW_OP_breg31)
+    {
+        kind = CompiledExpression::eKindRegisterOffset;
+        expr.reg_num = op - DW_OP_breg0;
+        expr.value = opcodes.GetSLEB128 (&offset);
+    }
+    else
+    {
+        switch (op)
+        {
+        case DW_OP_fbreg:
+            kind = CompiledExpression::eKindFrameBase;
+            expr.value = opcodes.GetSLEB128 (&offset);
+            break;
+        case DW_OP_regx:
+            kind = CompiledExpression::eKindRegister;
+            expr.reg_num = opcodes.GetULEB128 (&offset);
+            break;
+        case DW_OP_bregx:
+            kind = CompiledExpression::eKindRegisterOffset;
+            expr.reg_num = opcodes.GetULEB128 (&offset);
+            expr.value = opcodes.GetSLEB128 (&offset);
+            break;
+        case DW_OP_addr:
+            kind = CompiledExpression::eKindFileAddress;
+            expr.value = opcodes.GetAddress (&offset);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Only take the fast path if the opcode is the whole expression
+    if (offset == expr.offset + expr.length)
+        expr.kind = kind;
+}
+
+const DWARFExpression::CompiledLocation &
+DWARFExpression::GetCompiledLocation () const
+{
+    if (m_compiled_sp.get() == NULL)
+    {
+        CompiledLocationSP compiled_sp (new CompiledLocation);
+        compiled_sp->loclist_is_sorted = true;
+        CompileExpression (m_data, 0, IsLocationList() ? 0 : m_data.GetByteSize(), compiled_sp->expr);
+
+        if (IsLocationList())
+        {
+            uint32_t offset = 0;
+            while (m_data.ValidOffset(offset))
+            {
+                CompiledLocationListEntry entry;
+                entry.lo_pc = m_data.GetAddress(&offset);
+                entry.hi_pc = m_data.GetAddress(&offset);
+                if (entry.lo_pc == 0 && entry.hi_pc == 0)
+                    break;
+                const uint16_t length = m_data.GetU16(&offset);
+                // Empty entries never match any PC
+                if (length > 0)
+                {
+                    CompileExpression (m_data, offset, length, entry.expr);
+                    if (entry.lo_pc >= entry.hi_pc)
+                        compiled_sp->loclist_is_sorted = false;
+                    else if (!compiled_sp->loclist.empty() && entry.lo_pc < compiled_sp->loclist.back().hi_pc)
+                        compiled_sp->loclist_is_sorted = false;
+                    compiled_sp->loclist.push_back (entry);
+                }
+                offset += length;
+            }
+        }
+        m_compiled_sp = compiled_sp;
+    }
+    return *m_compiled_sp;
+}
+
+const DWARFExpression::CompiledExpression *
+DWARFExpression::FindCompiledLocationListEntry (addr_t loclist_base_addr, addr_t pc) const
+{
+    const CompiledLocation &compiled = GetCompiledLocation ();
+    const std::vector<CompiledLocationListEntry> &loclist = compiled.loclist;
+    const addr_t slide = loclist_base_addr - m_loclist_slide;
+
+    if (compiled.loclist_is_sorted)
+    {
+        // Find the first entry whose end is past "pc"
+        size_t lo = 0;
+        size_t hi = loclist.size();
+        while (lo < hi)
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (loclist[mid].hi_pc + slide <= pc)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < loclist.size() && loclist[lo].lo_pc + slide <= pc)
+            return &loclist[lo].expr;
+        return NULL;
+    }
+
+    // The first matching entry wins, just as when walking the raw list
+    for (size_t i = 0, n = loclist.size(); i < n; ++i)
+    {
+        if (loclist[i].lo_pc + slide <= pc && pc < loclist[i].hi_pc + slide)
+            return &loclist[i].expr;
+    }
+    return NULL;
+}
+
+bool
+DWARFExpression::EvaluateCompiled 
+(
+    const CompiledExpression &expr,
+    ExecutionContext *exe_ctx,
+    clang::ASTContext *ast_context,
+    ClangExpressionVariableList *expr_locals,
+    ClangExpressionDeclMap *decl_map,
+    RegisterContext *reg_ctx,
+    const Value* initial_value_ptr,
+    Value& result,
+    Error *error_ptr
+) const
+{
+    // The fast paths below produce exactly what the interpreter would for
+    // these single opcode expressions. Leave anything with an initial value
+    // or verbose logging to the interpreter.
+    if (expr.kind == CompiledExpression::eKindGeneral || initial_value_ptr != NULL)
+        return DWARFExpression::Evaluate (exe_ctx, ast_context, expr_locals, decl_map, reg_ctx, m_data, expr.offset, expr.length, m_reg_kind, initial_value_ptr, result, error_ptr);
+
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+    if (log && log->GetVerbose())
+        return DWARFExpression::Evaluate (exe_ctx, ast_context, expr_locals, decl_map, reg_ctx, m_data, expr.offset, expr.length, m_reg_kind, initial_value_ptr, result, error_ptr);
+
+    StackFrame *frame = NULL;
+    if (exe_ctx)
+        frame = exe_ctx->GetFramePtr();
+    if (reg_ctx == NULL && frame)
+        reg_ctx = frame->GetRegisterContext().get();
+
+    switch (expr.kind)
+    {
+    case CompiledExpression::eKindFrameBase:
+        {
+            if (exe_ctx == NULL)
+            {
+                if (error_ptr)
+                    error_ptr->SetErrorStringWithFormat ("NULL execution context for DW_OP_fbreg.\n");
+                return false;
+            }
+            if (frame == NULL)
+            {
+                if (error_ptr)
+                    error_ptr->SetErrorString ("Invalid stack frame in context for DW_OP_fbreg opcode.");
+                return false;
+            }
+            Scalar value;
+            if (!frame->GetFrameBaseValue(value, error_ptr))
+                return false;
+            value += (int64_t)expr.value;
+            result = value;
+            result.SetValueType (Value::eValueTypeLoadAddress);
+        }
+        return true;
+
+    case CompiledExpression::eKindRegisterOffset:
+        {
+            Value tmp;
+            if (!ReadRegisterValueAsScalar (reg_ctx, m_reg_kind, expr.reg_num, error_ptr, tmp))
+                return false;
+            tmp.ResolveValue(exe_ctx, ast_context) += (uint64_t)(int64_t)expr.value;
+            result = tmp;
+            result.SetValueType (Value::eValueTypeLoadAddress);
+        }
+        return true;
+
+    case CompiledExpression::eKindRegister:
+        {
+            Value tmp;
+            if (!ReadRegisterValueAsScalar (reg_ctx, m_reg_kind, expr.reg_num, error_ptr, tmp))
+                return false;
+            result = tmp;
+        }
+        return true;
+
+    case CompiledExpression::eKindFileAddress:
+        result = Scalar(expr.value);
+        result.SetValueType (Value::eValueTypeFileAddress);
+        return true;
+
+    case CompiledExpression::eKindGeneral:
+        break;
+    }
+    return false;
+}
+
 bool
 DWARFExpression::Evaluate
 (
@@ -1211,7 +1432,6 @@ DWARFExpression::Evaluate
 {
     if (IsLocationList())
     {
-        uint32_t offset = 0;
         addr_t pc;
         StackFrame *frame = NULL;
         if (reg_ctx)
@@ -1231,31 +1451,9 @@ DWARFExpression::Evaluate
                 return false;
             }
 
-            addr_t curr_loclist_base_load_addr = loclist_base_load_addr;
-
-            while (m_data.ValidOffset(offset))
-            {
-                // We need to figure out what the value is for the location.
-                addr_t lo_pc = m_data.GetAddress(&offset);
-                addr_t hi_pc = m_data.GetAddress(&offset);
-                if (lo_pc == 0 && hi_pc == 0)
-                {
-                    break;
-                }
-                else
-                {
-                    lo_pc += curr_loclist_base_load_addr - m_loclist_slide;
-                    hi_pc += curr_loclist_base_load_addr - m_loclist_slide;
-
-                    uint16_t length = m_data.GetU16(&offset);
-
-                    if (length > 0 && lo_pc <= pc && pc < hi_pc)
-                    {
-                        return DWARFExpression::Evaluate (exe_ctx, ast_context, expr_locals, decl_map, reg_ctx, m_data, offset, length, m_reg_kind, initial_value_ptr, result, error_ptr);
-                    }
-                    offset += length;
-                }
-            }
+            const CompiledExpression *expr = FindCompiledLocationListEntry (loclist_base_load_addr, pc);
+            if (expr)
+                return EvaluateCompiled (*expr, exe_ctx, ast_context, expr_locals, decl_map, reg_ctx, initial_value_ptr, result, error_ptr);
         }
         if (error_ptr)
             error_ptr->SetErrorString ("variable not available");
@@ -1263,7 +1461,7 @@ DWARFExpression::Evaluate
     }
 
     // Not a location list, just a single expression.
-    return DWARFExpression::Evaluate (exe_ctx, ast_context, expr_locals, decl_map, reg_ctx, m_data, 0, m_data.GetByteSize(), m_reg_kind, initial_value_ptr, result, error_ptr);
+    return EvaluateCompiled (GetCompiledLocation().expr, exe_ctx, ast_context, expr_locals, decl_map, reg_ctx, initial_value_ptr, result, error_ptr);
 }
 
 
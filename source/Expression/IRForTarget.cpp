@@ -2659,6 +2659,19 @@ IRForTarget::runOnModule (Module &llvm_module)
             m_interpret_success = true;
             return true;
         }
+        
+        // Running the expression again in the JIT would repeat the writes
+        
+        if (interpreter.WroteProcessMemory())
+        {
+            if (log)
+                log->Printf("The interpreter failed after writing to the process");
+            
+            if (m_error_stream)
+                m_error_stream->Printf("error: the expression could not be completed after it modified the process's memory\n");
+            
+            return false;
+        }
     }
     
     if (log && log->GetVerbose())
@@ -17,6 +17,7 @@
 #include "llvm/Constants.h"
 #include "llvm/Function.h"
 #include "llvm/Instructions.h"
+#include "llvm/IntrinsicInst.h"
 #include "llvm/Module.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetData.h"
@@ -28,7 +29,8 @@ using namespace llvm;
 IRInterpreter::IRInterpreter(lldb_private::ClangExpressionDeclMap &decl_map,
                                            lldb_private::Stream *error_stream) :
     m_decl_map(decl_map),
-    m_error_stream(error_stream)
+    m_error_stream(error_stream),
+    m_wrote_process_memory(false)
 {
     
 }
@@ -69,6 +71,53 @@ PrintType(const Type *type, bool truncate = false)
     return s;
 }
 
+// The number of instructions the interpreter will run before giving the
+// expression to the JIT.  This bounds expressions that loop forever.
+static const uint32_t g_max_interpreted_instructions = 0x10000;
+
+static unsigned
+GetIntegerBitWidth (Type *type)
+{
+    if (IntegerType *int_type = dyn_cast<IntegerType>(type))
+        return int_type->getBitWidth();
+    
+    return 64;
+}
+
+static uint64_t
+ZeroExtend (uint64_t value, unsigned bit_width)
+{
+    if (bit_width >= 64)
+        return value;
+    
+    return value & ((1ull << bit_width) - 1);
+}
+
+static int64_t
+SignExtend (uint64_t value, unsigned bit_width)
+{
+    if (bit_width == 0 || bit_width >= 64)
+        return (int64_t)value;
+    
+    uint64_t sign_bit = 1ull << (bit_width - 1);
+    
+    return (int64_t)((ZeroExtend(value, bit_width) ^ sign_bit) - sign_bit);
+}
+
+static bool
+IsSupportedIntegerType (Type *type)
+{
+    IntegerType *int_type = dyn_cast<IntegerType>(type);
+    
+    return (int_type && int_type->getBitWidth() <= 64);
+}
+
+static bool
+IsSupportedFloatType (Type *type)
+{
+    return (type->isFloatTy() || type->isDoubleTy());
+}
+
 typedef lldb::SharedPtr <lldb_private::DataEncoder>::Type DataEncoderSP;
 typedef lldb::SharedPtr <lldb_private::DataExtractor>::Type DataExtractorSP;
 
@@ -178,6 +227,7 @@ private:
     TargetData         &m_target_data;
     
     lldb_private::ClangExpressionDeclMap   &m_decl_map;
+    bool                                   &m_wrote_process_memory;
     
     MemoryMap::iterator LookupInternal (lldb::addr_t addr)
     {
@@ -197,11 +247,13 @@ public:
     Memory (TargetData &target_data,
             lldb_private::ClangExpressionDeclMap &decl_map,
             lldb::addr_t alloc_start,
-            lldb::addr_t alloc_max) :
+            lldb::addr_t alloc_max,
+            bool &wrote_process_memory) :
         m_addr_base(alloc_start),
         m_addr_max(alloc_max),
         m_target_data(target_data),
-        m_decl_map(decl_map)
+        m_decl_map(decl_map),
+        m_wrote_process_memory(wrote_process_memory)
     {
         m_byte_order = (target_data.isLittleEndian() ? lldb::eByteOrderLittle : lldb::eByteOrderBig);
         m_addr_byte_size = (target_data.getPointerSize());
@@ -332,11 +384,22 @@ public:
         return target;
     }
     
+    // Writes to a load address change the process, so the expression
+    // can't be run again in the JIT once one of them has happened.
+    
+    bool WriteTarget (lldb_private::Value &target, const uint8_t *data, size_t length)
+    {
+        if (target.GetValueType() == lldb_private::Value::eValueTypeLoadAddress)
+            m_wrote_process_memory = true;
+        
+        return m_decl_map.WriteTarget(target, data, length);
+    }
+    
     bool Write (lldb::addr_t addr, const uint8_t *data, size_t length)
     {
         lldb_private::Value target = GetAccessTarget(addr);
         
-        return m_decl_map.WriteTarget(target, data, length);
+        return WriteTarget(target, data, length);
     }
     
     bool Read (uint8_t *data, lldb::addr_t addr, size_t length)
@@ -350,7 +413,7 @@ public:
     {
         lldb_private::Value target = m_decl_map.WrapBareAddress(addr);
         
-        return m_decl_map.WriteTarget(target, data, length);
+        return WriteTarget(target, data, length);
     }
     
     bool ReadFromRawPtr (uint8_t *data, lldb::addr_t addr, size_t length)
@@ -360,6 +423,36 @@ public:
         return m_decl_map.ReadTarget(data, source, length);
     }
     
+    // Accesses to addresses outside the interpreter's own allocations go
+    // to the target.  Reads of the process's memory are served from the
+    // process's memory cache, so they don't resume the inferior.
+    
+    bool WriteToAddress (lldb::addr_t addr, const uint8_t *data, size_t length)
+    {
+        MemoryMap::iterator i = LookupInternal(addr);
+        
+        if (i == m_memory.end())
+            return WriteToRawPtr(addr, data, length);
+        
+        if (addr + length > (*i)->m_virtual_address + (*i)->m_extent)
+            return false;
+        
+        return Write(addr, data, length);
+    }
+    
+    bool ReadFromAddress (uint8_t *data, lldb::addr_t addr, size_t length)
+    {
+        MemoryMap::iterator i = LookupInternal(addr);
+        
+        if (i == m_memory.end())
+            return ReadFromRawPtr(data, addr, length);
+        
+        if (addr + length > (*i)->m_virtual_address + (*i)->m_extent)
+            return false;
+        
+        return Read(data, addr, length);
+    }
+    
     std::string PrintData (lldb::addr_t addr, size_t length)
     {
         lldb_private::Value target = GetAccessTarget(addr);
@@ -410,6 +503,7 @@ public:
     TargetData                             &m_target_data;
     lldb_private::ClangExpressionDeclMap   &m_decl_map;
     const BasicBlock                       *m_bb;
+    const BasicBlock                       *m_prev_bb;
     BasicBlock::const_iterator              m_ii;
     BasicBlock::const_iterator              m_ie;
     
@@ -421,7 +515,9 @@ public:
                            lldb_private::ClangExpressionDeclMap &decl_map) :
         m_memory (memory),
         m_target_data (target_data),
-        m_decl_map (decl_map)
+        m_decl_map (decl_map),
+        m_bb (NULL),
+        m_prev_bb (NULL)
     {
         m_byte_order = (target_data.isLittleEndian() ? lldb::eByteOrderLittle : lldb::eByteOrderBig);
         m_addr_byte_size = (target_data.getPointerSize());
@@ -429,6 +525,7 @@ public:
     
     void Jump (const BasicBlock *bb)
     {
+        m_prev_bb = m_bb;
         m_bb = bb;
         m_ii = m_bb->begin();
         m_ie = m_bb->end();
@@ -462,6 +559,24 @@ public:
     
     bool AssignToMatchType (lldb_private::Scalar &scalar, uint64_t u64value, Type *type)
     {
+        // Floating-point values are passed around as their raw bits
+        
+        if (type->isFloatTy())
+        {
+            uint32_t u32value = (uint32_t)u64value;
+            float float_value;
+            memcpy(&float_value, &u32value, sizeof(float_value));
+            scalar = float_value;
+            return true;
+        }
+        else if (type->isDoubleTy())
+        {
+            double double_value;
+            memcpy(&double_value, &u64value, sizeof(double_value));
+            scalar = double_value;
+            return true;
+        }
+        
         size_t type_size = m_target_data.getTypeStoreSize(type);
 
         switch (type_size)
@@ -495,6 +610,14 @@ public:
             {                
                 return AssignToMatchType(scalar, constant_int->getLimitedValue(), value->getType());
             }
+            else if (const ConstantFP *constant_fp = dyn_cast<ConstantFP>(constant))
+            {
+                return AssignToMatchType(scalar, constant_fp->getValueAPF().bitcastToAPInt().getLimitedValue(), value->getType());
+            }
+            else if (isa<ConstantPointerNull>(constant))
+            {
+                return AssignToMatchType(scalar, 0, value->getType());
+            }
         }
         else
         {
@@ -875,10 +998,121 @@ IRInterpreter::supportsFunction (Function &llvm_function)
                     return false;
                 }
             case Instruction::Add:
+            case Instruction::And:
+            case Instruction::AShr:
+            case Instruction::LShr:
+            case Instruction::Mul:
+            case Instruction::Or:
+            case Instruction::SDiv:
+            case Instruction::Shl:
+            case Instruction::SRem:
+            case Instruction::Sub:
+            case Instruction::UDiv:
+            case Instruction::URem:
+            case Instruction::Xor:
+            case Instruction::SExt:
+            case Instruction::Trunc:
+            case Instruction::ZExt:
+                {
+                    if (!IsSupportedIntegerType(ii->getType()) ||
+                        !IsSupportedIntegerType(ii->getOperand(0)->getType()))
+                    {
+                        if (log)
+                            log->Printf("Unsupported integer type: %s", PrintValue(ii).c_str());
+                        return false;
+                    }
+                }
+                break;
+            case Instruction::FAdd:
+            case Instruction::FCmp:
+            case Instruction::FDiv:
+            case Instruction::FMul:
+            case Instruction::FPExt:
+            case Instruction::FPToSI:
+            case Instruction::FPToUI:
+            case Instruction::FPTrunc:
+            case Instruction::FSub:
+            case Instruction::SIToFP:
+            case Instruction::UIToFP:
+                {
+                    // Only the operand of FPToSI and FPToUI, and only the result
+                    // of SIToFP and UIToFP, are floating-point
+                    
+                    Type *float_type = ii->getType();
+                    
+                    if (!IsSupportedFloatType(float_type))
+                        float_type = ii->getOperand(0)->getType();
+                    
+                    if (!IsSupportedFloatType(float_type))
+                    {
+                        if (log)
+                            log->Printf("Unsupported floating-point type: %s", PrintValue(ii).c_str());
+                        return false;
+                    }
+                    
+                    for (unsigned oi = 0, oe = ii->getNumOperands(); oi != oe; ++oi)
+                    {
+                        Type *operand_type = ii->getOperand(oi)->getType();
+                        
+                        if (!IsSupportedFloatType(operand_type) && !IsSupportedIntegerType(operand_type))
+                        {
+                            if (log)
+                                log->Printf("Unsupported operand type: %s", PrintValue(ii).c_str());
+                            return false;
+                        }
+                    }
+                }
+                break;
             case Instruction::Alloca:
             case Instruction::BitCast:
             case Instruction::Br:
             case Instruction::GetElementPtr:
+            case Instruction::PtrToInt:
+                break;
+            case Instruction::PHI:
+            case Instruction::Select:
+                {
+                    Type *type = ii->getType();
+                    
+                    if (!IsSupportedIntegerType(type) &&
+                        !IsSupportedFloatType(type) &&
+                        !type->isPointerTy())
+                    {
+                        if (log)
+                            log->Printf("Unsupported type: %s", PrintValue(ii).c_str());
+                        return false;
+                    }
+                    
+                    if (SelectInst *select_inst = dyn_cast<SelectInst>(ii))
+                    {
+                        if (!select_inst->getCondition()->getType()->isIntegerTy(1))
+                        {
+                            if (log)
+                                log->Printf("Unsupported Select condition: %s", PrintValue(ii).c_str());
+                            return false;
+                        }
+                    }
+                }
+                break;
+            case Instruction::Call:
+                {
+                    CallInst *call_inst = dyn_cast<CallInst>(ii);
+                    
+                    if (!call_inst)
+                        return false;
+                    
+                    // Calls can't be interpreted, but the compiler expresses
+                    // copies and fills of memory as calls to intrinsics that can.
+                    
+                    if (!isa<MemTransferInst>(call_inst) &&
+                        !isa<MemSetInst>(call_inst) &&
+                        !isa<DbgInfoIntrinsic>(call_inst))
+                    {
+                        if (log)
+                            log->Printf("Unsupported call: %s", PrintValue(ii).c_str());
+                        return false;
+                    }
+                }
                 break;
             case Instruction::ICmp:
                 {
@@ -911,12 +1145,8 @@ IRInterpreter::supportsFunction (Function &llvm_function)
                 break;
             case Instruction::IntToPtr:
             case Instruction::Load:
-            case Instruction::Mul:
             case Instruction::Ret:
-            case Instruction::SDiv:
             case Instruction::Store:
-            case Instruction::Sub:
-            case Instruction::UDiv:
                 break;
             }
         }
@@ -962,14 +1192,14 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
     if (target_data.isLittleEndian() != (target_info.byte_order == lldb::eByteOrderLittle))
         return false;
     
-    Memory memory(target_data, m_decl_map, alloc_min, alloc_max);
+    Memory memory(target_data, m_decl_map, alloc_min, alloc_max, m_wrote_process_memory);
     InterpreterStackFrame frame(target_data, memory, m_decl_map);
 
     uint32_t num_insts = 0;
     
     frame.Jump(llvm_function.begin());
     
-    while (frame.m_ii != frame.m_ie && (++num_insts < 4096))
+    while (frame.m_ii != frame.m_ie && (++num_insts < g_max_interpreted_instructions))
     {
         const Instruction *inst = frame.m_ii;
         
@@ -985,6 +1215,18 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
         case Instruction::Mul:
         case Instruction::SDiv:
         case Instruction::UDiv:
+        case Instruction::SRem:
+        case Instruction::URem:
+        case Instruction::Shl:
+        case Instruction::LShr:
+        case Instruction::AShr:
+        case Instruction::And:
+        case Instruction::Or:
+        case Instruction::Xor:
+        case Instruction::FAdd:
+        case Instruction::FSub:
+        case Instruction::FMul:
+        case Instruction::FDiv:
             {
                 const BinaryOperator *bin_op = dyn_cast<BinaryOperator>(inst);
                 
@@ -1020,24 +1262,104 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
                 
                 lldb_private::Scalar result;
                 
+                // Integer operands are held unsigned; the signed operations
+                // sign-extend them from the width of the IR type.
+                
+                unsigned bit_width = GetIntegerBitWidth(inst->getType());
+                uint64_t l = ZeroExtend(L.GetRawBits64(0), bit_width);
+                uint64_t r = ZeroExtend(R.GetRawBits64(0), bit_width);
+                int64_t sl = SignExtend(l, bit_width);
+                int64_t sr = SignExtend(r, bit_width);
+                
+                switch (inst->getOpcode())
+                {
+                default:
+                    break;
+                case Instruction::SDiv:
+                case Instruction::SRem:
+                    if (sr == -1 && sl == SignExtend(1ull << (bit_width - 1), bit_width))
+                    {
+                        if (log)
+                            log->Printf("Overflowing division in %s", PrintValue(inst).c_str());
+                        
+                        return false;
+                    }
+                    // fall through
+                case Instruction::UDiv:
+                case Instruction::URem:
+                    if (r == 0)
+                    {
+                        if (log)
+                            log->Printf("Division by zero in %s", PrintValue(inst).c_str());
+                        
+                        return false;
+                    }
+                    break;
+                case Instruction::Shl:
+                case Instruction::LShr:
+                case Instruction::AShr:
+                    if (r >= bit_width)
+                    {
+                        if (log)
+                            log->Printf("Shift amount exceeds the width of %s", PrintValue(inst).c_str());
+                        
+                        return false;
+                    }
+                    break;
+                }
+                
                 switch (inst->getOpcode())
                 {
                 default:
                     break;
                 case Instruction::Add:
+                case Instruction::FAdd:
                     result = L + R;
                     break;
                 case Instruction::Mul:
+                case Instruction::FMul:
                     result = L * R;
                     break;
                 case Instruction::Sub:
+                case Instruction::FSub:
                     result = L - R;
                     break;
+                case Instruction::FDiv:
+                    // Scalar's division refuses to divide by zero
+                    if (inst->getType()->isFloatTy())
+                        result = L.Float() / R.Float();
+                    else
+                        result = L.Double() / R.Double();
+                    break;
                 case Instruction::SDiv:
-                    result = L / R;
+                    result = (unsigned long long)(sl / sr);
                     break;
                 case Instruction::UDiv:
-                    result = L.GetRawBits64(0) / R.GetRawBits64(1);
+                    result = (unsigned long long)(l / r);
+                    break;
+                case Instruction::SRem:
+                    result = (unsigned long long)(sl % sr);
+                    break;
+                case Instruction::URem:
+                    result = (unsigned long long)(l % r);
+                    break;
+                case Instruction::Shl:
+                    result = (unsigned long long)(l << r);
+                    break;
+                case Instruction::LShr:
+                    result = (unsigned long long)(l >> r);
+                    break;
+                case Instruction::AShr:
+                    result = (unsigned long long)(sl < 0 ? ~(~sl >> r) : sl >> r);
+                    break;
+                case Instruction::And:
+                    result = (unsigned long long)(l & r);
+                    break;
+                case Instruction::Or:
+                    result = (unsigned long long)(l | r);
+                    break;
+                case Instruction::Xor:
+                    result = (unsigned long long)(l ^ r);
                     break;
                 }
                                 
@@ -1195,6 +1517,244 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
                 }
             }
             continue;
+        case Instruction::Call:
+            {
+                const CallInst *call_inst = dyn_cast<CallInst>(inst);
+                
+                if (!call_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns Call, but instruction is not a CallInst");
+                    
+                    return false;
+                }
+                
+                if (isa<DbgInfoIntrinsic>(call_inst))
+                    break;
+                
+                const MemIntrinsic *mem_inst = dyn_cast<MemIntrinsic>(call_inst);
+                
+                if (!mem_inst)
+                {
+                    if (log)
+                        log->Printf("The interpreter only handles calls to memcpy, memmove, and memset");
+                    
+                    return false;
+                }
+                
+                // The semantics of memcpy, memmove, and memset are:
+                //   Resolve the destination pointer D and the length N
+                //   Fill a buffer B of N bytes from the source pointer S, or with the value V
+                //   Transfer B to D
+                //
+                // Reading all of S before writing D makes memcpy behave as memmove.
+                
+                const Value *dest_operand = mem_inst->getRawDest();
+                const Value *length_operand = mem_inst->getLength();
+                
+                lldb_private::Scalar D;
+                lldb_private::Scalar N;
+                
+                if (!frame.EvaluateValue(D, dest_operand, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(dest_operand).c_str());
+                    
+                    return false;
+                }
+                
+                if (!frame.EvaluateValue(N, length_operand, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(length_operand).c_str());
+                    
+                    return false;
+                }
+                
+                uint64_t length = N.GetRawBits64(0);
+                
+                if (length == 0)
+                    break;
+                
+                // Nothing larger than the interpreter's own address space can
+                // be copied into it; leave bigger copies to the JIT.
+                
+                if (length > alloc_max - alloc_min)
+                {
+                    if (log)
+                        log->Printf("Length %llu is too large for the interpreter", (unsigned long long)length);
+                    
+                    return false;
+                }
+                
+                lldb_private::DataBufferHeap B(length, 0);
+                
+                if (const MemTransferInst *transfer_inst = dyn_cast<MemTransferInst>(mem_inst))
+                {
+                    const Value *source_operand = transfer_inst->getRawSource();
+                    
+                    lldb_private::Scalar S;
+                    
+                    if (!frame.EvaluateValue(S, source_operand, llvm_module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(source_operand).c_str());
+                        
+                        return false;
+                    }
+                    
+                    if (!memory.ReadFromAddress(B.GetBytes(), S.GetRawBits64(0), length))
+                    {
+                        if (log)
+                            log->Printf("Couldn't read from 0x%llx on behalf of a %s", (unsigned long long)S.GetRawBits64(0), inst->getOpcodeName());
+                        
+                        return false;
+                    }
+                }
+                else if (const MemSetInst *set_inst = dyn_cast<MemSetInst>(mem_inst))
+                {
+                    const Value *value_operand = set_inst->getValue();
+                    
+                    lldb_private::Scalar V;
+                    
+                    if (!frame.EvaluateValue(V, value_operand, llvm_module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(value_operand).c_str());
+                        
+                        return false;
+                    }
+                    
+                    memset(B.GetBytes(), (uint8_t)V.GetRawBits64(0), length);
+                }
+                else
+                {
+                    return false;
+                }
+                
+                if (!memory.WriteToAddress(D.GetRawBits64(0), B.GetBytes(), length))
+                {
+                    if (log)
+                        log->Printf("Couldn't write to 0x%llx on behalf of a %s", (unsigned long long)D.GetRawBits64(0), inst->getOpcodeName());
+                    
+                    return false;
+                }
+                
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", PrintValue(inst).c_str());
+                    log->Printf("  D : %s", frame.SummarizeValue(dest_operand).c_str());
+                    log->Printf("  N : %llu", (unsigned long long)length);
+                }
+            }
+            break;
+        case Instruction::FCmp:
+            {
+                const FCmpInst *fcmp_inst = dyn_cast<FCmpInst>(inst);
+                
+                if (!fcmp_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns FCmp, but instruction is not an FCmpInst");
+                    
+                    return false;
+                }
+                
+                Value *lhs = inst->getOperand(0);
+                Value *rhs = inst->getOperand(1);
+                
+                lldb_private::Scalar L;
+                lldb_private::Scalar R;
+                
+                if (!frame.EvaluateValue(L, lhs, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+                    
+                    return false;
+                }
+                
+                if (!frame.EvaluateValue(R, rhs, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+                    
+                    return false;
+                }
+                
+                double l = L.Double();
+                double r = R.Double();
+                
+                // A NaN compares unordered with everything, including itself
+                bool unordered = (l != l) || (r != r);
+                
+                lldb_private::Scalar result;
+                
+                switch (fcmp_inst->getPredicate())
+                {
+                default:
+                    return false;
+                case CmpInst::FCMP_FALSE:
+                    result = false;
+                    break;
+                case CmpInst::FCMP_OEQ:
+                    result = (!unordered && l == r);
+                    break;
+                case CmpInst::FCMP_OGT:
+                    result = (!unordered && l > r);
+                    break;
+                case CmpInst::FCMP_OGE:
+                    result = (!unordered && l >= r);
+                    break;
+                case CmpInst::FCMP_OLT:
+                    result = (!unordered && l < r);
+                    break;
+                case CmpInst::FCMP_OLE:
+                    result = (!unordered && l <= r);
+                    break;
+                case CmpInst::FCMP_ONE:
+                    result = (!unordered && l != r);
+                    break;
+                case CmpInst::FCMP_ORD:
+                    result = !unordered;
+                    break;
+                case CmpInst::FCMP_UNO:
+                    result = unordered;
+                    break;
+                case CmpInst::FCMP_UEQ:
+                    result = (unordered || l == r);
+                    break;
+                case CmpInst::FCMP_UGT:
+                    result = (unordered || l > r);
+                    break;
+                case CmpInst::FCMP_UGE:
+                    result = (unordered || l >= r);
+                    break;
+                case CmpInst::FCMP_ULT:
+                    result = (unordered || l < r);
+                    break;
+                case CmpInst::FCMP_ULE:
+                    result = (unordered || l <= r);
+                    break;
+                case CmpInst::FCMP_UNE:
+                    result = (unordered || l != r);
+                    break;
+                case CmpInst::FCMP_TRUE:
+                    result = true;
+                    break;
+                }
+                
+                frame.AssignValue(inst, result, llvm_module);
+                
+                if (log)
+                {
+                    log->Printf("Interpreted an FCmpInst");
+                    log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+                    log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+                    log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+            break;
         case Instruction::GetElementPtr:
             {
                 const GetElementPtrInst *gep_inst = dyn_cast<GetElementPtrInst>(inst);
@@ -1269,6 +1829,10 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
                 }
                 
                 lldb_private::Scalar result;
+                
+                unsigned bit_width = GetIntegerBitWidth(lhs->getType());
+                int64_t sl = SignExtend(L.GetRawBits64(0), bit_width);
+                int64_t sr = SignExtend(R.GetRawBits64(0), bit_width);
 
                 switch (predicate)
                 {
@@ -1293,16 +1857,16 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
                     result = (L.GetRawBits64(0) <= R.GetRawBits64(0));
                     break;
                 case CmpInst::ICMP_SGT:
-                    result = (L > R);
+                    result = (sl > sr);
                     break;
                 case CmpInst::ICMP_SGE:
-                    result = (L >= R);
+                    result = (sl >= sr);
                     break;
                 case CmpInst::ICMP_SLT:
-                    result = (L < R);
+                    result = (sl < sr);
                     break;
                 case CmpInst::ICMP_SLE:
-                    result = (L <= R);
+                    result = (sl <= sr);
                     break;
                 }
                 
@@ -1432,14 +1996,141 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
                 }
             }
             break;
+        case Instruction::PHI:
+            {
+                // The PHI nodes at the top of a block all take their values
+                // from the edge that was just followed, so evaluate every one
+                // of them before assigning any.
+                
+                if (!frame.m_prev_bb)
+                {
+                    if (log)
+                        log->Printf("PHINode in the entry block");
+                    
+                    return false;
+                }
+                
+                typedef std::vector <std::pair <const PHINode *, lldb_private::Scalar> > PHIValues;
+                PHIValues phi_values;
+                
+                BasicBlock::const_iterator phi_ii = frame.m_ii;
+                
+                for (; phi_ii != frame.m_ie && isa<PHINode>(phi_ii); ++phi_ii)
+                {
+                    const PHINode *phi_node = cast<PHINode>(phi_ii);
+                    
+                    int incoming_index = phi_node->getBasicBlockIndex(frame.m_prev_bb);
+                    
+                    if (incoming_index < 0)
+                    {
+                        if (log)
+                            log->Printf("PHINode has no value for the incoming block");
+                        
+                        return false;
+                    }
+                    
+                    const Value *incoming_value = phi_node->getIncomingValue(incoming_index);
+                    
+                    lldb_private::Scalar V;
+                    
+                    if (!frame.EvaluateValue(V, incoming_value, llvm_module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't evaluate %s", PrintValue(incoming_value).c_str());
+                        
+                        return false;
+                    }
+                    
+                    phi_values.push_back(std::make_pair(phi_node, V));
+                }
+                
+                for (PHIValues::iterator pi = phi_values.begin(), pe = phi_values.end();
+                     pi != pe;
+                     ++pi)
+                {
+                    if (!frame.AssignValue(pi->first, pi->second, llvm_module))
+                    {
+                        if (log)
+                            log->Printf("Couldn't assign to %s", PrintValue(pi->first).c_str());
+                        
+                        return false;
+                    }
+                    
+                    if (log)
+                    {
+                        log->Printf("Interpreted a PHINode");
+                        log->Printf("  = : %s", frame.SummarizeValue(pi->first).c_str());
+                    }
+                }
+                
+                // Resume at the last PHI node; the iterator is advanced below
+                
+                frame.m_ii = --phi_ii;
+            }
+            break;
         case Instruction::Ret:
             {
+                if (log)
+                    log->Printf("Interpreted the expression in %u instructions", num_insts);
+                
                 if (result_name.IsEmpty())
                     return true;
                 
                 GlobalValue *result_value = llvm_module.getNamedValue(result_name.GetCString());
                 return frame.ConstructResult(result, result_value, result_name, result_type, llvm_module);
             }
+        case Instruction::Select:
+            {
+                const SelectInst *select_inst = dyn_cast<SelectInst>(inst);
+                
+                if (!select_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns Select, but instruction is not a SelectInst");
+                    
+                    return false;
+                }
+                
+                const Value *condition = select_inst->getCondition();
+                
+                lldb_private::Scalar C;
+                
+                if (!frame.EvaluateValue(C, condition, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+                    
+                    return false;
+                }
+                
+                const Value *chosen = (C.GetRawBits64(0) & 1) ? select_inst->getTrueValue() : select_inst->getFalseValue();
+                
+                lldb_private::Scalar V;
+                
+                if (!frame.EvaluateValue(V, chosen, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(chosen).c_str());
+                    
+                    return false;
+                }
+                
+                if (!frame.AssignValue(inst, V, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't assign to %s", PrintValue(inst).c_str());
+                    
+                    return false;
+                }
+                
+                if (log)
+                {
+                    log->Printf("Interpreted a SelectInst");
+                    log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+                    log->Printf("  =    : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+            break;
         case Instruction::Store:
             {
                 const StoreInst *store_inst = dyn_cast<StoreInst>(inst);
@@ -1528,13 +2219,108 @@ IRInterpreter::runOnFunction (lldb::ClangExpressionVariableSP &result,
                 }
             }
             break;
+        case Instruction::FPExt:
+        case Instruction::FPToSI:
+        case Instruction::FPToUI:
+        case Instruction::FPTrunc:
+        case Instruction::PtrToInt:
+        case Instruction::SExt:
+        case Instruction::SIToFP:
+        case Instruction::Trunc:
+        case Instruction::UIToFP:
+        case Instruction::ZExt:
+            {
+                const CastInst *cast_inst = dyn_cast<CastInst>(inst);
+                
+                if (!cast_inst)
+                {
+                    if (log)
+                        log->Printf("getOpcode() returns %s, but instruction is not a CastInst", inst->getOpcodeName());
+                    
+                    return false;
+                }
+                
+                Value *source = cast_inst->getOperand(0);
+                
+                unsigned src_width = GetIntegerBitWidth(source->getType());
+                unsigned dst_width = GetIntegerBitWidth(cast_inst->getType());
+                bool dst_is_float = cast_inst->getType()->isFloatTy();
+                
+                lldb_private::Scalar S;
+                
+                if (!frame.EvaluateValue(S, source, llvm_module))
+                {
+                    if (log)
+                        log->Printf("Couldn't evaluate %s", PrintValue(source).c_str());
+                    
+                    return false;
+                }
+                
+                lldb_private::Scalar result;
+                
+                switch (inst->getOpcode())
+                {
+                default:
+                    return false;
+                case Instruction::ZExt:
+                case Instruction::PtrToInt:
+                    result = (unsigned long long)ZeroExtend(S.GetRawBits64(0), src_width);
+                    break;
+                case Instruction::SExt:
+                    result = (unsigned long long)SignExtend(S.GetRawBits64(0), src_width);
+                    break;
+                case Instruction::Trunc:
+                    result = (unsigned long long)ZeroExtend(S.GetRawBits64(0), dst_width);
+                    break;
+                case Instruction::FPExt:
+                case Instruction::FPTrunc:
+                    if (dst_is_float)
+                        result = S.Float();
+                    else
+                        result = S.Double();
+                    break;
+                case Instruction::SIToFP:
+                    if (dst_is_float)
+                        result = (float)SignExtend(S.GetRawBits64(0), src_width);
+                    else
+                        result = (double)SignExtend(S.GetRawBits64(0), src_width);
+                    break;
+                case Instruction::UIToFP:
+                    if (dst_is_float)
+                        result = (float)ZeroExtend(S.GetRawBits64(0), src_width);
+                    else
+                        result = (double)ZeroExtend(S.GetRawBits64(0), src_width);
+                    break;
+                case Instruction::FPToSI:
+                    result = (unsigned long long)(long long)S.Double();
+                    break;
+                case Instruction::FPToUI:
+                    result = (unsigned long long)S.Double();
+                    break;
+                }
+                
+                frame.AssignValue(inst, result, llvm_module);
+                
+                if (log)
+                {
+                    log->Printf("Interpreted a %s", inst->getOpcodeName());
+                    log->Printf("  Src : %s", frame.SummarizeValue(source).c_str());
+                    log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+                }
+            }
+            break;
         }
         
         ++frame.m_ii;
     }
     
-    if (num_insts >= 4096)
+    if (num_insts >= g_max_interpreted_instructions)
+    {
+        if (log)
+            log->Printf("Gave up after %u instructions", num_insts);
+        
         return false;
+    }
     
     return false; 
 }
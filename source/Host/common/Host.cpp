@@ -239,6 +239,18 @@ Host::GetPageSize()
     return ::getpagesize();
 }
 
+uint32_t
+Host::GetNumberCPUS ()
+{
+    static uint32_t g_num_cores = 0;
+    if (g_num_cores == 0)
+    {
+        const long num_cores = ::sysconf (_SC_NPROCESSORS_ONLN);
+        g_num_cores = num_cores > 0 ? num_cores : 1;
+    }
+    return g_num_cores;
+}
+
 const ArchSpec &
 Host::GetArchitecture (SystemDefaultArchitecture arch_kind)
 {
@@ -9,6 +9,10 @@
 
 #include "lldb/Host/Symbols.h"
 
+// Project includes
+#include "lldb/Core/StreamString.h"
+#include "lldb/Core/UUID.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -24,7 +28,23 @@ Symbols::LocateExecutableObjectFile (const FileSpec *exec_fspec, const ArchSpec*
 FileSpec
 Symbols::LocateExecutableSymbolFile (const FileSpec *exec_fspec, const ArchSpec* arch, const lldb_private::UUID *uuid)
 {
-    // FIXME
+    // Separate debug files installed by distributions are named after the
+    // build ID of the executable: the first byte selects a directory and the
+    // rest, followed by ".debug", names the file.
+    if (uuid && uuid->IsValid())
+    {
+        const uint8_t *uuid_bytes = (const uint8_t *)uuid->GetBytes();
+        const size_t uuid_byte_size = uuid->GetByteSize();
+        StreamString path;
+        path.Printf ("/usr/lib/debug/.build-id/%2.2x/", uuid_bytes[0]);
+        for (size_t i = 1; i < uuid_byte_size; ++i)
+            path.Printf ("%2.2x", uuid_bytes[i]);
+        path.PutCString (".debug");
+
+        FileSpec debug_fspec (path.GetData(), false);
+        if (debug_fspec.Exists())
+            return debug_fspec;
+    }
     return FileSpec();
 }
 
@@ -350,7 +350,8 @@ Error
 OptionValueUUID::SetValueFromCString (const char *value_cstr)
 {
     Error error;
-    if (m_uuid.SetfromCString(value_cstr) == 0)
+    // Accept 20 byte GNU build IDs as well as 16 byte UUIDs
+    if (m_uuid.SetfromCString(value_cstr, 20) == 0 && m_uuid.SetfromCString(value_cstr, 16) == 0)
         error.SetErrorStringWithFormat ("invalid uuid string value '%s'", value_cstr);
     return error;
 }
@@ -577,7 +577,41 @@ InstructionLLVM::CalculateComment(ExecutionContextScope *exe_scope)
 bool
 InstructionLLVM::DoesBranch() const
 {
-    return EDInstIsBranch(m_inst);
+    if (EDInstIsBranch(m_inst))
+        return true;
+
+    // Stepping runs to breakpoints on branches, so make sure the returns
+    // are counted as branches too.
+    if (m_arch_type == llvm::Triple::x86 || m_arch_type == llvm::Triple::x86_64)
+    {
+        const uint8_t *bytes = (const uint8_t *)m_opcode.GetOpcodeBytes();
+        const uint32_t byte_size = m_opcode.GetByteSize();
+        if (bytes == NULL)
+            return false;
+        // Skip the operand size, rep and REX prefixes
+        uint32_t i = 0;
+        while (i < byte_size && 
+               (bytes[i] == 0x66 || 
+                bytes[i] == 0xf2 || 
+                bytes[i] == 0xf3 || 
+                (m_arch_type == llvm::Triple::x86_64 && (bytes[i] & 0xf0) == 0x40)))
+            ++i;
+        if (i < byte_size)
+        {
+            switch (bytes[i])
+            {
+            case 0xc2:  // ret imm16
+            case 0xc3:  // ret
+            case 0xca:  // lret imm16
+            case 0xcb:  // lret
+            case 0xcf:  // iret
+                return true;
+            default:
+                break;
+            }
+        }
+    }
+    return false;
 }
 
 size_t
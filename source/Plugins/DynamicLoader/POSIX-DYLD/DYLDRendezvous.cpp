@@ -8,9 +8,13 @@
 //===----------------------------------------------------------------------===//
 
 // C Includes
+#include <limits.h>
+
 // C++ Includes
 // Other libraries and framework includes
+#include "llvm/ADT/DenseSet.h"
 #include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Core/Error.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Target/Process.h"
@@ -54,6 +58,8 @@ DYLDRendezvous::DYLDRendezvous(Process *process)
       m_current(),
       m_previous(),
       m_soentries(),
+      m_soentry_map(),
+      m_last_link_addr(0),
       m_added_soentries(),
       m_removed_soentries()
 {
@@ -112,8 +118,6 @@ DYLDRendezvous::IsValid()
 bool
 DYLDRendezvous::UpdateSOEntries()
 {
-    SOEntry entry;
-
     if (m_current.map_addr == 0)
         return false;
 
@@ -121,17 +125,19 @@ DYLDRendezvous::UpdateSOEntries()
     // time we have been asked to update.  Just take a snapshot of the currently
     // loaded modules.
     if (m_previous.state == eConsistent && m_current.state == eConsistent) 
-        return TakeSnapshot(m_soentries);
+        return TakeSnapshot();
 
-    // If we are about to add or remove a shared object clear out the current
-    // state and take a snapshot of the currently loaded images.
+    // If we are about to add or remove a shared object the link map still
+    // holds the modules we already know about, so only the lists of changes
+    // need to be reset.  Take a snapshot if we have not read the link map yet.
     if (m_current.state == eAdd || m_current.state == eDelete)
     {
         assert(m_previous.state == eConsistent);
-        m_soentries.clear();
         m_added_soentries.clear();
         m_removed_soentries.clear();
-        return TakeSnapshot(m_soentries);
+        if (m_soentries.empty())
+            return TakeSnapshot();
+        return true;
     }
     assert(m_current.state == eConsistent);
 
@@ -149,27 +155,36 @@ bool
 DYLDRendezvous::UpdateSOEntriesForAddition()
 {
     SOEntry entry;
-    iterator pos;
+    addr_t cursor;
 
     assert(m_previous.state == eAdd);
 
     if (m_current.map_addr == 0)
         return false;
 
-    for (addr_t cursor = m_current.map_addr; cursor != 0; cursor = entry.next)
+    // The runtime linker appends new modules to the end of the link map, so
+    // only the entries after the last one we read need to be looked at.
+    if (m_last_link_addr == 0)
+        cursor = m_current.map_addr;
+    else
+    {
+        if (!ReadLinkMapFromMemory(m_last_link_addr, entry))
+            return false;
+        cursor = entry.next;
+    }
+
+    for (; cursor != 0; cursor = entry.next)
     {
         if (!ReadSOEntryFromMemory(cursor, entry))
             return false;
 
+        m_last_link_addr = cursor;
+
         if (entry.path.empty())
             continue;
 
-        pos = std::find(m_soentries.begin(), m_soentries.end(), entry);
-        if (pos == m_soentries.end())
-        {
-            m_soentries.push_back(entry);
-            m_added_soentries.push_back(entry);
-        }
+        if (m_soentry_map.find(cursor) == m_soentry_map.end())
+            m_added_soentries.push_back(*AddSOEntry(entry));
     }
 
     return true;
@@ -178,54 +193,95 @@ DYLDRendezvous::UpdateSOEntriesForAddition()
 bool
 DYLDRendezvous::UpdateSOEntriesForDeletion()
 {
-    SOEntryList entry_list;
-    iterator pos;
+    llvm::DenseSet<addr_t> link_addrs;
+    SOEntry entry;
 
     assert(m_previous.state == eDelete);
 
-    if (!TakeSnapshot(entry_list))
+    if (m_current.map_addr == 0)
         return false;
 
-    for (iterator I = begin(); I != end(); ++I)
+    // Modules can be unloaded from anywhere in the link map.  Walk all of it,
+    // but only read the paths of entries we have not seen before.
+    m_last_link_addr = 0;
+    for (addr_t cursor = m_current.map_addr; cursor != 0; cursor = entry.next)
     {
-        pos = std::find(entry_list.begin(), entry_list.end(), *I);
-        if (pos == entry_list.end())
-            m_removed_soentries.push_back(*I);
+        if (!ReadLinkMapFromMemory(cursor, entry))
+            return false;
+
+        link_addrs.insert(cursor);
+        m_last_link_addr = cursor;
+
+        if (m_soentry_map.find(cursor) != m_soentry_map.end())
+            continue;
+
+        if (!ReadSOEntryFromMemory(cursor, entry))
+            return false;
+
+        if (!entry.path.empty())
+            m_added_soentries.push_back(*AddSOEntry(entry));
+    }
+
+    SOEntryList::iterator pos = m_soentries.begin();
+    while (pos != m_soentries.end())
+    {
+        if (link_addrs.count(pos->link_addr))
+        {
+            ++pos;
+            continue;
+        }
+
+        m_removed_soentries.push_back(*pos);
+        m_soentry_map.erase(pos->link_addr);
+        pos = m_soentries.erase(pos);
     }
 
-    m_soentries = entry_list;
     return true;
 }
 
 bool
-DYLDRendezvous::TakeSnapshot(SOEntryList &entry_list)
+DYLDRendezvous::TakeSnapshot()
 {
     SOEntry entry;
 
     if (m_current.map_addr == 0)
         return false;
 
+    m_soentries.clear();
+    m_soentry_map.clear();
+    m_last_link_addr = 0;
+
     for (addr_t cursor = m_current.map_addr; cursor != 0; cursor = entry.next)
     {
         if (!ReadSOEntryFromMemory(cursor, entry))
             return false;
 
+        m_last_link_addr = cursor;
+
         if (entry.path.empty())
             continue;
 
-        entry_list.push_back(entry);
+        AddSOEntry(entry);
     }
 
     return true;
 }
 
+DYLDRendezvous::SOEntryList::iterator
+DYLDRendezvous::AddSOEntry(const SOEntry &entry)
+{
+    SOEntryList::iterator pos = m_soentries.insert(m_soentries.end(), entry);
+    m_soentry_map[entry.link_addr] = pos;
+    return pos;
+}
+
 addr_t
 DYLDRendezvous::ReadMemory(addr_t addr, void *dst, size_t size)
 {
     size_t bytes_read;
     Error error;
 
-    bytes_read = m_process->DoReadMemory(addr, dst, size, error);
+    bytes_read = m_process->ReadMemory(addr, dst, size, error);
     if (bytes_read != size || error.Fail())
         return 0;
 
@@ -235,49 +291,55 @@ DYLDRendezvous::ReadMemory(addr_t addr, void *dst, size_t size)
 std::string
 DYLDRendezvous::ReadStringFromMemory(addr_t addr)
 {
-    std::string str;
+    char str[PATH_MAX];
     Error error;
-    size_t size;
-    char c;
 
     if (addr == LLDB_INVALID_ADDRESS)
         return std::string();
 
-    for (;;) {
-        size = m_process->DoReadMemory(addr, &c, 1, error);
-        if (size != 1 || error.Fail())
-            return std::string();
-        if (c == 0)
-            break;
-        else {
-            str.push_back(c);
-            addr++;
-        }
-    }
+    // Read a cache line at a time rather than a byte at a time.
+    m_process->ReadCStringFromMemory(addr, str, sizeof(str), error);
+    if (error.Fail())
+        return std::string();
 
-    return str;
+    return std::string(str);
 }
 
 bool
-DYLDRendezvous::ReadSOEntryFromMemory(lldb::addr_t addr, SOEntry &entry)
+DYLDRendezvous::ReadLinkMapFromMemory(lldb::addr_t addr, SOEntry &entry)
 {
-    size_t address_size = m_process->GetAddressByteSize();
+    // struct link_map starts with five pointer-sized fields: l_addr, l_name,
+    // l_ld, l_next and l_prev.  Read them all at once.
+    const size_t address_size = m_process->GetAddressByteSize();
+    const size_t num_fields = 5;
+    uint8_t buf[num_fields * sizeof(uint64_t)];
+    uint32_t offset = 0;
 
     entry.clear();
-    
-    if (!(addr = ReadMemory(addr, &entry.base_addr, address_size)))
-        return false;
-    
-    if (!(addr = ReadMemory(addr, &entry.path_addr, address_size)))
-        return false;
-    
-    if (!(addr = ReadMemory(addr, &entry.dyn_addr, address_size)))
+
+    if (address_size > sizeof(uint64_t))
         return false;
-    
-    if (!(addr = ReadMemory(addr, &entry.next, address_size)))
+
+    if (!ReadMemory(addr, buf, num_fields * address_size))
         return false;
-    
-    if (!(addr = ReadMemory(addr, &entry.prev, address_size)))
+
+    DataExtractor data(buf, num_fields * address_size,
+                       m_process->GetByteOrder(), address_size);
+
+    entry.link_addr = addr;
+    entry.base_addr = data.GetAddress(&offset);
+    entry.path_addr = data.GetAddress(&offset);
+    entry.dyn_addr  = data.GetAddress(&offset);
+    entry.next      = data.GetAddress(&offset);
+    entry.prev      = data.GetAddress(&offset);
+
+    return true;
+}
+
+bool
+DYLDRendezvous::ReadSOEntryFromMemory(lldb::addr_t addr, SOEntry &entry)
+{
+    if (!ReadLinkMapFromMemory(addr, entry))
         return false;
     
     entry.path = ReadStringFromMemory(entry.path_addr);
@@ -16,6 +16,7 @@
 #include <string>
 
 // Other libraries and framework includes
+#include "llvm/ADT/DenseMap.h"
 #include "lldb/lldb-defines.h"
 #include "lldb/lldb-types.h"
 
@@ -128,6 +129,7 @@ public:
     /// This object is a rough analogue to the struct link_map object which
     /// actually lives in the inferiors memory.
     struct SOEntry {
+        lldb::addr_t link_addr; ///< Address of this link_map entry.
         lldb::addr_t base_addr; ///< Base address of the loaded object.
         lldb::addr_t path_addr; ///< String naming the shared object.
         lldb::addr_t dyn_addr;  ///< Dynamic section of shared object.
@@ -142,6 +144,7 @@ public:
         }
 
         void clear() {
+            link_addr = 0;
             base_addr = 0;
             path_addr = 0;
             dyn_addr  = 0;
@@ -153,6 +156,7 @@ public:
 
 protected:
     typedef std::list<SOEntry> SOEntryList;
+    typedef llvm::DenseMap<lldb::addr_t, SOEntryList::iterator> SOEntryMap;
 
 public:
     typedef SOEntryList::const_iterator iterator;
@@ -184,6 +188,13 @@ protected:
     /// List of SOEntry objects corresponding to the current link map state.
     SOEntryList m_soentries;
 
+    /// The entries of m_soentries, keyed by the address of their link_map.
+    SOEntryMap m_soentry_map;
+
+    /// Address of the last link_map in the list when it was last read, or zero
+    /// if the list has not been read.
+    lldb::addr_t m_last_link_addr;
+
     /// List of SOEntry's added to the link map since the last call to Resolve().
     SOEntryList m_added_soentries;
 
@@ -203,25 +214,37 @@ protected:
     std::string
     ReadStringFromMemory(lldb::addr_t addr);
 
+    /// Reads the link_map fields of an SOEntry starting at @p addr, leaving
+    /// its path empty.
+    bool
+    ReadLinkMapFromMemory(lldb::addr_t addr, SOEntry &entry);
+
     /// Reads an SOEntry starting at @p addr.
     bool
     ReadSOEntryFromMemory(lldb::addr_t addr, SOEntry &entry);
 
+    /// Appends @p entry to the current set of SOEntries.
+    SOEntryList::iterator
+    AddSOEntry(const SOEntry &entry);
+
     /// Updates the current set of SOEntries, the set of added entries, and the
     /// set of removed entries.
     bool
     UpdateSOEntries();
 
+    /// Reads the entries the runtime linker appended to the link map since it
+    /// was last read.
     bool
     UpdateSOEntriesForAddition();
 
+    /// Walks the link map and drops the entries that are no longer in it.
     bool
     UpdateSOEntriesForDeletion();
 
     /// Reads the current list of shared objects according to the link map
     /// supplied by the runtime linker.
     bool
-    TakeSnapshot(SOEntryList &entry_list);
+    TakeSnapshot();
 };
 
 #endif
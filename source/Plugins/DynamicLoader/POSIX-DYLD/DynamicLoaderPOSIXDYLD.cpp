@@ -94,7 +94,8 @@ DynamicLoaderPOSIXDYLD::DynamicLoaderPOSIXDYLD(Process *process)
       m_rendezvous(process),
       m_load_offset(LLDB_INVALID_ADDRESS),
       m_entry_point(LLDB_INVALID_ADDRESS),
-      m_auxv(NULL)
+      m_auxv(NULL),
+      m_link_map_modules()
 {
 }
 
@@ -267,7 +268,10 @@ DynamicLoaderPOSIXDYLD::RefreshModules()
             FileSpec file(I->path.c_str(), true);
             ModuleSP module_sp = LoadModuleAtAddress(file, I->base_addr);
             if (module_sp.get())
+            {
                 new_modules.Append(module_sp);
+                m_link_map_modules[I->link_addr] = module_sp;
+            }
         }
         m_process->GetTarget().ModulesDidLoad(new_modules);
     }
@@ -279,9 +283,20 @@ DynamicLoaderPOSIXDYLD::RefreshModules()
         E = m_rendezvous.unloaded_end();
         for (I = m_rendezvous.unloaded_begin(); I != E; ++I)
         {
-            FileSpec file(I->path.c_str(), true);
-            ModuleSP module_sp = 
-                loaded_modules.FindFirstModuleForFileSpec(file, NULL, NULL);
+            // Look the module up by the link_map entry that loaded it, rather
+            // than searching every image for its path.
+            ModuleSP module_sp;
+            LinkMapModules::iterator pos = m_link_map_modules.find(I->link_addr);
+            if (pos != m_link_map_modules.end())
+            {
+                module_sp = pos->second;
+                m_link_map_modules.erase(pos);
+            }
+            if (!module_sp.get())
+            {
+                FileSpec file(I->path.c_str(), true);
+                module_sp = loaded_modules.FindFirstModuleForFileSpec(file, NULL, NULL);
+            }
             if (module_sp.get())
                 old_modules.Append(module_sp);
         }
@@ -353,12 +368,16 @@ DynamicLoaderPOSIXDYLD::LoadAllCurrentModules()
     if (!m_rendezvous.Resolve())
         return;
 
+    m_link_map_modules.clear();
     for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I)
     {
         FileSpec file(I->path.c_str(), false);
         ModuleSP module_sp = LoadModuleAtAddress(file, I->base_addr);
         if (module_sp.get())
+        {
             module_list.Append(module_sp);
+            m_link_map_modules[I->link_addr] = module_sp;
+        }
     }
 
     m_process->GetTarget().ModulesDidLoad(module_list);
@@ -13,6 +13,7 @@
 // C Includes
 // C++ Includes
 // Other libraries and framework includes
+#include "llvm/ADT/DenseMap.h"
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Target/DynamicLoader.h"
 
@@ -95,6 +96,11 @@ protected:
     /// Auxiliary vector of the inferior process.
     std::auto_ptr<AuxVector> m_auxv;
 
+    /// The module loaded for each entry of the runtime linker's link map,
+    /// keyed by the address of the entry's link_map.
+    typedef llvm::DenseMap<lldb::addr_t, lldb::ModuleSP> LinkMapModules;
+    LinkMapModules m_link_map_modules;
+
     /// Enables a breakpoint on a function called by the runtime
     /// linker each time a module is loaded or unloaded.
     void
@@ -7,8 +7,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <assert.h>
 #include <stdlib.h>
 
+#include <vector>
+
 #include "EmulateInstructionARM.h"
 #include "EmulationStateARM.h"
 #include "lldb/Core/ArchSpec.h"
@@ -163,6 +166,11 @@ EmulateInstructionARM::Initialize ()
     PluginManager::RegisterPlugin (GetPluginNameStatic (),
                                    GetPluginDescriptionStatic (),
                                    CreateInstance);
+    // Build the opcode decode tables now rather than on whichever thread
+    // first emulates an instruction
+    GetARMOpcodeForInstruction (0, ARMvAll);
+    GetThumbOpcodeForInstruction (0, ARMvAll);
+    GetThumbOpcodeForInstruction (0xffff0000, ARMvAll);
 }
 
 void
@@ -12211,7 +12219,141 @@ EmulateInstructionARM::EmulateSUBSPcLrEtc (const uint32_t opcode, const ARMEncod
     }
     return true;
 }
-    
+
+//----------------------------------------------------------------------
+// A decode table over one of the opcode tables below, built the first
+// time the table is searched.
+//
+// The opcode bits in "key_mask" are gathered into a key, and each key has
+// a bucket listing, in table order, the entries whose mask and value agree
+// with that key. Any entry that matches an opcode is in the bucket for the
+// opcode's key, so the first entry in the bucket that matches the whole
+// opcode is the entry a front-to-back scan of the table would have found.
+// Only entries accepted by "filter" are considered, which lets the 16 and
+// 32 bit Thumb instructions be keyed on different bits.
+//----------------------------------------------------------------------
+class EmulateInstructionARM::OpcodeDecodeTable
+{
+public:
+    typedef bool (*EntryFilter) (const ARMOpcode &entry);
+
+    OpcodeDecodeTable (ARMOpcode *opcodes,
+                       size_t num_opcodes,
+                       uint32_t key_mask,
+                       EntryFilter filter) :
+        m_opcodes (opcodes),
+        m_key_mask (key_mask),
+        m_num_fields (0),
+        m_bucket_start (),
+        m_entries ()
+    {
+        // Split the key mask into contiguous bit fields
+        uint32_t key_bits = 0;
+        for (uint32_t bit = 0; bit < 32; )
+        {
+            if ((key_mask & (1u << bit)) == 0)
+            {
+                ++bit;
+                continue;
+            }
+            uint32_t width = 0;
+            while (bit + width < 32 && (key_mask & (1u << (bit + width))))
+                ++width;
+            assert (m_num_fields < kMaxFields);
+            m_fields[m_num_fields].shift = bit;
+            m_fields[m_num_fields].mask = (width == 32) ? UINT32_MAX : ((1u << width) - 1);
+            m_fields[m_num_fields].key_shift = key_bits;
+            ++m_num_fields;
+            key_bits += width;
+            bit += width;
+        }
+        assert (key_bits <= 16);
+
+        const uint32_t num_keys = 1u << key_bits;
+        m_bucket_start.reserve (num_keys + 1);
+        for (uint32_t key = 0; key < num_keys; ++key)
+        {
+            m_bucket_start.push_back (m_entries.size());
+            const uint32_t key_value = KeyToOpcodeBits (key);
+            for (size_t i = 0; i < num_opcodes; ++i)
+            {
+                const ARMOpcode &entry = opcodes[i];
+                if (filter && !filter (entry))
+                    continue;
+                const uint32_t common_mask = entry.mask & m_key_mask;
+                if ((entry.value & common_mask) == (key_value & common_mask))
+                    m_entries.push_back (i);
+            }
+        }
+        m_bucket_start.push_back (m_entries.size());
+    }
+
+    ARMOpcode *
+    FindOpcode (const uint32_t opcode, uint32_t isa_mask) const
+    {
+        const uint32_t key = OpcodeBitsToKey (opcode);
+        const uint32_t end = m_bucket_start[key + 1];
+        for (uint32_t i = m_bucket_start[key]; i < end; ++i)
+        {
+            ARMOpcode *entry = m_opcodes + m_entries[i];
+            if ((entry->mask & opcode) == entry->value &&
+                (entry->variants & isa_mask) != 0)
+                return entry;
+        }
+        return NULL;
+    }
+
+    // 16-bit Thumb instructions are passed in the low halfword with the
+    // high halfword clear, while the first halfword of a 32-bit one is
+    // never zero. These pick out the entries that can match either kind.
+    static bool
+    CanMatchThumb16 (const ARMOpcode &entry)
+    {
+        return (entry.value & entry.mask & 0xffff0000) == 0;
+    }
+
+    static bool
+    CanMatchThumb32 (const ARMOpcode &entry)
+    {
+        return (entry.mask & 0xffff0000) != 0xffff0000 || (entry.value & 0xffff0000) != 0;
+    }
+
+private:
+    enum { kMaxFields = 4 };
+
+    struct KeyField
+    {
+        uint32_t shift;     // Position of the field in the opcode
+        uint32_t mask;      // Mask for the field once shifted down
+        uint32_t key_shift; // Position of the field in the key
+    };
+
+    uint32_t
+    OpcodeBitsToKey (uint32_t opcode) const
+    {
+        uint32_t key = 0;
+        for (uint32_t i = 0; i < m_num_fields; ++i)
+            key |= ((opcode >> m_fields[i].shift) & m_fields[i].mask) << m_fields[i].key_shift;
+        return key;
+    }
+
+    uint32_t
+    KeyToOpcodeBits (uint32_t key) const
+    {
+        uint32_t opcode = 0;
+        for (uint32_t i = 0; i < m_num_fields; ++i)
+            opcode |= ((key >> m_fields[i].key_shift) & m_fields[i].mask) << m_fields[i].shift;
+        return opcode;
+    }
+
+    ARMOpcode *m_opcodes;
+    uint32_t m_key_mask;
+    KeyField m_fields[kMaxFields];
+    uint32_t m_num_fields;
+    std::vector<uint32_t> m_bucket_start;   // Index into m_entries of the first entry for each key, plus an end marker
+    std::vector<uint16_t> m_entries;        // Opcode table indexes, grouped by key
+};
+
 EmulateInstructionARM::ARMOpcode*
 EmulateInstructionARM::GetARMOpcodeForInstruction (const uint32_t opcode, uint32_t arm_isa)
 {
@@ -12435,14 +12577,14 @@ EmulateInstructionARM::GetARMOpcodeForInstruction (const uint32_t opcode, uint32
                   
     };
     static const size_t k_num_arm_opcodes = sizeof(g_arm_opcodes)/sizeof(ARMOpcode);
-                  
-    for (size_t i=0; i<k_num_arm_opcodes; ++i)
-    {
-        if ((g_arm_opcodes[i].mask & opcode) == g_arm_opcodes[i].value &&
-            (g_arm_opcodes[i].variants & arm_isa) != 0)
-            return &g_arm_opcodes[i];
-    }
-    return NULL;
+
+    // Keyed on bits 27:20 and 7:4, the fields the ARM ARM decodes the
+    // A32 instruction set on
+    static const OpcodeDecodeTable g_arm_decode_table (g_arm_opcodes,
+                                                       k_num_arm_opcodes,
+                                                       0x0ff000f0,
+                                                       NULL);
+    return g_arm_decode_table.FindOpcode (opcode, arm_isa);
 }
 
     
@@ -12761,13 +12903,21 @@ EmulateInstructionARM::GetThumbOpcodeForInstruction (const uint32_t opcode, uint
     };
 
     const size_t k_num_thumb_opcodes = sizeof(g_thumb_opcodes)/sizeof(ARMOpcode);
-    for (size_t i=0; i<k_num_thumb_opcodes; ++i)
-    {
-        if ((g_thumb_opcodes[i].mask & opcode) == g_thumb_opcodes[i].value &&
-            (g_thumb_opcodes[i].variants & arm_isa) != 0)
-            return &g_thumb_opcodes[i];
-    }
-    return NULL;
+
+    // 16-bit instructions are keyed on their top ten bits. 32-bit ones are
+    // keyed on bits 12:4 of the first halfword and the top nibble of the
+    // second, which covers op1, op2 and op of the T32 encoding tables.
+    static const OpcodeDecodeTable g_thumb16_decode_table (g_thumb_opcodes,
+                                                           k_num_thumb_opcodes,
+                                                           0x0000ffc0,
+                                                           OpcodeDecodeTable::CanMatchThumb16);
+    static const OpcodeDecodeTable g_thumb32_decode_table (g_thumb_opcodes,
+                                                           k_num_thumb_opcodes,
+                                                           0x1ff0f000,
+                                                           OpcodeDecodeTable::CanMatchThumb32);
+    if (opcode & 0xffff0000)
+        return g_thumb32_decode_table.FindOpcode (opcode, arm_isa);
+    return g_thumb16_decode_table.FindOpcode (opcode, arm_isa);
 }
 
 bool
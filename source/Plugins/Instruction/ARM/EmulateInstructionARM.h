@@ -378,6 +378,10 @@ protected:
     uint32_t
     GetFramePointerDWARFRegisterNumber () const;
 
+    // Maps the opcode bits that select an instruction class to the few
+    // entries of an opcode table that can match them.
+    class OpcodeDecodeTable;
+
     static ARMOpcode*
     GetARMOpcodeForInstruction (const uint32_t opcode, uint32_t isa_mask);
 
@@ -34,6 +34,13 @@ using namespace elf;
 using namespace llvm::ELF;
 
 namespace {
+
+// Note type of the NT_GNU_BUILD_ID note emitted by "ld --build-id".
+const elf_word LLDB_NT_GNU_BUILD_ID_TAG = 0x03;
+
+// Section type of the .gnu.hash section emitted by "ld --hash-style=gnu".
+const elf_word LLDB_SHT_GNU_HASH = 0x6ffffff6;
+
 //===----------------------------------------------------------------------===//
 /// @class ELFRelocation
 /// @brief Generic wrapper for ELFRel and ELFRela.
@@ -230,7 +237,14 @@ ObjectFileELF::ObjectFileELF(Module* module, DataBufferSP& dataSP,
       m_sections_ap(),
       m_symtab_ap(),
       m_filespec_ap(),
-      m_shstr_data()
+      m_shstr_data(),
+      m_dynsym_data(),
+      m_dynstr_data(),
+      m_hash_data(),
+      m_hash_type(0),
+      m_hash_parsed(false),
+      m_hashed_symbols(),
+      m_hash_mutex(Mutex::eMutexTypeNormal)
 {
     if (file)
         m_file = *file;
@@ -285,10 +299,97 @@ ObjectFileELF::ParseHeader()
 bool
 ObjectFileELF::GetUUID(lldb_private::UUID* uuid)
 {
-    // FIXME: Return MD5 sum here.  See comment in ObjectFile.h.
+    if (uuid == NULL)
+        return false;
+
+    // The linker places the build ID note in a PT_NOTE segment near the
+    // start of the file, so it can be read without touching the rest of it.
+    if (ParseProgramHeaders())
+    {
+        for (ProgramHeaderCollConstIter I = m_program_headers.begin();
+             I != m_program_headers.end(); ++I)
+        {
+            if (I->p_type != PT_NOTE)
+                continue;
+
+            DataExtractor note_data;
+            if (GetFileData(I->p_offset, I->p_filesz, note_data) &&
+                ParseBuildID(note_data, *uuid))
+                return true;
+        }
+    }
+
+    // Separate debug files created with "objcopy --only-keep-debug" may only
+    // describe the note in the section headers.
+    if (ParseSectionHeaders())
+    {
+        for (SectionHeaderCollConstIter I = m_section_headers.begin();
+             I != m_section_headers.end(); ++I)
+        {
+            if (I->sh_type != SHT_NOTE)
+                continue;
+
+            DataExtractor note_data;
+            if (GetFileData(I->sh_offset, I->sh_size, note_data) &&
+                ParseBuildID(note_data, *uuid))
+                return true;
+        }
+    }
     return false;
 }
 
+bool
+ObjectFileELF::ParseBuildID(const DataExtractor &data, lldb_private::UUID &uuid)
+{
+    // Each note is a header of three words (name size, descriptor size and
+    // type) followed by the name and the descriptor, both padded to four
+    // bytes.
+    uint32_t offset = 0;
+    while (data.ValidOffsetForDataOfSize(offset, 12))
+    {
+        const elf_word n_namesz = data.GetU32(&offset);
+        const elf_word n_descsz = data.GetU32(&offset);
+        const elf_word n_type = data.GetU32(&offset);
+        const uint64_t name_offset = offset;
+        const uint64_t desc_offset = name_offset + ((n_namesz + 3ull) & ~3ull);
+        const uint64_t next_offset = desc_offset + ((n_descsz + 3ull) & ~3ull);
+
+        if (next_offset > data.GetByteSize())
+            return false;
+
+        if (n_type == LLDB_NT_GNU_BUILD_ID_TAG && n_namesz == 4)
+        {
+            const char *name = data.PeekCStr(name_offset);
+            if (name && strcmp(name, "GNU") == 0)
+                return uuid.SetBytes(data.GetDataStart() + desc_offset, n_descsz);
+        }
+        offset = next_offset;
+    }
+    return false;
+}
+
+bool
+ObjectFileELF::GetFileData(elf_off file_offset, size_t length, DataExtractor &data)
+{
+    // Use the bytes we already have from the start of the file when they
+    // cover the request and only go back to the file otherwise.
+    const elf_off offset = m_offset + file_offset;
+    if (offset + length <= m_data.GetByteSize())
+    {
+        data.SetData(m_data, offset, length);
+    }
+    else
+    {
+        DataBufferSP buffer_sp(m_file.ReadFileContents(offset, length));
+        if (buffer_sp.get() == NULL || buffer_sp->GetByteSize() != length)
+            return false;
+        data.SetData(buffer_sp);
+    }
+    data.SetByteOrder(m_data.GetByteOrder());
+    data.SetAddressByteSize(m_data.GetAddressByteSize());
+    return data.GetByteSize() == length;
+}
+
 uint32_t
 ObjectFileELF::GetDependentModules(FileSpecList &files)
 {
@@ -473,15 +574,10 @@ ObjectFileELF::ParseProgramHeaders()
         return 0;
 
     const size_t ph_size = m_header.e_phnum * m_header.e_phentsize;
-    const elf_off ph_offset = m_offset + m_header.e_phoff;
-    DataBufferSP buffer_sp(m_file.ReadFileContents(ph_offset, ph_size));
-
-    if (buffer_sp.get() == NULL || buffer_sp->GetByteSize() != ph_size)
+    DataExtractor data;
+    if (!GetFileData(m_header.e_phoff, ph_size, data))
         return 0;
 
-    DataExtractor data(buffer_sp, m_data.GetByteOrder(),
-                       m_data.GetAddressByteSize());
-
     uint32_t idx;
     uint32_t offset;
     for (idx = 0, offset = 0; idx < m_header.e_phnum; ++idx)
@@ -669,19 +765,14 @@ ObjectFileELF::GetSectionList()
     return m_sections_ap.get();
 }
 
-static unsigned
-ParseSymbols(Symtab *symtab, 
-             user_id_t start_id,
+// Converts an ELF symbol into an lldb_private::Symbol with the given ID and
+// already uniqued name.
+static Symbol
+CreateSymbol(const ELFSymbol &symbol,
+             user_id_t symbol_id,
              SectionList *section_list,
-             const ELFSectionHeader *symtab_shdr,
-             const DataExtractor &symtab_data,
-             const DataExtractor &strtab_data)
+             const ConstString &symbol_name)
 {
-    ELFSymbol symbol;
-    uint32_t offset = 0;
-    const unsigned num_symbols = 
-        symtab_data.GetByteSize() / symtab_shdr->sh_entsize;
-
     static ConstString text_section_name(".text");
     static ConstString init_section_name(".init");
     static ConstString fini_section_name(".fini");
@@ -694,110 +785,248 @@ ParseSymbols(Symtab *symtab,
     static ConstString data2_section_name(".data1");
     static ConstString bss_section_name(".bss");
 
-    unsigned i;
-    for (i = 0; i < num_symbols; ++i)
+    Section *symbol_section = NULL;
+    SymbolType symbol_type = eSymbolTypeInvalid;
+    Elf64_Half symbol_idx = symbol.st_shndx;
+
+    switch (symbol_idx)
     {
-        if (symbol.Parse(symtab_data, &offset) == false)
-            break;
+    case SHN_ABS:
+        symbol_type = eSymbolTypeAbsolute;
+        break;
+    case SHN_UNDEF:
+        symbol_type = eSymbolTypeUndefined;
+        break;
+    default:
+        symbol_section = section_list->GetSectionAtIndex(symbol_idx).get();
+        break;
+    }
+
+    switch (symbol.getType())
+    {
+    default:
+    case STT_NOTYPE:
+        // The symbol's type is not specified.
+        break;
 
-        Section *symbol_section = NULL;
-        SymbolType symbol_type = eSymbolTypeInvalid;
-        Elf64_Half symbol_idx = symbol.st_shndx;
+    case STT_OBJECT:
+        // The symbol is associated with a data object, such as a variable,
+        // an array, etc.
+        symbol_type = eSymbolTypeData;
+        break;
+
+    case STT_FUNC:
+        // The symbol is associated with a function or other executable code.
+        symbol_type = eSymbolTypeCode;
+        break;
+
+    case STT_SECTION:
+        // The symbol is associated with a section. Symbol table entries of
+        // this type exist primarily for relocation and normally have
+        // STB_LOCAL binding.
+        break;
+
+    case STT_FILE:
+        // Conventionally, the symbol's name gives the name of the source
+        // file associated with the object file. A file symbol has STB_LOCAL
+        // binding, its section index is SHN_ABS, and it precedes the other
+        // STB_LOCAL symbols for the file, if it is present.
+        symbol_type = eSymbolTypeObjectFile;
+        break;
+    }
 
-        switch (symbol_idx)
+    if (symbol_type == eSymbolTypeInvalid)
+    {
+        if (symbol_section)
         {
-        case SHN_ABS:
-            symbol_type = eSymbolTypeAbsolute;
-            break;
-        case SHN_UNDEF:
-            symbol_type = eSymbolTypeUndefined;
-            break;
-        default:
-            symbol_section = section_list->GetSectionAtIndex(symbol_idx).get();
-            break;
+            const ConstString &sect_name = symbol_section->GetName();
+            if (sect_name == text_section_name ||
+                sect_name == init_section_name ||
+                sect_name == fini_section_name ||
+                sect_name == ctors_section_name ||
+                sect_name == dtors_section_name)
+            {
+                symbol_type = eSymbolTypeCode;
+            }
+            else if (sect_name == data_section_name ||
+                     sect_name == data2_section_name ||
+                     sect_name == rodata_section_name ||
+                     sect_name == rodata1_section_name ||
+                     sect_name == bss_section_name)
+            {
+                symbol_type = eSymbolTypeData;
+            }
         }
+    }
 
-        switch (symbol.getType())
-        {
-        default:
-        case STT_NOTYPE:
-            // The symbol's type is not specified.
-            break;
+    uint64_t symbol_value = symbol.st_value;
+    if (symbol_section != NULL)
+        symbol_value -= symbol_section->GetFileAddress();
+    bool is_global = symbol.getBinding() == STB_GLOBAL;
+    uint32_t flags = symbol.st_other << 8 | symbol.st_info;
+
+    Symbol elf_symbol(
+        symbol_id,       // ID is the original symbol table index.
+        NULL,            // Symbol name, set below.
+        false,           // Is the symbol name mangled?
+        symbol_type,     // Type of this symbol
+        is_global,       // Is this globally visible?
+        false,           // Is this symbol debug info?
+        false,           // Is this symbol a trampoline?
+        false,           // Is this symbol artificial?
+        symbol_section,  // Section in which this symbol is defined or null.
+        symbol_value,    // Offset in section or symbol value.
+        symbol.st_size,  // Size in bytes of this symbol.
+        flags);          // Symbol flags.
+    elf_symbol.GetMangled().SetDemangledName(symbol_name);
+    return elf_symbol;
+}
 
-        case STT_OBJECT:
-            // The symbol is associated with a data object, such as a variable,
-            // an array, etc.
-            symbol_type = eSymbolTypeData;
-            break;
+namespace {
 
-        case STT_FUNC:
-            // The symbol is associated with a function or other executable code.
-            symbol_type = eSymbolTypeCode;
-            break;
+// Shared state for the threads that parse one symbol table.  Each thread
+// repeatedly claims the next chunk of symbols and converts it directly into
+// the symbol table's pre-sized storage, so the result doesn't depend on the
+// order in which the chunks are parsed.
+struct SymbolTableParse
+{
+    SymbolTableParse(Symbol *symbols_,
+                     unsigned num_symbols_,
+                     user_id_t start_id_,
+                     SectionList *section_list_,
+                     uint32_t entsize_,
+                     const DataExtractor &symtab_data_,
+                     const DataExtractor &strtab_data_) :
+        mutex(Mutex::eMutexTypeNormal),
+        symbols(symbols_),
+        num_symbols(num_symbols_),
+        start_id(start_id_),
+        section_list(section_list_),
+        entsize(entsize_),
+        symtab_data(symtab_data_),
+        strtab_data(strtab_data_),
+        next_symbol(0),
+        num_parsed(num_symbols_)
+    {
+    }
 
-        case STT_SECTION:
-            // The symbol is associated with a section. Symbol table entries of
-            // this type exist primarily for relocation and normally have
-            // STB_LOCAL binding.
-            break;
+    Mutex mutex;
+    Symbol *symbols;
+    const unsigned num_symbols;
+    const user_id_t start_id;
+    SectionList *section_list;
+    const uint32_t entsize;
+    const DataExtractor &symtab_data;
+    const DataExtractor &strtab_data;
+    unsigned next_symbol; // First symbol of the next unclaimed chunk
+    unsigned num_parsed;  // Index of the first symbol that failed to parse
+};
 
-        case STT_FILE:
-            // Conventionally, the symbol's name gives the name of the source
-            // file associated with the object file. A file symbol has STB_LOCAL
-            // binding, its section index is SHN_ABS, and it precedes the other
-            // STB_LOCAL symbols for the file, if it is present.
-            symbol_type = eSymbolTypeObjectFile;
-            break;
+// Symbols are claimed in chunks large enough that the names of a chunk can
+// be added to the string pool with one lock.
+const unsigned g_symbol_parse_chunk_size = 4096;
+
+}
+
+static lldb::thread_result_t
+ParseSymbolsThread(lldb::thread_arg_t arg)
+{
+    SymbolTableParse *parse = (SymbolTableParse *)arg;
+    std::vector<ELFSymbol> elf_symbols;
+    std::vector<const char *> names;
+    std::vector<ConstString> const_names;
+    while (1)
+    {
+        unsigned begin;
+        unsigned end;
+        {
+            Mutex::Locker locker(parse->mutex);
+            begin = parse->next_symbol;
+            if (begin >= parse->num_symbols)
+                break;
+            end = std::min(begin + g_symbol_parse_chunk_size, parse->num_symbols);
+            parse->next_symbol = end;
         }
 
-        if (symbol_type == eSymbolTypeInvalid)
+        const unsigned count = end - begin;
+        elf_symbols.resize(count);
+        names.resize(count);
+        const_names.resize(count);
+
+        unsigned n;
+        for (n = 0; n < count; ++n)
         {
-            if (symbol_section)
-            {
-                const ConstString &sect_name = symbol_section->GetName();
-                if (sect_name == text_section_name ||
-                    sect_name == init_section_name ||
-                    sect_name == fini_section_name ||
-                    sect_name == ctors_section_name ||
-                    sect_name == dtors_section_name)
-                {
-                    symbol_type = eSymbolTypeCode;
-                }
-                else if (sect_name == data_section_name ||
-                         sect_name == data2_section_name ||
-                         sect_name == rodata_section_name ||
-                         sect_name == rodata1_section_name ||
-                         sect_name == bss_section_name)
-                {
-                    symbol_type = eSymbolTypeData;
-                }
-            }
+            uint32_t offset = (begin + n) * parse->entsize;
+            if (elf_symbols[n].Parse(parse->symtab_data, &offset) == false)
+                break;
+            const char *name = parse->strtab_data.PeekCStr(elf_symbols[n].st_name);
+            names[n] = (name && name[0]) ? name : NULL;
         }
 
-        uint64_t symbol_value = symbol.st_value;
-        if (symbol_section != NULL)
-            symbol_value -= symbol_section->GetFileAddress();
-        const char *symbol_name = strtab_data.PeekCStr(symbol.st_name);
-        bool is_global = symbol.getBinding() == STB_GLOBAL;
-        uint32_t flags = symbol.st_other << 8 | symbol.st_info;
-
-        Symbol dc_symbol(
-            i + start_id,    // ID is the original symbol table index.
-            symbol_name,     // Symbol name.
-            false,           // Is the symbol name mangled?
-            symbol_type,     // Type of this symbol
-            is_global,       // Is this globally visible?
-            false,           // Is this symbol debug info?
-            false,           // Is this symbol a trampoline?
-            false,           // Is this symbol artificial?
-            symbol_section,  // Section in which this symbol is defined or null.
-            symbol_value,    // Offset in section or symbol value.
-            symbol.st_size,  // Size in bytes of this symbol.
-            flags);          // Symbol flags.
-        symtab->AddSymbol(dc_symbol);
+        ConstString::SetCStrings(&names[0], n, &const_names[0]);
+
+        for (unsigned i = 0; i < n; ++i)
+            parse->symbols[begin + i] = CreateSymbol(elf_symbols[i],
+                                                     parse->start_id + begin + i,
+                                                     parse->section_list,
+                                                     const_names[i]);
+
+        if (n < count)
+        {
+            Mutex::Locker locker(parse->mutex);
+            parse->num_parsed = std::min(parse->num_parsed, begin + n);
+        }
     }
+    return NULL;
+}
 
-    return i;
+static unsigned
+ParseSymbols(Symtab *symtab, 
+             user_id_t start_id,
+             SectionList *section_list,
+             const ELFSectionHeader *symtab_shdr,
+             const DataExtractor &symtab_data,
+             const DataExtractor &strtab_data)
+{
+    if (symtab_shdr->sh_entsize == 0)
+        return 0;
+
+    const unsigned num_symbols = 
+        symtab_data.GetByteSize() / symtab_shdr->sh_entsize;
+    if (num_symbols == 0)
+        return 0;
+
+    // Make room for all of the symbols up front so the parsing threads can
+    // fill in their chunks in place.
+    const uint32_t first_idx = symtab->GetNumSymbols();
+    Symbol *symbols = symtab->Resize(first_idx + num_symbols) + first_idx;
+
+    SymbolTableParse parse(symbols, num_symbols, start_id, section_list,
+                           symtab_shdr->sh_entsize, symtab_data, strtab_data);
+
+    // The calling thread is one of the workers.
+    const unsigned num_chunks = 
+        (num_symbols + g_symbol_parse_chunk_size - 1) / g_symbol_parse_chunk_size;
+    const unsigned num_threads = std::min<unsigned>(Host::GetNumberCPUS(), num_chunks);
+    std::vector<lldb::thread_t> threads;
+    for (unsigned i = 1; i < num_threads; ++i)
+    {
+        char thread_name[64];
+        ::snprintf(thread_name, sizeof(thread_name), "<lldb.object-file.elf.parse-symbols-%u>", i);
+        lldb::thread_t thread = Host::ThreadCreate(thread_name, ParseSymbolsThread, &parse, NULL);
+        if (IS_VALID_LLDB_HOST_THREAD(thread))
+            threads.push_back(thread);
+    }
+    ParseSymbolsThread(&parse);
+    for (size_t i = 0; i < threads.size(); ++i)
+        Host::ThreadJoin(threads[i], NULL, NULL);
+
+    // Like the serial parse, stop at the first symbol that could not be
+    // parsed.
+    if (parse.num_parsed < num_symbols)
+        symtab->Resize(first_idx + parse.num_parsed);
+
+    return parse.num_parsed;
 }
 
 unsigned
@@ -1080,6 +1309,17 @@ ObjectFileELF::GetSymtab()
     if (!(ParseSectionHeaders() && GetSectionHeaderStringTable()))
         return symbol_table;
 
+    // Reserve space for the entries of all the linker symbol tables so
+    // parsing them doesn't grow the symbol table piecemeal.
+    uint32_t num_entries = 0;
+    for (SectionHeaderCollIter I = m_section_headers.begin();
+         I != m_section_headers.end(); ++I)
+    {
+        if ((I->sh_type == SHT_SYMTAB || I->sh_type == SHT_DYNSYM) && I->sh_entsize)
+            num_entries += I->sh_size / I->sh_entsize;
+    }
+    symbol_table->Reserve(num_entries);
+
     // Locate and parse all linker symbol tables.
     uint64_t symbol_id = 0;
     for (SectionHeaderCollIter I = m_section_headers.begin();
@@ -1108,6 +1348,231 @@ ObjectFileELF::GetSymtab()
     return symbol_table;
 }
 
+bool
+ObjectFileELF::FindSymbolsWithNameAndType(const ConstString &name,
+                                          SymbolType symbol_type,
+                                          std::vector<Symbol *> &symbols)
+{
+    // The hash tables only cover the defined symbols in .dynsym, so only
+    // code and data lookups can be answered from them. Trampolines are
+    // synthesized from the PLT relocations and undefined symbols are not
+    // hashed, so those lookups, and any lookup once the symbol table has
+    // been parsed, go to the symbol table.
+    if (!name || m_symtab_ap.get())
+        return false;
+    if (symbol_type != eSymbolTypeCode && symbol_type != eSymbolTypeData)
+        return false;
+
+    Mutex::Locker locker(m_hash_mutex);
+    if (!ParseHashSection())
+        return false;
+
+    std::vector<uint32_t> indexes;
+    if (m_hash_type == LLDB_SHT_GNU_HASH)
+        LookupGNUHash(name.GetCString(), indexes);
+    else
+        LookupSysVHash(name.GetCString(), indexes);
+
+    SectionList *section_list = GetSectionList();
+    for (size_t i = 0; i < indexes.size(); ++i)
+    {
+        const uint32_t idx = indexes[i];
+        HashedSymbolMap::iterator pos = m_hashed_symbols.find(idx);
+        if (pos == m_hashed_symbols.end())
+        {
+            ELFSymbol symbol;
+            if (!DynamicSymbolMatches(idx, name.GetCString(), symbol))
+                continue;
+            // .dynsym is the only symbol table when hashed lookups are
+            // used, so the index is also the ID the symbol gets in the
+            // symbol table.
+            pos = m_hashed_symbols.insert(std::make_pair(idx, CreateSymbol(symbol, idx, section_list, name))).first;
+        }
+
+        if (pos->second.GetType() == symbol_type)
+            symbols.push_back(&pos->second);
+    }
+    return true;
+}
+
+bool
+ObjectFileELF::HasSymbolNameLookupTable()
+{
+    Mutex::Locker locker(m_hash_mutex);
+    return ParseHashSection();
+}
+
+bool
+ObjectFileELF::ParseHashSection()
+{
+    if (m_hash_parsed)
+        return m_hash_type != 0;
+    m_hash_parsed = true;
+
+    if (!ParseSectionHeaders())
+        return false;
+
+    // Local symbols are only in .symtab, so if there is one the hash table
+    // of .dynsym can't answer every lookup.  Prefer .gnu.hash to .hash when
+    // the linker emitted both.
+    SectionHeaderCollConstIter hash_iter = m_section_headers.end();
+    for (SectionHeaderCollConstIter I = m_section_headers.begin();
+         I != m_section_headers.end(); ++I)
+    {
+        if (I->sh_type == SHT_SYMTAB)
+            return false;
+
+        if (I->sh_type == LLDB_SHT_GNU_HASH ||
+            (I->sh_type == SHT_HASH && hash_iter == m_section_headers.end()))
+            hash_iter = I;
+    }
+    if (hash_iter == m_section_headers.end())
+        return false;
+
+    SectionList *section_list = GetSectionList();
+    if (!section_list)
+        return false;
+
+    // The hash section links to the symbol table it indexes, which in turn
+    // links to its string table.  Section ID's are ones based.
+    const user_id_t hash_id = SectionIndex(hash_iter);
+    const user_id_t dynsym_id = hash_iter->sh_link + 1;
+    const ELFSectionHeader *dynsym_hdr = GetSectionHeaderByIndex(dynsym_id);
+    if (!dynsym_hdr || dynsym_hdr->sh_type != SHT_DYNSYM)
+        return false;
+
+    Section *hash = section_list->FindSectionByID(hash_id).get();
+    Section *dynsym = section_list->FindSectionByID(dynsym_id).get();
+    Section *dynstr = section_list->FindSectionByID(dynsym_hdr->sh_link + 1).get();
+    if (!hash || !dynsym || !dynstr)
+        return false;
+
+    if (!hash->MemoryMapSectionDataFromObjectFile(this, m_hash_data) ||
+        !dynsym->MemoryMapSectionDataFromObjectFile(this, m_dynsym_data) ||
+        !dynstr->MemoryMapSectionDataFromObjectFile(this, m_dynstr_data))
+        return false;
+
+    m_hash_type = hash_iter->sh_type;
+    return true;
+}
+
+void
+ObjectFileELF::LookupGNUHash(const char *name, std::vector<uint32_t> &indexes)
+{
+    // The header is followed by the bloom filter words (which are the size
+    // of an address), the buckets, and one hash value per symbol starting
+    // at symoffset.
+    uint32_t offset = 0;
+    if (!m_hash_data.ValidOffsetForDataOfSize(offset, 16))
+        return;
+    const uint32_t nbuckets = m_hash_data.GetU32(&offset);
+    const uint32_t symoffset = m_hash_data.GetU32(&offset);
+    const uint32_t bloom_size = m_hash_data.GetU32(&offset);
+    const uint32_t bloom_shift = m_hash_data.GetU32(&offset);
+    if (nbuckets == 0 || bloom_size == 0)
+        return;
+
+    uint32_t hash = 5381;
+    for (const uint8_t *p = (const uint8_t *)name; *p; ++p)
+        hash = hash * 33 + *p;
+
+    // Most names that aren't defined in this file are rejected by the bloom
+    // filter without looking at the buckets.
+    const uint32_t word_size = GetAddressByteSize();
+    const uint32_t word_bits = word_size * 8;
+    uint32_t word_offset = offset + ((hash / word_bits) % bloom_size) * word_size;
+    if (!m_hash_data.ValidOffsetForDataOfSize(word_offset, word_size))
+        return;
+    const uint64_t word = m_hash_data.GetMaxU64(&word_offset, word_size);
+    const uint64_t mask = (1ull << (hash % word_bits)) |
+                          (1ull << ((hash >> bloom_shift) % word_bits));
+    if ((word & mask) != mask)
+        return;
+
+    const uint32_t buckets_offset = offset + bloom_size * word_size;
+    uint32_t bucket_offset = buckets_offset + (hash % nbuckets) * 4;
+    if (!m_hash_data.ValidOffsetForDataOfSize(bucket_offset, 4))
+        return;
+    uint32_t idx = m_hash_data.GetU32(&bucket_offset);
+    if (idx < symoffset)
+        return;
+
+    // Symbols in a bucket are consecutive and the low bit of the hash value
+    // marks the last one.
+    const uint32_t chain_offset = buckets_offset + nbuckets * 4;
+    ELFSymbol symbol;
+    for (;; ++idx)
+    {
+        uint32_t hash_offset = chain_offset + (idx - symoffset) * 4;
+        if (!m_hash_data.ValidOffsetForDataOfSize(hash_offset, 4))
+            break;
+        const uint32_t chain_hash = m_hash_data.GetU32(&hash_offset);
+        if ((chain_hash | 1) == (hash | 1) && DynamicSymbolMatches(idx, name, symbol))
+            indexes.push_back(idx);
+        if (chain_hash & 1)
+            break;
+    }
+}
+
+void
+ObjectFileELF::LookupSysVHash(const char *name, std::vector<uint32_t> &indexes)
+{
+    uint32_t offset = 0;
+    if (!m_hash_data.ValidOffsetForDataOfSize(offset, 8))
+        return;
+    const uint32_t nbucket = m_hash_data.GetU32(&offset);
+    const uint32_t nchain = m_hash_data.GetU32(&offset);
+    if (nbucket == 0)
+        return;
+
+    uint32_t hash = 0;
+    for (const uint8_t *p = (const uint8_t *)name; *p; ++p)
+    {
+        hash = (hash << 4) + *p;
+        const uint32_t high = hash & 0xf0000000;
+        if (high)
+            hash ^= high >> 24;
+        hash &= ~high;
+    }
+
+    uint32_t bucket_offset = offset + (hash % nbucket) * 4;
+    if (!m_hash_data.ValidOffsetForDataOfSize(bucket_offset, 4))
+        return;
+    uint32_t idx = m_hash_data.GetU32(&bucket_offset);
+
+    // The chain ends at STN_UNDEF (zero).  Never follow more links than
+    // there are symbols in case the table is corrupt.
+    const uint32_t chain_offset = offset + nbucket * 4;
+    ELFSymbol symbol;
+    for (uint32_t count = 0; idx != 0 && idx < nchain && count < nchain; ++count)
+    {
+        if (DynamicSymbolMatches(idx, name, symbol))
+            indexes.push_back(idx);
+
+        uint32_t link_offset = chain_offset + idx * 4;
+        if (!m_hash_data.ValidOffsetForDataOfSize(link_offset, 4))
+            break;
+        idx = m_hash_data.GetU32(&link_offset);
+    }
+}
+
+bool
+ObjectFileELF::DynamicSymbolMatches(uint32_t idx, const char *name, ELFSymbol &symbol)
+{
+    // Elf32_Sym is 16 bytes and Elf64_Sym is 24 bytes.
+    const uint32_t entsize = GetAddressByteSize() == 4 ? 16 : 24;
+    uint32_t offset = idx * entsize;
+    if (!m_dynsym_data.ValidOffsetForDataOfSize(offset, entsize) ||
+        !symbol.Parse(m_dynsym_data, &offset))
+        return false;
+
+    if (symbol.st_shndx == SHN_UNDEF)
+        return false;
+
+    const char *symbol_name = m_dynstr_data.PeekCStr(symbol.st_name);
+    return symbol_name && strcmp(symbol_name, name) == 0;
+}
+
 //===----------------------------------------------------------------------===//
 // Dump
 //
@@ -11,10 +11,12 @@
 #define liblldb_ObjectFileELF_h_
 
 #include <stdint.h>
+#include <map>
 #include <vector>
 
 #include "lldb/lldb-private.h"
 #include "lldb/Host/FileSpec.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Symbol/ObjectFile.h"
 
 #include "ELFHeader.h"
@@ -84,6 +86,14 @@ public:
     virtual lldb_private::Symtab *
     GetSymtab();
 
+    virtual bool
+    HasSymbolNameLookupTable();
+
+    virtual bool
+    FindSymbolsWithNameAndType(const lldb_private::ConstString &name,
+                               lldb::SymbolType symbol_type,
+                               std::vector<lldb_private::Symbol *> &symbols);
+
     virtual lldb_private::SectionList *
     GetSectionList();
 
@@ -130,6 +140,8 @@ private:
     typedef DynamicSymbolColl::iterator         DynamicSymbolCollIter;
     typedef DynamicSymbolColl::const_iterator   DynamicSymbolCollConstIter;
 
+    typedef std::map<uint32_t, lldb_private::Symbol> HashedSymbolMap;
+
     /// Version of this reader common to all plugins based on this class.
     static const uint32_t m_plugin_version = 1;
 
@@ -161,6 +173,26 @@ private:
     /// Cached value of the entry point for this module.
     lldb_private::Address  m_entry_point_address;
 
+    /// The dynamic symbol table, its string table and its .gnu.hash or .hash
+    /// section, used to look up exported symbols by name before the symbol
+    /// table has been parsed.
+    lldb_private::DataExtractor m_dynsym_data;
+    lldb_private::DataExtractor m_dynstr_data;
+    lldb_private::DataExtractor m_hash_data;
+
+    /// The type of the section in m_hash_data (SHT_GNU_HASH or SHT_HASH), or
+    /// zero if hashed lookups can not be used for this file.
+    unsigned m_hash_type;
+
+    /// True once ParseHashSection has been called.
+    bool m_hash_parsed;
+
+    /// Symbols created by hashed lookups keyed by their index in .dynsym.
+    HashedSymbolMap m_hashed_symbols;
+
+    /// Protects the hashed lookup state above.
+    lldb_private::Mutex m_hash_mutex;
+
     /// Returns a 1 based index of the given section header.
     unsigned
     SectionIndex(const SectionHeaderCollIter &I);
@@ -211,6 +243,42 @@ private:
                            const elf::ELFSectionHeader *rela_hdr,
                            lldb::user_id_t section_id);
 
+    /// Fills in @p data with @p length bytes of the object file starting at
+    /// @p file_offset, using the already mapped header data when it covers
+    /// the range.  Returns true if all of the bytes could be read.
+    bool
+    GetFileData(elf::elf_off file_offset, size_t length,
+                lldb_private::DataExtractor &data);
+
+    /// Scans the notes in @p data for an NT_GNU_BUILD_ID note and stores its
+    /// descriptor in @p uuid.  Returns true if a build ID was found.
+    static bool
+    ParseBuildID(const lldb_private::DataExtractor &data,
+                 lldb_private::UUID &uuid);
+
+    /// Locates the hash section for the dynamic symbol table and loads the
+    /// data needed for hashed lookups.  Returns true if hashed lookups can be
+    /// used, which requires a .gnu.hash or .hash section and no .symtab
+    /// (whose local symbols are not in the hash table).
+    bool
+    ParseHashSection();
+
+    /// Appends the .dynsym indexes of the defined symbols named @p name to
+    /// @p indexes by walking the bloom filter and the bucket chain of the
+    /// .gnu.hash section.
+    void
+    LookupGNUHash(const char *name, std::vector<uint32_t> &indexes);
+
+    /// Appends the .dynsym indexes of the defined symbols named @p name to
+    /// @p indexes by walking the bucket chain of the SysV .hash section.
+    void
+    LookupSysVHash(const char *name, std::vector<uint32_t> &indexes);
+
+    /// Returns true and fills in @p symbol if .dynsym entry @p idx is a
+    /// defined symbol named @p name.
+    bool
+    DynamicSymbolMatches(uint32_t idx, const char *name, elf::ELFSymbol &symbol);
+
     /// Loads the section name string table into m_shstr_data.  Returns the
     /// number of bytes constituting the table.
     size_t
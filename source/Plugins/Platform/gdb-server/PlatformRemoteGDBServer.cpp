@@ -25,9 +25,12 @@
 #include "lldb/Core/StreamString.h"
 #include "lldb/Host/FileSpec.h"
 #include "lldb/Host/Host.h"
+#include "lldb/Interpreter/CommandObjectMultiword.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
+#include "../../Process/gdb-remote/ProcessGDBRemote.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -114,7 +117,8 @@ PlatformRemoteGDBServer::GetFile (const FileSpec &platform_file,
 //------------------------------------------------------------------
 PlatformRemoteGDBServer::PlatformRemoteGDBServer () :
     Platform(false), // This is a remote platform
-    m_gdb_client(true)
+    m_gdb_client(true),
+    m_command_sp()
 {
 }
 
@@ -203,9 +207,6 @@ PlatformRemoteGDBServer::ConnectRemote (Args& args)
                 {
                     m_gdb_client.QueryNoAckModeSupported();
                     m_gdb_client.GetHostInfo();
-#if 0
-                    m_gdb_client.TestPacketSpeed(10000);
-#endif
                 }
                 else
                 {
@@ -230,6 +231,21 @@ PlatformRemoteGDBServer::DisconnectRemote ()
     return error;
 }
 
+CommandObject *
+PlatformRemoteGDBServer::GetPluginCommandObject (CommandInterpreter &interpreter)
+{
+    if (!m_command_sp)
+    {
+        CommandObjectMultiword *plugin_cmd = new CommandObjectMultiword (interpreter,
+                                                                         "platform plugin",
+                                                                         "A set of commands for operating on a remote GDB server platform.",
+                                                                         "platform plugin <subcommand> [<subcommand-options>]");
+        m_command_sp.reset (plugin_cmd);
+        plugin_cmd->LoadSubCommand ("packet", CommandObjectSP (ProcessGDBRemote::CreatePacketCommandObject (interpreter, "platform plugin", m_gdb_client)));
+    }
+    return m_command_sp.get();
+}
+
 const char *
 PlatformRemoteGDBServer::GetHostname ()
 {
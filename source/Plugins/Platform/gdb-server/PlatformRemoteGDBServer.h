@@ -140,8 +140,12 @@ public:
     virtual lldb_private::Error
     DisconnectRemote ();
 
+    virtual lldb_private::CommandObject *
+    GetPluginCommandObject (lldb_private::CommandInterpreter &interpreter);
+
 protected:
     GDBRemoteCommunicationClient m_gdb_client;
+    lldb::CommandObjectSP m_command_sp;
     std::string m_platform_description; // After we connect we can get a more complete description of what we are connected to
 
 private:
@@ -100,16 +100,24 @@ ProcessLinux::UpdateThreadList(ThreadList &old_thread_list, ThreadList &new_thre
     if (log && log->GetMask().Test(POSIX_LOG_VERBOSE))
         log->Printf ("ProcessLinux::%s() (pid = %i)", __FUNCTION__, GetID());
 
-    // Update the process thread list with this new thread.
-    // FIXME: We should be using tid, not pid.
+    // Update the process thread list with every thread the monitor is
+    // tracing.  Threads we already know about are carried over; new ones are
+    // cheap to create as their register contexts are built on first use.
     assert(m_monitor);
-    ThreadSP thread_sp (old_thread_list.FindThreadByID (GetID(), false));
-    if (!thread_sp)
-        thread_sp.reset(new POSIXThread(*this, GetID()));
+    std::vector<lldb::tid_t> tids;
+    m_monitor->GetThreadIDs(tids);
 
-    if (log && log->GetMask().Test(POSIX_LOG_VERBOSE))
-        log->Printf ("ProcessLinux::%s() updated pid = %i", __FUNCTION__, GetID());
-    new_thread_list.AddThread(thread_sp);
+    for (size_t i = 0; i < tids.size(); ++i)
+    {
+        const lldb::tid_t tid = tids[i];
+        ThreadSP thread_sp (old_thread_list.FindThreadByID (tid, false));
+        if (!thread_sp)
+            thread_sp.reset(new POSIXThread(*this, tid));
+
+        if (log && log->GetMask().Test(POSIX_LOG_VERBOSE))
+            log->Printf ("ProcessLinux::%s() updated tid = %i", __FUNCTION__, tid);
+        new_thread_list.AddThread(thread_sp);
+    }
 
     return new_thread_list.GetSize(false);
 }
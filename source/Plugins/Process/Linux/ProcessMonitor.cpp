@@ -8,12 +8,17 @@
 //===----------------------------------------------------------------------===//
 
 // C Includes
+#include <dirent.h>
 #include <errno.h>
+#include <limits.h>
 #include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/ptrace.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 
@@ -36,6 +41,10 @@
 
 #define DEBUG_PTRACE_MAXBYTES 20
 
+// Events we want reported for every traced thread: exits (so the inferior can
+// be held in limbo) and clones (so new threads are traced from birth).
+#define PTRACE_OPTIONS (PTRACE_O_TRACEEXIT | PTRACE_O_TRACECLONE)
+
 using namespace lldb_private;
 
 // FIXME: this code is host-dependent with respect to types and
@@ -404,13 +413,15 @@ WriteOperation::Execute(ProcessMonitor *monitor)
 class ReadRegOperation : public Operation
 {
 public:
-    ReadRegOperation(unsigned offset, RegisterValue &value, bool &result)
-        : m_offset(offset), m_value(value), m_result(result)
+    ReadRegOperation(lldb::tid_t tid, unsigned offset, RegisterValue &value,
+                     bool &result)
+        : m_tid(tid), m_offset(offset), m_value(value), m_result(result)
         { }
 
     void Execute(ProcessMonitor *monitor);
 
 private:
+    lldb::tid_t m_tid;
     unsigned m_offset;
     RegisterValue &m_value;
     bool &m_result;
@@ -419,12 +430,11 @@ private:
 void
 ReadRegOperation::Execute(ProcessMonitor *monitor)
 {
-    lldb::pid_t pid = monitor->GetPID();
     LogSP log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_REGISTERS));
 
     // Set errno to zero so that we can detect a failed peek.
     errno = 0;
-    lldb::addr_t data = PTRACE(PTRACE_PEEKUSER, pid, (void*)m_offset, NULL);
+    lldb::addr_t data = PTRACE(PTRACE_PEEKUSER, m_tid, (void*)m_offset, NULL);
     if (data == -1UL && errno)
         m_result = false;
     else
@@ -443,13 +453,15 @@ ReadRegOperation::Execute(ProcessMonitor *monitor)
 class WriteRegOperation : public Operation
 {
 public:
-    WriteRegOperation(unsigned offset, const RegisterValue &value, bool &result)
-        : m_offset(offset), m_value(value), m_result(result)
+    WriteRegOperation(lldb::tid_t tid, unsigned offset,
+                      const RegisterValue &value, bool &result)
+        : m_tid(tid), m_offset(offset), m_value(value), m_result(result)
         { }
 
     void Execute(ProcessMonitor *monitor);
 
 private:
+    lldb::tid_t m_tid;
     unsigned m_offset;
     const RegisterValue &m_value;
     bool &m_result;
@@ -459,7 +471,6 @@ void
 WriteRegOperation::Execute(ProcessMonitor *monitor)
 {
     void* buf;
-    lldb::pid_t pid = monitor->GetPID();
     LogSP log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_REGISTERS));
 
     if (sizeof(void*) == sizeof(uint64_t))
@@ -473,7 +484,7 @@ WriteRegOperation::Execute(ProcessMonitor *monitor)
     if (log)
         log->Printf ("ProcessMonitor::%s() reg %s: %p", __FUNCTION__,
                      POSIXThread::GetRegisterNameFromOffset(m_offset), buf);
-    if (PTRACE(PTRACE_POKEUSER, pid, (void*)m_offset, buf))
+    if (PTRACE(PTRACE_POKEUSER, m_tid, (void*)m_offset, buf))
         m_result = false;
     else
         m_result = true;
@@ -485,13 +496,14 @@ WriteRegOperation::Execute(ProcessMonitor *monitor)
 class ReadGPROperation : public Operation
 {
 public:
-    ReadGPROperation(void *buf, bool &result)
-        : m_buf(buf), m_result(result)
+    ReadGPROperation(lldb::tid_t tid, void *buf, bool &result)
+        : m_tid(tid), m_buf(buf), m_result(result)
         { }
 
     void Execute(ProcessMonitor *monitor);
 
 private:
+    lldb::tid_t m_tid;
     void *m_buf;
     bool &m_result;
 };
@@ -499,7 +511,7 @@ private:
 void
 ReadGPROperation::Execute(ProcessMonitor *monitor)
 {
-    if (PTRACE(PTRACE_GETREGS, monitor->GetPID(), NULL, m_buf) < 0)
+    if (PTRACE(PTRACE_GETREGS, m_tid, NULL, m_buf) < 0)
         m_result = false;
     else
         m_result = true;
@@ -511,13 +523,14 @@ ReadGPROperation::Execute(ProcessMonitor *monitor)
 class ReadFPROperation : public Operation
 {
 public:
-    ReadFPROperation(void *buf, bool &result)
-        : m_buf(buf), m_result(result)
+    ReadFPROperation(lldb::tid_t tid, void *buf, bool &result)
+        : m_tid(tid), m_buf(buf), m_result(result)
         { }
 
     void Execute(ProcessMonitor *monitor);
 
 private:
+    lldb::tid_t m_tid;
     void *m_buf;
     bool &m_result;
 };
@@ -525,7 +538,7 @@ private:
 void
 ReadFPROperation::Execute(ProcessMonitor *monitor)
 {
-    if (PTRACE(PTRACE_GETFPREGS, monitor->GetPID(), NULL, m_buf) < 0)
+    if (PTRACE(PTRACE_GETFPREGS, m_tid, NULL, m_buf) < 0)
         m_result = false;
     else
         m_result = true;
@@ -537,13 +550,14 @@ ReadFPROperation::Execute(ProcessMonitor *monitor)
 class WriteGPROperation : public Operation
 {
 public:
-    WriteGPROperation(void *buf, bool &result)
-        : m_buf(buf), m_result(result)
+    WriteGPROperation(lldb::tid_t tid, void *buf, bool &result)
+        : m_tid(tid), m_buf(buf), m_result(result)
         { }
 
     void Execute(ProcessMonitor *monitor);
 
 private:
+    lldb::tid_t m_tid;
     void *m_buf;
     bool &m_result;
 };
@@ -551,7 +565,7 @@ private:
 void
 WriteGPROperation::Execute(ProcessMonitor *monitor)
 {
-    if (PTRACE(PTRACE_SETREGS, monitor->GetPID(), NULL, m_buf) < 0)
+    if (PTRACE(PTRACE_SETREGS, m_tid, NULL, m_buf) < 0)
         m_result = false;
     else
         m_result = true;
@@ -563,13 +577,14 @@ WriteGPROperation::Execute(ProcessMonitor *monitor)
 class WriteFPROperation : public Operation
 {
 public:
-    WriteFPROperation(void *buf, bool &result)
-        : m_buf(buf), m_result(result)
+    WriteFPROperation(lldb::tid_t tid, void *buf, bool &result)
+        : m_tid(tid), m_buf(buf), m_result(result)
         { }
 
     void Execute(ProcessMonitor *monitor);
 
 private:
+    lldb::tid_t m_tid;
     void *m_buf;
     bool &m_result;
 };
@@ -577,7 +592,7 @@ private:
 void
 WriteFPROperation::Execute(ProcessMonitor *monitor)
 {
-    if (PTRACE(PTRACE_SETFPREGS, monitor->GetPID(), NULL, m_buf) < 0)
+    if (PTRACE(PTRACE_SETFPREGS, m_tid, NULL, m_buf) < 0)
         m_result = false;
     else
         m_result = true;
@@ -739,11 +754,14 @@ private:
 void
 DetachOperation::Execute(ProcessMonitor *monitor)
 {
-    lldb::pid_t pid = monitor->GetPID();
+    std::vector<lldb::tid_t> tids;
+    monitor->GetThreadIDs(tids);
 
-    if (ptrace(PT_DETACH, pid, NULL, 0) < 0)
-        m_error.SetErrorToErrno();
-  
+    for (size_t i = 0; i < tids.size(); ++i)
+    {
+        if (ptrace(PT_DETACH, tids[i], NULL, 0) < 0 && m_error.Success())
+            m_error.SetErrorToErrno();
+    }
 }
 
 ProcessMonitor::OperationArgs::OperationArgs(ProcessMonitor *monitor)
@@ -848,8 +866,8 @@ WAIT_AGAIN:
     }
 
     // Finally, start monitoring the child process for change in state.
-    m_monitor_thread = Host::StartMonitoringChildProcess(
-        ProcessMonitor::MonitorCallback, this, GetPID(), true);
+    m_monitor_thread = Host::ThreadCreate(
+        "lldb.process.linux.monitor", MonitorThread, this, NULL);
     if (!IS_VALID_LLDB_HOST_THREAD(m_monitor_thread))
     {
         error.SetErrorToGenericError();
@@ -906,8 +924,8 @@ WAIT_AGAIN:
     }
 
     // Finally, start monitoring the child process for change in state.
-    m_monitor_thread = Host::StartMonitoringChildProcess(
-        ProcessMonitor::MonitorCallback, this, GetPID(), true);
+    m_monitor_thread = Host::ThreadCreate(
+        "lldb.process.linux.monitor", MonitorThread, this, NULL);
     if (!IS_VALID_LLDB_HOST_THREAD(m_monitor_thread))
     {
         error.SetErrorToGenericError();
@@ -1083,8 +1101,9 @@ ProcessMonitor::Launch(LaunchArgs *args)
            "Could not sync with inferior process.");
 
     // Have the child raise an event on exit.  This is used to keep the child in
-    // limbo until it is destroyed.
-    if (PTRACE(PTRACE_SETOPTIONS, pid, NULL, (void*)PTRACE_O_TRACEEXIT) < 0)
+    // limbo until it is destroyed.  Also have it report new threads; threads
+    // created by clone(2) inherit these options.
+    if (PTRACE(PTRACE_SETOPTIONS, pid, NULL, (void*)PTRACE_OPTIONS) < 0)
     {
         args->m_error.SetErrorToErrno();
         goto FINISH;
@@ -1104,7 +1123,10 @@ ProcessMonitor::Launch(LaunchArgs *args)
     // Update the process thread list with this new thread and mark it as
     // current.
     // FIXME: should we be letting UpdateThreadList handle this?
-    // FIXME: by using pids instead of tids, we can only support one thread.
+    {
+        Mutex::Locker lock(monitor->m_threads_mutex);
+        monitor->m_tids.insert(pid);
+    }
     inferior.reset(new POSIXThread(process, pid));
     if (log)
         log->Printf ("ProcessMonitor::%s() adding pid = %i", __FUNCTION__, pid);
@@ -1178,22 +1200,14 @@ ProcessMonitor::Attach(AttachArgs *args)
         goto FINISH;
     }
 
-    // Attach to the requested process.
-    if (PTRACE(PTRACE_ATTACH, pid, NULL, NULL) < 0)
-    {
-        args->m_error.SetErrorToErrno();
-        goto FINISH;
-    }
-
-    int status;
-    if ((status = waitpid(pid, NULL, 0)) < 0)
-    {
-        args->m_error.SetErrorToErrno();
+    // Attach to the requested process and each of its threads.
+    monitor->m_pid = pid;
+    if (!AttachThreads(pid, monitor, args->m_error))
         goto FINISH;
-    }
 
     // Update the process thread list with the attached thread and
-    // mark it as current.
+    // mark it as current.  The remaining threads are picked up by
+    // ProcessLinux::UpdateThreadList.
     inferior.reset(new POSIXThread(process, pid));
     if (log)
         log->Printf ("ProcessMonitor::%s() adding tid = %i", __FUNCTION__, pid);
@@ -1209,6 +1223,149 @@ ProcessMonitor::Attach(AttachArgs *args)
     return args->m_error.Success();
 }
 
+bool
+ProcessMonitor::AttachThreads(lldb::pid_t pid, ProcessMonitor *monitor,
+                              Error &error)
+{
+    char task_path[PATH_MAX];
+    ::snprintf(task_path, sizeof(task_path), "/proc/%llu/task",
+               (unsigned long long)pid);
+
+    // Threads may be created while we are attaching to their siblings, so
+    // rescan the task directory until a pass finds nothing new.
+    bool found_new;
+    do
+    {
+        DIR *dir = ::opendir(task_path);
+        if (dir == NULL)
+        {
+            error.SetErrorToErrno();
+            return false;
+        }
+
+        found_new = false;
+        struct dirent *entry;
+        while ((entry = ::readdir(dir)) != NULL)
+        {
+            const lldb::tid_t tid = ::strtoull(entry->d_name, NULL, 10);
+            if (tid == 0)
+                continue;
+
+            {
+                Mutex::Locker lock(monitor->m_threads_mutex);
+                if (monitor->m_tids.count(tid))
+                    continue;
+            }
+
+            if (PTRACE(PTRACE_ATTACH, tid, NULL, NULL) < 0)
+            {
+                // A thread other than the leader may exit under our feet.
+                if (errno == ESRCH && tid != pid)
+                    continue;
+                error.SetErrorToErrno();
+                ::closedir(dir);
+                return false;
+            }
+
+            int status;
+            if (::waitpid(tid, &status, __WALL) < 0 ||
+                PTRACE(PTRACE_SETOPTIONS, tid, NULL, (void*)PTRACE_OPTIONS) < 0)
+            {
+                error.SetErrorToErrno();
+                ::closedir(dir);
+                return false;
+            }
+
+            Mutex::Locker lock(monitor->m_threads_mutex);
+            monitor->m_tids.insert(tid);
+            found_new = true;
+        }
+        ::closedir(dir);
+    } while (found_new);
+
+    return true;
+}
+
+void *
+ProcessMonitor::MonitorThread(void *arg)
+{
+    ProcessMonitor *monitor = static_cast<ProcessMonitor*>(arg);
+
+    for (;;)
+    {
+        int status;
+        const ::pid_t wait_pid = monitor->WaitForThread(status);
+        if (wait_pid == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        bool exited = false;
+        int signal = 0;
+        int exit_status = 0;
+        if (WIFSTOPPED(status))
+            signal = WSTOPSIG(status);
+        else if (WIFEXITED(status))
+        {
+            exited = true;
+            exit_status = WEXITSTATUS(status);
+        }
+        else if (WIFSIGNALED(status))
+        {
+            exited = true;
+            signal = WTERMSIG(status);
+            exit_status = -1;
+        }
+        else
+            continue;
+
+        LogSP log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
+        if (log)
+            log->Printf ("ProcessMonitor::%s() tid = %i, status = 0x%8.8x",
+                         __FUNCTION__, wait_pid, status);
+
+        // Do not honour cancellation requests while talking to the operation
+        // thread on behalf of the inferior.
+        int old_state;
+        ::pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &old_state);
+        const bool stop_monitoring = MonitorCallback(monitor, wait_pid, exited,
+                                                     signal, exit_status);
+        ::pthread_setcancelstate(old_state, NULL);
+
+        if (stop_monitoring)
+            break;
+    }
+
+    return NULL;
+}
+
+::pid_t
+ProcessMonitor::WaitForThread(int &status)
+{
+    // Wait on the process group of the inferior rather than on any child:
+    // that catches every one of its threads (__WALL is needed for those)
+    // without reaping unrelated children of the debugger.  Should the
+    // inferior move itself to another group, waitpid() fails with ECHILD
+    // and we simply retry with the new group.
+    lldb::pid_t last_pgid = LLDB_INVALID_PROCESS_ID;
+    for (;;)
+    {
+        const ::pid_t pgid = ::getpgid(m_pid);
+        if (pgid == -1 || (lldb::pid_t)pgid == last_pgid)
+        {
+            errno = ECHILD;
+            return -1;
+        }
+        last_pgid = pgid;
+
+        const ::pid_t wait_pid = ::waitpid(-pgid, &status, __WALL);
+        if (wait_pid != -1 || errno != ECHILD)
+            return wait_pid;
+    }
+}
+
 bool
 ProcessMonitor::MonitorCallback(void *callback_baton,
                                 lldb::pid_t pid,
@@ -1220,28 +1377,214 @@ ProcessMonitor::MonitorCallback(void *callback_baton,
     ProcessMonitor *monitor = static_cast<ProcessMonitor*>(callback_baton);
     ProcessLinux *process = monitor->m_process;
     assert(process);
-    bool stop_monitoring;
+
+    // Threads other than the leader come and go without affecting the state
+    // of the process as a whole.
+    if (exited)
+    {
+        monitor->RemoveThread(pid);
+        return pid == monitor->GetPID();
+    }
+
+    // The initial stop of a new thread is of no interest to the user.
+    if (monitor->NewThreadStopped(pid, signal))
+    {
+        monitor->Resume(pid, LLDB_INVALID_SIGNAL_NUMBER);
+        return false;
+    }
+
+    if (!monitor->GetThreadMessage(pid, signal, message))
+        return pid == monitor->GetPID(); // pid is gone.  Bail.
+
+    if (message.GetKind() == ProcessMessage::eInvalidMessage)
+    {
+        monitor->Resume(pid, LLDB_INVALID_SIGNAL_NUMBER);
+        return false;
+    }
+
+    // Bring the rest of the process to a halt before reporting the stop.
+    // Threads which stopped for reasons of their own on the way are queued
+    // ahead of the message that changes the process state.
+    std::vector<ProcessMessage> messages;
+    monitor->StopAllThreads(pid, messages);
+    for (size_t i = 0; i < messages.size(); ++i)
+        process->QueueMessage(messages[i]);
+
+    process->SendMessage(message);
+    return message.GetKind() == ProcessMessage::eExitMessage;
+}
+
+bool
+ProcessMonitor::GetThreadMessage(lldb::tid_t tid, int signo,
+                                 ProcessMessage &message)
+{
+    message = ProcessMessage();
+
+    // Swallow a SIGSTOP left behind by an earlier StopAllThreads.
+    if (signo == SIGSTOP)
+    {
+        Mutex::Locker lock(m_threads_mutex);
+        if (m_pending_stops.erase(tid))
+            return true;
+    }
+
     siginfo_t info;
+    if (!GetSignalInfo(tid, &info))
+        return false;
+
+    switch (info.si_signo)
+    {
+    case SIGTRAP:
+        message = MonitorSIGTRAP(this, &info, tid);
+        break;
+
+    default:
+        message = MonitorSignal(this, &info, tid);
+        break;
+    }
+    return true;
+}
+
+bool
+ProcessMonitor::NewThreadStopped(lldb::tid_t tid, int signo)
+{
+    if (signo != SIGSTOP)
+        return false;
+
+    // The kernel gives no ordering guarantee between the clone event of the
+    // parent and the initial stop of the child, so either may come first.
+    Mutex::Locker lock(m_threads_mutex);
+    if (m_pending_clones.erase(tid))
+        return true;
+    if (m_tids.count(tid))
+        return false;
+
+    m_tids.insert(tid);
+    m_early_clones.insert(tid);
+    return true;
+}
+
+void
+ProcessMonitor::AddClonedThread(lldb::tid_t tid)
+{
+    Mutex::Locker lock(m_threads_mutex);
+    if (m_early_clones.erase(tid))
+        return;
+
+    m_tids.insert(tid);
+    m_pending_clones.insert(tid);
+}
+
+void
+ProcessMonitor::RemoveThread(lldb::tid_t tid)
+{
+    Mutex::Locker lock(m_threads_mutex);
+    m_tids.erase(tid);
+    m_pending_clones.erase(tid);
+    m_early_clones.erase(tid);
+    m_pending_stops.erase(tid);
+    m_suspended.erase(tid);
+}
+
+size_t
+ProcessMonitor::GetThreadIDs(std::vector<lldb::tid_t> &tids)
+{
+    Mutex::Locker lock(m_threads_mutex);
+    tids.assign(m_tids.begin(), m_tids.end());
+    return tids.size();
+}
+
+void
+ProcessMonitor::StopAllThreads(lldb::tid_t stopped_tid,
+                               std::vector<ProcessMessage> &messages)
+{
+    LogSP log (ProcessPOSIXLog::GetLogIfAllCategoriesSet (POSIX_LOG_PROCESS));
 
-    if (!monitor->GetSignalInfo(pid, &info))
-        stop_monitoring = true; // pid is gone.  Bail.
-    else {
-        switch (info.si_signo)
+    // Signal every thread first and only then start reaping them, so that
+    // the threads stop concurrently and we pay for one round of scheduling
+    // rather than one per thread.
+    std::set<lldb::tid_t> waiting;
+    {
+        Mutex::Locker lock(m_threads_mutex);
+        for (std::set<lldb::tid_t>::const_iterator pos = m_tids.begin();
+             pos != m_tids.end(); ++pos)
         {
-        case SIGTRAP:
-            message = MonitorSIGTRAP(monitor, &info, pid);
-            break;
-            
-        default:
-            message = MonitorSignal(monitor, &info, pid);
-            break;
+            const lldb::tid_t tid = *pos;
+            if (tid == stopped_tid || m_pending_clones.count(tid) ||
+                m_suspended.count(tid))
+                continue;
+            if (::syscall(SYS_tgkill, m_pid, tid, SIGSTOP) == 0)
+                waiting.insert(tid);
         }
 
-        process->SendMessage(message);
-        stop_monitoring = message.GetKind() == ProcessMessage::eExitMessage;
+        // Freshly cloned threads stop on their own.
+        waiting.insert(m_pending_clones.begin(), m_pending_clones.end());
     }
 
-    return stop_monitoring;
+    if (log)
+        log->Printf ("ProcessMonitor::%s() stopping %u threads", __FUNCTION__,
+                     (unsigned)waiting.size());
+
+    while (!waiting.empty())
+    {
+        int status;
+        const ::pid_t wait_pid = WaitForThread(status);
+        if (wait_pid == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        const lldb::tid_t tid = wait_pid;
+        if (!WIFSTOPPED(status))
+        {
+            waiting.erase(tid);
+            RemoveThread(tid);
+            continue;
+        }
+
+        const int signo = WSTOPSIG(status);
+        if (signo == SIGSTOP && waiting.erase(tid))
+        {
+            // Our SIGSTOP, or the initial stop of a new thread.  Either way
+            // any SIGSTOP we had outstanding for the thread is now spent.
+            Mutex::Locker lock(m_threads_mutex);
+            m_pending_clones.erase(tid);
+            m_pending_stops.erase(tid);
+            continue;
+        }
+
+        // A thread cloned during the stop stays stopped.
+        if (NewThreadStopped(tid, signo))
+            continue;
+
+        ProcessMessage message;
+        if (!GetThreadMessage(tid, signo, message))
+        {
+            waiting.erase(tid);
+            continue;
+        }
+
+        if (message.GetKind() == ProcessMessage::eInvalidMessage)
+        {
+            // Let the thread run on into our SIGSTOP.  If it just cloned,
+            // wait for its child as well.
+            Resume(tid, LLDB_INVALID_SIGNAL_NUMBER);
+            Mutex::Locker lock(m_threads_mutex);
+            waiting.insert(m_pending_clones.begin(), m_pending_clones.end());
+            continue;
+        }
+
+        // The thread stopped for a reason of its own.  Our SIGSTOP is still
+        // queued and will be swallowed once the thread is resumed.
+        waiting.erase(tid);
+        {
+            Mutex::Locker lock(m_threads_mutex);
+            m_pending_stops.insert(tid);
+        }
+        messages.push_back(message);
+    }
 }
 
 ProcessMessage
@@ -1259,8 +1602,22 @@ ProcessMonitor::MonitorSIGTRAP(ProcessMonitor *monitor,
         assert(false && "Unexpected SIGTRAP code!");
         break;
 
+    case (SIGTRAP | (PTRACE_EVENT_CLONE << 8)):
+    {
+        // A new thread was created.  Start tracking it; the caller resumes
+        // the parent.
+        unsigned long tid = 0;
+        if (monitor->GetEventMessage(pid, &tid))
+            monitor->AddClonedThread(tid);
+        break;
+    }
+
     case (SIGTRAP | (PTRACE_EVENT_EXIT << 8)):
     {
+        // A thread other than the leader is exiting.  Let it go.
+        if (pid != monitor->GetPID())
+            break;
+
         // The inferior process is about to exit.  Maintain the process in a
         // state of "limbo" until we are explicitly commanded to detach,
         // destroy, resume, etc.
@@ -1570,55 +1927,57 @@ ProcessMonitor::WriteMemory(lldb::addr_t vm_addr, const void *buf, size_t size,
 }
 
 bool
-ProcessMonitor::ReadRegisterValue(unsigned offset, unsigned size, RegisterValue &value)
+ProcessMonitor::ReadRegisterValue(lldb::tid_t tid, unsigned offset,
+                                  unsigned size, RegisterValue &value)
 {
     bool result;
-    ReadRegOperation op(offset, value, result);
+    ReadRegOperation op(tid, offset, value, result);
     DoOperation(&op);
     return result;
 }
 
 bool
-ProcessMonitor::WriteRegisterValue(unsigned offset, const RegisterValue &value)
+ProcessMonitor::WriteRegisterValue(lldb::tid_t tid, unsigned offset,
+                                   const RegisterValue &value)
 {
     bool result;
-    WriteRegOperation op(offset, value, result);
+    WriteRegOperation op(tid, offset, value, result);
     DoOperation(&op);
     return result;
 }
 
 bool
-ProcessMonitor::ReadGPR(void *buf)
+ProcessMonitor::ReadGPR(lldb::tid_t tid, void *buf)
 {
     bool result;
-    ReadGPROperation op(buf, result);
+    ReadGPROperation op(tid, buf, result);
     DoOperation(&op);
     return result;
 }
 
 bool
-ProcessMonitor::ReadFPR(void *buf)
+ProcessMonitor::ReadFPR(lldb::tid_t tid, void *buf)
 {
     bool result;
-    ReadFPROperation op(buf, result);
+    ReadFPROperation op(tid, buf, result);
     DoOperation(&op);
     return result;
 }
 
 bool
-ProcessMonitor::WriteGPR(void *buf)
+ProcessMonitor::WriteGPR(lldb::tid_t tid, void *buf)
 {
     bool result;
-    WriteGPROperation op(buf, result);
+    WriteGPROperation op(tid, buf, result);
     DoOperation(&op);
     return result;
 }
 
 bool
-ProcessMonitor::WriteFPR(void *buf)
+ProcessMonitor::WriteFPR(lldb::tid_t tid, void *buf)
 {
     bool result;
-    WriteFPROperation op(buf, result);
+    WriteFPROperation op(tid, buf, result);
     DoOperation(&op);
     return result;
 }
@@ -1627,6 +1986,10 @@ bool
 ProcessMonitor::Resume(lldb::tid_t tid, uint32_t signo)
 {
     bool result;
+    {
+        Mutex::Locker lock(m_threads_mutex);
+        m_suspended.erase(tid);
+    }
     ResumeOperation op(tid, signo, result);
     DoOperation(&op);
     return result;
@@ -1636,11 +1999,22 @@ bool
 ProcessMonitor::SingleStep(lldb::tid_t tid, uint32_t signo)
 {
     bool result;
+    {
+        Mutex::Locker lock(m_threads_mutex);
+        m_suspended.erase(tid);
+    }
     SingleStepOperation op(tid, signo, result);
     DoOperation(&op);
     return result;
 }
 
+void
+ProcessMonitor::Suspend(lldb::tid_t tid)
+{
+    Mutex::Locker lock(m_threads_mutex);
+    m_suspended.insert(tid);
+}
+
 bool
 ProcessMonitor::BringProcessIntoLimbo()
 {
@@ -15,6 +15,9 @@
 #include <signal.h>
 
 // C++ Includes
+#include <set>
+#include <vector>
+
 // Other libraries and framework includes
 #include "lldb/lldb-types.h"
 #include "lldb/Host/Mutex.h"
@@ -102,34 +105,40 @@ public:
                 lldb_private::Error &error);
 
     /// Reads the contents from the register identified by the given (architecture
-    /// dependent) offset.
+    /// dependent) offset of thread @p tid.
     ///
     /// This method is provided for use by RegisterContextLinux derivatives.
     bool
-    ReadRegisterValue(unsigned offset, unsigned size, lldb_private::RegisterValue &value);
+    ReadRegisterValue(lldb::tid_t tid, unsigned offset, unsigned size,
+                      lldb_private::RegisterValue &value);
 
     /// Writes the given value to the register identified by the given
-    /// (architecture dependent) offset.
+    /// (architecture dependent) offset of thread @p tid.
     ///
     /// This method is provided for use by RegisterContextLinux derivatives.
     bool
-    WriteRegisterValue(unsigned offset, const lldb_private::RegisterValue &value);
+    WriteRegisterValue(lldb::tid_t tid, unsigned offset,
+                       const lldb_private::RegisterValue &value);
 
-    /// Reads all general purpose registers into the specified buffer.
+    /// Reads all general purpose registers of thread @p tid into the
+    /// specified buffer.
     bool
-    ReadGPR(void *buf);
+    ReadGPR(lldb::tid_t tid, void *buf);
 
-    /// Reads all floating point registers into the specified buffer.
+    /// Reads all floating point registers of thread @p tid into the specified
+    /// buffer.
     bool
-    ReadFPR(void *buf);
+    ReadFPR(lldb::tid_t tid, void *buf);
 
-    /// Writes all general purpose registers into the specified buffer.
+    /// Writes all general purpose registers of thread @p tid from the
+    /// specified buffer.
     bool
-    WriteGPR(void *buf);
+    WriteGPR(lldb::tid_t tid, void *buf);
 
-    /// Writes all floating point registers into the specified buffer.
+    /// Writes all floating point registers of thread @p tid from the
+    /// specified buffer.
     bool
-    WriteFPR(void *buf);
+    WriteFPR(lldb::tid_t tid, void *buf);
 
     /// Writes a siginfo_t structure corresponding to the given thread ID to the
     /// memory region pointed to by @p siginfo.
@@ -152,6 +161,11 @@ public:
     bool
     SingleStep(lldb::tid_t tid, uint32_t signo);
 
+    /// Leaves the given thread stopped while the rest of the process is
+    /// resumed.  It is not signalled when the other threads are stopped.
+    void
+    Suspend(lldb::tid_t tid);
+
     /// Sends the inferior process a PTRACE_KILL signal.  The inferior will
     /// still exists and can be interrogated.  Once resumed it will exit as
     /// though it received a SIGKILL.
@@ -161,6 +175,11 @@ public:
     bool
     Detach();
 
+    /// Fills @p tids with the ID of every thread of the inferior currently
+    /// being traced, including threads created via clone(2) since launch or
+    /// attach.  Returns the number of threads.
+    size_t
+    GetThreadIDs(std::vector<lldb::tid_t> &tids);
 
 private:
     ProcessLinux *m_process;
@@ -171,6 +190,21 @@ private:
 
     lldb::thread_t m_monitor_thread;
 
+    // The thread bookkeeping below is updated by the monitor thread (and by
+    // the operation thread during attach) and read by ProcessLinux when it
+    // rebuilds its thread list, hence the mutex.
+    lldb_private::Mutex m_threads_mutex;
+    std::set<lldb::tid_t> m_tids;           // Every traced thread.
+    std::set<lldb::tid_t> m_pending_clones; // Clone reported, initial stop not.
+    std::set<lldb::tid_t> m_early_clones;   // Initial stop seen before clone.
+
+    // Threads which were sent a SIGSTOP by StopAllThreads but reported some
+    // other event first.  The SIGSTOP is swallowed when it finally arrives.
+    std::set<lldb::tid_t> m_pending_stops;
+
+    // Threads left stopped by the last resume.
+    std::set<lldb::tid_t> m_suspended;
+
     lldb_private::Mutex m_server_mutex;
     int m_client_fd;
     int m_server_fd;
@@ -253,10 +287,50 @@ private:
     static bool
     DupDescriptor(const char *path, int fd, int flags);
 
+    static void *
+    MonitorThread(void *arg);
+
+    /// Blocks until any thread of the inferior changes state.  Returns the
+    /// thread ID or -1 on error (in which case errno is set).
+    ::pid_t
+    WaitForThread(int &status);
+
     static bool
     MonitorCallback(void *callback_baton,
                     lldb::pid_t pid, bool exited, int signal, int status);
 
+    /// Translates a stop of thread @p tid into a message for ProcessLinux.
+    /// Events which are only of interest to the monitor (clone and thread
+    /// exit notifications, the SIGSTOPs used to halt the process) yield an
+    /// invalid message, in which case the thread should simply be resumed.
+    /// Returns false if the thread has vanished.
+    bool
+    GetThreadMessage(lldb::tid_t tid, int signo, ProcessMessage &message);
+
+    /// Records the initial stop of a freshly cloned thread.  Returns false if
+    /// @p tid is already known and the stop must be handled normally.
+    bool
+    NewThreadStopped(lldb::tid_t tid, int signo);
+
+    /// Records a thread reported through PTRACE_EVENT_CLONE.
+    void
+    AddClonedThread(lldb::tid_t tid);
+
+    void
+    RemoveThread(lldb::tid_t tid);
+
+    /// Stops every thread of the inferior but @p stopped_tid.  All threads
+    /// are sent a SIGSTOP up front and then reaped by a single waitpid() loop.
+    /// Threads which report some other event on the way are recorded in @p
+    /// messages.
+    void
+    StopAllThreads(lldb::tid_t stopped_tid,
+                   std::vector<ProcessMessage> &messages);
+
+    static bool
+    AttachThreads(lldb::pid_t pid, ProcessMonitor *monitor,
+                  lldb_private::Error &error);
+
     static ProcessMessage
     MonitorSIGTRAP(ProcessMonitor *monitor,
                    const siginfo_t *info, lldb::pid_t pid);
@@ -60,10 +60,9 @@ POSIXThread::RefreshStateAfterStop()
     if (log && log->GetMask().Test(POSIX_LOG_VERBOSE))
         log->Printf ("POSIXThread::%s ()", __FUNCTION__);
 
-    // Let all threads recover from stopping and do any clean up based
-    // on the previous thread state (if any).
-    ProcessPOSIX &process = static_cast<ProcessPOSIX&>(GetProcess());
-    process.GetThreadList().RefreshStateAfterStop();
+    // Stop reasons are delivered by ProcessPOSIX::RefreshStateAfterStop,
+    // which notifies each thread named in a queued message.  Threads without
+    // a message were merely halted along with the rest of the process.
 }
 
 const char *
@@ -143,6 +142,11 @@ POSIXThread::WillResume(lldb::StateType resume_state)
 {
     SetResumeState(resume_state);
 
+    // Forget why we last stopped; a thread that is only halted alongside
+    // others at the next stop has no reason of its own.
+    m_stop_info.reset();
+    m_breakpoint.reset();
+
     ClearStackFrames();
     if (m_unwinder_ap.get())
         m_unwinder_ap->Clear();
@@ -177,6 +181,12 @@ POSIXThread::Resume()
         SetState(resume_state);
         status = monitor.SingleStep(GetID(), GetResumeSignal());
         break;
+
+    case lldb::eStateSuspended:
+        // Another thread is running alone, e.g. to step over a breakpoint.
+        monitor.Suspend(GetID());
+        status = false;
+        break;
     }
 
     return status;
@@ -339,6 +339,13 @@ ProcessPOSIX::SendMessage(const ProcessMessage &message)
     m_message_queue.push(message);
 }
 
+void
+ProcessPOSIX::QueueMessage(const ProcessMessage &message)
+{
+    Mutex::Locker lock(m_message_mutex);
+    m_message_queue.push(message);
+}
+
 void
 ProcessPOSIX::RefreshStateAfterStop()
 {
@@ -347,24 +354,24 @@ ProcessPOSIX::RefreshStateAfterStop()
         log->Printf ("ProcessPOSIX::%s()", __FUNCTION__);
 
     Mutex::Locker lock(m_message_mutex);
-    if (m_message_queue.empty())
-        return;
 
-    ProcessMessage &message = m_message_queue.front();
+    // Several threads may have stopped at once.  Resolve the thread each
+    // message corresponds to and pass it along.
+    while (!m_message_queue.empty())
+    {
+        ProcessMessage &message = m_message_queue.front();
 
-    // Resolve the thread this message corresponds to and pass it along.
-    // FIXME: we're really dealing with the pid here.  This should get
-    // fixed when this code is fixed to handle multiple threads.
-    lldb::tid_t tid = message.GetTID();
-    if (log)
-        log->Printf ("ProcessPOSIX::%s() pid = %i", __FUNCTION__, tid);
-    POSIXThread *thread = static_cast<POSIXThread*>(
-        GetThreadList().FindThreadByID(tid, false).get());
+        lldb::tid_t tid = message.GetTID();
+        if (log)
+            log->Printf ("ProcessPOSIX::%s() tid = %i", __FUNCTION__, tid);
+        POSIXThread *thread = static_cast<POSIXThread*>(
+            GetThreadList().FindThreadByID(tid, true).get());
 
-    assert(thread);
-    thread->Notify(message);
+        assert(thread);
+        thread->Notify(message);
 
-    m_message_queue.pop();
+        m_message_queue.pop();
+    }
 }
 
 bool
@@ -468,6 +475,18 @@ ProcessPOSIX::DisableBreakpoint(BreakpointSite *bp_site)
     return DisableSoftwareBreakpoint(bp_site);
 }
 
+Error
+ProcessPOSIX::EnableBreakpoints(const BreakpointSiteCollection &bp_sites)
+{
+    return EnableSoftwareBreakpoints(bp_sites);
+}
+
+Error
+ProcessPOSIX::DisableBreakpoints(const BreakpointSiteCollection &bp_sites)
+{
+    return DisableSoftwareBreakpoints(bp_sites);
+}
+
 uint32_t
 ProcessPOSIX::UpdateThreadListIfNeeded()
 {
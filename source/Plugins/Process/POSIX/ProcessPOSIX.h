@@ -102,6 +102,12 @@ public:
     virtual lldb_private::Error
     DisableBreakpoint(lldb_private::BreakpointSite *bp_site);
 
+    virtual lldb_private::Error
+    EnableBreakpoints(const BreakpointSiteCollection &bp_sites);
+
+    virtual lldb_private::Error
+    DisableBreakpoints(const BreakpointSiteCollection &bp_sites);
+
     virtual uint32_t
     UpdateThreadListIfNeeded();
 
@@ -130,6 +136,10 @@ public:
     /// Registers the given message with this process.
     void SendMessage(const ProcessMessage &message);
 
+    /// Registers the message of a thread which stopped alongside the thread
+    /// whose message, sent next, changes the state of the process.
+    void QueueMessage(const ProcessMessage &message);
+
     ProcessMonitor &
     GetMonitor() { assert(m_monitor); return *m_monitor; }
 
@@ -72,6 +72,29 @@ GDBRemoteCommunication::CalculcateChecksum (const char *payload, size_t payload_
     return checksum & 255;
 }
 
+void
+GDBRemoteCommunication::PutEscapedBinary (StreamString &packet, const void *src, size_t src_len)
+{
+    const uint8_t *bytes = (const uint8_t *)src;
+    for (size_t i = 0; i < src_len; ++i)
+    {
+        const uint8_t byte = bytes[i];
+        switch (byte)
+        {
+        case '#':
+        case '$':
+        case '}':
+        case '*':
+            packet.PutChar (0x7d);
+            packet.PutChar (byte ^ 0x20);
+            break;
+        default:
+            packet.PutChar (byte);
+            break;
+        }
+    }
+}
+
 size_t
 GDBRemoteCommunication::SendAck ()
 {
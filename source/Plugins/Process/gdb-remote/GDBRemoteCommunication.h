@@ -73,6 +73,14 @@ public:
     CalculcateChecksum (const char *payload,
                         size_t payload_length);
 
+    // Append "src" to "packet" as binary data for the 'x' and 'X' packets,
+    // escaping the bytes the packet framing reserves ('#', '$', '}' and
+    // '*') with a '}' followed by the byte XOR'ed with 0x20.
+    static void
+    PutEscapedBinary (lldb_private::StreamString &packet,
+                      const void *src,
+                      size_t src_len);
+
     bool
     GetSequenceMutex(lldb_private::Mutex::Locker& locker);
 
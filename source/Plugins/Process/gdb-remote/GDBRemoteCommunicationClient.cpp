@@ -12,6 +12,8 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 #include "llvm/ADT/Triple.h"
 #include "lldb/Interpreter/Args.h"
@@ -47,6 +49,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_qHostInfo_is_valid (eLazyBoolCalculate),
     m_supports_alloc_dealloc_memory (eLazyBoolCalculate),
     m_supports_memory_region_info  (eLazyBoolCalculate),
+    m_supports_x (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
     m_supports_qUserName (true),
@@ -57,6 +60,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_supports_z2 (true),
     m_supports_z3 (true),
     m_supports_z4 (true),
+    m_supports_QMultiBreakpoint (true),
     m_curr_tid (LLDB_INVALID_THREAD_ID),
     m_curr_tid_run (LLDB_INVALID_THREAD_ID),
     m_async_mutex (Mutex::eMutexTypeRecursive),
@@ -125,6 +129,7 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_qHostInfo_is_valid = eLazyBoolCalculate;
     m_supports_alloc_dealloc_memory = eLazyBoolCalculate;
     m_supports_memory_region_info = eLazyBoolCalculate;
+    m_supports_x = eLazyBoolCalculate;
 
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
@@ -136,6 +141,7 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_supports_z2 = true;
     m_supports_z3 = true;
     m_supports_z4 = true;
+    m_supports_QMultiBreakpoint = true;
     m_host_arch.Clear();
 }
 
@@ -155,6 +161,24 @@ GDBRemoteCommunicationClient::GetThreadSuffixSupported ()
     }
     return m_supports_thread_suffix;
 }
+bool
+GDBRemoteCommunicationClient::GetxPacketSupported ()
+{
+    if (m_supports_x == eLazyBoolCalculate)
+    {
+        // A zero length read is answered with "OK" by stubs that know the
+        // packet, while other stubs reply with an error or nothing at all.
+        StringExtractorGDBRemote response;
+        m_supports_x = eLazyBoolNo;
+        if (SendPacketAndWaitForResponse("x0,0", response, false))
+        {
+            if (response.IsOKResponse())
+                m_supports_x = eLazyBoolYes;
+        }
+    }
+    return m_supports_x == eLazyBoolYes;
+}
+
 bool
 GDBRemoteCommunicationClient::GetVContSupported (char flavor)
 {
@@ -1054,7 +1078,9 @@ GDBRemoteCommunicationClient::AllocateMemory (size_t size, uint32_t permissions)
         StringExtractorGDBRemote response;
         if (SendPacketAndWaitForResponse (packet, packet_len, response, false))
         {
-            if (!response.IsErrorResponse())
+            if (response.IsUnsupportedResponse())
+                m_supports_alloc_dealloc_memory = eLazyBoolNo;
+            else if (!response.IsErrorResponse())
                 return response.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
         }
         else
@@ -1079,6 +1105,8 @@ GDBRemoteCommunicationClient::DeallocateMemory (addr_t addr)
         {
             if (response.IsOKResponse())
                 return true;
+            if (response.IsUnsupportedResponse())
+                m_supports_alloc_dealloc_memory = eLazyBoolNo;
         }
         else
         {
@@ -1536,63 +1564,248 @@ GDBRemoteCommunicationClient::GetGroupName (uint32_t gid, std::string &name)
     return false;
 }
 
+//----------------------------------------------------------------------
+// Latency statistics for a single packet speed test run. All times are
+// in nanoseconds.
+//----------------------------------------------------------------------
+namespace {
+
+    struct PacketSpeedStats
+    {
+        // Round trip latencies for each packet that was sent
+        std::vector<uint64_t> wire_times;
+        uint64_t encode_time;
+        uint64_t decode_time;
+        uint64_t total_time;
+        
+        PacketSpeedStats () :
+            wire_times (),
+            encode_time (0),
+            decode_time (0),
+            total_time (0)
+        {
+        }
+
+        void
+        Clear ()
+        {
+            wire_times.clear();
+            encode_time = 0;
+            decode_time = 0;
+            total_time = 0;
+        }
+    };
+
+    // Number of log2 histogram buckets. Bucket N holds round trips that took
+    // less than 2^N microseconds (the last bucket holds everything else).
+    enum { kNumLatencyBuckets = 24 };
+
+    uint64_t
+    GetPercentile (const std::vector<uint64_t> &sorted_times, uint32_t percent)
+    {
+        if (sorted_times.empty())
+            return 0;
+        size_t idx = (sorted_times.size() * percent) / 100;
+        if (idx >= sorted_times.size())
+            idx = sorted_times.size() - 1;
+        return sorted_times[idx];
+    }
+
+    uint32_t
+    GetLatencyBucket (uint64_t nsec)
+    {
+        uint64_t usec = nsec / TimeValue::NanoSecPerMicroSec;
+        uint32_t bucket = 0;
+        while (usec > 0 && bucket < kNumLatencyBuckets - 1)
+        {
+            usec >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    void
+    DumpPacketSpeedStats (Stream &strm,
+                          bool json,
+                          bool first,
+                          const char *packet_name,
+                          uint32_t send_size,
+                          uint32_t recv_size,
+                          PacketSpeedStats &stats)
+    {
+        std::vector<uint64_t> &times = stats.wire_times;
+        std::sort (times.begin(), times.end());
+        const size_t num_packets = times.size();
+        const uint64_t min_time = num_packets ? times.front() : 0;
+        const uint64_t max_time = num_packets ? times.back() : 0;
+        const uint64_t p50_time = GetPercentile (times, 50);
+        const uint64_t p99_time = GetPercentile (times, 99);
+        uint64_t wire_time = 0;
+        uint32_t buckets[kNumLatencyBuckets];
+        ::memset (buckets, 0, sizeof(buckets));
+        for (size_t i=0; i<num_packets; ++i)
+        {
+            wire_time += times[i];
+            ++buckets[GetLatencyBucket (times[i])];
+        }
+        const uint64_t avg_time = num_packets ? wire_time / num_packets : 0;
+        float packets_per_second = 0.0f;
+        if (stats.total_time > 0)
+            packets_per_second = (((float)num_packets)/(float)stats.total_time) * (float)TimeValue::NanoSecPerSec;
+
+        if (json)
+        {
+            strm.Printf ("%s    { \"packet\" : \"%s\", \"send_size\" : %u, \"recv_size\" : %u, \"count\" : %llu, "
+                         "\"packets_per_second\" : %f, \"total_nsec\" : %llu, \"encode_nsec\" : %llu, "
+                         "\"wire_nsec\" : %llu, \"decode_nsec\" : %llu, \"min_nsec\" : %llu, \"avg_nsec\" : %llu, "
+                         "\"p50_nsec\" : %llu, \"p99_nsec\" : %llu, \"max_nsec\" : %llu, \"histogram_usec_log2\" : [",
+                         first ? "" : ",\n",
+                         packet_name,
+                         send_size,
+                         recv_size,
+                         (uint64_t)num_packets,
+                         packets_per_second,
+                         stats.total_time,
+                         stats.encode_time,
+                         wire_time,
+                         stats.decode_time,
+                         min_time,
+                         avg_time,
+                         p50_time,
+                         p99_time,
+                         max_time);
+            for (uint32_t i=0; i<kNumLatencyBuckets; ++i)
+                strm.Printf ("%s%u", i > 0 ? ", " : "", buckets[i]);
+            strm.PutCString ("] }");
+        }
+        else
+        {
+            strm.Printf ("%llu %s(send=%-5u, recv=%-5u) in %llu.%9.9llu sec for %f packets/sec\n",
+                         (uint64_t)num_packets,
+                         packet_name,
+                         send_size,
+                         recv_size,
+                         stats.total_time / TimeValue::NanoSecPerSec,
+                         stats.total_time % TimeValue::NanoSecPerSec,
+                         packets_per_second);
+            strm.Printf ("    encode = %llu ns, wire = %llu ns, decode = %llu ns\n",
+                         stats.encode_time,
+                         wire_time,
+                         stats.decode_time);
+            strm.Printf ("    latency: min = %llu ns, avg = %llu ns, p50 = %llu ns, p99 = %llu ns, max = %llu ns\n",
+                         min_time,
+                         avg_time,
+                         p50_time,
+                         p99_time,
+                         max_time);
+            for (uint32_t i=0; i<kNumLatencyBuckets; ++i)
+            {
+                if (buckets[i] == 0)
+                    continue;
+                if (i == kNumLatencyBuckets - 1)
+                    strm.Printf ("    >= %8llu us: %u\n", 1ull << (i - 1), buckets[i]);
+                else
+                    strm.Printf ("    <  %8llu us: %u\n", 1ull << i, buckets[i]);
+            }
+        }
+    }
+
+    // Payload sizes are swept as 0, 32, 64, 128, ...
+    uint64_t
+    NextSpeedTestPayloadSize (uint64_t size)
+    {
+        if (size == 0)
+            return 32;
+        return size * 2;
+    }
+}
+
 void
-GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets)
+GDBRemoteCommunicationClient::TestPacketSpeed (const uint32_t num_packets,
+                                               uint32_t max_send,
+                                               uint32_t max_recv,
+                                               bool json,
+                                               Stream &strm)
 {
     uint32_t i;
-    TimeValue start_time, end_time;
-    uint64_t total_time_nsec;
-    float packets_per_second;
+    TimeValue start_time, encode_time, wire_time, end_time;
+    PacketSpeedStats stats;
+    stats.wire_times.reserve (num_packets);
+    StreamString packet;
+    StringExtractorGDBRemote response;
+    bool first = true;
+
+    if (json)
+        strm.PutCString ("{ \"packet_speed_test\" : [\n");
+
     if (SendSpeedTestPacket (0, 0))
     {
-        for (uint32_t send_size = 0; send_size <= 1024; send_size *= 2)
+        // The sizes are 64 bit so doubling them can't wrap around when
+        // the maximums are 2GB or more.
+        bool success = true;
+        for (uint64_t send_size = 0; success && send_size <= max_send; send_size = NextSpeedTestPayloadSize (send_size))
         {
-            for (uint32_t recv_size = 0; recv_size <= 1024; recv_size *= 2)
+            for (uint64_t recv_size = 0; success && recv_size <= max_recv; recv_size = NextSpeedTestPayloadSize (recv_size))
             {
-                start_time = TimeValue::Now();
+                stats.Clear();
+                const TimeValue test_start_time (TimeValue::Now());
                 for (i=0; i<num_packets; ++i)
                 {
-                    SendSpeedTestPacket (send_size, recv_size);
+                    start_time = TimeValue::Now();
+                    packet.Clear();
+                    MakeSpeedTestPacket (send_size, recv_size, packet);
+                    encode_time = TimeValue::Now();
+                    if (SendPacketAndWaitForResponse (packet.GetData(), packet.GetSize(), response, false) == 0)
+                    {
+                        // Stop the whole sweep on the first failure, the
+                        // connection is unlikely to recover for larger sizes.
+                        success = false;
+                        break;
+                    }
+                    wire_time = TimeValue::Now();
+                    // Decode the response the same way a real packet would be,
+                    // by walking the payload bytes.
+                    if (recv_size > 0)
+                    {
+                        response.SetFilePos(0);
+                        std::string key;
+                        std::string value;
+                        while (response.GetNameColonValue(key, value))
+                            ;
+                    }
+                    end_time = TimeValue::Now();
+                    stats.encode_time += encode_time.GetAsNanoSecondsSinceJan1_1970() - start_time.GetAsNanoSecondsSinceJan1_1970();
+                    stats.wire_times.push_back (wire_time.GetAsNanoSecondsSinceJan1_1970() - encode_time.GetAsNanoSecondsSinceJan1_1970());
+                    stats.decode_time += end_time.GetAsNanoSecondsSinceJan1_1970() - wire_time.GetAsNanoSecondsSinceJan1_1970();
                 }
-                end_time = TimeValue::Now();
-                total_time_nsec = end_time.GetAsNanoSecondsSinceJan1_1970() - start_time.GetAsNanoSecondsSinceJan1_1970();
-                packets_per_second = (((float)num_packets)/(float)total_time_nsec) * (float)TimeValue::NanoSecPerSec;
-                printf ("%u qSpeedTest(send=%-5u, recv=%-5u) in %llu.%9.9llu sec for %f packets/sec.\n", 
-                        num_packets, 
-                        send_size,
-                        recv_size,
-                        total_time_nsec / TimeValue::NanoSecPerSec,
-                        total_time_nsec % TimeValue::NanoSecPerSec, 
-                        packets_per_second);
-                if (recv_size == 0)
-                    recv_size = 32;
+                stats.total_time = TimeValue::Now().GetAsNanoSecondsSinceJan1_1970() - test_start_time.GetAsNanoSecondsSinceJan1_1970();
+                DumpPacketSpeedStats (strm, json, first, "qSpeedTest", send_size, recv_size, stats);
+                first = false;
             }
-            if (send_size == 0)
-                send_size = 32;
         }
     }
     else
     {
-        start_time = TimeValue::Now();
+        const TimeValue test_start_time (TimeValue::Now());
         for (i=0; i<num_packets; ++i)
         {
-            GetCurrentProcessID ();
+            start_time = TimeValue::Now();
+            if (SendPacketAndWaitForResponse ("qC", 2, response, false) == 0)
+                break;
+            end_time = TimeValue::Now();
+            stats.wire_times.push_back (end_time.GetAsNanoSecondsSinceJan1_1970() - start_time.GetAsNanoSecondsSinceJan1_1970());
         }
-        end_time = TimeValue::Now();
-        total_time_nsec = end_time.GetAsNanoSecondsSinceJan1_1970() - start_time.GetAsNanoSecondsSinceJan1_1970();
-        packets_per_second = (((float)num_packets)/(float)total_time_nsec) * (float)TimeValue::NanoSecPerSec;
-        printf ("%u 'qC' packets packets in 0x%llu%9.9llu sec for %f packets/sec.\n", 
-                num_packets, 
-                total_time_nsec / TimeValue::NanoSecPerSec, 
-                total_time_nsec % TimeValue::NanoSecPerSec, 
-                packets_per_second);
+        stats.total_time = TimeValue::Now().GetAsNanoSecondsSinceJan1_1970() - test_start_time.GetAsNanoSecondsSinceJan1_1970();
+        DumpPacketSpeedStats (strm, json, first, "qC", 0, 0, stats);
     }
+
+    if (json)
+        strm.PutCString ("\n] }\n");
 }
 
-bool
-GDBRemoteCommunicationClient::SendSpeedTestPacket (uint32_t send_size, uint32_t recv_size)
+void
+GDBRemoteCommunicationClient::MakeSpeedTestPacket (uint32_t send_size, uint32_t recv_size, StreamString &packet)
 {
-    StreamString packet;
     packet.Printf ("qSpeedTest:response_size:%i;data:", recv_size);
     uint32_t bytes_left = send_size;
     while (bytes_left > 0)
@@ -1608,10 +1821,15 @@ GDBRemoteCommunicationClient::SendSpeedTestPacket (uint32_t send_size, uint32_t
             bytes_left = 0;
         }
     }
+}
 
+bool
+GDBRemoteCommunicationClient::SendSpeedTestPacket (uint32_t send_size, uint32_t recv_size)
+{
+    StreamString packet;
+    MakeSpeedTestPacket (send_size, recv_size, packet);
     StringExtractorGDBRemote response;
     return SendPacketAndWaitForResponse (packet.GetData(), packet.GetSize(), response, false) > 0;
-    return false;
 }
 
 uint16_t
@@ -1768,6 +1986,66 @@ GDBRemoteCommunicationClient::SendGDBStoppointTypePacket (GDBStoppointType type,
     return UINT8_MAX;
 }
 
+uint32_t
+GDBRemoteCommunicationClient::SendGDBStoppointTypePackets (GDBStoppointType type,
+                                                           bool insert,
+                                                           const std::vector<addr_t> &addrs,
+                                                           const std::vector<uint32_t> &lengths,
+                                                           std::vector<bool> &results)
+{
+    // Keep each packet well below the packet sizes stubs are known to handle
+    const size_t max_packet_size = 1024;
+    const size_t num_addrs = addrs.size();
+    assert (lengths.size() == num_addrs);
+    results.assign (num_addrs, false);
+
+    size_t idx = 0;
+    if (m_supports_QMultiBreakpoint &&
+        (type == eBreakpointSoftware || type == eBreakpointHardware) &&
+        SupportsGDBStoppointPacket (type))
+    {
+        StreamString packet;
+        StringExtractorGDBRemote response;
+        while (idx < num_addrs)
+        {
+            const size_t batch_start_idx = idx;
+            packet.Clear();
+            packet.Printf ("QMultiBreakpoint:%c%i", insert ? 'Z' : 'z', type);
+            while (idx < num_addrs && packet.GetSize() < max_packet_size)
+            {
+                packet.Printf (";%llx,%x", (uint64_t)addrs[idx], lengths[idx]);
+                ++idx;
+            }
+
+            if (SendPacketAndWaitForResponse (packet.GetData(), packet.GetSize(), response, true) == 0 ||
+                response.IsUnsupportedResponse())
+            {
+                // Fall back to individual packets for this and all
+                // remaining breakpoints
+                m_supports_QMultiBreakpoint = false;
+                idx = batch_start_idx;
+                break;
+            }
+
+            if (response.IsOKResponse())
+            {
+                for (size_t i = batch_start_idx; i < idx; ++i)
+                    results[i] = true;
+            }
+            else if (response.GetChar() == 'R')
+            {
+                for (size_t i = batch_start_idx; i < idx; ++i)
+                    results[i] = response.GetChar() == '1';
+            }
+        }
+    }
+
+    for (; idx < num_addrs; ++idx)
+        results[idx] = SendGDBStoppointTypePacket (type, insert, addrs[idx], lengths[idx]) == 0;
+
+    return std::count (results.begin(), results.end(), true);
+}
+
 size_t
 GDBRemoteCommunicationClient::GetCurrentThreadIDs (std::vector<lldb::tid_t> &thread_ids, 
                                                    bool &sequence_mutex_unavailable)
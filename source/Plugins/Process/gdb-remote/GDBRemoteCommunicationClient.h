@@ -207,6 +207,11 @@ public:
     bool
     GetVContSupported (char flavor);
 
+    // Returns true if the remote stub reads and writes memory with the
+    // binary 'x' and 'X' packets instead of the hex 'm' and 'M' packets.
+    bool
+    GetxPacketSupported ();
+
     void
     ResetDiscoverableSettings();
 
@@ -294,8 +299,73 @@ public:
                                 lldb::addr_t addr,        // Address of breakpoint or watchpoint
                                 uint32_t length);         // Byte Size of breakpoint or watchpoint
 
+    //------------------------------------------------------------------
+    /// Insert or remove a number of breakpoints of the same type.
+    ///
+    /// If the remote stub supports the "QMultiBreakpoint" packet, as
+    /// many breakpoints as fit are sent in each packet so large numbers
+    /// of breakpoints only cost a handful of round trips. Otherwise each
+    /// breakpoint is sent with its own Z/z packet.
+    ///
+    /// @param[in] addrs
+    ///     The addresses of the breakpoints.
+    ///
+    /// @param[in] lengths
+    ///     The byte sizes of the breakpoints, one for each address.
+    ///
+    /// @param[out] results
+    ///     Filled in with one entry per address that is \b true if the
+    ///     breakpoint was inserted or removed successfully.
+    ///
+    /// @return
+    ///     The number of breakpoints that were successfully inserted or
+    ///     removed.
+    //------------------------------------------------------------------
+    uint32_t
+    SendGDBStoppointTypePackets (GDBStoppointType type,
+                                 bool insert,
+                                 const std::vector<lldb::addr_t> &addrs,
+                                 const std::vector<uint32_t> &lengths,
+                                 std::vector<bool> &results);
+
+    //------------------------------------------------------------------
+    /// Benchmark the packet transport.
+    ///
+    /// Sweeps send and receive payload sizes of 0, 32, 64, 128, ...
+    /// bytes up to the maximums and sends \a num_packets packets for
+    /// each combination. The sweep stops at the first packet that
+    /// fails to get a response. Every round trip is timed
+    /// individually so the results include the minimum, median, 99th
+    /// percentile and maximum latencies along with a log2 histogram of
+    /// the round trip times. The time spent encoding the packet payload
+    /// and decoding the response are reported separately from the time
+    /// spent on the wire.
+    ///
+    /// If the remote side doesn't support the "qSpeedTest" packet, "qC"
+    /// packets are timed instead.
+    ///
+    /// @param[in] num_packets
+    ///     The number of packets to send for each payload size pair.
+    ///
+    /// @param[in] max_send
+    ///     The maximum payload size in bytes to send.
+    ///
+    /// @param[in] max_recv
+    ///     The maximum payload size in bytes to request in responses.
+    ///
+    /// @param[in] json
+    ///     If true, emit the results as JSON, else as human readable
+    ///     text.
+    ///
+    /// @param[in] strm
+    ///     The stream the results are written to.
+    //------------------------------------------------------------------
     void
-    TestPacketSpeed (const uint32_t num_packets);
+    TestPacketSpeed (const uint32_t num_packets,
+                     uint32_t max_send,
+                     uint32_t max_recv,
+                     bool json,
+                     lldb_private::Stream &strm);
 
     // This packet is for testing the speed of the interface only. Both
     // the client and server need to support it, but this allows us to
@@ -305,6 +375,11 @@ public:
     bool
     SendSpeedTestPacket (uint32_t send_size, 
                          uint32_t recv_size);
+
+    static void
+    MakeSpeedTestPacket (uint32_t send_size,
+                         uint32_t recv_size,
+                         lldb_private::StreamString &packet);
     
     bool
     SetCurrentThread (int tid);
@@ -338,6 +413,7 @@ protected:
     lldb_private::LazyBool m_qHostInfo_is_valid;
     lldb_private::LazyBool m_supports_alloc_dealloc_memory;
     lldb_private::LazyBool m_supports_memory_region_info;
+    lldb_private::LazyBool m_supports_x;
 
     bool
         m_supports_qProcessInfoPID:1,
@@ -349,7 +425,8 @@ protected:
         m_supports_z1:1,
         m_supports_z2:1,
         m_supports_z3:1,
-        m_supports_z4:1;
+        m_supports_z4:1,
+        m_supports_QMultiBreakpoint:1;
     
 
     lldb::tid_t m_curr_tid;         // Current gdb remote protocol thread index for all other operations
@@ -11,18 +11,32 @@
 #include "GDBRemoteCommunicationServer.h"
 
 // C Includes
+#include <signal.h>
+
 // C++ Includes
+#include <vector>
+
 // Other libraries and framework includes
 #include "llvm/ADT/Triple.h"
 #include "lldb/Interpreter/Args.h"
+#include "lldb/Breakpoint/Breakpoint.h"
 #include "lldb/Core/ConnectionFileDescriptor.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Event.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/RegisterValue.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Host/Endian.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/TimeValue.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StopInfo.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/TargetList.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Target/ThreadList.h"
 
 // Project includes
 #include "Utility/StringExtractorGDBRemote.h"
@@ -32,6 +46,11 @@
 using namespace lldb;
 using namespace lldb_private;
 
+// The largest packet the server sends or accepts. Memory reads and writes
+// are capped at half of it since hex encoding doubles each byte.
+static const size_t g_max_packet_size = 0x20000;
+static const size_t g_max_memory_size = g_max_packet_size / 2;
+
 //----------------------------------------------------------------------
 // GDBRemoteCommunicationServer constructor
 //----------------------------------------------------------------------
@@ -43,7 +62,15 @@ GDBRemoteCommunicationServer::GDBRemoteCommunicationServer(bool is_platform) :
     m_proc_infos (),
     m_proc_infos_index (0),
     m_lo_port_num (0),
-    m_hi_port_num (0)
+    m_hi_port_num (0),
+    m_process_plugin_name (),
+    m_debugger_sp (),
+    m_target_sp (),
+    m_process_sp (),
+    m_process_listener ("gdb-remote.server.process"),
+    m_current_tid (LLDB_INVALID_THREAD_ID),
+    m_continue_tid (LLDB_INVALID_THREAD_ID),
+    m_breakpoints ()
 {
 }
 
@@ -52,6 +79,12 @@ GDBRemoteCommunicationServer::GDBRemoteCommunicationServer(bool is_platform) :
 //----------------------------------------------------------------------
 GDBRemoteCommunicationServer::~GDBRemoteCommunicationServer()
 {
+    if (m_process_sp && m_process_sp->IsAlive())
+        m_process_sp->Destroy();
+    m_process_sp.reset();
+    m_target_sp.reset();
+    if (m_debugger_sp)
+        Debugger::Destroy (m_debugger_sp);
 }
 
 
@@ -160,6 +193,87 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
 
             case StringExtractorGDBRemote::eServerPacketType_QStartNoAckMode:
                 return Handle_QStartNoAckMode (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_QThreadSuffixSupported:
+                return Handle_QThreadSuffixSupported (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_stop_reason:
+                return Handle_stop_reason (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_qfThreadInfo:
+                return Handle_qfThreadInfo (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_qsThreadInfo:
+                return Handle_qsThreadInfo (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_qThreadStopInfo:
+                return Handle_qThreadStopInfo (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_qRegisterInfo:
+                return Handle_qRegisterInfo (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_qShlibInfoAddr:
+                return Handle_qShlibInfoAddr (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_H:
+                return Handle_H (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_p:
+                return Handle_p (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_P:
+                return Handle_P (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_g:
+                return Handle_g (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_G:
+                return Handle_G (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_m:
+                return Handle_m (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_M:
+                return Handle_M (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_x:
+                return Handle_x (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_X:
+                return Handle_X (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_z:
+                return Handle_z (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_Z:
+                return Handle_Z (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_c:
+            case StringExtractorGDBRemote::eServerPacketType_C:
+                return Handle_c (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_s:
+            case StringExtractorGDBRemote::eServerPacketType_S:
+                return Handle_s (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_vCont_actions:
+                return Handle_vCont_actions (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_vCont:
+                return Handle_vCont (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_vAttach:
+                return Handle_vAttach (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_k:
+                // Once the inferior is gone there is nothing left to serve
+                quit = !m_is_platform;
+                return Handle_k (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_D:
+                // Once the inferior is gone there is nothing left to serve
+                quit = !m_is_platform;
+                return Handle_D (packet);
         }
         return true;
     }
@@ -627,7 +741,10 @@ GDBRemoteCommunicationServer::Handle_A (StringExtractorGDBRemote &packet)
     if (success)
     {
         m_process_launch_info.GetFlags().Set (eLaunchFlagDebug);
-        m_process_launch_error = Host::LaunchProcess (m_process_launch_info);
+        if (m_is_platform)
+            m_process_launch_error = Host::LaunchProcess (m_process_launch_info);
+        else
+            m_process_launch_error = LaunchProcess ();
         if (m_process_launch_info.GetProcessID() != LLDB_INVALID_PROCESS_ID)
         {
             return SendOKResponse ();
@@ -641,6 +758,15 @@ GDBRemoteCommunicationServer::Handle_qC (StringExtractorGDBRemote &packet)
 {
     lldb::pid_t pid = m_process_launch_info.GetProcessID();
     StreamString response;
+    if (!m_is_platform && m_process_sp)
+    {
+        // When debugging a process "qC" asks for the current thread.
+        ThreadSP thread_sp (m_process_sp->GetThreadList().GetSelectedThread());
+        if (!thread_sp)
+            return SendErrorResponse (14);
+        response.Printf("QC%llx", thread_sp->GetID());
+        return SendPacket (response);
+    }
     response.Printf("QC%llx", pid);
     if (m_is_platform)
     {
@@ -832,3 +958,955 @@ GDBRemoteCommunicationServer::Handle_QStartNoAckMode (StringExtractorGDBRemote &
     m_send_acks = false;
     return true;
 }
+
+//----------------------------------------------------------------------
+// Process debugging
+//
+// The packets below are only answered when the server isn't acting as a
+// platform. They are implemented on top of a native lldb_private::Process
+// so that breakpoints, single stepping over breakpoints and thread
+// bookkeeping are shared with local debugging.
+//----------------------------------------------------------------------
+
+Error
+GDBRemoteCommunicationServer::LaunchProcess ()
+{
+    Error error;
+    if (m_process_sp && m_process_sp->IsAlive())
+    {
+        error.SetErrorString ("a process is already being debugged");
+        return error;
+    }
+
+    if (!m_debugger_sp)
+        m_debugger_sp = Debugger::CreateInstance ();
+
+    const FileSpec &exe_file = m_process_launch_info.GetExecutableFile();
+    error = m_debugger_sp->GetTargetList().CreateTarget (*m_debugger_sp,
+                                                         exe_file,
+                                                         NULL,
+                                                         false,
+                                                         NULL,
+                                                         m_target_sp);
+    if (error.Fail())
+        return error;
+
+    m_process_sp = m_target_sp->CreateProcess (m_process_listener,
+                                               m_process_plugin_name.empty() ? NULL : m_process_plugin_name.c_str());
+    if (!m_process_sp)
+    {
+        error.SetErrorStringWithFormat ("no process plug-in can debug '%s'", 
+                                        exe_file.GetFilename().AsCString("<unknown>"));
+        return error;
+    }
+
+    error = m_process_sp->Launch (m_process_launch_info);
+    if (error.Success())
+    {
+        TimeValue timeout = TimeValue::Now();
+        timeout.OffsetWithSeconds (10);
+        const StateType state = WaitForProcessToStop (&timeout);
+        if (state == eStateStopped)
+            m_process_launch_info.SetProcessID (m_process_sp->GetID());
+        else
+            error.SetErrorStringWithFormat ("process did not stop after launching, state = %s", StateAsCString (state));
+    }
+    return error;
+}
+
+Error
+GDBRemoteCommunicationServer::AttachToProcess (lldb::pid_t pid)
+{
+    Error error;
+    if (m_process_sp && m_process_sp->IsAlive())
+    {
+        error.SetErrorString ("a process is already being debugged");
+        return error;
+    }
+
+    if (!m_debugger_sp)
+        m_debugger_sp = Debugger::CreateInstance ();
+
+    error = m_debugger_sp->GetTargetList().CreateTarget (*m_debugger_sp,
+                                                         FileSpec(),
+                                                         NULL,
+                                                         false,
+                                                         NULL,
+                                                         m_target_sp);
+    if (error.Fail())
+        return error;
+
+    m_process_sp = m_target_sp->CreateProcess (m_process_listener,
+                                               m_process_plugin_name.empty() ? NULL : m_process_plugin_name.c_str());
+    if (!m_process_sp)
+    {
+        error.SetErrorStringWithFormat ("no process plug-in can attach to pid %llu", pid);
+        return error;
+    }
+
+    ProcessAttachInfo attach_info;
+    attach_info.SetProcessID (pid);
+    error = m_process_sp->Attach (attach_info);
+    if (error.Success())
+    {
+        TimeValue timeout = TimeValue::Now();
+        timeout.OffsetWithSeconds (10);
+        const StateType state = WaitForProcessToStop (&timeout);
+        if (state == eStateStopped)
+            m_process_launch_info.SetProcessID (pid);
+        else
+            error.SetErrorStringWithFormat ("process did not stop after attaching, state = %s", StateAsCString (state));
+    }
+    return error;
+}
+
+StateType
+GDBRemoteCommunicationServer::WaitForProcessToStop (const TimeValue *timeout)
+{
+    EventSP event_sp;
+    while (m_process_listener.WaitForEvent (timeout, event_sp))
+    {
+        const StateType state = Process::ProcessEventData::GetStateFromEvent (event_sp.get());
+        if (StateIsStoppedState (state, false) && 
+            !Process::ProcessEventData::GetRestartedFromEvent (event_sp.get()))
+            return state;
+    }
+    return m_process_sp->GetState();
+}
+
+static bool
+PutRegisterValue (StreamString &response,
+                  const RegisterInfo *reg_info, 
+                  const RegisterValue &reg_value,
+                  ByteOrder byte_order)
+{
+    uint8_t bytes[RegisterValue::kMaxRegisterByteSize];
+    Error error;
+    const uint32_t bytes_copied = reg_value.GetAsMemoryData (reg_info, 
+                                                             bytes, 
+                                                             reg_info->byte_size, 
+                                                             byte_order, 
+                                                             error);
+    if (bytes_copied != reg_info->byte_size)
+        return false;
+    response.PutBytesAsRawHex8 (bytes, bytes_copied);
+    return true;
+}
+
+bool
+GDBRemoteCommunicationServer::SendStopReplyPacketForThread (lldb::tid_t tid)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    StreamString response;
+    const StateType state = m_process_sp->GetState();
+    if (state == eStateExited)
+    {
+        response.Printf ("W%2.2x", (uint8_t)m_process_sp->GetExitStatus());
+        return SendPacket (response);
+    }
+
+    if (!StateIsStoppedState (state, true))
+        return SendErrorResponse (17);
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    ThreadSP thread_sp;
+    if (tid == LLDB_INVALID_THREAD_ID)
+    {
+        // Report the thread the process stopped for, preferring the one the
+        // process selected when several threads have a reason.
+        thread_sp = thread_list.GetSelectedThread();
+        StopInfoSP stop_info_sp;
+        if (thread_sp)
+            stop_info_sp = thread_sp->GetStopInfo();
+        if (!stop_info_sp || stop_info_sp->GetStopReason() == eStopReasonNone)
+        {
+            const uint32_t num_threads = thread_list.GetSize();
+            for (uint32_t idx = 0; idx < num_threads; ++idx)
+            {
+                ThreadSP candidate_sp (thread_list.GetThreadAtIndex (idx));
+                stop_info_sp = candidate_sp->GetStopInfo();
+                if (stop_info_sp && stop_info_sp->GetStopReason() != eStopReasonNone)
+                {
+                    thread_sp = candidate_sp;
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        thread_sp = thread_list.FindThreadByID (tid);
+    }
+
+    if (!thread_sp)
+        return SendErrorResponse (18);
+
+    int signo = 0;
+    const char *reason = NULL;
+    const char *description = NULL;
+    StopInfoSP stop_info_sp (thread_sp->GetStopInfo());
+    if (stop_info_sp)
+    {
+        switch (stop_info_sp->GetStopReason())
+        {
+        case eStopReasonBreakpoint:
+            signo = SIGTRAP;
+            reason = "breakpoint";
+            break;
+
+        case eStopReasonTrace:
+        case eStopReasonPlanComplete:
+            signo = SIGTRAP;
+            reason = "trace";
+            break;
+
+        case eStopReasonWatchpoint:
+            signo = SIGTRAP;
+            reason = "watchpoint";
+            break;
+
+        case eStopReasonSignal:
+            signo = stop_info_sp->GetValue();
+            break;
+
+        case eStopReasonException:
+            reason = "exception";
+            description = stop_info_sp->GetDescription();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    response.Printf ("T%2.2xthread:%llx;", (uint8_t)signo, thread_sp->GetID());
+
+    // Expedite the general purpose registers so the client can unwind the
+    // first frame without asking for them.
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+    const RegisterSet *reg_set = reg_ctx_sp ? reg_ctx_sp->GetRegisterSet (0) : NULL;
+    if (reg_set)
+    {
+        const ByteOrder byte_order = m_process_sp->GetByteOrder();
+        for (uint32_t i = 0; i < reg_set->num_registers; ++i)
+        {
+            const uint32_t reg = reg_set->registers[i];
+            // The stop reply uses two hex digits for register numbers
+            if (reg > 0xff)
+                continue;
+            const RegisterInfo *reg_info = reg_ctx_sp->GetRegisterInfoAtIndex (reg);
+            RegisterValue reg_value;
+            StreamString reg_hex;
+            if (reg_info && 
+                reg_ctx_sp->ReadRegister (reg_info, reg_value) &&
+                PutRegisterValue (reg_hex, reg_info, reg_value, byte_order))
+                response.Printf ("%2.2x:%s;", reg, reg_hex.GetData());
+        }
+    }
+
+    if (reason)
+        response.Printf ("reason:%s;", reason);
+    if (description)
+    {
+        response.PutCString ("description:");
+        response.PutCStringAsRawHex8 (description);
+        response.PutChar (';');
+    }
+    return SendPacket (response);
+}
+
+lldb::ThreadSP
+GDBRemoteCommunicationServer::GetThreadForPacket (StringExtractorGDBRemote &packet)
+{
+    ThreadSP thread_sp;
+    if (!m_process_sp)
+        return thread_sp;
+
+    // Register packets name their thread with a ";thread:<tid>;" suffix
+    // when the client knows we support QThreadSuffixSupported, otherwise
+    // the thread comes from the last "Hg" packet.
+    lldb::tid_t tid = m_current_tid;
+    const std::string &packet_str = packet.GetStringRef();
+    const size_t suffix_pos = packet_str.find (";thread:");
+    if (suffix_pos != std::string::npos)
+    {
+        StringExtractor tid_extractor (packet_str.c_str() + suffix_pos + ::strlen (";thread:"));
+        tid = tid_extractor.GetHexMaxU64 (false, LLDB_INVALID_THREAD_ID);
+    }
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    if (tid == LLDB_INVALID_THREAD_ID || tid == 0)
+        thread_sp = thread_list.GetSelectedThread();
+    else
+        thread_sp = thread_list.FindThreadByID (tid);
+    return thread_sp;
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_QThreadSuffixSupported (StringExtractorGDBRemote &packet)
+{
+    if (m_is_platform)
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+    return SendOKResponse ();
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_stop_reason (StringExtractorGDBRemote &packet)
+{
+    return SendStopReplyPacketForThread (LLDB_INVALID_THREAD_ID);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_qfThreadInfo (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // Send all of the thread IDs in the first reply
+    StreamString response;
+    response.PutChar ('m');
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    const uint32_t num_threads = thread_list.GetSize();
+    for (uint32_t idx = 0; idx < num_threads; ++idx)
+    {
+        if (idx > 0)
+            response.PutChar (',');
+        response.Printf ("%llx", thread_list.GetThreadAtIndex (idx)->GetID());
+    }
+    return SendPacket (response);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_qsThreadInfo (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+    return SendPacket ("l");
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_qThreadStopInfo (StringExtractorGDBRemote &packet)
+{
+    packet.SetFilePos (::strlen ("qThreadStopInfo"));
+    const lldb::tid_t tid = packet.GetHexMaxU64 (false, LLDB_INVALID_THREAD_ID);
+    if (tid == LLDB_INVALID_THREAD_ID)
+        return SendErrorResponse (18);
+    return SendStopReplyPacketForThread (tid);
+}
+
+static const char *
+GetEncodingName (Encoding encoding)
+{
+    switch (encoding)
+    {
+    case eEncodingSint:     return "sint";
+    case eEncodingIEEE754:  return "ieee754";
+    case eEncodingVector:   return "vector";
+    default:                return "uint";
+    }
+}
+
+static const char *
+GetFormatName (Format format)
+{
+    switch (format)
+    {
+    case eFormatBinary:             return "binary";
+    case eFormatDecimal:            return "decimal";
+    case eFormatFloat:              return "float";
+    case eFormatVectorOfSInt8:      return "vector-sint8";
+    case eFormatVectorOfUInt8:      return "vector-uint8";
+    case eFormatVectorOfSInt16:     return "vector-sint16";
+    case eFormatVectorOfUInt16:     return "vector-uint16";
+    case eFormatVectorOfSInt32:     return "vector-sint32";
+    case eFormatVectorOfUInt32:     return "vector-uint32";
+    case eFormatVectorOfFloat32:    return "vector-float32";
+    case eFormatVectorOfUInt128:    return "vector-uint128";
+    default:                        return "hex";
+    }
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_qRegisterInfo (StringExtractorGDBRemote &packet)
+{
+    ThreadSP thread_sp (GetThreadForPacket (packet));
+    if (!thread_sp)
+        return SendErrorResponse (15);
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+
+    packet.SetFilePos (::strlen ("qRegisterInfo"));
+    const uint32_t reg = packet.GetHexMaxU32 (false, UINT32_MAX);
+    if (!reg_ctx_sp || reg >= reg_ctx_sp->GetRegisterCount())
+        return SendErrorResponse (0x45); // Past the last register
+
+    const RegisterInfo *reg_info = reg_ctx_sp->GetRegisterInfoAtIndex (reg);
+
+    // Offsets describe where each register lives in the "g" packet, which
+    // simply packs the registers in order.
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < reg; ++i)
+        offset += reg_ctx_sp->GetRegisterInfoAtIndex (i)->byte_size;
+
+    StreamString response;
+    response.Printf ("name:%s;", reg_info->name);
+    if (reg_info->alt_name)
+        response.Printf ("alt-name:%s;", reg_info->alt_name);
+    response.Printf ("bitsize:%u;offset:%u;encoding:%s;format:%s;",
+                     reg_info->byte_size * 8, 
+                     offset,
+                     GetEncodingName (reg_info->encoding),
+                     GetFormatName (reg_info->format));
+
+    const uint32_t num_sets = reg_ctx_sp->GetRegisterSetCount();
+    for (uint32_t set_idx = 0; set_idx < num_sets; ++set_idx)
+    {
+        const RegisterSet *reg_set = reg_ctx_sp->GetRegisterSet (set_idx);
+        for (uint32_t i = 0; i < reg_set->num_registers; ++i)
+        {
+            if (reg_set->registers[i] == reg)
+            {
+                response.Printf ("set:%s;", reg_set->name);
+                set_idx = num_sets;
+                break;
+            }
+        }
+    }
+
+    if (reg_info->kinds[eRegisterKindGCC] != LLDB_INVALID_REGNUM)
+        response.Printf ("gcc:%u;", reg_info->kinds[eRegisterKindGCC]);
+    if (reg_info->kinds[eRegisterKindDWARF] != LLDB_INVALID_REGNUM)
+        response.Printf ("dwarf:%u;", reg_info->kinds[eRegisterKindDWARF]);
+
+    switch (reg_info->kinds[eRegisterKindGeneric])
+    {
+    case LLDB_REGNUM_GENERIC_PC:    response.PutCString ("generic:pc;"); break;
+    case LLDB_REGNUM_GENERIC_SP:    response.PutCString ("generic:sp;"); break;
+    case LLDB_REGNUM_GENERIC_FP:    response.PutCString ("generic:fp;"); break;
+    case LLDB_REGNUM_GENERIC_RA:    response.PutCString ("generic:ra;"); break;
+    case LLDB_REGNUM_GENERIC_FLAGS: response.PutCString ("generic:flags;"); break;
+    default: break;
+    }
+    return SendPacket (response);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_qShlibInfoAddr (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+    const lldb::addr_t image_info_addr = m_process_sp->GetImageInfoAddress();
+    if (image_info_addr == LLDB_INVALID_ADDRESS)
+        return SendErrorResponse (15);
+    StreamString response;
+    response.Printf ("%llx", image_info_addr);
+    return SendPacket (response);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_H (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // "Hg<tid>" selects the thread for other operations, "Hc<tid>" the
+    // thread for legacy continue and step packets. A tid of -1 or 0
+    // means any thread.
+    packet.SetFilePos (1);
+    const char op = packet.GetChar();
+    lldb::tid_t tid = LLDB_INVALID_THREAD_ID;
+    const char *tid_cstr = packet.Peek();
+    if (tid_cstr && tid_cstr[0] != '-')
+        tid = packet.GetHexMaxU64 (false, LLDB_INVALID_THREAD_ID);
+
+    if (tid != LLDB_INVALID_THREAD_ID && tid != 0 &&
+        !m_process_sp->GetThreadList().FindThreadByID (tid))
+        return SendErrorResponse (18);
+
+    if (op == 'g')
+        m_current_tid = tid;
+    else if (op == 'c')
+        m_continue_tid = tid;
+    else
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+    return SendOKResponse ();
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_p (StringExtractorGDBRemote &packet)
+{
+    ThreadSP thread_sp (GetThreadForPacket (packet));
+    if (!thread_sp)
+        return SendErrorResponse (18);
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+
+    packet.SetFilePos (1);
+    const uint32_t reg = packet.GetHexMaxU32 (false, UINT32_MAX);
+    const RegisterInfo *reg_info = reg_ctx_sp ? reg_ctx_sp->GetRegisterInfoAtIndex (reg) : NULL;
+    if (reg_info == NULL)
+        return SendErrorResponse (19);
+
+    StreamString response;
+    RegisterValue reg_value;
+    if (!reg_ctx_sp->ReadRegister (reg_info, reg_value) ||
+        !PutRegisterValue (response, reg_info, reg_value, m_process_sp->GetByteOrder()))
+        return SendErrorResponse (19);
+    return SendPacket (response);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_P (StringExtractorGDBRemote &packet)
+{
+    ThreadSP thread_sp (GetThreadForPacket (packet));
+    if (!thread_sp)
+        return SendErrorResponse (18);
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+
+    packet.SetFilePos (1);
+    const uint32_t reg = packet.GetHexMaxU32 (false, UINT32_MAX);
+    const RegisterInfo *reg_info = reg_ctx_sp ? reg_ctx_sp->GetRegisterInfoAtIndex (reg) : NULL;
+    if (reg_info == NULL || packet.GetChar() != '=')
+        return SendErrorResponse (19);
+
+    uint8_t bytes[RegisterValue::kMaxRegisterByteSize];
+    if (reg_info->byte_size > sizeof(bytes) ||
+        packet.GetHexBytes (bytes, reg_info->byte_size, 0) != reg_info->byte_size)
+        return SendErrorResponse (19);
+
+    Error error;
+    RegisterValue reg_value;
+    reg_value.SetFromMemoryData (reg_info, bytes, reg_info->byte_size, m_process_sp->GetByteOrder(), error);
+    if (error.Fail() || !reg_ctx_sp->WriteRegister (reg_info, reg_value))
+        return SendErrorResponse (19);
+    return SendOKResponse ();
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_g (StringExtractorGDBRemote &packet)
+{
+    ThreadSP thread_sp (GetThreadForPacket (packet));
+    if (!thread_sp)
+        return SendErrorResponse (18);
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+    if (!reg_ctx_sp)
+        return SendErrorResponse (19);
+
+    // Registers that can't be read are sent as zeros so the offsets given
+    // out by qRegisterInfo stay valid.
+    StreamString response;
+    const ByteOrder byte_order = m_process_sp->GetByteOrder();
+    const uint32_t num_regs = reg_ctx_sp->GetRegisterCount();
+    for (uint32_t reg = 0; reg < num_regs; ++reg)
+    {
+        const RegisterInfo *reg_info = reg_ctx_sp->GetRegisterInfoAtIndex (reg);
+        RegisterValue reg_value;
+        if (!reg_ctx_sp->ReadRegister (reg_info, reg_value) ||
+            !PutRegisterValue (response, reg_info, reg_value, byte_order))
+        {
+            for (uint32_t i = 0; i < reg_info->byte_size; ++i)
+                response.PutCString ("00");
+        }
+    }
+    return SendPacket (response);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_G (StringExtractorGDBRemote &packet)
+{
+    ThreadSP thread_sp (GetThreadForPacket (packet));
+    if (!thread_sp)
+        return SendErrorResponse (18);
+    RegisterContextSP reg_ctx_sp (thread_sp->GetRegisterContext());
+    if (!reg_ctx_sp)
+        return SendErrorResponse (19);
+
+    packet.SetFilePos (1);
+    const ByteOrder byte_order = m_process_sp->GetByteOrder();
+    const uint32_t num_regs = reg_ctx_sp->GetRegisterCount();
+    for (uint32_t reg = 0; reg < num_regs; ++reg)
+    {
+        const RegisterInfo *reg_info = reg_ctx_sp->GetRegisterInfoAtIndex (reg);
+        uint8_t bytes[RegisterValue::kMaxRegisterByteSize];
+        if (reg_info->byte_size > sizeof(bytes) ||
+            packet.GetHexBytes (bytes, reg_info->byte_size, 0) != reg_info->byte_size)
+            return SendErrorResponse (19);
+
+        Error error;
+        RegisterValue reg_value;
+        reg_value.SetFromMemoryData (reg_info, bytes, reg_info->byte_size, byte_order, error);
+        if (error.Success())
+            reg_ctx_sp->WriteRegister (reg_info, reg_value);
+    }
+    return SendOKResponse ();
+}
+
+bool
+GDBRemoteCommunicationServer::ReadMemory (StringExtractorGDBRemote &packet, bool binary)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // Packet format: "m<addr>,<length>" or "x<addr>,<length>"
+    packet.SetFilePos (1);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+    if (addr == LLDB_INVALID_ADDRESS || packet.GetChar() != ',')
+        return SendErrorResponse (20);
+    const size_t length = packet.GetHexMaxU64 (false, 0);
+    if (length == 0)
+        return SendOKResponse ();
+    if (length > g_max_memory_size)
+        return SendErrorResponse (27);
+
+    std::vector<uint8_t> buffer (length);
+    Error error;
+    const size_t bytes_read = m_process_sp->ReadMemory (addr, &buffer[0], length, error);
+    if (bytes_read == 0)
+        return SendErrorResponse (21);
+
+    StreamString response;
+    if (binary)
+    {
+        // The 'b' keeps a reply that happens to look like "OK" or "Exx"
+        // from being mistaken for a status.
+        response.PutChar ('b');
+        PutEscapedBinary (response, &buffer[0], bytes_read);
+    }
+    else
+    {
+        response.PutBytesAsRawHex8 (&buffer[0], bytes_read);
+    }
+    return SendPacket (response);
+}
+
+bool
+GDBRemoteCommunicationServer::WriteMemory (StringExtractorGDBRemote &packet, bool binary)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // Packet format: "M<addr>,<length>:<hex bytes>" or 
+    // "X<addr>,<length>:<binary bytes>"
+    packet.SetFilePos (1);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+    if (addr == LLDB_INVALID_ADDRESS || packet.GetChar() != ',')
+        return SendErrorResponse (20);
+    const size_t length = packet.GetHexMaxU64 (false, 0);
+    if (packet.GetChar() != ':')
+        return SendErrorResponse (20);
+    if (length == 0)
+        return SendOKResponse ();
+    if (length > g_max_memory_size)
+        return SendErrorResponse (27);
+
+    std::vector<uint8_t> buffer (length);
+    size_t bytes_decoded;
+    if (binary)
+        bytes_decoded = packet.GetEscapedBinaryData (&buffer[0], length);
+    else
+        bytes_decoded = packet.GetHexBytes (&buffer[0], length, 0);
+    if (bytes_decoded != length)
+        return SendErrorResponse (20);
+
+    Error error;
+    if (m_process_sp->WriteMemory (addr, &buffer[0], length, error) != length)
+        return SendErrorResponse (22);
+    return SendOKResponse ();
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_m (StringExtractorGDBRemote &packet)
+{
+    return ReadMemory (packet, false);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_M (StringExtractorGDBRemote &packet)
+{
+    return WriteMemory (packet, false);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_x (StringExtractorGDBRemote &packet)
+{
+    return ReadMemory (packet, true);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_X (StringExtractorGDBRemote &packet)
+{
+    return WriteMemory (packet, true);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_Z (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // Packet format: "Z0,<addr>,<kind>". Only software breakpoints are
+    // supported. They become internal breakpoints in our target so the
+    // process plug-in reports hits and steps over them for us.
+    packet.SetFilePos (1);
+    if (packet.GetChar() != '0')
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+    if (packet.GetChar() != ',')
+        return SendErrorResponse (23);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+    if (addr == LLDB_INVALID_ADDRESS)
+        return SendErrorResponse (23);
+
+    if (m_breakpoints.find (addr) != m_breakpoints.end())
+        return SendOKResponse ();
+
+    BreakpointSP bp_sp (m_target_sp->CreateBreakpoint (addr, true));
+    if (!bp_sp)
+        return SendErrorResponse (23);
+    if (bp_sp->GetNumResolvedLocations() == 0)
+    {
+        m_target_sp->RemoveBreakpointByID (bp_sp->GetID());
+        return SendErrorResponse (23);
+    }
+    m_breakpoints[addr] = bp_sp->GetID();
+    return SendOKResponse ();
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_z (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // Packet format: "z0,<addr>,<kind>"
+    packet.SetFilePos (1);
+    if (packet.GetChar() != '0')
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+    if (packet.GetChar() != ',')
+        return SendErrorResponse (23);
+    const lldb::addr_t addr = packet.GetHexMaxU64 (false, LLDB_INVALID_ADDRESS);
+
+    BreakpointMap::iterator pos = m_breakpoints.find (addr);
+    if (pos != m_breakpoints.end())
+    {
+        m_target_sp->RemoveBreakpointByID (pos->second);
+        m_breakpoints.erase (pos);
+    }
+    return SendOKResponse ();
+}
+
+bool
+GDBRemoteCommunicationServer::ResumeProcess (const ResumeAction &default_action,
+                                             const ResumeActionMap &thread_actions)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+    if (!StateIsStoppedState (m_process_sp->GetState(), true))
+        return SendErrorResponse (16);
+
+    // Forget the events from the previous stop so that only the ones for
+    // this resume are seen below.
+    EventSP event_sp;
+    while (m_process_listener.GetNextEvent (event_sp))
+        event_sp.reset();
+
+    // A thread that single steps while the packet leaves the other threads
+    // stopped runs alone, which the thread plan takes care of. Threads are
+    // otherwise resumed together.
+    const bool others_run = default_action.state != eStateSuspended;
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    const uint32_t num_threads = thread_list.GetSize();
+    for (uint32_t idx = 0; idx < num_threads; ++idx)
+    {
+        ThreadSP thread_sp (thread_list.GetThreadAtIndex (idx));
+        ResumeAction action = default_action;
+        ResumeActionMap::const_iterator pos = thread_actions.find (thread_sp->GetID());
+        if (pos != thread_actions.end())
+            action = pos->second;
+
+        thread_sp->SetResumeState (eStateRunning);
+        thread_sp->SetResumeSignal (action.signo ? action.signo : LLDB_INVALID_SIGNAL_NUMBER);
+        if (action.state == eStateStepping)
+        {
+            thread_sp->QueueThreadPlanForStepSingleInstruction (false, true, !others_run);
+            thread_list.SetSelectedThreadByID (thread_sp->GetID());
+        }
+    }
+
+    Error error (m_process_sp->Resume ());
+    if (error.Fail())
+        return SendErrorResponse (16);
+
+    // Wait for the process to stop while watching the connection for an
+    // interrupt from the client.
+    for (;;)
+    {
+        TimeValue timeout = TimeValue::Now();
+        timeout.OffsetWithMicroSeconds (50000);
+        if (m_process_listener.WaitForEvent (&timeout, event_sp))
+        {
+            const StateType state = Process::ProcessEventData::GetStateFromEvent (event_sp.get());
+            if (StateIsStoppedState (state, false) &&
+                !Process::ProcessEventData::GetRestartedFromEvent (event_sp.get()))
+                break;
+            continue;
+        }
+
+        StringExtractorGDBRemote packet;
+        if (WaitForPacketWithTimeoutMicroSeconds (packet, 0))
+        {
+            if (packet.GetServerPacketType() == StringExtractorGDBRemote::eServerPacketType_interrupt)
+                m_process_sp->Halt();
+        }
+        else if (!IsConnected())
+        {
+            m_process_sp->Destroy();
+            return false;
+        }
+    }
+    return SendStopReplyPacketForThread (LLDB_INVALID_THREAD_ID);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_c (StringExtractorGDBRemote &packet)
+{
+    // Packet format: "c" or "C<signo>"; resume addresses aren't supported.
+    packet.SetFilePos (1);
+    ResumeAction action = { eStateRunning, 0 };
+    if (packet.GetStringRef()[0] == 'C')
+        action.signo = packet.GetHexU8 ();
+    if (packet.GetBytesLeft() > 0)
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+    return ResumeProcess (action, ResumeActionMap());
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_s (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // Packet format: "s" or "S<signo>"; steps the thread chosen with "Hc".
+    packet.SetFilePos (1);
+    ResumeAction action = { eStateStepping, 0 };
+    if (packet.GetStringRef()[0] == 'S')
+        action.signo = packet.GetHexU8 ();
+    if (packet.GetBytesLeft() > 0)
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+
+    ThreadList &thread_list = m_process_sp->GetThreadList();
+    ThreadSP thread_sp;
+    if (m_continue_tid != LLDB_INVALID_THREAD_ID && m_continue_tid != 0)
+        thread_sp = thread_list.FindThreadByID (m_continue_tid);
+    else
+        thread_sp = thread_list.GetSelectedThread();
+    if (!thread_sp)
+        return SendErrorResponse (18);
+
+    const ResumeAction default_action = { eStateSuspended, 0 };
+    ResumeActionMap thread_actions;
+    thread_actions[thread_sp->GetID()] = action;
+    return ResumeProcess (default_action, thread_actions);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_vCont_actions (StringExtractorGDBRemote &packet)
+{
+    if (m_is_platform)
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+    return SendPacket ("vCont;c;C;s;S");
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_vCont (StringExtractorGDBRemote &packet)
+{
+    // Packet format: "vCont;<action>[:<tid>];...". An action without a
+    // thread ID applies to all threads no other action names.
+    packet.SetFilePos (::strlen ("vCont"));
+    ResumeAction default_action = { eStateSuspended, 0 };
+    ResumeActionMap thread_actions;
+    while (packet.GetBytesLeft() > 0)
+    {
+        if (packet.GetChar() != ';')
+            return SendErrorResponse (24);
+
+        ResumeAction action = { eStateInvalid, 0 };
+        switch (packet.GetChar())
+        {
+        case 'C':
+            action.signo = packet.GetHexU8 ();
+            // Fall through
+        case 'c':
+            action.state = eStateRunning;
+            break;
+
+        case 'S':
+            action.signo = packet.GetHexU8 ();
+            // Fall through
+        case 's':
+            action.state = eStateStepping;
+            break;
+
+        default:
+            return SendErrorResponse (24);
+        }
+
+        const char *tid_cstr = packet.Peek();
+        if (tid_cstr && tid_cstr[0] == ':')
+        {
+            packet.GetChar();
+            const lldb::tid_t tid = packet.GetHexMaxU64 (false, LLDB_INVALID_THREAD_ID);
+            if (tid == LLDB_INVALID_THREAD_ID)
+                return SendErrorResponse (24);
+            thread_actions[tid] = action;
+        }
+        else
+        {
+            default_action = action;
+        }
+    }
+    return ResumeProcess (default_action, thread_actions);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_vAttach (StringExtractorGDBRemote &packet)
+{
+    if (m_is_platform)
+        return SendUnimplementedResponse (packet.GetStringRef().c_str());
+
+    // Packet format: "vAttach;<pid>"
+    packet.SetFilePos (::strlen ("vAttach;"));
+    const lldb::pid_t pid = packet.GetHexMaxU64 (false, LLDB_INVALID_PROCESS_ID);
+    if (pid == LLDB_INVALID_PROCESS_ID)
+        return SendErrorResponse (25);
+
+    m_process_launch_error = AttachToProcess (pid);
+    if (m_process_launch_error.Fail())
+        return SendErrorResponse (25);
+    return SendStopReplyPacketForThread (LLDB_INVALID_THREAD_ID);
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_k (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+    m_process_sp->Destroy();
+    return SendPacket ("X09");
+}
+
+bool
+GDBRemoteCommunicationServer::Handle_D (StringExtractorGDBRemote &packet)
+{
+    if (!m_process_sp)
+        return SendErrorResponse (15);
+
+    // Take our breakpoints out before letting the process go
+    for (BreakpointMap::iterator pos = m_breakpoints.begin(); pos != m_breakpoints.end(); ++pos)
+        m_target_sp->RemoveBreakpointByID (pos->second);
+    m_breakpoints.clear();
+
+    Error error (m_process_sp->Detach());
+    if (error.Fail())
+        return SendErrorResponse (26);
+    return SendOKResponse ();
+}
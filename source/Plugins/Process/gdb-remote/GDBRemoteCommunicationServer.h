@@ -12,8 +12,11 @@
 
 // C Includes
 // C++ Includes
+#include <map>
+
 // Other libraries and framework includes
 // Project includes
+#include "lldb/Core/Listener.h"
 #include "lldb/Target/Process.h"
 
 #include "GDBRemoteCommunication.h"
@@ -62,7 +65,45 @@ public:
         m_hi_port_num = hi_port_num;
     }
 
+    //------------------------------------------------------------------
+    // When not acting as a platform, the server debugs a single inferior
+    // through a native lldb_private::Process plug-in (ProcessLinux on
+    // Linux) and answers the process packets that debugserver would.
+    //------------------------------------------------------------------
+    void
+    SetProcessPluginName (const char *plugin_name)
+    {
+        if (plugin_name)
+            m_process_plugin_name.assign (plugin_name);
+        else
+            m_process_plugin_name.clear();
+    }
+
+    lldb_private::ProcessLaunchInfo &
+    GetProcessLaunchInfo ()
+    {
+        return m_process_launch_info;
+    }
+
+    // Launch the inferior described by GetProcessLaunchInfo() and wait for
+    // it to stop at its first instruction.
+    lldb_private::Error
+    LaunchProcess ();
+
+    // Attach to an existing process and wait for it to stop.
+    lldb_private::Error
+    AttachToProcess (lldb::pid_t pid);
+
 protected:
+    struct ResumeAction
+    {
+        lldb::StateType state;  // eStateRunning, eStateStepping or eStateSuspended
+        int signo;              // Signal to deliver on resume, or zero
+    };
+
+    typedef std::map<lldb::tid_t, ResumeAction> ResumeActionMap;
+    typedef std::map<lldb::addr_t, lldb::break_id_t> BreakpointMap;
+
     //typedef std::map<uint16_t, lldb::pid_t> PortToPIDMap;
 
     lldb::thread_t m_async_thread;
@@ -73,6 +114,14 @@ protected:
     uint16_t m_lo_port_num;
     uint16_t m_hi_port_num;
     //PortToPIDMap m_port_to_pid_map;
+    std::string m_process_plugin_name;
+    lldb::DebuggerSP m_debugger_sp;
+    lldb::TargetSP m_target_sp;
+    lldb::ProcessSP m_process_sp;
+    lldb_private::Listener m_process_listener;
+    lldb::tid_t m_current_tid;      // Thread selected with "Hg"
+    lldb::tid_t m_continue_tid;     // Thread selected with "Hc"
+    BreakpointMap m_breakpoints;    // Z0 breakpoints by address
 
     size_t
     SendUnimplementedResponse (const char *packet);
@@ -136,7 +185,101 @@ protected:
 
     bool
     Handle_QSetSTDERR (StringExtractorGDBRemote &packet);
-    
+
+    bool
+    Handle_QThreadSuffixSupported (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_stop_reason (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_qfThreadInfo (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_qsThreadInfo (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_qThreadStopInfo (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_qRegisterInfo (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_qShlibInfoAddr (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_H (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_p (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_P (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_g (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_G (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_m (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_M (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_x (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_X (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_Z (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_z (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_c (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_s (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_vCont_actions (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_vCont (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_vAttach (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_k (StringExtractorGDBRemote &packet);
+
+    bool
+    Handle_D (StringExtractorGDBRemote &packet);
+
+    lldb::StateType
+    WaitForProcessToStop (const lldb_private::TimeValue *timeout);
+
+    bool
+    ResumeProcess (const ResumeAction &default_action,
+                   const ResumeActionMap &thread_actions);
+
+    bool
+    SendStopReplyPacketForThread (lldb::tid_t tid);
+
+    lldb::ThreadSP
+    GetThreadForPacket (StringExtractorGDBRemote &packet);
+
+    bool
+    ReadMemory (StringExtractorGDBRemote &packet, bool binary);
+
+    bool
+    WriteMemory (StringExtractorGDBRemote &packet, bool binary);
+
 private:
     //------------------------------------------------------------------
     // For GDBRemoteCommunicationServer only
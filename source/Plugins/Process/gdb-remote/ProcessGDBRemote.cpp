@@ -36,11 +36,16 @@
 #include "lldb/Core/Timer.h"
 #include "lldb/Core/Value.h"
 #include "lldb/Host/TimeValue.h"
+#include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Interpreter/CommandObjectMultiword.h"
+#include "lldb/Interpreter/CommandReturnObject.h"
+#include "lldb/Interpreter/Options.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/DynamicLoader.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/TargetList.h"
 #include "lldb/Target/ThreadPlanCallFunction.h"
+#include "lldb/Target/UnwindAssembly.h"
 #include "lldb/Utility/PseudoTerminal.h"
 
 // Project includes
@@ -134,7 +139,9 @@ ProcessGDBRemote::ProcessGDBRemote(Target& target, Listener &listener) :
     m_dispatch_queue_offsets_addr (LLDB_INVALID_ADDRESS),
     m_max_memory_size (512),
     m_waiting_for_attach (false),
-    m_thread_observation_bps()
+    m_thread_observation_bps(),
+    m_command_sp (),
+    m_supports_displaced_stepping (eLazyBoolCalculate)
 {
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncThreadShouldExit,   "async thread should exit");
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncContinue,           "async thread continue");
@@ -1211,7 +1218,7 @@ ProcessGDBRemote::SetThreadStopInfo (StringExtractor& stop_packet)
                     // Swap "value" over into "name_extractor"
                     desc_extractor.GetStringRef().swap(value);
                     // Now convert the HEX bytes into a string value
-                    desc_extractor.GetHexByteString (thread_name);
+                    desc_extractor.GetHexByteString (description);
                 }
                 else if (name.size() == 2 && ::isxdigit(name[0]) && ::isxdigit(name[1]))
                 {
@@ -1604,8 +1611,10 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
         size = m_max_memory_size;
     }
 
+    // Binary reads return half as many bytes over the wire as hex ones
+    const bool binary = m_gdb_comm.GetxPacketSupported();
     char packet[64];
-    const int packet_len = ::snprintf (packet, sizeof(packet), "m%llx,%zx", (uint64_t)addr, size);
+    const int packet_len = ::snprintf (packet, sizeof(packet), "%c%llx,%zx", binary ? 'x' : 'm', (uint64_t)addr, size);
     assert (packet_len + 1 < sizeof(packet));
     StringExtractorGDBRemote response;
     if (m_gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, true))
@@ -1613,6 +1622,12 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
         if (response.IsNormalResponse())
         {
             error.Clear();
+            if (binary)
+            {
+                // Skip the leading 'b' that marks binary data
+                response.SetFilePos(1);
+                return response.GetEscapedBinaryData(buf, size);
+            }
             return response.GetHexBytes(buf, size, '\xdd');
         }
         else if (response.IsErrorResponse())
@@ -1641,8 +1656,16 @@ ProcessGDBRemote::DoWriteMemory (addr_t addr, const void *buf, size_t size, Erro
     }
 
     StreamString packet;
-    packet.Printf("M%llx,%zx:", addr, size);
-    packet.PutBytesAsRawHex8(buf, size, lldb::endian::InlHostByteOrder(), lldb::endian::InlHostByteOrder());
+    if (m_gdb_comm.GetxPacketSupported())
+    {
+        packet.Printf("X%llx,%zx:", addr, size);
+        GDBRemoteCommunication::PutEscapedBinary(packet, buf, size);
+    }
+    else
+    {
+        packet.Printf("M%llx,%zx:", addr, size);
+        packet.PutBytesAsRawHex8(buf, size, lldb::endian::InlHostByteOrder(), lldb::endian::InlHostByteOrder());
+    }
     StringExtractorGDBRemote response;
     if (m_gdb_comm.SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true))
     {
@@ -1704,6 +1727,29 @@ ProcessGDBRemote::DoAllocateMemory (size_t size, uint32_t permissions, Error &er
     return allocated_addr;
 }
 
+bool
+ProcessGDBRemote::SupportsDisplacedStepping ()
+{
+    // Scratch memory for displaced stepping gets allocated while we are
+    // resuming, so only allow it when the remote stub can allocate memory
+    // for us. Falling back to calling mmap() would run the inferior.
+    if (m_supports_displaced_stepping == eLazyBoolCalculate)
+    {
+        m_supports_displaced_stepping = eLazyBoolNo;
+        if (m_gdb_comm.SupportsAllocDeallocMemory() != eLazyBoolNo)
+        {
+            const uint32_t permissions = ePermissionsReadable | ePermissionsWritable | ePermissionsExecutable;
+            addr_t addr = m_gdb_comm.AllocateMemory (DisplacedInstruction::kMaxByteSize, permissions);
+            if (addr != LLDB_INVALID_ADDRESS)
+            {
+                m_gdb_comm.DeallocateMemory (addr);
+                m_supports_displaced_stepping = eLazyBoolYes;
+            }
+        }
+    }
+    return m_supports_displaced_stepping == eLazyBoolYes;
+}
+
 Error
 ProcessGDBRemote::GetMemoryRegionInfo (addr_t load_addr, 
                                        MemoryRegionInfo &region_info)
@@ -1873,6 +1919,140 @@ ProcessGDBRemote::DisableBreakpoint (BreakpointSite *bp_site)
     return error;
 }
 
+Error
+ProcessGDBRemote::EnableBreakpoints (const BreakpointSiteCollection &bp_sites)
+{
+    Error error;
+    LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("ProcessGDBRemote::EnableBreakpoints (%llu sites)", (uint64_t)bp_sites.size());
+
+    BreakpointSiteCollection software_sites;
+    BreakpointSiteCollection external_sites;
+    std::vector<addr_t> addrs;
+    std::vector<uint32_t> lengths;
+    const bool supports_z0 = m_gdb_comm.SupportsGDBStoppointPacket (eBreakpointSoftware);
+    BreakpointSiteCollection::const_iterator pos, end = bp_sites.end();
+    for (pos = bp_sites.begin(); pos != end; ++pos)
+    {
+        BreakpointSite *bp_site = *pos;
+        if (bp_site->IsEnabled())
+            continue;
+
+        if (bp_site->HardwarePreferred())
+        {
+            // Hardware breakpoints are rare, set them one at a time
+            Error site_error (EnableBreakpoint (bp_site));
+            if (site_error.Fail() && error.Success())
+                error = site_error;
+        }
+        else if (supports_z0)
+        {
+            external_sites.push_back (bp_site);
+            addrs.push_back (bp_site->GetLoadAddress());
+            lengths.push_back (GetSoftwareBreakpointTrapOpcode (bp_site));
+        }
+        else
+        {
+            software_sites.push_back (bp_site);
+        }
+    }
+
+    if (!external_sites.empty())
+    {
+        std::vector<bool> results;
+        m_gdb_comm.SendGDBStoppointTypePackets (eBreakpointSoftware, true, addrs, lengths, results);
+        const size_t num_external_sites = external_sites.size();
+        for (size_t i = 0; i < num_external_sites; ++i)
+        {
+            if (results[i])
+            {
+                external_sites[i]->SetEnabled(true);
+                external_sites[i]->SetType (BreakpointSite::eExternal);
+            }
+            else
+            {
+                // Fall back to writing the trap into memory ourselves
+                software_sites.push_back (external_sites[i]);
+            }
+        }
+    }
+
+    if (!software_sites.empty())
+    {
+        Error software_error (EnableSoftwareBreakpoints (software_sites));
+        if (software_error.Fail() && error.Success())
+            error = software_error;
+    }
+    return error;
+}
+
+Error
+ProcessGDBRemote::DisableBreakpoints (const BreakpointSiteCollection &bp_sites)
+{
+    Error error;
+    LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+    if (log)
+        log->Printf ("ProcessGDBRemote::DisableBreakpoints (%llu sites)", (uint64_t)bp_sites.size());
+
+    BreakpointSiteCollection software_sites;
+    BreakpointSiteCollection external_sites;
+    std::vector<addr_t> addrs;
+    std::vector<uint32_t> lengths;
+    BreakpointSiteCollection::const_iterator pos, end = bp_sites.end();
+    for (pos = bp_sites.begin(); pos != end; ++pos)
+    {
+        BreakpointSite *bp_site = *pos;
+        if (!bp_site->IsEnabled())
+            continue;
+
+        switch (bp_site->GetType())
+        {
+        case BreakpointSite::eSoftware:
+            software_sites.push_back (bp_site);
+            break;
+
+        case BreakpointSite::eExternal:
+            external_sites.push_back (bp_site);
+            addrs.push_back (bp_site->GetLoadAddress());
+            lengths.push_back (GetSoftwareBreakpointTrapOpcode (bp_site));
+            break;
+
+        case BreakpointSite::eHardware:
+            {
+                Error site_error (DisableBreakpoint (bp_site));
+                if (!bp_site->IsEnabled())
+                    break;
+                if (site_error.Fail() && error.Success())
+                    error = site_error;
+            }
+            break;
+        }
+    }
+
+    if (!external_sites.empty())
+    {
+        std::vector<bool> results;
+        m_gdb_comm.SendGDBStoppointTypePackets (eBreakpointSoftware, false, addrs, lengths, results);
+        const size_t num_external_sites = external_sites.size();
+        for (size_t i = 0; i < num_external_sites; ++i)
+        {
+            if (results[i])
+                external_sites[i]->SetEnabled(false);
+            else if (error.Success())
+                error.SetErrorStringWithFormat ("failed to remove breakpoint at 0x%llx", (uint64_t)addrs[i]);
+        }
+    }
+
+    if (!software_sites.empty())
+    {
+        Error software_error (DisableSoftwareBreakpoints (software_sites));
+        if (software_error.Fail() && error.Success())
+            error = software_error;
+    }
+    return error;
+}
+
 // Pre-requisite: wp != NULL.
 static GDBStoppointType
 GetGDBStoppointType (Watchpoint *wp)
@@ -2592,3 +2772,207 @@ ProcessGDBRemote::StopNoticingNewThreads()
 }
     
 
+
+
+//----------------------------------------------------------------------
+// Plug-in commands available through "process plugin" and, for the
+// "remote-gdb-server" platform, through "platform plugin"
+//----------------------------------------------------------------------
+class CommandObjectGDBRemotePacketSpeedTest : public CommandObject
+{
+public:
+
+    class CommandOptions : public Options
+    {
+    public:
+
+        CommandOptions (CommandInterpreter &interpreter) :
+            Options(interpreter)
+        {
+            OptionParsingStarting ();
+        }
+
+        ~CommandOptions ()
+        {
+        }
+
+        Error
+        SetOptionValue (uint32_t option_idx, const char *option_arg)
+        {
+            Error error;
+            char short_option = (char) m_getopt_table[option_idx].val;
+            bool success = false;
+            switch (short_option)
+            {
+                case 'c':
+                    num_packets = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success || num_packets == 0)
+                        error.SetErrorStringWithFormat("invalid packet count '%s'", option_arg);
+                    break;
+
+                case 's':
+                    max_send = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success)
+                        error.SetErrorStringWithFormat("invalid max send size '%s'", option_arg);
+                    break;
+
+                case 'r':
+                    max_recv = Args::StringToUInt32 (option_arg, 0, 0, &success);
+                    if (!success)
+                        error.SetErrorStringWithFormat("invalid max receive size '%s'", option_arg);
+                    break;
+
+                case 'j':
+                    json = true;
+                    break;
+
+                default:
+                    error.SetErrorStringWithFormat("invalid short option character '%c'", short_option);
+                    break;
+            }
+            return error;
+        }
+
+        void
+        OptionParsingStarting ()
+        {
+            num_packets = 1000;
+            max_send = 1024;
+            max_recv = 1024;
+            json = false;
+        }
+
+        const OptionDefinition*
+        GetDefinitions ()
+        {
+            return g_option_table;
+        }
+
+        // Options table: Required for subclasses of Options.
+
+        static OptionDefinition g_option_table[];
+
+        // Instance variables to hold the values for command options.
+
+        uint32_t num_packets;
+        uint32_t max_send;
+        uint32_t max_recv;
+        bool json;
+    };
+
+    CommandObjectGDBRemotePacketSpeedTest (CommandInterpreter &interpreter,
+                                           const std::string &cmd_prefix,
+                                           GDBRemoteCommunicationClient &gdb_client) :
+        CommandObject (interpreter,
+                       (cmd_prefix + " packet speed-test").c_str(),
+                       "Benchmark the GDB remote packet transport by sending packets of varying sizes and reporting latencies.",
+                       (cmd_prefix + " packet speed-test [<cmd-options>]").c_str(),
+                       0),
+        m_options (interpreter),
+        m_gdb_client (gdb_client)
+    {
+    }
+
+    ~CommandObjectGDBRemotePacketSpeedTest ()
+    {
+    }
+
+    Options *
+    GetOptions ()
+    {
+        return &m_options;
+    }
+
+    bool
+    Execute (Args& command, CommandReturnObject &result)
+    {
+        if (command.GetArgumentCount() != 0)
+        {
+            result.AppendErrorWithFormat ("'%s' takes no arguments, only options.\n", m_cmd_name.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        if (!m_gdb_client.IsConnected())
+        {
+            result.AppendError ("not connected to a GDB remote server");
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        m_gdb_client.TestPacketSpeed (m_options.num_packets,
+                                      m_options.max_send,
+                                      m_options.max_recv,
+                                      m_options.json,
+                                      result.GetOutputStream());
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return true;
+    }
+
+protected:
+
+    CommandOptions m_options;
+    GDBRemoteCommunicationClient &m_gdb_client;
+};
+
+OptionDefinition
+CommandObjectGDBRemotePacketSpeedTest::CommandOptions::g_option_table[] =
+{
+{ LLDB_OPT_SET_1, false, "count",    'c', required_argument, NULL, 0, eArgTypeCount,       "The number of packets to send for each send and receive size (default is 1000)."},
+{ LLDB_OPT_SET_1, false, "max-send", 's', required_argument, NULL, 0, eArgTypeByteSize,    "The maximum number of payload bytes to send in each packet (default is 1024)."},
+{ LLDB_OPT_SET_1, false, "max-recv", 'r', required_argument, NULL, 0, eArgTypeByteSize,    "The maximum number of payload bytes to request in each response (default is 1024)."},
+{ LLDB_OPT_SET_1, false, "json",     'j', no_argument,       NULL, 0, eArgTypeNone,        "Print the results as JSON."},
+{ 0, false, NULL, 0, 0, NULL, 0, eArgTypeNone, NULL }
+};
+
+class CommandObjectGDBRemotePacket : public CommandObjectMultiword
+{
+public:
+    CommandObjectGDBRemotePacket (CommandInterpreter &interpreter,
+                                  const std::string &cmd_prefix,
+                                  GDBRemoteCommunicationClient &gdb_client) :
+        CommandObjectMultiword (interpreter,
+                                (cmd_prefix + " packet").c_str(),
+                                "Commands that deal with GDB remote packets.",
+                                NULL)
+    {
+        LoadSubCommand ("speed-test", CommandObjectSP (new CommandObjectGDBRemotePacketSpeedTest (interpreter, cmd_prefix, gdb_client)));
+    }
+
+    ~CommandObjectGDBRemotePacket ()
+    {
+    }
+};
+
+class CommandObjectMultiwordProcessGDBRemote : public CommandObjectMultiword
+{
+public:
+    CommandObjectMultiwordProcessGDBRemote (CommandInterpreter &interpreter, GDBRemoteCommunicationClient &gdb_client) :
+        CommandObjectMultiword (interpreter,
+                                "process plugin",
+                                "A set of commands for operating on a ProcessGDBRemote process.",
+                                "process plugin <subcommand> [<subcommand-options>]")
+    {
+        LoadSubCommand ("packet", CommandObjectSP (new CommandObjectGDBRemotePacket (interpreter, "process plugin", gdb_client)));
+    }
+
+    ~CommandObjectMultiwordProcessGDBRemote ()
+    {
+    }
+};
+
+CommandObject *
+ProcessGDBRemote::GetPluginCommandObject()
+{
+    if (!m_command_sp)
+        m_command_sp.reset (new CommandObjectMultiwordProcessGDBRemote (GetTarget().GetDebugger().GetCommandInterpreter(), m_gdb_comm));
+    return m_command_sp.get();
+}
+
+CommandObject *
+ProcessGDBRemote::CreatePacketCommandObject (CommandInterpreter &interpreter,
+                                             const char *cmd_prefix,
+                                             GDBRemoteCommunicationClient &gdb_client)
+{
+    return new CommandObjectGDBRemotePacket (interpreter, cmd_prefix, gdb_client);
+}
@@ -118,6 +118,19 @@ public:
     virtual uint32_t
     GetPluginVersion();
 
+    virtual lldb_private::CommandObject *
+    GetPluginCommandObject();
+
+    //------------------------------------------------------------------
+    // Create the "<cmd_prefix> packet" multi-word command that operates
+    // on \a gdb_client. The remote-gdb-server platform uses this to
+    // offer the same packet commands as "process plugin".
+    //------------------------------------------------------------------
+    static lldb_private::CommandObject *
+    CreatePacketCommandObject (lldb_private::CommandInterpreter &interpreter,
+                               const char *cmd_prefix,
+                               GDBRemoteCommunicationClient &gdb_client);
+
     //------------------------------------------------------------------
     // Process Control
     //------------------------------------------------------------------
@@ -173,6 +186,9 @@ public:
     virtual lldb_private::Error
     DoDeallocateMemory (lldb::addr_t ptr);
 
+    virtual bool
+    SupportsDisplacedStepping ();
+
     //------------------------------------------------------------------
     // Process STDIO
     //------------------------------------------------------------------
@@ -188,6 +204,12 @@ public:
     virtual lldb_private::Error
     DisableBreakpoint (lldb_private::BreakpointSite *bp_site);
 
+    virtual lldb_private::Error
+    EnableBreakpoints (const BreakpointSiteCollection &bp_sites);
+
+    virtual lldb_private::Error
+    DisableBreakpoints (const BreakpointSiteCollection &bp_sites);
+
     //----------------------------------------------------------------------
     // Process Watchpoints
     //----------------------------------------------------------------------
@@ -306,6 +328,8 @@ protected:
     bool m_waiting_for_attach;
     std::vector<lldb::user_id_t>  m_thread_observation_bps;
     MMapMap m_addr_to_mmap_size;
+    lldb::CommandObjectSP m_command_sp;
+    lldb_private::LazyBool m_supports_displaced_stepping;
     bool
     StartAsyncThread ();
 
@@ -31,14 +31,16 @@ DWARFAbbreviationDeclaration::DWARFAbbreviationDeclaration(dw_tag_t tag, uint8_t
 {
 }
 
+template <typename OffsetType>
 bool
-DWARFAbbreviationDeclaration::Extract(const DataExtractor& data, uint32_t* offset_ptr)
+DWARFAbbreviationDeclaration::Extract(const DataExtractor& data, OffsetType* offset_ptr)
 {
     return Extract(data, offset_ptr, data.GetULEB128(offset_ptr));
 }
 
+template <typename OffsetType>
 bool
-DWARFAbbreviationDeclaration::Extract(const DataExtractor& data, uint32_t* offset_ptr, dw_uleb128_t code)
+DWARFAbbreviationDeclaration::Extract(const DataExtractor& data, OffsetType* offset_ptr, dw_uleb128_t code)
 {
     m_code = code;
     m_attributes.clear();
@@ -69,6 +71,10 @@ DWARFAbbreviationDeclaration::Extract(const DataExtractor& data, uint32_t* offse
     return false;
 }
 
+template bool DWARFAbbreviationDeclaration::Extract (const DataExtractor& data, uint32_t* offset_ptr);
+template bool DWARFAbbreviationDeclaration::Extract (const DataExtractor& data, uint64_t* offset_ptr);
+template bool DWARFAbbreviationDeclaration::Extract (const DataExtractor& data, uint32_t* offset_ptr, dw_uleb128_t code);
+template bool DWARFAbbreviationDeclaration::Extract (const DataExtractor& data, uint64_t* offset_ptr, dw_uleb128_t code);
 
 void
 DWARFAbbreviationDeclaration::Dump(Stream *s)  const
@@ -63,8 +63,10 @@ public:
                         const DWARFCompileUnit* cu,
                         const uint32_t strp_min_len);
     uint32_t        FindAttributeIndex(dw_attr_t attr) const;
-    bool            Extract(const lldb_private::DataExtractor& data, uint32_t* offset_ptr);
-    bool            Extract(const lldb_private::DataExtractor& data, uint32_t* offset_ptr, dw_uleb128_t code);
+    template <typename OffsetType>
+    bool            Extract(const lldb_private::DataExtractor& data, OffsetType* offset_ptr);
+    template <typename OffsetType>
+    bool            Extract(const lldb_private::DataExtractor& data, OffsetType* offset_ptr, dw_uleb128_t code);
 //  void            Append(BinaryStreamBuf& out_buff) const;
     bool            IsValid();
     void            Dump(lldb_private::Stream *s) const;
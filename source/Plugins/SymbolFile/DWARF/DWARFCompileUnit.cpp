@@ -60,14 +60,16 @@ DWARFCompileUnit::Clear()
     m_user_data     = NULL;
 }
 
+template <typename OffsetType>
 bool
-DWARFCompileUnit::Extract(const DataExtractor &debug_info, uint32_t* offset_ptr)
+DWARFCompileUnit::Extract(const DataExtractor &debug_info, OffsetType* offset_ptr)
 {
     Clear();
 
-    m_offset = *offset_ptr;
+    const OffsetType cu_offset = *offset_ptr;
+    m_offset = cu_offset;
 
-    if (debug_info.ValidOffset(*offset_ptr))
+    if (debug_info.ValidOffset(cu_offset))
     {
         dw_offset_t abbr_offset;
         const DWARFDebugAbbrev *abbr = m_dwarf2Data->DebugAbbrev();
@@ -88,12 +90,15 @@ DWARFCompileUnit::Extract(const DataExtractor &debug_info, uint32_t* offset_ptr)
         }
 
         // reset the offset to where we tried to parse from if anything went wrong
-        *offset_ptr = m_offset;
+        *offset_ptr = cu_offset;
     }
 
     return false;
 }
 
+template bool DWARFCompileUnit::Extract (const DataExtractor &debug_info, uint32_t* offset_ptr);
+template bool DWARFCompileUnit::Extract (const DataExtractor &debug_info, uint64_t* offset_ptr);
+
 
 dw_offset_t
 DWARFCompileUnit::Extract(dw_offset_t offset, const DataExtractor& debug_info_data, const DWARFAbbreviationDeclarationSet* abbrevs)
@@ -154,32 +159,51 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
         return 0; // Already parsed
 
     Timer scoped_timer (__PRETTY_FUNCTION__,
-                        "%8.8x: DWARFCompileUnit::ExtractDIEsIfNeeded( cu_die_only = %i )",
-                        m_offset,
+                        "%8.8llx: DWARFCompileUnit::ExtractDIEsIfNeeded( cu_die_only = %i )",
+                        (uint64_t)m_offset,
                         cu_die_only);
 
-    // Set the offset to that of the first DIE and calculate the start of the
-    // next compilation unit header.
-    uint32_t offset = GetFirstDIEOffset();
-    uint32_t next_cu_offset = GetNextCompileUnitOffset();
-
-    DWARFDebugInfoEntry die;
-        // Keep a flat array of the DIE for binary lookup by DIE offset
+    // Keep a flat array of the DIE for binary lookup by DIE offset
     if (!cu_die_only)
     {
         LogSP log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
         if (log)
         {
             m_dwarf2Data->LogMessage (log.get(), 
-                                      "DWARFCompileUnit::ExtractDIEsIfNeeded () for compile unit at .debug_info[0x%8.8x]", 
-                                      GetOffset());
+                                      "DWARFCompileUnit::ExtractDIEsIfNeeded () for compile unit at .debug_info[0x%8.8llx]", 
+                                      (uint64_t)GetOffset());
         }
     }
 
+    // Only walk the DIEs with 64 bit offsets when the .debug_info section
+    // is too large for 32 bit ones.
+    const DataExtractor& debug_info_data = m_dwarf2Data->get_debug_info_data();
+    if (DW_SECTION_NEEDS_64BIT_OFFSETS(debug_info_data.GetByteSize()))
+        return ExtractDIEs<uint64_t> (debug_info_data, cu_die_only, initial_die_array_size);
+    return ExtractDIEs<uint32_t> (debug_info_data, cu_die_only, initial_die_array_size);
+}
+
+//----------------------------------------------------------------------
+// ExtractDIEs
+//
+// Parses the DIEs of this compile unit using OffsetType for the offsets
+// into the .debug_info section.
+//----------------------------------------------------------------------
+template <typename OffsetType>
+size_t
+DWARFCompileUnit::ExtractDIEs (const DataExtractor& debug_info_data,
+                               bool cu_die_only,
+                               size_t initial_die_array_size)
+{
+    // Set the offset to that of the first DIE and calculate the start of the
+    // next compilation unit header.
+    OffsetType offset = GetFirstDIEOffset();
+    OffsetType next_cu_offset = GetNextCompileUnitOffset();
+
+    DWARFDebugInfoEntry die;
     uint32_t depth = 0;
     // We are in our compile unit, parse starting at the offset
     // we were told to parse
-    const DataExtractor& debug_info_data = m_dwarf2Data->get_debug_info_data();
     std::vector<uint32_t> die_index_stack;
     die_index_stack.reserve(32);
     die_index_stack.push_back(0);
@@ -266,9 +290,9 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
     // unit header).
     if (offset > next_cu_offset)
     {
-        m_dwarf2Data->ReportWarning ("DWARF compile unit extends beyond its bounds cu 0x%8.8x at 0x%8.8x\n", 
-                                     GetOffset(), 
-                                     offset);
+        m_dwarf2Data->ReportWarning ("DWARF compile unit extends beyond its bounds cu 0x%8.8llx at 0x%8.8llx\n", 
+                                     (uint64_t)GetOffset(), 
+                                     (uint64_t)offset);
     }
 
     // Since std::vector objects will double their size, we really need to
@@ -314,12 +338,12 @@ DWARFCompileUnit::Verify(Stream *s) const
     if (valid_offset && length_OK && version_OK && addr_size_OK && abbr_offset_OK)
     {
         if (verbose)
-            s->Printf("    0x%8.8x: OK\n", m_offset);
+            s->Printf("    0x%8.8llx: OK\n", (uint64_t)m_offset);
         return true;
     }
     else
     {
-        s->Printf("    0x%8.8x: ", m_offset);
+        s->Printf("    0x%8.8llx: ", (uint64_t)m_offset);
 
         m_dwarf2Data->get_debug_info_data().Dump (s, m_offset, lldb::eFormatHex, 1, Size(), 32, LLDB_INVALID_ADDRESS, 0, 0);
         s->EOL();
@@ -330,7 +354,7 @@ DWARFCompileUnit::Verify(Stream *s) const
             if (!version_OK)
                 s->Printf("        The 16 bit compile unit header version is not supported.\n");
             if (!abbr_offset_OK)
-                s->Printf("        The offset into the .debug_abbrev section (0x%8.8x) is not valid.\n", GetAbbrevOffset());
+                s->Printf("        The offset into the .debug_abbrev section (0x%8.8llx) is not valid.\n", (uint64_t)GetAbbrevOffset());
             if (!addr_size_OK)
                 s->Printf("        The address size is unsupported: 0x%2.2x\n", m_addr_size);
         }
@@ -344,8 +368,8 @@ DWARFCompileUnit::Verify(Stream *s) const
 void
 DWARFCompileUnit::Dump(Stream *s) const
 {
-    s->Printf("0x%8.8x: Compile Unit: length = 0x%8.8x, version = 0x%4.4x, abbr_offset = 0x%8.8x, addr_size = 0x%2.2x (next CU at {0x%8.8x})\n",
-                m_offset, m_length, m_version, GetAbbrevOffset(), m_addr_size, GetNextCompileUnitOffset());
+    s->Printf("0x%8.8llx: Compile Unit: length = 0x%8.8x, version = 0x%4.4x, abbr_offset = 0x%8.8llx, addr_size = 0x%2.2x (next CU at {0x%8.8llx})\n",
+                (uint64_t)m_offset, m_length, m_version, (uint64_t)GetAbbrevOffset(), m_addr_size, (uint64_t)GetNextCompileUnitOffset());
 }
 
 
@@ -405,8 +429,8 @@ DWARFCompileUnit::GetFunctionAranges ()
         if (log)
         {
             m_dwarf2Data->LogMessage (log.get(), 
-                                      "DWARFCompileUnit::GetFunctionAranges() for compile unit at .debug_info[0x%8.8x]",
-                                      GetOffset());
+                                      "DWARFCompileUnit::GetFunctionAranges() for compile unit at .debug_info[0x%8.8llx]",
+                                      (uint64_t)GetOffset());
         }
         DIE()->BuildFunctionAddressRangeTable (m_dwarf2Data, this, m_func_aranges_ap.get());
         const bool minimize = false;
@@ -578,8 +602,8 @@ DWARFCompileUnit::Index (const uint32_t cu_idx,
     if (log)
     {
         m_dwarf2Data->LogMessage (log.get(), 
-                                  "DWARFCompileUnit::Index() for compile unit at .debug_info[0x%8.8x]",
-                                  GetOffset());
+                                  "DWARFCompileUnit::Index() for compile unit at .debug_info[0x%8.8llx]",
+                                  (uint64_t)GetOffset());
     }
 
     DWARFDebugInfoEntry::const_iterator pos;
@@ -20,7 +20,8 @@ class DWARFCompileUnit
 public:
     DWARFCompileUnit(SymbolFileDWARF* dwarf2Data);
 
-    bool        Extract(const lldb_private::DataExtractor &debug_info, uint32_t* offset_ptr);
+    template <typename OffsetType>
+    bool        Extract(const lldb_private::DataExtractor &debug_info, OffsetType* offset_ptr);
     dw_offset_t Extract(dw_offset_t offset, const lldb_private::DataExtractor& debug_info_data, const DWARFAbbreviationDeclarationSet* abbrevs);
     size_t      ExtractDIEsIfNeeded (bool cu_die_only);
     bool        LookupAddress(
@@ -151,6 +152,12 @@ public:
     GetFunctionAranges ();
 
 protected:
+    template <typename OffsetType>
+    size_t
+    ExtractDIEs (const lldb_private::DataExtractor& debug_info_data,
+                 bool cu_die_only,
+                 size_t initial_die_array_size);
+
     SymbolFileDWARF*    m_dwarf2Data;
     const DWARFAbbreviationDeclarationSet *m_abbrevs;
     void *              m_user_data;
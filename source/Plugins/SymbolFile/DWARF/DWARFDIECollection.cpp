@@ -58,5 +58,5 @@ DWARFDIECollection::Dump(Stream *s, const char* title) const
     const_iterator end_pos = m_dies.end();
     const_iterator pos;
     for (pos = m_dies.begin(); pos != end_pos; ++pos)
-        s->Printf( "0x%8.8x\n", (*pos)->GetOffset());
+        s->Printf( "0x%8.8llx\n", (uint64_t)(*pos)->GetOffset());
 }
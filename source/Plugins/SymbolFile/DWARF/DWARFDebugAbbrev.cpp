@@ -29,10 +29,11 @@ DWARFAbbreviationDeclarationSet::Clear()
 //----------------------------------------------------------------------
 // DWARFAbbreviationDeclarationSet::Extract()
 //----------------------------------------------------------------------
+template <typename OffsetType>
 bool
-DWARFAbbreviationDeclarationSet::Extract(const DataExtractor& data, uint32_t* offset_ptr)
+DWARFAbbreviationDeclarationSet::Extract(const DataExtractor& data, OffsetType* offset_ptr)
 {
-    const uint32_t begin_offset = *offset_ptr;
+    const OffsetType begin_offset = *offset_ptr;
     m_offset = begin_offset;
     Clear();
     DWARFAbbreviationDeclaration abbrevDeclaration;
@@ -52,6 +53,9 @@ DWARFAbbreviationDeclarationSet::Extract(const DataExtractor& data, uint32_t* of
     return begin_offset != *offset_ptr;
 }
 
+template bool DWARFAbbreviationDeclarationSet::Extract (const DataExtractor& data, uint32_t* offset_ptr);
+template bool DWARFAbbreviationDeclarationSet::Extract (const DataExtractor& data, uint64_t* offset_ptr);
+
 
 //----------------------------------------------------------------------
 // DWARFAbbreviationDeclarationSet::Dump()
@@ -144,11 +148,28 @@ DWARFDebugAbbrev::DWARFDebugAbbrev() :
 void
 DWARFDebugAbbrev::Parse(const DataExtractor& data)
 {
-    uint32_t offset = 0;
+    if (DW_SECTION_NEEDS_64BIT_OFFSETS(data.GetByteSize()))
+        ParseSets<uint64_t>(data);
+    else
+        ParseSets<uint32_t>(data);
+    m_prev_abbr_offset_pos = m_abbrevCollMap.end();
+}
+
+//----------------------------------------------------------------------
+// DWARFDebugAbbrev::ParseSets()
+//
+// Parse all abbreviation declaration sets using OffsetType for the
+// offsets into the .debug_abbrev section.
+//----------------------------------------------------------------------
+template <typename OffsetType>
+void
+DWARFDebugAbbrev::ParseSets(const DataExtractor& data)
+{
+    OffsetType offset = 0;
 
     while (data.ValidOffset(offset))
     {
-        uint32_t initial_cu_offset = offset;
+        OffsetType initial_cu_offset = offset;
         DWARFAbbreviationDeclarationSet abbrevDeclSet;
 
         if (abbrevDeclSet.Extract(data, &offset))
@@ -156,7 +177,6 @@ DWARFDebugAbbrev::Parse(const DataExtractor& data)
         else
             break;
     }
-    m_prev_abbr_offset_pos = m_abbrevCollMap.end();
 }
 
 //----------------------------------------------------------------------
@@ -174,7 +194,7 @@ DWARFDebugAbbrev::Dump(Stream *s) const
     DWARFAbbreviationDeclarationCollMapConstIter pos;
     for (pos = m_abbrevCollMap.begin(); pos != m_abbrevCollMap.end(); ++pos)
     {
-        s->Printf("Abbrev table for offset: 0x%8.8x\n", pos->first);
+        s->Printf("Abbrev table for offset: 0x%8.8llx\n", (uint64_t)pos->first);
         pos->second.Dump(s);
     }
 }
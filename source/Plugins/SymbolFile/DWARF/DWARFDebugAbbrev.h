@@ -43,7 +43,8 @@ public:
     void Clear();
     dw_offset_t GetOffset() const { return m_offset; }
     void Dump(lldb_private::Stream *s) const;
-    bool Extract(const lldb_private::DataExtractor& data, uint32_t* offset_ptr);
+    template <typename OffsetType>
+    bool Extract(const lldb_private::DataExtractor& data, OffsetType* offset_ptr);
     //void Encode(BinaryStreamBuf& debug_abbrev_buf) const;
     dw_uleb128_t AppendAbbrevDeclSequential(const DWARFAbbreviationDeclaration& abbrevDecl);
 
@@ -67,6 +68,9 @@ public:
     void Dump(lldb_private::Stream *s) const;
     void Parse(const lldb_private::DataExtractor& data);
 protected:
+    template <typename OffsetType>
+    void ParseSets(const lldb_private::DataExtractor& data);
+
     DWARFAbbreviationDeclarationCollMap m_abbrevCollMap;
     mutable DWARFAbbreviationDeclarationCollMapConstIter m_prev_abbr_offset_pos;
 };
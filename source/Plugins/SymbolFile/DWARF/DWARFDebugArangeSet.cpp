@@ -43,7 +43,7 @@ void
 DWARFDebugArangeSet::SetHeader
 (
     uint16_t version,
-    uint32_t cu_offset,
+    dw_offset_t cu_offset,
     uint8_t addr_size,
     uint8_t seg_size
 )
@@ -161,13 +161,15 @@ DWARFDebugArangeSet::AddDescriptor(const DWARFDebugArangeSet::Descriptor& range)
     }
 }
 
+template <typename OffsetType>
 bool
-DWARFDebugArangeSet::Extract(const DataExtractor &data, uint32_t* offset_ptr)
+DWARFDebugArangeSet::Extract(const DataExtractor &data, OffsetType* offset_ptr)
 {
     if (data.ValidOffset(*offset_ptr))
     {
         m_arange_descriptors.clear();
-        m_offset = *offset_ptr;
+        const OffsetType set_offset = *offset_ptr;
+        m_offset = set_offset;
 
         // 7.20 Address Range Table
         //
@@ -194,13 +196,13 @@ DWARFDebugArangeSet::Extract(const DataExtractor &data, uint32_t* offset_ptr)
         // that is a multiple of the size of a single tuple (that is, twice the
         // size of an address). The header is padded, if necessary, to the
         // appropriate boundary.
-        const uint32_t header_size = *offset_ptr - m_offset;
+        const uint32_t header_size = *offset_ptr - set_offset;
         const uint32_t tuple_size = m_header.addr_size << 1;
         uint32_t first_tuple_offset = 0;
         while (first_tuple_offset < header_size)
             first_tuple_offset += tuple_size;
 
-        *offset_ptr = m_offset + first_tuple_offset;
+        *offset_ptr = set_offset + first_tuple_offset;
 
         Descriptor arangeDescriptor;
 
@@ -225,6 +227,9 @@ DWARFDebugArangeSet::Extract(const DataExtractor &data, uint32_t* offset_ptr)
     return false;
 }
 
+template bool DWARFDebugArangeSet::Extract (const DataExtractor &data, uint32_t* offset_ptr);
+template bool DWARFDebugArangeSet::Extract (const DataExtractor &data, uint64_t* offset_ptr);
+
 
 dw_offset_t
 DWARFDebugArangeSet::GetOffsetOfNextEntry() const
@@ -236,8 +241,8 @@ DWARFDebugArangeSet::GetOffsetOfNextEntry() const
 void
 DWARFDebugArangeSet::Dump(Stream *s) const
 {
-    s->Printf("Address Range Header: length = 0x%8.8x, version = 0x%4.4x, cu_offset = 0x%8.8x, addr_size = 0x%2.2x, seg_size = 0x%2.2x\n",
-        m_header.length ,m_header.version, m_header.cu_offset, m_header.addr_size, m_header.seg_size);
+    s->Printf("Address Range Header: length = 0x%8.8x, version = 0x%4.4x, cu_offset = 0x%8.8llx, addr_size = 0x%2.2x, seg_size = 0x%2.2x\n",
+        m_header.length ,m_header.version, (uint64_t)m_header.cu_offset, m_header.addr_size, m_header.seg_size);
 
     const uint32_t hex_width = m_header.addr_size * 2;
     DescriptorConstIter pos;
@@ -22,7 +22,7 @@ public:
     {
         uint32_t    length;     // The total length of the entries for that set, not including the length field itself.
         uint16_t    version;    // The DWARF version number
-        uint32_t    cu_offset;  // The offset from the beginning of the .debug_info section of the compilation unit entry referenced by the table.
+        dw_offset_t cu_offset;  // The offset from the beginning of the .debug_info section of the compilation unit entry referenced by the table.
         uint8_t     addr_size;  // The size in bytes of an address on the target architecture. For segmented addressing, this is the size of the offset portion of the address
         uint8_t     seg_size;   // The size in bytes of a segment descriptor on the target architecture. If the target system uses a flat address space, this value is 0.
     };
@@ -37,11 +37,12 @@ public:
 
                     DWARFDebugArangeSet();
         void        Clear();
-        void        SetOffset(uint32_t offset) { m_offset = offset; }
-        void        SetHeader(uint16_t version, uint32_t cu_offset, uint8_t addr_size, uint8_t seg_size);
+        void        SetOffset(dw_offset_t offset) { m_offset = offset; }
+        void        SetHeader(uint16_t version, dw_offset_t cu_offset, uint8_t addr_size, uint8_t seg_size);
         void        AddDescriptor(const DWARFDebugArangeSet::Descriptor& range);
         void        Compact();
-        bool        Extract(const lldb_private::DataExtractor &data, uint32_t* offset_ptr);
+        template <typename OffsetType>
+        bool        Extract(const lldb_private::DataExtractor &data, OffsetType* offset_ptr);
         void        Dump(lldb_private::Stream *s) const;
         dw_offset_t GetCompileUnitDIEOffset() const { return m_header.cu_offset; }
         dw_offset_t GetOffsetOfNextEntry() const;
@@ -68,7 +69,7 @@ protected:
     typedef DescriptorColl::const_iterator  DescriptorConstIter;
 
 
-    uint32_t        m_offset;
+    dw_offset_t     m_offset;
     Header          m_header;
     DescriptorColl  m_arange_descriptors;
 };
@@ -60,27 +60,43 @@ DWARFDebugAranges::Extract(const DataExtractor &debug_aranges_data)
 {
     if (debug_aranges_data.ValidOffset(0))
     {
-        uint32_t offset = 0;
+        if (DW_SECTION_NEEDS_64BIT_OFFSETS(debug_aranges_data.GetByteSize()))
+            ExtractSets<uint64_t>(debug_aranges_data);
+        else
+            ExtractSets<uint32_t>(debug_aranges_data);
+    }
+    return false;
+}
 
-        DWARFDebugArangeSet set;
-        Range range;
-        while (set.Extract(debug_aranges_data, &offset))
+//----------------------------------------------------------------------
+// ExtractSets
+//
+// Extract all address range sets using OffsetType for the offsets into
+// the .debug_aranges section.
+//----------------------------------------------------------------------
+template <typename OffsetType>
+void
+DWARFDebugAranges::ExtractSets(const DataExtractor &debug_aranges_data)
+{
+    OffsetType offset = 0;
+
+    DWARFDebugArangeSet set;
+    Range range;
+    while (set.Extract(debug_aranges_data, &offset))
+    {
+        const uint32_t num_descriptors = set.NumDescriptors();
+        if (num_descriptors > 0)
         {
-            const uint32_t num_descriptors = set.NumDescriptors();
-            if (num_descriptors > 0)
+            const dw_offset_t cu_offset = set.GetCompileUnitDIEOffset();
+            
+            for (uint32_t i=0; i<num_descriptors; ++i)
             {
-                const dw_offset_t cu_offset = set.GetCompileUnitDIEOffset();
-                
-                for (uint32_t i=0; i<num_descriptors; ++i)
-                {
-                    const DWARFDebugArangeSet::Descriptor &descriptor = set.GetDescriptorRef(i);
-                    m_aranges.Append(RangeToDIE::Entry (descriptor.address, descriptor.length, cu_offset));
-                }
+                const DWARFDebugArangeSet::Descriptor &descriptor = set.GetDescriptorRef(i);
+                m_aranges.Append(RangeToDIE::Entry (descriptor.address, descriptor.length, cu_offset));
             }
-            set.Clear();
         }
+        set.Clear();
     }
-    return false;
 }
 
 //----------------------------------------------------------------------
@@ -117,8 +133,8 @@ DWARFDebugAranges::Dump (Log *log) const
     for (size_t i=0; i<num_entries; ++i)
     {
         const RangeToDIE::Entry *entry = m_aranges.GetEntryAtIndex(i);
-        log->Printf ("0x%8.8x: [0x%llx - 0x%llx)", 
-                     entry->data,
+        log->Printf ("0x%8.8llx: [0x%llx - 0x%llx)", 
+                     (uint64_t)entry->data,
                      entry->GetRangeBase(),
                      entry->GetRangeEnd());
     }
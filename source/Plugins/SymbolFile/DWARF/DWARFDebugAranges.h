@@ -86,6 +86,9 @@ public:
     
 protected:
 
+    template <typename OffsetType>
+    void
+    ExtractSets(const lldb_private::DataExtractor &debug_aranges_data);
 
     RangeToDIE m_aranges;
 };
@@ -148,23 +148,33 @@ DWARFDebugInfo::ParseCompileUnitHeadersIfNeeded()
     {
         if (m_dwarf2Data != NULL)
         {
-            uint32_t offset = 0;
             const DataExtractor &debug_info_data = m_dwarf2Data->get_debug_info_data();
-            while (debug_info_data.ValidOffset(offset))
-            {
-                DWARFCompileUnitSP cu_sp(new DWARFCompileUnit(m_dwarf2Data));
-                // Out of memory?
-                if (cu_sp.get() == NULL)
-                    break;
+            if (DW_SECTION_NEEDS_64BIT_OFFSETS(debug_info_data.GetByteSize()))
+                ParseCompileUnitHeaders<uint64_t>(debug_info_data);
+            else
+                ParseCompileUnitHeaders<uint32_t>(debug_info_data);
+        }
+    }
+}
 
-                if (cu_sp->Extract(debug_info_data, &offset) == false)
-                    break;
+template <typename OffsetType>
+void
+DWARFDebugInfo::ParseCompileUnitHeaders(const DataExtractor &debug_info_data)
+{
+    OffsetType offset = 0;
+    while (debug_info_data.ValidOffset(offset))
+    {
+        DWARFCompileUnitSP cu_sp(new DWARFCompileUnit(m_dwarf2Data));
+        // Out of memory?
+        if (cu_sp.get() == NULL)
+            break;
 
-                m_compile_units.push_back(cu_sp);
+        if (cu_sp->Extract(debug_info_data, &offset) == false)
+            break;
 
-                offset = cu_sp->GetNextCompileUnitOffset();
-            }
-        }
+        m_compile_units.push_back(cu_sp);
+
+        offset = cu_sp->GetNextCompileUnitOffset();
     }
 }
 
@@ -378,7 +388,7 @@ DWARFDebugInfo::Parse(SymbolFileDWARF* dwarf2Data, Callback callback, void* user
 {
     if (dwarf2Data)
     {
-        uint32_t offset = 0;
+        dw_offset_t offset = 0;
         uint32_t depth = 0;
         DWARFCompileUnitSP cu(new DWARFCompileUnit(dwarf2Data));
         if (cu.get() == NULL)
@@ -438,7 +448,7 @@ DWARFDebugInfo::Parse(SymbolFileDWARF* dwarf2Data, Callback callback, void* user
 
 typedef struct DumpInfo
 {
-    DumpInfo(Stream* init_strm, uint32_t off, uint32_t depth) :
+    DumpInfo(Stream* init_strm, dw_offset_t off, uint32_t depth) :
         strm(init_strm),
         die_offset(off),
         recurse_depth(depth),
@@ -448,7 +458,7 @@ typedef struct DumpInfo
     {
     }
     Stream* strm;
-    const uint32_t die_offset;
+    const dw_offset_t die_offset;
     const uint32_t recurse_depth;
     uint32_t found_depth;
     bool found_die;
@@ -637,7 +647,7 @@ DWARFDebugInfo::Dump
 (
     Stream *s,
     SymbolFileDWARF* dwarf2Data,
-    const uint32_t die_offset,
+    const dw_offset_t die_offset,
     const uint32_t recurse_depth
 )
 {
@@ -649,7 +659,7 @@ DWARFDebugInfo::Dump
             s->PutCString(":\n");
         else
         {
-            s->Printf(" for DIE entry at .debug_info[0x%8.8x]", die_offset);
+            s->Printf(" for DIE entry at .debug_info[0x%8.8llx]", (uint64_t)die_offset);
             if (recurse_depth != UINT32_MAX)
                 s->Printf(" recursing %u levels deep.", recurse_depth);
             s->EOL();
@@ -671,7 +681,7 @@ DWARFDebugInfo::Dump
 // and/or modified after it has been parsed.
 //----------------------------------------------------------------------
 void
-DWARFDebugInfo::Dump (Stream *s, const uint32_t die_offset, const uint32_t recurse_depth)
+DWARFDebugInfo::Dump (Stream *s, const dw_offset_t die_offset, const uint32_t recurse_depth)
 {
     DumpInfo dumpInfo(s, die_offset, recurse_depth);
 
@@ -55,10 +55,10 @@ public:
 
     const DWARFDebugInfoEntry* GetDIEPtrContainingOffset(dw_offset_t die_offset, DWARFCompileUnitSP* cu_sp_ptr);
 
-    void Dump(lldb_private::Stream *s, const uint32_t die_offset, const uint32_t recurse_depth);
+    void Dump(lldb_private::Stream *s, const dw_offset_t die_offset, const uint32_t recurse_depth);
     static void Parse(SymbolFileDWARF* parser, Callback callback, void* userData);
     static void Verify(lldb_private::Stream *s, SymbolFileDWARF* dwarf2Data);
-    static void Dump(lldb_private::Stream *s, SymbolFileDWARF* dwarf2Data, const uint32_t die_offset, const uint32_t recurse_depth);
+    static void Dump(lldb_private::Stream *s, SymbolFileDWARF* dwarf2Data, const dw_offset_t die_offset, const uint32_t recurse_depth);
     bool Find(const char* name, bool ignore_case, std::vector<dw_offset_t>& die_offsets) const;
     bool Find(lldb_private::RegularExpression& re, std::vector<dw_offset_t>& die_offsets) const;
 
@@ -81,6 +81,8 @@ protected:
 private:
     // All parsing needs to be done partially any managed by this class as accessors are called.
     void ParseCompileUnitHeadersIfNeeded();
+    template <typename OffsetType>
+    void ParseCompileUnitHeaders(const lldb_private::DataExtractor &debug_info_data);
 
     DISALLOW_COPY_AND_ASSIGN (DWARFDebugInfo);
 };
@@ -111,13 +111,14 @@ DWARFDebugInfoEntry::Attributes::FormValueAsUnsignedAtIndex(SymbolFileDWARF* dwa
 
 
 
+template <typename OffsetType>
 bool
 DWARFDebugInfoEntry::FastExtract
 (
     const DataExtractor& debug_info_data,
     const DWARFCompileUnit* cu,
     const uint8_t *fixed_form_sizes,
-    uint32_t* offset_ptr
+    OffsetType* offset_ptr
 )
 {
     m_offset = *offset_ptr;
@@ -132,7 +133,7 @@ DWARFDebugInfoEntry::FastExtract
     
     if (m_abbr_idx)
     {
-        uint32_t offset = *offset_ptr;
+        OffsetType offset = *offset_ptr;
 
         const DWARFAbbreviationDeclaration *abbrevDecl = cu->GetAbbreviations()->GetAbbreviationDeclaration(m_abbr_idx);
         
@@ -243,19 +244,20 @@ DWARFDebugInfoEntry::FastExtract
 // .debug_info and .debug_abbrev data within the SymbolFileDWARF class
 // starting at the given offset
 //----------------------------------------------------------------------
+template <typename OffsetType>
 bool
 DWARFDebugInfoEntry::Extract
 (
     SymbolFileDWARF* dwarf2Data,
     const DWARFCompileUnit* cu,
-    uint32_t* offset_ptr
+    OffsetType* offset_ptr
 )
 {
     const DataExtractor& debug_info_data = dwarf2Data->get_debug_info_data();
 //    const DataExtractor& debug_str_data = dwarf2Data->get_debug_str_data();
-    const uint32_t cu_end_offset = cu->GetNextCompileUnitOffset();
+    const dw_offset_t cu_end_offset = cu->GetNextCompileUnitOffset();
     const uint8_t cu_addr_size = cu->GetAddressByteSize();
-    uint32_t offset = *offset_ptr;
+    OffsetType offset = *offset_ptr;
 //  if (offset >= cu_end_offset)
 //      Log::Error("DIE at offset 0x%8.8x is beyond the end of the current compile unit (0x%8.8x)", m_offset, cu_end_offset);
     if ((offset < cu_end_offset) && debug_info_data.ValidOffset(offset))
@@ -387,6 +389,14 @@ DWARFDebugInfoEntry::Extract
     return false;
 }
 
+//----------------------------------------------------------------------
+// Instantiate the DIE extractors for 32 and 64 bit .debug_info offsets.
+//----------------------------------------------------------------------
+template bool DWARFDebugInfoEntry::FastExtract (const DataExtractor& debug_info_data, const DWARFCompileUnit* cu, const uint8_t *fixed_form_sizes, uint32_t* offset_ptr);
+template bool DWARFDebugInfoEntry::FastExtract (const DataExtractor& debug_info_data, const DWARFCompileUnit* cu, const uint8_t *fixed_form_sizes, uint64_t* offset_ptr);
+template bool DWARFDebugInfoEntry::Extract (SymbolFileDWARF* dwarf2Data, const DWARFCompileUnit* cu, uint32_t* offset_ptr);
+template bool DWARFDebugInfoEntry::Extract (SymbolFileDWARF* dwarf2Data, const DWARFCompileUnit* cu, uint64_t* offset_ptr);
+
 //----------------------------------------------------------------------
 // DumpAncestry
 //
@@ -716,7 +726,7 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
     if (abbrevDecl)
     {
         const DataExtractor& debug_info_data = dwarf2Data->get_debug_info_data();
-        uint32_t offset = m_offset;
+        dw_offset_t offset = m_offset;
 
         if (!debug_info_data.ValidOffset(offset))
             return false;
@@ -809,7 +819,7 @@ DWARFDebugInfoEntry::GetDIENamesAndRanges
                     {
                         if (form_value.BlockData())
                         {
-                            uint32_t block_offset = form_value.BlockData() - debug_info_data.GetDataStart();
+                            dw_offset_t block_offset = form_value.BlockData() - debug_info_data.GetDataStart();
                             uint32_t block_length = form_value.Unsigned();
                             frame_base->SetOpcodeData(debug_info_data, block_offset, block_length);
                         }
@@ -897,13 +907,13 @@ DWARFDebugInfoEntry::Dump
 ) const
 {
     const DataExtractor& debug_info_data = dwarf2Data->get_debug_info_data();
-    uint32_t offset = m_offset;
+    dw_offset_t offset = m_offset;
 
     if (debug_info_data.ValidOffset(offset))
     {
         dw_uleb128_t abbrCode = debug_info_data.GetULEB128(&offset);
 
-        s.Printf("\n0x%8.8x: ", m_offset);
+        s.Printf("\n0x%8.8llx: ", (uint64_t)m_offset);
         s.Indent();
         if (abbrCode)
         {
@@ -966,9 +976,9 @@ DWARFDebugInfoEntry::DumpLocation
     if (obj_file)
         obj_file_name = obj_file->GetFileSpec().GetFilename().AsCString();
     const char *die_name = GetName (dwarf2Data, cu);
-    s.Printf ("0x%8.8x/0x%8.8x: %-30s (from %s in %s)", 
-              cu->GetOffset(),
-              GetOffset(),
+    s.Printf ("0x%8.8llx/0x%8.8llx: %-30s (from %s in %s)", 
+              (uint64_t)cu->GetOffset(),
+              (uint64_t)GetOffset(),
               die_name ? die_name : "", 
               cu_name ? cu_name : "<NULL>",
               obj_file_name ? obj_file_name : "<NULL>");
@@ -987,7 +997,7 @@ DWARFDebugInfoEntry::DumpAttribute
     SymbolFileDWARF* dwarf2Data,
     const DWARFCompileUnit* cu,
     const DataExtractor& debug_info_data,
-    uint32_t* offset_ptr,
+    dw_offset_t* offset_ptr,
     Stream &s,
     dw_attr_t attr,
     dw_form_t form
@@ -1153,7 +1163,7 @@ DWARFDebugInfoEntry::GetAttributes
     {
         if (fixed_form_sizes == NULL)
             fixed_form_sizes = DWARFFormValue::GetFixedFormSizesForAddressSize(cu->GetAddressByteSize());
-        uint32_t offset = GetOffset();
+        dw_offset_t offset = GetOffset();
         const DataExtractor& debug_info_data = dwarf2Data->get_debug_info_data();
 
         // Skip the abbreviation code so we are at the data for the attributes
@@ -1254,7 +1264,7 @@ DWARFDebugInfoEntry::GetAttributeValue
 
         if (attr_idx != DW_INVALID_INDEX)
         {
-            uint32_t offset = GetOffset();
+            dw_offset_t offset = GetOffset();
 
             const DataExtractor& debug_info_data = dwarf2Data->get_debug_info_data();
 
@@ -1508,12 +1518,12 @@ DWARFDebugInfoEntry::GetName
 (
     SymbolFileDWARF* dwarf2Data,
     const DWARFCompileUnit* cu,
-    const uint32_t die_offset,
+    const dw_offset_t die_offset,
     Stream &s
 )
 {
     DWARFDebugInfoEntry die;
-    uint32_t offset = die_offset;
+    dw_offset_t offset = die_offset;
     if (die.Extract(dwarf2Data, cu, &offset))
     {
         if (die.IsNULL())
@@ -1551,12 +1561,12 @@ DWARFDebugInfoEntry::AppendTypeName
 (
     SymbolFileDWARF* dwarf2Data,
     const DWARFCompileUnit* cu,
-    const uint32_t die_offset,
+    const dw_offset_t die_offset,
     Stream &s
 )
 {
     DWARFDebugInfoEntry die;
-    uint32_t offset = die_offset;
+    dw_offset_t offset = die_offset;
     if (die.Extract(dwarf2Data, cu, &offset))
     {
         if (die.IsNULL())
@@ -2089,11 +2099,11 @@ DWARFDebugInfoEntry::DumpDIECollection (Stream &strm, DWARFDebugInfoEntry::colle
         const DWARFDebugInfoEntry* p = die_ref.GetParent();
         const DWARFDebugInfoEntry* s = die_ref.GetSibling();
         const DWARFDebugInfoEntry* c = die_ref.GetFirstChild();
-        strm.Printf("%.8x: %.8x %.8x %.8x 0x%4.4x %s%s\n", 
-                    die_ref.GetOffset(),
-                    p ? p->GetOffset() : 0,
-                    s ? s->GetOffset() : 0,
-                    c ? c->GetOffset() : 0,
+        strm.Printf("%.8llx: %.8llx %.8llx %.8llx 0x%4.4x %s%s\n", 
+                    (uint64_t)die_ref.GetOffset(),
+                    (uint64_t)(p ? p->GetOffset() : 0),
+                    (uint64_t)(s ? s->GetOffset() : 0),
+                    (uint64_t)(c ? c->GetOffset() : 0),
                     die_ref.Tag(), 
                     DW_TAG_value_to_name(die_ref.Tag()),
                     die_ref.HasChildren() ? " *" : "");
@@ -93,16 +93,14 @@ public:
         CompareState() :
             die_offset_pairs()
         {
-            assert(sizeof(dw_offset_t)*2 == sizeof(uint64_t));
         }
 
         bool AddTypePair(dw_offset_t a, dw_offset_t b)
         {
-            uint64_t a_b_offsets = (uint64_t)a << 32 | (uint64_t)b;
             // Return true if this type was inserted, false otherwise
-            return die_offset_pairs.insert(a_b_offsets).second;
+            return die_offset_pairs.insert(std::make_pair(a, b)).second;
         }
-        std::set< uint64_t > die_offset_pairs;
+        std::set< std::pair<dw_offset_t, dw_offset_t> > die_offset_pairs;
     };
 
                 DWARFDebugInfoEntry():
@@ -139,16 +137,18 @@ public:
                     const DWARFCompileUnit* cu,
                     DWARFDebugAranges* debug_aranges) const;
 
+    template <typename OffsetType>
     bool        FastExtract(
                     const lldb_private::DataExtractor& debug_info_data,
                     const DWARFCompileUnit* cu,
                     const uint8_t *fixed_form_sizes,
-                    dw_offset_t* offset_ptr);
+                    OffsetType* offset_ptr);
 
+    template <typename OffsetType>
     bool        Extract(
                     SymbolFileDWARF* dwarf2Data,
                     const DWARFCompileUnit* cu,
-                    dw_offset_t* offset_ptr);
+                    OffsetType* offset_ptr);
 
     bool        LookupAddress(
                     const dw_addr_t address,
@@ -275,7 +275,7 @@ public:
                     SymbolFileDWARF* dwarf2Data,
                     const DWARFCompileUnit* cu,
                     const lldb_private::DataExtractor& debug_info_data,
-                    uint32_t* offset_ptr,
+                    dw_offset_t* offset_ptr,
                     lldb_private::Stream &s,
                     dw_attr_t attr,
                     dw_form_t form);
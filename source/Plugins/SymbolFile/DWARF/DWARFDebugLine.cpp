@@ -37,7 +37,7 @@ DWARFDebugLine::Parse(const DataExtractor& debug_line_data)
     LineTable::shared_ptr line_table_sp(new LineTable);
     while (debug_line_data.ValidOffset(offset))
     {
-        const uint32_t debug_line_offset = offset;
+        const dw_offset_t debug_line_offset = offset;
 
         if (line_table_sp.get() == NULL)
             break;
@@ -133,10 +133,10 @@ DWARFDebugLine::DumpStatementTable(Log *log, const DataExtractor& debug_line_dat
 {
     if (debug_line_data.ValidOffset(debug_line_offset))
     {
-        uint32_t offset = debug_line_offset;
+        dw_offset_t offset = debug_line_offset;
         log->Printf(  "----------------------------------------------------------------------\n"
-                    "debug_line[0x%8.8x]\n"
-                    "----------------------------------------------------------------------\n", debug_line_offset);
+                    "debug_line[0x%8.8llx]\n"
+                    "----------------------------------------------------------------------\n", (uint64_t)debug_line_offset);
 
         if (ParseStatementTable(debug_line_data, &offset, DumpStateToFile, log))
             return offset;
@@ -183,7 +183,7 @@ DWARFDebugLine::DumpOpcodes(Log *log, SymbolFileDWARF* dwarf2Data, dw_offset_t d
 dw_offset_t
 DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_data, const dw_offset_t debug_line_offset, uint32_t flags)
 {
-    uint32_t offset = debug_line_offset;
+    dw_offset_t offset = debug_line_offset;
     if (debug_line_data.ValidOffset(offset))
     {
         Prologue prologue;
@@ -191,14 +191,14 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
         if (ParsePrologue(debug_line_data, &offset, &prologue))
         {
             log->PutCString ("----------------------------------------------------------------------");
-            log->Printf     ("debug_line[0x%8.8x]", debug_line_offset);
+            log->Printf     ("debug_line[0x%8.8llx]", (uint64_t)debug_line_offset);
             log->PutCString ("----------------------------------------------------------------------\n");
             prologue.Dump (log);
         }
         else
         {
             offset = debug_line_offset;
-            log->Printf( "0x%8.8x: skipping pad byte %2.2x", offset, debug_line_data.GetU8(&offset));
+            log->Printf( "0x%8.8llx: skipping pad byte %2.2x", (uint64_t)offset, debug_line_data.GetU8(&offset));
             return offset;
         }
 
@@ -209,7 +209,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
 
         while (offset < end_offset)
         {
-            const uint32_t op_offset = offset;
+            const dw_offset_t op_offset = offset;
             uint8_t opcode = debug_line_data.GetU8(&offset);
             switch (opcode)
             {
@@ -226,7 +226,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
                     switch (sub_opcode)
                     {
                     case DW_LNE_end_sequence    :
-                        log->Printf( "0x%8.8x: DW_LNE_end_sequence", op_offset);
+                        log->Printf( "0x%8.8llx: DW_LNE_end_sequence", (uint64_t)op_offset);
                         row.Dump(log);
                         row.Reset(prologue.default_is_stmt);
                         break;
@@ -234,7 +234,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
                     case DW_LNE_set_address     :
                         {
                             row.address = debug_line_data.GetMaxU64(&offset, arg_size);
-                            log->Printf( "0x%8.8x: DW_LNE_set_address (0x%llx)", op_offset, row.address);
+                            log->Printf( "0x%8.8llx: DW_LNE_set_address (0x%llx)", (uint64_t)op_offset, row.address);
                         }
                         break;
 
@@ -245,8 +245,8 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
                             fileEntry.dir_idx   = debug_line_data.GetULEB128(&offset);
                             fileEntry.mod_time  = debug_line_data.GetULEB128(&offset);
                             fileEntry.length    = debug_line_data.GetULEB128(&offset);
-                            log->Printf( "0x%8.8x: DW_LNE_define_file('%s', dir=%i, mod_time=0x%8.8x, length=%i )",
-                                    op_offset,
+                            log->Printf( "0x%8.8llx: DW_LNE_define_file('%s', dir=%i, mod_time=0x%8.8x, length=%i )",
+                                    (uint64_t)op_offset,
                                     fileEntry.name.c_str(),
                                     fileEntry.dir_idx,
                                     fileEntry.mod_time,
@@ -256,7 +256,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
                         break;
 
                     default:
-                        log->Printf( "0x%8.8x: DW_LNE_??? (%2.2x) - Skipping unknown upcode", op_offset, opcode);
+                        log->Printf( "0x%8.8llx: DW_LNE_??? (%2.2x) - Skipping unknown upcode", (uint64_t)op_offset, opcode);
                         // Length doesn't include the zero opcode byte or the length itself, but
                         // it does include the sub_opcode, so we have to adjust for that below
                         offset += arg_size;
@@ -267,7 +267,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
 
             // Standard Opcodes
             case DW_LNS_copy:
-                log->Printf( "0x%8.8x: DW_LNS_copy", op_offset);
+                log->Printf( "0x%8.8llx: DW_LNS_copy", (uint64_t)op_offset);
                 row.Dump (log);
                 break;
 
@@ -275,7 +275,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
                 {
                     dw_uleb128_t addr_offset_n = debug_line_data.GetULEB128(&offset);
                     dw_uleb128_t addr_offset = addr_offset_n * prologue.min_inst_length;
-                    log->Printf( "0x%8.8x: DW_LNS_advance_pc (0x%x)", op_offset, addr_offset);
+                    log->Printf( "0x%8.8llx: DW_LNS_advance_pc (0x%x)", (uint64_t)op_offset, addr_offset);
                     row.address += addr_offset;
                 }
                 break;
@@ -283,36 +283,36 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
             case DW_LNS_advance_line:
                 {
                     dw_sleb128_t line_offset = debug_line_data.GetSLEB128(&offset);
-                    log->Printf( "0x%8.8x: DW_LNS_advance_line (%i)", op_offset, line_offset);
+                    log->Printf( "0x%8.8llx: DW_LNS_advance_line (%i)", (uint64_t)op_offset, line_offset);
                     row.line += line_offset;
                 }
                 break;
 
             case DW_LNS_set_file:
                 row.file = debug_line_data.GetULEB128(&offset);
-                log->Printf( "0x%8.8x: DW_LNS_set_file (%u)", op_offset, row.file);
+                log->Printf( "0x%8.8llx: DW_LNS_set_file (%u)", (uint64_t)op_offset, row.file);
                 break;
 
             case DW_LNS_set_column:
                 row.column = debug_line_data.GetULEB128(&offset);
-                log->Printf( "0x%8.8x: DW_LNS_set_column (%u)", op_offset, row.column);
+                log->Printf( "0x%8.8llx: DW_LNS_set_column (%u)", (uint64_t)op_offset, row.column);
                 break;
 
             case DW_LNS_negate_stmt:
                 row.is_stmt = !row.is_stmt;
-                log->Printf( "0x%8.8x: DW_LNS_negate_stmt", op_offset);
+                log->Printf( "0x%8.8llx: DW_LNS_negate_stmt", (uint64_t)op_offset);
                 break;
 
             case DW_LNS_set_basic_block:
                 row.basic_block = true;
-                log->Printf( "0x%8.8x: DW_LNS_set_basic_block", op_offset);
+                log->Printf( "0x%8.8llx: DW_LNS_set_basic_block", (uint64_t)op_offset);
                 break;
 
             case DW_LNS_const_add_pc:
                 {
                     uint8_t adjust_opcode = 255 - prologue.opcode_base;
                     dw_addr_t addr_offset = (adjust_opcode / prologue.line_range) * prologue.min_inst_length;
-                    log->Printf( "0x%8.8x: DW_LNS_const_add_pc (0x%8.8llx)", op_offset, addr_offset);
+                    log->Printf( "0x%8.8llx: DW_LNS_const_add_pc (0x%8.8llx)", (uint64_t)op_offset, addr_offset);
                     row.address += addr_offset;
                 }
                 break;
@@ -320,24 +320,24 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
             case DW_LNS_fixed_advance_pc:
                 {
                     uint16_t pc_offset = debug_line_data.GetU16(&offset);
-                    log->Printf( "0x%8.8x: DW_LNS_fixed_advance_pc (0x%4.4x)", op_offset, pc_offset);
+                    log->Printf( "0x%8.8llx: DW_LNS_fixed_advance_pc (0x%4.4x)", (uint64_t)op_offset, pc_offset);
                     row.address += pc_offset;
                 }
                 break;
 
             case DW_LNS_set_prologue_end:
                 row.prologue_end = true;
-                log->Printf( "0x%8.8x: DW_LNS_set_prologue_end", op_offset);
+                log->Printf( "0x%8.8llx: DW_LNS_set_prologue_end", (uint64_t)op_offset);
                 break;
 
             case DW_LNS_set_epilogue_begin:
                 row.epilogue_begin = true;
-                log->Printf( "0x%8.8x: DW_LNS_set_epilogue_begin", op_offset);
+                log->Printf( "0x%8.8llx: DW_LNS_set_epilogue_begin", (uint64_t)op_offset);
                 break;
 
             case DW_LNS_set_isa:
                 row.isa = debug_line_data.GetULEB128(&offset);
-                log->Printf( "0x%8.8x: DW_LNS_set_isa (%u)", op_offset, row.isa);
+                log->Printf( "0x%8.8llx: DW_LNS_set_isa (%u)", (uint64_t)op_offset, row.isa);
                 break;
 
             // Special Opcodes
@@ -348,7 +348,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
                     // the number of ULEB128 numbers that is says to skip in the
                     // prologue's standard_opcode_lengths array
                     uint8_t n = prologue.standard_opcode_lengths[opcode-1];
-                    log->Printf( "0x%8.8x: Special : Unknown skipping %u ULEB128 values.", op_offset, n);
+                    log->Printf( "0x%8.8llx: Special : Unknown skipping %u ULEB128 values.", (uint64_t)op_offset, n);
                     while (n > 0)
                     {
                         debug_line_data.GetULEB128(&offset);
@@ -360,7 +360,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
                     uint8_t adjust_opcode = opcode - prologue.opcode_base;
                     dw_addr_t addr_offset = (adjust_opcode / prologue.line_range) * prologue.min_inst_length;
                     int32_t line_offset = prologue.line_base + (adjust_opcode % prologue.line_range);
-                    log->Printf("0x%8.8x: address += 0x%llx,  line += %i\n", op_offset, (uint64_t)addr_offset, line_offset);
+                    log->Printf("0x%8.8llx: address += 0x%llx,  line += %i\n", (uint64_t)op_offset, (uint64_t)addr_offset, line_offset);
                     row.address += addr_offset;
                     row.line += line_offset;
                     row.Dump (log);
@@ -386,7 +386,7 @@ DWARFDebugLine::DumpStatementOpcodes(Log *log, const DataExtractor& debug_line_d
 void
 DWARFDebugLine::Parse(const DataExtractor& debug_line_data, DWARFDebugLine::State::Callback callback, void* userData)
 {
-    uint32_t offset = 0;
+    dw_offset_t offset = 0;
     if (debug_line_data.ValidOffset(offset))
     {
         if (!ParseStatementTable(debug_line_data, &offset, callback, userData))
@@ -401,7 +401,7 @@ DWARFDebugLine::Parse(const DataExtractor& debug_line_data, DWARFDebugLine::Stat
 bool
 DWARFDebugLine::ParsePrologue(const DataExtractor& debug_line_data, dw_offset_t* offset_ptr, Prologue* prologue)
 {
-    const uint32_t prologue_offset = *offset_ptr;
+    const dw_offset_t prologue_offset = *offset_ptr;
 
     //DEBUG_PRINTF("0x%8.8x: ParsePrologue()\n", *offset_ptr);
 
@@ -456,8 +456,8 @@ DWARFDebugLine::ParsePrologue(const DataExtractor& debug_line_data, dw_offset_t*
 
     if (*offset_ptr != end_prologue_offset)
     {
-        fprintf (stderr, "warning: parsing line table prologue at 0x%8.8x should have ended at 0x%8.8x but it ended ad 0x%8.8x\n", 
-                 prologue_offset, end_prologue_offset, *offset_ptr);
+        fprintf (stderr, "warning: parsing line table prologue at 0x%8.8llx should have ended at 0x%8.8llx but it ended ad 0x%8.8llx\n", 
+                 (uint64_t)prologue_offset, (uint64_t)end_prologue_offset, (uint64_t)*offset_ptr);
     }
     return end_prologue_offset;
 }
@@ -465,7 +465,7 @@ DWARFDebugLine::ParsePrologue(const DataExtractor& debug_line_data, dw_offset_t*
 bool
 DWARFDebugLine::ParseSupportFiles(const DataExtractor& debug_line_data, const char *cu_comp_dir, dw_offset_t stmt_list, FileSpecList &support_files)
 {
-    uint32_t offset = stmt_list + 4;    // Skip the total length
+    dw_offset_t offset = stmt_list + 4;    // Skip the total length
     const char * s;
     uint32_t version = debug_line_data.GetU16(&offset);
     if (version != 2)
@@ -539,8 +539,8 @@ DWARFDebugLine::ParseSupportFiles(const DataExtractor& debug_line_data, const ch
 
     if (offset != end_prologue_offset)
     {
-        fprintf (stderr, "warning: parsing line table prologue at 0x%8.8x should have ended at 0x%8.8x but it ended ad 0x%8.8x\n", 
-                 stmt_list, end_prologue_offset, offset);
+        fprintf (stderr, "warning: parsing line table prologue at 0x%8.8llx should have ended at 0x%8.8llx but it ended ad 0x%8.8llx\n", 
+                 (uint64_t)stmt_list, (uint64_t)end_prologue_offset, (uint64_t)offset);
     }
     return end_prologue_offset;
 }
@@ -568,8 +568,8 @@ DWARFDebugLine::ParseStatementTable
     const dw_offset_t debug_line_offset = *offset_ptr;
 
     Timer scoped_timer (__PRETTY_FUNCTION__,
-                        "DWARFDebugLine::ParseStatementTable (.debug_line[0x%8.8x])",
-                        debug_line_offset);
+                        "DWARFDebugLine::ParseStatementTable (.debug_line[0x%8.8llx])",
+                        (uint64_t)debug_line_offset);
 
     if (!ParsePrologue(debug_line_data, offset_ptr, prologue.get()))
     {
@@ -856,7 +856,7 @@ ParseStatementTableCallback(dw_offset_t offset, const DWARFDebugLine::State& sta
 // the prologue and all rows.
 //----------------------------------------------------------------------
 bool
-DWARFDebugLine::ParseStatementTable(const DataExtractor& debug_line_data, uint32_t* offset_ptr, LineTable* line_table)
+DWARFDebugLine::ParseStatementTable(const DataExtractor& debug_line_data, dw_offset_t* offset_ptr, LineTable* line_table)
 {
     return ParseStatementTable(debug_line_data, offset_ptr, ParseStatementTableCallback, line_table);
 }
@@ -40,19 +40,10 @@ DWARFDebugPubnames::Extract(const DataExtractor& data)
 
     if (data.ValidOffset(0))
     {
-        uint32_t offset = 0;
-
-        DWARFDebugPubnamesSet set;
-        while (data.ValidOffset(offset))
-        {
-            if (set.Extract(data, &offset))
-            {
-                m_sets.push_back(set);
-                offset = set.GetOffsetOfNextEntry();
-            }
-            else
-                break;
-        }
+        if (DW_SECTION_NEEDS_64BIT_OFFSETS(data.GetByteSize()))
+            ExtractSets<uint64_t>(data);
+        else
+            ExtractSets<uint32_t>(data);
         if (log)
             Dump (log.get());
         return true;
@@ -60,6 +51,29 @@ DWARFDebugPubnames::Extract(const DataExtractor& data)
     return false;
 }
 
+//----------------------------------------------------------------------
+// Extract all pubnames sets using OffsetType for the offsets into the
+// .debug_pubnames section.
+//----------------------------------------------------------------------
+template <typename OffsetType>
+void
+DWARFDebugPubnames::ExtractSets(const DataExtractor& data)
+{
+    OffsetType offset = 0;
+
+    DWARFDebugPubnamesSet set;
+    while (data.ValidOffset(offset))
+    {
+        if (set.Extract(data, &offset))
+        {
+            m_sets.push_back(set);
+            offset = set.GetOffsetOfNextEntry();
+        }
+        else
+            break;
+    }
+}
+
 
 bool
 DWARFDebugPubnames::GeneratePubnames(SymbolFileDWARF* dwarf2Data)
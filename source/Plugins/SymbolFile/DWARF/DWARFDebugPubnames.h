@@ -28,6 +28,9 @@ public:
     bool    Find(const char* name, bool ignore_case, std::vector<dw_offset_t>& die_offset_coll) const;
     bool    Find(const lldb_private::RegularExpression& regex, std::vector<dw_offset_t>& die_offsets) const;
 protected:
+    template <typename OffsetType>
+    void    ExtractSets(const lldb_private::DataExtractor& data);
+
     typedef std::list<DWARFDebugPubnamesSet>    collection;
     typedef collection::iterator                iterator;
     typedef collection::const_iterator          const_iterator;
@@ -42,7 +42,7 @@ DWARFDebugPubnamesSet::AddDescriptor(dw_offset_t cu_rel_offset, const char* name
     if (name && name[0])
     {
         // Adjust our header length
-        m_header.length += strlen(name) + 1 + sizeof(dw_offset_t);
+        m_header.length += strlen(name) + 1 + sizeof(uint32_t);
         Descriptor pubnameDesc(cu_rel_offset, name);
         m_descriptors.push_back(pubnameDesc);
     }
@@ -77,13 +77,15 @@ DWARFDebugPubnamesSet::InitNameIndexes() const
 }
 
 
+template <typename OffsetType>
 bool
-DWARFDebugPubnamesSet::Extract(const DataExtractor& data, uint32_t* offset_ptr)
+DWARFDebugPubnamesSet::Extract(const DataExtractor& data, OffsetType* offset_ptr)
 {
     if (data.ValidOffset(*offset_ptr))
     {
         m_descriptors.clear();
-        m_offset = *offset_ptr;
+        const OffsetType set_offset = *offset_ptr;
+        m_offset = set_offset;
         m_header.length     = data.GetU32(offset_ptr);
         m_header.version    = data.GetU16(offset_ptr);
         m_header.die_offset = data.GetU32(offset_ptr);
@@ -112,6 +114,9 @@ DWARFDebugPubnamesSet::Extract(const DataExtractor& data, uint32_t* offset_ptr)
     return false;
 }
 
+template bool DWARFDebugPubnamesSet::Extract (const DataExtractor& data, uint32_t* offset_ptr);
+template bool DWARFDebugPubnamesSet::Extract (const DataExtractor& data, uint64_t* offset_ptr);
+
 dw_offset_t
 DWARFDebugPubnamesSet::GetOffsetOfNextEntry() const
 {
@@ -121,10 +126,10 @@ DWARFDebugPubnamesSet::GetOffsetOfNextEntry() const
 void
 DWARFDebugPubnamesSet::Dump(Log *log) const
 {
-    log->Printf("Pubnames Header: length = 0x%8.8x, version = 0x%4.4x, die_offset = 0x%8.8x, die_length = 0x%8.8x",
+    log->Printf("Pubnames Header: length = 0x%8.8x, version = 0x%4.4x, die_offset = 0x%8.8llx, die_length = 0x%8.8x",
         m_header.length,
         m_header.version,
-        m_header.die_offset,
+        (uint64_t)m_header.die_offset,
         m_header.die_length);
 
     bool verbose = log->GetVerbose();
@@ -134,9 +139,9 @@ DWARFDebugPubnamesSet::Dump(Log *log) const
     for (pos = m_descriptors.begin(); pos != end; ++pos)
     {
         if (verbose)
-            log->Printf("0x%8.8x + 0x%8.8x = 0x%8.8x: %s", pos->offset, m_header.die_offset, pos->offset + m_header.die_offset, pos->name.c_str());
+            log->Printf("0x%8.8llx + 0x%8.8llx = 0x%8.8llx: %s", (uint64_t)pos->offset, (uint64_t)m_header.die_offset, (uint64_t)(pos->offset + m_header.die_offset), pos->name.c_str());
         else
-            log->Printf("0x%8.8x: %s", pos->offset + m_header.die_offset, pos->name.c_str());
+            log->Printf("0x%8.8llx: %s", (uint64_t)(pos->offset + m_header.die_offset), pos->name.c_str());
     }
 }
 
@@ -22,7 +22,7 @@ public:
     {
         uint32_t    length;     // length of the set of entries for this compilation unit, not including the length field itself
         uint16_t    version;    // The DWARF version number
-        uint32_t    die_offset; // compile unit .debug_info offset
+        dw_offset_t die_offset; // compile unit .debug_info offset
         uint32_t    die_length; // compile unit .debug_info length
         Header() :
             length(10),
@@ -66,7 +66,8 @@ public:
     uint32_t    NumDescriptors() const { return m_descriptors.size(); }
     void        AddDescriptor(dw_offset_t cu_rel_offset, const char* name);
     void        Clear();
-    bool        Extract(const lldb_private::DataExtractor& debug_pubnames_data, uint32_t* offset_ptr);
+    template <typename OffsetType>
+    bool        Extract(const lldb_private::DataExtractor& debug_pubnames_data, OffsetType* offset_ptr);
     void        Dump(lldb_private::Log *s) const;
     void        InitNameIndexes() const;
     void        Find(const char* name, bool ignore_case, std::vector<dw_offset_t>& die_offset_coll) const;
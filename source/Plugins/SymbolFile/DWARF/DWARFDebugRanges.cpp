@@ -82,11 +82,11 @@ DWARFDebugRanges::Extract(SymbolFileDWARF* dwarf2Data)
 //}
 
 bool
-DWARFDebugRanges::Extract(SymbolFileDWARF* dwarf2Data, uint32_t* offset_ptr, RangeList &range_list)
+DWARFDebugRanges::Extract(SymbolFileDWARF* dwarf2Data, dw_offset_t* offset_ptr, RangeList &range_list)
 {
     range_list.Clear();
 
-    uint32_t range_offset = *offset_ptr;
+    dw_offset_t range_offset = *offset_ptr;
     const DataExtractor& debug_ranges_data = dwarf2Data->get_debug_ranges_data();
     uint32_t addr_size = debug_ranges_data.GetAddressByteSize();
 
@@ -33,7 +33,7 @@ protected:
 
     bool
     Extract (SymbolFileDWARF* dwarf2Data, 
-             uint32_t* offset_ptr, 
+             dw_offset_t* offset_ptr, 
              RangeList &range_list);
 
     typedef std::map<dw_offset_t, RangeList>    range_map;
@@ -92,8 +92,9 @@ DWARFFormValue::DWARFFormValue(dw_form_t form) :
 {
 }
 
+template <typename OffsetType>
 bool
-DWARFFormValue::ExtractValue(const DataExtractor& data, uint32_t* offset_ptr, const DWARFCompileUnit* cu)
+DWARFFormValue::ExtractValue(const DataExtractor& data, OffsetType* offset_ptr, const DWARFCompileUnit* cu)
 {
     bool indirect = false;
     bool is_block = false;
@@ -152,14 +153,16 @@ DWARFFormValue::ExtractValue(const DataExtractor& data, uint32_t* offset_ptr, co
     return true;
 }
 
+template <typename OffsetType>
 bool
-DWARFFormValue::SkipValue(const DataExtractor& debug_info_data, uint32_t* offset_ptr, const DWARFCompileUnit* cu) const
+DWARFFormValue::SkipValue(const DataExtractor& debug_info_data, OffsetType* offset_ptr, const DWARFCompileUnit* cu) const
 {
     return DWARFFormValue::SkipValue(m_form, debug_info_data, offset_ptr, cu);
 }
 
+template <typename OffsetType>
 bool
-DWARFFormValue::SkipValue(dw_form_t form, const DataExtractor& debug_info_data, uint32_t* offset_ptr, const DWARFCompileUnit* cu)
+DWARFFormValue::SkipValue(dw_form_t form, const DataExtractor& debug_info_data, OffsetType* offset_ptr, const DWARFCompileUnit* cu)
 {
     bool indirect = false;
     do
@@ -230,6 +233,19 @@ DWARFFormValue::SkipValue(dw_form_t form, const DataExtractor& debug_info_data,
     return true;
 }
 
+//----------------------------------------------------------------------
+// Instantiate the value extractors for 32 and 64 bit section offsets.
+//----------------------------------------------------------------------
+#define INSTANTIATE_FORM_VALUE_EXTRACTORS(OffsetType) \
+    template bool DWARFFormValue::ExtractValue (const DataExtractor& data, OffsetType* offset_ptr, const DWARFCompileUnit* cu); \
+    template bool DWARFFormValue::SkipValue (const DataExtractor& debug_info_data, OffsetType* offset_ptr, const DWARFCompileUnit* cu) const; \
+    template bool DWARFFormValue::SkipValue (dw_form_t form, const DataExtractor& debug_info_data, OffsetType* offset_ptr, const DWARFCompileUnit* cu);
+
+INSTANTIATE_FORM_VALUE_EXTRACTORS(uint32_t)
+INSTANTIATE_FORM_VALUE_EXTRACTORS(uint64_t)
+
+#undef INSTANTIATE_FORM_VALUE_EXTRACTORS
+
 //bool
 //DWARFFormValue::PutUnsigned(dw_form_t form, dw_offset_t offset, uint64_t value, BinaryStreamBuf& out_buff, const DWARFCompileUnit* cu, bool fixup_cu_relative_refs)
 //{
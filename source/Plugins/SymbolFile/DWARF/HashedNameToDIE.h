@@ -57,7 +57,7 @@ struct DWARFMappedHash
     };
     
     typedef std::vector<DIEInfo> DIEInfoArray;
-    typedef std::vector<uint32_t> DIEArray;
+    typedef std::vector<dw_offset_t> DIEArray;
     
     static void
     ExtractDIEArray (const DIEInfoArray &die_info_array,
@@ -353,7 +353,7 @@ struct DWARFMappedHash
                 switch (header_data.atoms[i].type)
                 {
                     case eAtomTypeDIEOffset:    // DIE offset, check form for encoding
-                        strm.Printf ("{0x%8.8x}", hash_data.offset);
+                        strm.Printf ("{0x%8.8llx}", (uint64_t)hash_data.offset);
                         break;
 
                     case eAtomTypeTag:          // DW_TAG value for the DIE
@@ -607,8 +607,8 @@ struct DWARFMappedHash
         }
         
         size_t
-        AppendAllDIEsInRange (const uint32_t die_offset_start, 
-                              const uint32_t die_offset_end, 
+        AppendAllDIEsInRange (const dw_offset_t die_offset_start, 
+                              const dw_offset_t die_offset_end, 
                               DIEInfoArray &die_info_array) const
         {
             const uint32_t hash_count = m_header.hashes_count;
@@ -30,7 +30,7 @@ NameToDIE::Finalize()
 }
 
 void
-NameToDIE::Insert (const ConstString& name, uint32_t die_offset)
+NameToDIE::Insert (const ConstString& name, dw_offset_t die_offset)
 {
     m_map.Append(name.GetCString(), die_offset);
 }
@@ -48,15 +48,15 @@ NameToDIE::Find (const RegularExpression& regex, DIEArray &info_array) const
 }
 
 size_t
-NameToDIE::FindAllEntriesForCompileUnit (uint32_t cu_offset, 
-                                         uint32_t cu_end_offset, 
+NameToDIE::FindAllEntriesForCompileUnit (dw_offset_t cu_offset, 
+                                         dw_offset_t cu_end_offset, 
                                          DIEArray &info_array) const
 {
     const size_t initial_size = info_array.size();
     const uint32_t size = m_map.GetSize();
     for (uint32_t i=0; i<size; ++i)
     {
-        const uint32_t die_offset = m_map.GetValueAtIndexUnchecked(i);
+        const dw_offset_t die_offset = m_map.GetValueAtIndexUnchecked(i);
         if (cu_offset < die_offset && die_offset < cu_end_offset)
             info_array.push_back (die_offset);
     }
@@ -70,6 +70,6 @@ NameToDIE::Dump (Stream *s)
     for (uint32_t i=0; i<size; ++i)
     {
         const char *cstr = m_map.GetCStringAtIndex(i);
-        s->Printf("%p: {0x%8.8x} \"%s\"\n", cstr, m_map.GetValueAtIndexUnchecked(i), cstr);
+        s->Printf("%p: {0x%8.8llx} \"%s\"\n", cstr, (uint64_t)m_map.GetValueAtIndexUnchecked(i), cstr);
     }
 }
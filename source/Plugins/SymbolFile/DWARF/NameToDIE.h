@@ -10,12 +10,13 @@
 #ifndef SymbolFileDWARF_NameToDIE_h_
 #define SymbolFileDWARF_NameToDIE_h_
 
+#include "lldb/Core/dwarf.h"
 #include "lldb/Core/UniqueCStringMap.h"
 #include "lldb/lldb-defines.h"
 
 class SymbolFileDWARF;
 
-typedef std::vector<uint32_t> DIEArray;
+typedef std::vector<dw_offset_t> DIEArray;
 
 class NameToDIE
 {
@@ -33,7 +34,7 @@ public:
     Dump (lldb_private::Stream *s);
 
     void
-    Insert (const lldb_private::ConstString& name, uint32_t die_offset);
+    Insert (const lldb_private::ConstString& name, dw_offset_t die_offset);
 
     void
     Finalize();
@@ -47,12 +48,12 @@ public:
           DIEArray &info_array) const;
 
     size_t
-    FindAllEntriesForCompileUnit (uint32_t cu_offset, 
-                                  uint32_t cu_end_offset, 
+    FindAllEntriesForCompileUnit (dw_offset_t cu_offset, 
+                                  dw_offset_t cu_end_offset, 
                                   DIEArray &info_array) const;
 
 protected:
-    lldb_private::UniqueCStringMap<uint32_t> m_map;
+    lldb_private::UniqueCStringMap<dw_offset_t> m_map;
 
 };
 
@@ -13,6 +13,7 @@
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/Decl.h"
+#include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclGroup.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/Basic/Builtins.h"
@@ -242,6 +243,7 @@ SymbolFileDWARF::GetClangASTContext ()
             new ClangExternalASTSourceCallbacks (SymbolFileDWARF::CompleteTagDecl,
                                                  SymbolFileDWARF::CompleteObjCInterfaceDecl,
                                                  SymbolFileDWARF::FindExternalVisibleDeclsByName,
+                                                 SymbolFileDWARF::FindExternalLexicalDecls,
                                                  this));
 
         ast.SetExternalSource (ast_source_ap);
@@ -446,6 +448,13 @@ SymbolFileDWARF::GetCachedSectionData (uint32_t got_flag, SectionType sect_type,
                 {
                     data.SetData(m_dwarf_data, section->GetOffset (), section->GetByteSize());
                 }
+                else if (DW_SECTION_NEEDS_64BIT_OFFSETS(section->GetByteSize()))
+                {
+                    // Don't copy sections larger than 4GB onto the heap,
+                    // only the parts that get parsed need to be paged in.
+                    if (section->MemoryMapSectionDataFromObjectFile(m_obj_file, data) == 0)
+                        data.Clear();
+                }
                 else
                 {
                     if (section->ReadSectionDataFromObjectFile(m_obj_file, data) == 0)
@@ -582,7 +591,7 @@ SymbolFileDWARF::GetDWARFCompileUnitForUID(lldb::user_id_t cu_uid)
 {
     DWARFDebugInfo* info = DebugInfo();
     if (info && UserIDMatches(cu_uid))
-        return info->GetCompileUnit((dw_offset_t)cu_uid).get();
+        return info->GetCompileUnit(GetDIEOffsetForUserID(cu_uid)).get();
     return NULL;
 }
 
@@ -1031,7 +1040,7 @@ SymbolFileDWARF::ParseCompileUnitLineTable (const SymbolContext &sc)
                         SectionSP(), 
                         SectionSP()
                     };
-                    uint32_t offset = cu_line_offset;
+                    dw_offset_t offset = cu_line_offset;
                     DWARFDebugLine::ParseStatementTable(get_debug_line_data(), &offset, ParseDWARFLineTableCallback, &info);
                     sc.comp_unit->SetLineTable(line_table_ap.release());
                     return true;
@@ -1528,14 +1537,18 @@ SymbolFileDWARF::ParseChildMembers
                                     Value memberOffset(0);
                                     const DataExtractor& debug_info_data = get_debug_info_data();
                                     uint32_t block_length = form_value.Unsigned();
-                                    uint32_t block_offset = form_value.BlockData() - debug_info_data.GetDataStart();
+                                    // The block may lie past 4GB, so hand the expression a
+                                    // data extractor that starts at the block
+                                    const DataExtractor block_data (debug_info_data,
+                                                                    form_value.BlockData() - debug_info_data.GetDataStart(),
+                                                                    block_length);
                                     if (DWARFExpression::Evaluate (NULL, 
                                                                    NULL, 
                                                                    NULL, 
                                                                    NULL, 
                                                                    NULL,
-                                                                   debug_info_data, 
-                                                                   block_offset, 
+                                                                   block_data, 
+                                                                   0, 
                                                                    block_length, 
                                                                    eRegisterKindDWARF, 
                                                                    &initialValue, 
@@ -1594,7 +1607,7 @@ SymbolFileDWARF::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
     if (debug_info && UserIDMatches(type_uid))
     {
         DWARFCompileUnitSP cu_sp;
-        const DWARFDebugInfoEntry* die = debug_info->GetDIEPtr(type_uid, &cu_sp);
+        const DWARFDebugInfoEntry* die = debug_info->GetDIEPtr(GetDIEOffsetForUserID(type_uid), &cu_sp);
         if (die)
             return GetClangDeclContextContainingDIE (cu_sp.get(), die, NULL);
     }
@@ -1605,7 +1618,7 @@ clang::DeclContext*
 SymbolFileDWARF::GetClangDeclContextForTypeUID (const lldb_private::SymbolContext &sc, lldb::user_id_t type_uid)
 {
     if (UserIDMatches(type_uid))
-        return GetClangDeclContextForDIEOffset (sc, type_uid);
+        return GetClangDeclContextForDIEOffset (sc, GetDIEOffsetForUserID(type_uid));
     return NULL;
 }
 
@@ -1618,7 +1631,7 @@ SymbolFileDWARF::ResolveTypeUID (lldb::user_id_t type_uid)
         if (debug_info)
         {
             DWARFCompileUnitSP cu_sp;
-            const DWARFDebugInfoEntry* type_die = debug_info->GetDIEPtr(type_uid, &cu_sp);
+            const DWARFDebugInfoEntry* type_die = debug_info->GetDIEPtr(GetDIEOffsetForUserID(type_uid), &cu_sp);
             const bool assert_not_being_parsed = true;
             return ResolveTypeUID (cu_sp.get(), type_die, assert_not_being_parsed);
         }
@@ -1633,8 +1646,8 @@ SymbolFileDWARF::ResolveTypeUID (DWARFCompileUnit* cu, const DWARFDebugInfoEntry
     {
         LogSP log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
         if (log)
-            LogMessage (log.get(), "SymbolFileDWARF::ResolveTypeUID (die = 0x%8.8x) %s '%s'", 
-                        die->GetOffset(), 
+            LogMessage (log.get(), "SymbolFileDWARF::ResolveTypeUID (die = 0x%8.8llx) %s '%s'", 
+                        (uint64_t)die->GetOffset(), 
                         DW_TAG_value_to_name(die->Tag()), 
                         die->GetName(this, cu));
 
@@ -1650,21 +1663,21 @@ SymbolFileDWARF::ResolveTypeUID (DWARFCompileUnit* cu, const DWARFDebugInfoEntry
             {
                 // Get the type, which could be a forward declaration
                 if (log)
-                    LogMessage (log.get(), "SymbolFileDWARF::ResolveTypeUID (die = 0x%8.8x) %s '%s' resolve parent forward type for 0x%8.8x", 
-                                die->GetOffset(), 
+                    LogMessage (log.get(), "SymbolFileDWARF::ResolveTypeUID (die = 0x%8.8llx) %s '%s' resolve parent forward type for 0x%8.8llx", 
+                                (uint64_t)die->GetOffset(), 
                                 DW_TAG_value_to_name(die->Tag()), 
                                 die->GetName(this, cu), 
-                                decl_ctx_die->GetOffset());
+                                (uint64_t)decl_ctx_die->GetOffset());
 
                 Type *parent_type = ResolveTypeUID (cu, decl_ctx_die, assert_not_being_parsed);
                 if (DW_TAG_is_function_tag(die->Tag()))
                 {
                     if (log)
-                        LogMessage (log.get(), "SymbolFileDWARF::ResolveTypeUID (die = 0x%8.8x) %s '%s' resolve parent full type for 0x%8.8x since die is a function", 
-                                    die->GetOffset(), 
+                        LogMessage (log.get(), "SymbolFileDWARF::ResolveTypeUID (die = 0x%8.8llx) %s '%s' resolve parent full type for 0x%8.8llx since die is a function", 
+                                    (uint64_t)die->GetOffset(), 
                                     DW_TAG_value_to_name(die->Tag()), 
                                     die->GetName(this, cu), 
-                                    decl_ctx_die->GetOffset());
+                                    (uint64_t)decl_ctx_die->GetOffset());
                     // Ask the type to complete itself if it already hasn't since if we
                     // want a function (method or static) from a class, the class must 
                     // create itself and add it's own methods and class functions.
@@ -1710,6 +1723,7 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t clang_type
     // The type will get resolved when all of the calls to SymbolFileDWARF::ResolveClangOpaqueTypeDefinition
     // are done.
     m_forward_decl_clang_type_to_die.erase (clang_type_no_qualifiers);
+    ++m_num_types_completed;
     
 
     // Disable external storage for this type so we don't get anymore 
@@ -1785,12 +1799,46 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t clang_type
                                is_a_class);
 
             // Now parse any methods if there were any...
-            size_t num_functions = member_function_dies.Size();                
+            size_t num_functions = member_function_dies.Size();
             if (num_functions > 0)
             {
+                // C++ methods that clang needs in order to lay out the class
+                // or to decide whether it is trivial or POD are added now,
+                // along with any overloads of theirs so that a lookup of the
+                // name finds all of them. The other methods are added when
+                // clang looks up their name in the class or walks all of its
+                // declarations, see ResolveDeferredMethods().
+                clang::CXXRecordDecl *cxx_record_decl = NULL;
+                if (class_language != eLanguageTypeObjC)
+                    cxx_record_decl = clang::QualType::getFromOpaquePtr(clang_type)->getAsCXXRecordDecl();
+
+                llvm::SmallPtrSet<const char *, 8> needed_method_names;
+                if (cxx_record_decl)
+                {
+                    const char *class_name = die->GetName(this, curr_cu);
+                    for (size_t i=0; i<num_functions; ++i)
+                    {
+                        const DWARFDebugInfoEntry *method_die = member_function_dies.GetDIEPtrAtIndex(i);
+                        const char *method_name = method_die->GetName(this, curr_cu);
+                        if (method_name && MethodIsNeededForClassLayout(curr_cu, method_die, class_name))
+                            needed_method_names.insert (ConstString(method_name).GetCString());
+                    }
+                }
+
                 for (size_t i=0; i<num_functions; ++i)
                 {
-                    ResolveType(curr_cu, member_function_dies.GetDIEPtrAtIndex(i));
+                    const DWARFDebugInfoEntry *method_die = member_function_dies.GetDIEPtrAtIndex(i);
+                    if (cxx_record_decl)
+                    {
+                        const char *method_name = method_die->GetName(this, curr_cu);
+                        if (method_name && !needed_method_names.count (ConstString(method_name).GetCString()))
+                        {
+                            m_decl_ctx_to_deferred_method_dies[cxx_record_decl].insert(method_die);
+                            m_deferred_method_die_to_decl_ctx[method_die] = cxx_record_decl;
+                            continue;
+                        }
+                    }
+                    ResolveType(curr_cu, method_die);
                 }
             }
             
@@ -1832,8 +1880,8 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t clang_type
                             {
                                 if (m_using_apple_tables)
                                 {
-                                    ReportError (".apple_objc accelerator table had bad die 0x%8.8x for '%s'\n",
-                                                 die_offset, class_str.c_str());
+                                    ReportError (".apple_objc accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                                 (uint64_t)die_offset, class_str.c_str());
                                 }
                             }            
                         }
@@ -1883,6 +1931,11 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t clang_type
             
         }
         ast.CompleteTagDeclarationDefinition (clang_type);
+
+        // Keep getting clang::ExternalASTSource queries for a class that
+        // still has methods to add.
+        if (m_decl_ctx_to_deferred_method_dies.count (ClangASTContext::GetDeclContextForType (clang_type)))
+            ClangASTContext::SetHasExternalStorage (clang_type, true);
         return clang_type;
 
     case DW_TAG_enumeration_type:
@@ -2403,8 +2456,8 @@ SymbolFileDWARF::FindGlobalVariables (const ConstString &name, const lldb_privat
             {
                 if (m_using_apple_tables)
                 {
-                    ReportError (".apple_names accelerator table had bad die 0x%8.8x for '%s'\n",
-                                 die_offset, name.GetCString());
+                    ReportError (".apple_names accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                 (uint64_t)die_offset, name.GetCString());
                 }
             }
         }
@@ -2488,8 +2541,8 @@ SymbolFileDWARF::FindGlobalVariables(const RegularExpression& regex, bool append
             {
                 if (m_using_apple_tables)
                 {
-                    ReportError (".apple_names accelerator table had bad die 0x%8.8x for regex '%s'\n",
-                                 die_offset, regex.GetText());
+                    ReportError (".apple_names accelerator table had bad die 0x%8.8llx for regex '%s'\n",
+                                 (uint64_t)die_offset, regex.GetText());
                 }
             }            
         }
@@ -2798,8 +2851,8 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
                     }
                     else
                     {
-                        ReportError (".apple_names accelerator table had bad die 0x%8.8x for '%s'\n",
-                                     die_offset, name_cstr);
+                        ReportError (".apple_names accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                     (uint64_t)die_offset, name_cstr);
                     }                                    
                 }
             }
@@ -2826,8 +2879,8 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
                         }
                         else
                         {
-                            ReportError (".apple_names accelerator table had bad die 0x%8.8x for '%s'\n",
-                                         die_offset, name_cstr);
+                            ReportError (".apple_names accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                         (uint64_t)die_offset, name_cstr);
                         }                                    
                     }
                     die_offsets.clear();
@@ -2870,8 +2923,8 @@ SymbolFileDWARF::FindFunctions (const ConstString &name,
                         }
                         else
                         {
-                            ReportError (".apple_names accelerator table had bad die 0x%8.8x for '%s'\n",
-                                         die_offset, name_cstr);
+                            ReportError (".apple_names accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                         (uint64_t)die_offset, name_cstr);
                         }                                    
                     }
                     die_offsets.clear();
@@ -3084,8 +3137,8 @@ SymbolFileDWARF::FindTypes (const SymbolContext& sc,
             {
                 if (m_using_apple_tables)
                 {
-                    ReportError (".apple_types accelerator table had bad die 0x%8.8x for '%s'\n",
-                                 die_offset, name.GetCString());
+                    ReportError (".apple_types accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                 (uint64_t)die_offset, name.GetCString());
                 }
             }            
 
@@ -3165,8 +3218,8 @@ SymbolFileDWARF::FindNamespace (const SymbolContext& sc,
                 {
                     if (m_using_apple_tables)
                     {
-                        ReportError (".apple_namespaces accelerator table had bad die 0x%8.8x for '%s'\n",
-                                     die_offset, name.GetCString());
+                        ReportError (".apple_namespaces accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                     (uint64_t)die_offset, name.GetCString());
                     }
                 }            
 
@@ -3703,7 +3756,7 @@ SymbolFileDWARF::GetClangDeclContextForDIE (const SymbolContext &sc, DWARFCompil
     
     LogSP log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
     if (log)
-        LogMessage(log.get(), "SymbolFileDWARF::GetClangDeclContextForDIE (die = 0x%8.8x) %s '%s'", die->GetOffset(), DW_TAG_value_to_name(die->Tag()), die->GetName(this, cu));
+        LogMessage(log.get(), "SymbolFileDWARF::GetClangDeclContextForDIE (die = 0x%8.8llx) %s '%s'", (uint64_t)die->GetOffset(), DW_TAG_value_to_name(die->Tag()), die->GetName(this, cu));
     // This is the DIE we want.  Parse it, then query our map.
     bool assert_not_being_parsed = true;
     ResolveTypeUID (cu, die, assert_not_being_parsed);    
@@ -3950,8 +4003,8 @@ SymbolFileDWARF::FindCompleteObjCDefinitionTypeForDIE (DWARFCompileUnit* cu,
             {
                 if (m_using_apple_tables)
                 {
-                    ReportError (".apple_types accelerator table had bad die 0x%8.8x for '%s'\n",
-                                 die_offset, type_name.GetCString());
+                    ReportError (".apple_types accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                 (uint64_t)die_offset, type_name.GetCString());
                 }
             }            
             
@@ -4075,8 +4128,8 @@ SymbolFileDWARF::FindDefinitionTypeForDIE (DWARFCompileUnit* cu,
             {
                 if (m_using_apple_tables)
                 {
-                    ReportError (".apple_types accelerator table had bad die 0x%8.8x for '%s'\n",
-                                 die_offset, type_name.GetCString());
+                    ReportError (".apple_types accelerator table had bad die 0x%8.8llx for '%s'\n",
+                                 (uint64_t)die_offset, type_name.GetCString());
                 }
             }            
 
@@ -4098,8 +4151,8 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
     {
         LogSP log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
         if (log)
-            LogMessage (log.get(), "SymbolFileDWARF::ParseType (die = 0x%8.8x) %s '%s'", 
-                        die->GetOffset(), 
+            LogMessage (log.get(), "SymbolFileDWARF::ParseType (die = 0x%8.8llx) %s '%s'", 
+                        (uint64_t)die->GetOffset(), 
                         DW_TAG_value_to_name(die->Tag()), 
                         die->GetName(this, dwarf_cu));
 //
@@ -4119,6 +4172,7 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
             ClangASTContext &ast = GetClangASTContext();
             if (type_is_new_ptr)
                 *type_is_new_ptr = true;
+            ++m_num_types_parsed;
 
             const dw_tag_t tag = die->Tag();
 
@@ -4192,7 +4246,7 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                         }
                     }
 
-                    DEBUG_PRINTF ("0x%8.8llx: %s (\"%s\") type => 0x%8.8x\n", MakeUserID(die->GetOffset()), DW_TAG_value_to_name(tag), type_name_cstr, encoding_uid);
+                    DEBUG_PRINTF ("0x%8.8llx: %s (\"%s\") type => 0x%8.8llx\n", MakeUserID(die->GetOffset()), DW_TAG_value_to_name(tag), type_name_cstr, encoding_uid);
 
                     switch (tag)
                     {
@@ -4433,9 +4487,9 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                 if (log)
                                 {
                                     LogMessage (log.get(),
-                                                "SymbolFileDWARF(%p) - 0x%8.8x: %s type \"%s\" is an incomplete objc type, complete type is 0x%8.8llx", 
+                                                "SymbolFileDWARF(%p) - 0x%8.8llx: %s type \"%s\" is an incomplete objc type, complete type is 0x%8.8llx", 
                                                 this,
-                                                die->GetOffset(), 
+                                                (uint64_t)die->GetOffset(), 
                                                 DW_TAG_value_to_name(tag),
                                                 type_name_cstr,
                                                 type_sp->GetID());
@@ -4461,9 +4515,9 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                         if (log)
                         {
                             LogMessage (log.get(), 
-                                        "SymbolFileDWARF(%p) - 0x%8.8x: %s type \"%s\" is a forward declaration, trying to find complete type", 
+                                        "SymbolFileDWARF(%p) - 0x%8.8llx: %s type \"%s\" is a forward declaration, trying to find complete type", 
                                         this,
-                                        die->GetOffset(), 
+                                        (uint64_t)die->GetOffset(), 
                                         DW_TAG_value_to_name(tag),
                                         type_name_cstr);
                         }
@@ -4483,9 +4537,9 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                             if (log)
                             {
                                 LogMessage (log.get(),
-                                            "SymbolFileDWARF(%p) - 0x%8.8x: %s type \"%s\" is a forward declaration, complete type is 0x%8.8llx", 
+                                            "SymbolFileDWARF(%p) - 0x%8.8llx: %s type \"%s\" is a forward declaration, complete type is 0x%8.8llx", 
                                             this,
-                                            die->GetOffset(), 
+                                            (uint64_t)die->GetOffset(), 
                                             DW_TAG_value_to_name(tag),
                                             type_name_cstr,
                                             type_sp->GetID());
@@ -4907,6 +4961,9 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                         // made with the specification and not with this die.
                                         DWARFCompileUnitSP spec_cu_sp;
                                         const DWARFDebugInfoEntry* spec_die = DebugInfo()->GetDIEPtr(specification_die_offset, &spec_cu_sp);
+                                        // The declaration may be a method that its class left out.
+                                        if (m_deferred_method_die_to_decl_ctx.count (spec_die))
+                                            ResolveType (spec_cu_sp.get(), spec_die);
                                         clang::DeclContext *spec_clang_decl_ctx = GetCachedClangDeclContextForDIE (spec_die);
                                         if (spec_clang_decl_ctx)
                                         {
@@ -4914,9 +4971,9 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                         }
                                         else
                                         {
-                                            ReportWarning ("0x%8.8llx: DW_AT_specification(0x%8.8x) has no decl\n", 
+                                            ReportWarning ("0x%8.8llx: DW_AT_specification(0x%8.8llx) has no decl\n", 
                                                            MakeUserID(die->GetOffset()), 
-                                                           specification_die_offset);
+                                                           (uint64_t)specification_die_offset);
                                         }
                                         type_handled = true;
                                     }
@@ -4930,6 +4987,8 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
 
                                         DWARFCompileUnitSP abs_cu_sp;
                                         const DWARFDebugInfoEntry* abs_die = DebugInfo()->GetDIEPtr(abstract_origin_die_offset, &abs_cu_sp);
+                                        if (m_deferred_method_die_to_decl_ctx.count (abs_die))
+                                            ResolveType (abs_cu_sp.get(), abs_die);
                                         clang::DeclContext *abs_clang_decl_ctx = GetCachedClangDeclContextForDIE (abs_die);
                                         if (abs_clang_decl_ctx)
                                         {
@@ -4937,9 +4996,9 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                         }
                                         else
                                         {
-                                            ReportWarning ("0x%8.8llx: DW_AT_abstract_origin(0x%8.8x) has no decl\n", 
+                                            ReportWarning ("0x%8.8llx: DW_AT_abstract_origin(0x%8.8llx) has no decl\n", 
                                                            MakeUserID(die->GetOffset()), 
-                                                           abstract_origin_die_offset);
+                                                           (uint64_t)abstract_origin_die_offset);
                                         }
                                         type_handled = true;
                                     }
@@ -4948,7 +5007,19 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                         clang_type_t class_opaque_type = class_type->GetClangForwardType();
                                         if (ClangASTContext::IsCXXClassType (class_opaque_type))
                                         {
-                                            if (ClangASTContext::IsBeingDefined (class_opaque_type))
+                                            // Methods that were left out when the class was defined
+                                            // are added to the class definition as they are needed.
+                                            DIEToDeclContextMap::iterator deferred_pos = m_deferred_method_die_to_decl_ctx.find (die);
+                                            const bool is_deferred_method = deferred_pos != m_deferred_method_die_to_decl_ctx.end();
+                                            if (is_deferred_method)
+                                            {
+                                                // Forget about the method before adding it, since adding
+                                                // it makes clang look up its name in the class again.
+                                                m_decl_ctx_to_deferred_method_dies[deferred_pos->second].erase (die);
+                                                m_deferred_method_die_to_decl_ctx.erase (deferred_pos);
+                                            }
+
+                                            if (is_deferred_method || ClangASTContext::IsBeingDefined (class_opaque_type))
                                             {
                                                 // Neither GCC 4.2 nor clang++ currently set a valid accessibility
                                                 // in the DWARF for C++ methods... Default to public for now...
@@ -5008,8 +5079,11 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                                 // base classes and all methods (including the method for this DIE).
                                                 class_type->GetClangFullType();
 
-                                                // The type for this DIE should have been filled in the function call above
+                                                // The type for this DIE should have been filled in the function call above,
+                                                // unless the class left the method out for now.
                                                 type_ptr = m_die_to_type[die];
+                                                if (type_ptr == NULL && m_deferred_method_die_to_decl_ctx.count (die))
+                                                    type_ptr = ResolveType (dwarf_cu, die);
                                                 if (type_ptr)
                                                 {
                                                     type_sp = type_ptr;
@@ -5290,7 +5364,7 @@ SymbolFileDWARF::ParseFunctionBlocks (const SymbolContext &sc)
     DWARFCompileUnit* dwarf_cu = GetDWARFCompileUnitForUID(sc.comp_unit->GetID());
     if (dwarf_cu)
     {
-        dw_offset_t function_die_offset = sc.function->GetID();
+        dw_offset_t function_die_offset = GetDIEOffsetForUserID(sc.function->GetID());
         const DWARFDebugInfoEntry *function_die = dwarf_cu->GetDIEPtr(function_die_offset);
         if (function_die)
         {
@@ -5313,7 +5387,7 @@ SymbolFileDWARF::ParseTypes (const SymbolContext &sc)
     {
         if (sc.function)
         {
-            dw_offset_t function_die_offset = sc.function->GetID();
+            dw_offset_t function_die_offset = GetDIEOffsetForUserID(sc.function->GetID());
             const DWARFDebugInfoEntry *func_die = dwarf_cu->GetDIEPtr(function_die_offset);
             if (func_die && func_die->HasChildren())
             {
@@ -5343,14 +5417,14 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
             return 0;
         
         uint32_t cu_idx = UINT32_MAX;
-        DWARFCompileUnit* dwarf_cu = info->GetCompileUnit(sc.comp_unit->GetID(), &cu_idx).get();
+        DWARFCompileUnit* dwarf_cu = info->GetCompileUnit(GetDIEOffsetForUserID(sc.comp_unit->GetID()), &cu_idx).get();
 
         if (dwarf_cu == NULL)
             return 0;
 
         if (sc.function)
         {
-            const DWARFDebugInfoEntry *function_die = dwarf_cu->GetDIEPtr(sc.function->GetID());
+            const DWARFDebugInfoEntry *function_die = dwarf_cu->GetDIEPtr(GetDIEOffsetForUserID(sc.function->GetID()));
             
             dw_addr_t func_lo_pc = function_die->GetAttributeValueAsUnsigned (this, dwarf_cu, DW_AT_low_pc, DW_INVALID_ADDRESS);
             assert (func_lo_pc != DW_INVALID_ADDRESS);
@@ -5421,7 +5495,7 @@ SymbolFileDWARF::ParseVariablesForContext (const SymbolContext& sc)
                         {
                             if (m_using_apple_tables)
                             {
-                                ReportError (".apple_names accelerator table had bad die 0x%8.8x\n", die_offset);
+                                ReportError (".apple_names accelerator table had bad die 0x%8.8llx\n", (uint64_t)die_offset);
                             }
                         }            
 
@@ -5494,9 +5568,12 @@ SymbolFileDWARF::ParseVariableDIE
                             {
                                 const DataExtractor& debug_info_data = get_debug_info_data();
 
-                                uint32_t block_offset = form_value.BlockData() - debug_info_data.GetDataStart();
                                 uint32_t block_length = form_value.Unsigned();
-                                location.SetOpcodeData(get_debug_info_data(), block_offset, block_length);
+                                // The block may lie past 4GB, so give the location a data
+                                // extractor that starts at the block
+                                location.SetOpcodeData(DataExtractor (debug_info_data,
+                                                                      form_value.BlockData() - debug_info_data.GetDataStart(),
+                                                                      block_length));
                             }
                             else
                             {
@@ -5838,7 +5915,7 @@ SymbolFileDWARF::ParseVariables
                                     // to find the concrete block so we can correctly add the 
                                     // variable to it
                                     DWARFCompileUnit *concrete_block_die_cu = dwarf_cu;
-                                    const DWARFDebugInfoEntry *concrete_block_die = FindBlockContainingSpecification (sc.function->GetID(), 
+                                    const DWARFDebugInfoEntry *concrete_block_die = FindBlockContainingSpecification (GetDIEOffsetForUserID(sc.function->GetID()), 
                                                                                                                       sc_parent_die->GetOffset(), 
                                                                                                                       &concrete_block_die_cu);
                                     if (concrete_block_die)
@@ -6038,7 +6115,110 @@ SymbolFileDWARF::FindExternalVisibleDeclsByName (void *baton,
             symbol_file_dwarf->SearchDeclContext (decl_context, decl_name.getAsString().c_str(), results);
         }
         break;
+    case clang::Decl::CXXRecord:
+        {
+            // The methods are added to the class, which makes clang find
+            // them, so they aren't added to "results".
+            SymbolFileDWARF *symbol_file_dwarf = (SymbolFileDWARF *)baton;
+            symbol_file_dwarf->ResolveDeferredMethods (decl_context, decl_name.getAsString().c_str());
+        }
+        break;
     default:
         break;
     }
 }
+
+void
+SymbolFileDWARF::FindExternalLexicalDecls (void *baton,
+                                           const clang::DeclContext *decl_context,
+                                           bool (*isKindWeWant)(clang::Decl::Kind),
+                                           llvm::SmallVectorImpl <clang::Decl *> *results)
+{
+    // Only classes have declarations left to add, and only methods at that.
+    // Walking just the fields of a class doesn't need them.
+    if (decl_context->getDeclKind() != clang::Decl::CXXRecord)
+        return;
+    if (isKindWeWant && !isKindWeWant (clang::Decl::CXXMethod))
+        return;
+
+    SymbolFileDWARF *symbol_file_dwarf = (SymbolFileDWARF *)baton;
+    symbol_file_dwarf->ResolveDeferredMethods (decl_context, NULL);
+}
+
+bool
+SymbolFileDWARF::ResolveDeferredMethods (const clang::DeclContext *decl_context, const char *name)
+{
+    DeclContextToDIEMap::iterator pos = m_decl_ctx_to_deferred_method_dies.find (decl_context);
+    if (pos == m_decl_ctx_to_deferred_method_dies.end())
+        return false;
+
+    // Adding a method removes it from the set, so pick the methods first.
+    DWARFDebugInfo* debug_info = DebugInfo();
+    std::vector<const DWARFDebugInfoEntry *> method_dies;
+    for (DIEPointerSet::iterator die_pos = pos->second.begin(), end = pos->second.end(); die_pos != end; ++die_pos)
+    {
+        const DWARFDebugInfoEntry *method_die = *die_pos;
+        if (name)
+        {
+            DWARFCompileUnit *method_cu = debug_info->GetCompileUnitContainingDIE (method_die->GetOffset()).get();
+            const char *method_name = method_die->GetName (this, method_cu);
+            if (method_name == NULL || ::strcmp (method_name, name) != 0)
+                continue;
+        }
+        method_dies.push_back (method_die);
+    }
+
+    LogSP log (LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO));
+    if (log && !method_dies.empty())
+        LogMessage (log.get(), 
+                    "SymbolFileDWARF::ResolveDeferredMethods (name = '%s') adding %u methods",
+                    name ? name : "<all>",
+                    (uint32_t)method_dies.size());
+
+    for (size_t i = 0; i < method_dies.size(); ++i)
+    {
+        // The method may have been added already while adding an overload.
+        if (m_deferred_method_die_to_decl_ctx.count (method_dies[i]) == 0)
+            continue;
+        DWARFCompileUnit *method_cu = debug_info->GetCompileUnitContainingDIE (method_dies[i]->GetOffset()).get();
+        ResolveType (method_cu, method_dies[i]);
+    }
+
+    pos = m_decl_ctx_to_deferred_method_dies.find (decl_context);
+    if (pos != m_decl_ctx_to_deferred_method_dies.end() && pos->second.empty())
+        m_decl_ctx_to_deferred_method_dies.erase (pos);
+    return true;
+}
+
+bool
+SymbolFileDWARF::MethodIsNeededForClassLayout (DWARFCompileUnit* dwarf_cu,
+                                               const DWARFDebugInfoEntry *method_die,
+                                               const char *class_name)
+{
+    // Virtual methods decide whether the class has a vtable pointer.
+    if (method_die->GetAttributeValueAsUnsigned(this, dwarf_cu, DW_AT_virtuality, 0) != 0)
+        return true;
+
+    // Implicit methods are cheap and clang expects them with the class.
+    if (method_die->GetAttributeValueAsUnsigned(this, dwarf_cu, DW_AT_artificial, 0) != 0)
+        return true;
+
+    // Constructors, destructors and assignment operators decide whether the
+    // class is trivial or POD, which decides whether its tail padding can be
+    // reused. Conversion functions and the other operators are kept with
+    // them since their names aren't plain identifiers.
+    const char *method_name = method_die->GetName(this, dwarf_cu);
+    if (method_name == NULL)
+        return true;
+    if (method_name[0] == '~' || ::strncmp (method_name, "operator", 8) == 0)
+        return true;
+    if (class_name)
+    {
+        // The class name may carry template arguments the constructor lacks.
+        const size_t method_name_len = ::strlen (method_name);
+        if (::strncmp (class_name, method_name, method_name_len) == 0 &&
+            (class_name[method_name_len] == '\0' || class_name[method_name_len] == '<'))
+            return true;
+    }
+    return false;
+}
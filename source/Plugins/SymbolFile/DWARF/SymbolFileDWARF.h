@@ -140,6 +140,12 @@ public:
                                     clang::DeclarationName Name,
                                     llvm::SmallVectorImpl <clang::NamedDecl *> *results);
 
+    static void
+    FindExternalLexicalDecls (void *baton,
+                              const clang::DeclContext *DC,
+                              bool (*isKindWeWant)(clang::Decl::Kind),
+                              llvm::SmallVectorImpl <clang::Decl *> *results);
+
     //------------------------------------------------------------------
     // PluginInterface protocol
     //------------------------------------------------------------------
@@ -237,6 +243,13 @@ public:
     bool
     HasForwardDeclForClangType (lldb::clang_type_t clang_type);
 
+    // Adds the methods named "name", or all of them if "name" is NULL, that
+    // were left out when the class for "decl_context" was completed.
+    // Returns false if the class didn't come from this symbol file.
+    bool
+    ResolveDeferredMethods (const clang::DeclContext *decl_context,
+                            const char *name);
+
 protected:
 
     enum
@@ -308,6 +321,11 @@ protected:
                                 lldb::AccessType &default_accessibility,
                                 bool &is_a_class);
 
+    bool                    MethodIsNeededForClassLayout(
+                                DWARFCompileUnit* dwarf_cu,
+                                const DWARFDebugInfoEntry *method_die,
+                                const char *class_name);
+
     size_t                  ParseChildParameters(
                                 const lldb_private::SymbolContext& sc,
                                 clang::DeclContext *containing_decl_ctx,
@@ -422,9 +440,17 @@ protected:
                                 m_decl_ctx_to_die[decl_ctx].insert(die);
                             }
     
+    //------------------------------------------------------------------
+    // A symbol file owned by a debug map keeps its OSO index in the high
+    // 32 bits of its ID and of every user ID it makes. A standalone
+    // symbol file has an ID of zero and uses all 64 bits of a user ID
+    // for the DIE offset, so DIEs past 4GB get unique user IDs.
+    //------------------------------------------------------------------
     bool
     UserIDMatches (lldb::user_id_t uid) const
     {
+        if (GetID() == 0)
+            return true;
         const lldb::user_id_t high_uid = uid & 0xffffffff00000000ull;
         if (high_uid)
             return high_uid == GetID();
@@ -434,9 +460,22 @@ protected:
     lldb::user_id_t
     MakeUserID (dw_offset_t die_offset) const
     {
+        if (GetID() == 0)
+            return die_offset;
+        // The OSO index leaves only 32 bits for the DIE offset
+        if (die_offset > 0xffffffffull)
+            return LLDB_INVALID_UID;
         return GetID() | die_offset;
     }
 
+    dw_offset_t
+    GetDIEOffsetForUserID (lldb::user_id_t uid) const
+    {
+        if (GetID() == 0)
+            return uid;
+        return uid & 0xffffffffull;
+    }
+
     static bool
     DeclKindIsCXXClass (clang::Decl::Kind decl_kind)
     {
@@ -517,6 +556,8 @@ protected:
     DIEToVariableSP m_die_to_variable_sp;
     DIEToClangType m_forward_decl_die_to_clang_type;
     ClangTypeToDIE m_forward_decl_clang_type_to_die;
+    DeclContextToDIEMap m_decl_ctx_to_deferred_method_dies; // Classes with methods that haven't been added yet
+    DIEToDeclContextMap m_deferred_method_die_to_decl_ctx;  // Those methods and their classes
 };
 
 #endif  // SymbolFileDWARF_SymbolFileDWARF_h_
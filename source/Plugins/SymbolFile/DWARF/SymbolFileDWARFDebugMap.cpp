@@ -81,7 +81,8 @@ SymbolFileDWARFDebugMap::InitializeObject()
     llvm::OwningPtr<clang::ExternalASTSource> ast_source_ap (
         new ClangExternalASTSourceCallbacks (SymbolFileDWARFDebugMap::CompleteTagDecl,
                                              SymbolFileDWARFDebugMap::CompleteObjCInterfaceDecl,
-                                             NULL,
+                                             SymbolFileDWARFDebugMap::FindExternalVisibleDeclsByName,
+                                             SymbolFileDWARFDebugMap::FindExternalLexicalDecls,
                                              this));
 
     GetClangASTContext().SetExternalSource (ast_source_ap);
@@ -593,6 +594,36 @@ SymbolFileDWARFDebugMap::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t cl
     return NULL;
 }
 
+uint32_t
+SymbolFileDWARFDebugMap::GetNumTypesParsed () const
+{
+    // The types are parsed by the DWARF in the object files, only count the
+    // ones that have been loaded.
+    uint32_t num_types = 0;
+    const size_t num_oso_idxs = m_compile_unit_infos.size();
+    for (size_t oso_idx = 0; oso_idx < num_oso_idxs; ++oso_idx)
+    {
+        SymbolVendor *oso_symbol_vendor = m_compile_unit_infos[oso_idx].oso_symbol_vendor;
+        if (oso_symbol_vendor && oso_symbol_vendor->GetSymbolFile())
+            num_types += oso_symbol_vendor->GetSymbolFile()->GetNumTypesParsed();
+    }
+    return num_types;
+}
+
+uint32_t
+SymbolFileDWARFDebugMap::GetNumTypesCompleted () const
+{
+    uint32_t num_types = 0;
+    const size_t num_oso_idxs = m_compile_unit_infos.size();
+    for (size_t oso_idx = 0; oso_idx < num_oso_idxs; ++oso_idx)
+    {
+        SymbolVendor *oso_symbol_vendor = m_compile_unit_infos[oso_idx].oso_symbol_vendor;
+        if (oso_symbol_vendor && oso_symbol_vendor->GetSymbolFile())
+            num_types += oso_symbol_vendor->GetSymbolFile()->GetNumTypesCompleted();
+    }
+    return num_types;
+}
+
 uint32_t
 SymbolFileDWARFDebugMap::ResolveSymbolContext (const Address& exe_so_addr, uint32_t resolve_scope, SymbolContext& sc)
 {
@@ -1125,6 +1156,57 @@ SymbolFileDWARFDebugMap::CompleteObjCInterfaceDecl (void *baton, clang::ObjCInte
     }
 }
 
+void
+SymbolFileDWARFDebugMap::FindExternalVisibleDeclsByName (void *baton,
+                                                         const clang::DeclContext *decl_context,
+                                                         clang::DeclarationName decl_name,
+                                                         llvm::SmallVectorImpl <clang::NamedDecl *> *results)
+{
+    // Only classes that an object file completed can have methods left to
+    // add, so the object files that aren't loaded yet are skipped.
+    if (decl_context->getDeclKind() != clang::Decl::CXXRecord)
+        return;
+
+    SymbolFileDWARFDebugMap *symbol_file_dwarf = (SymbolFileDWARFDebugMap *)baton;
+    const std::string name (decl_name.getAsString());
+    const size_t num_oso_idxs = symbol_file_dwarf->m_compile_unit_infos.size();
+    for (size_t oso_idx = 0; oso_idx < num_oso_idxs; ++oso_idx)
+    {
+        SymbolVendor *oso_symbol_vendor = symbol_file_dwarf->m_compile_unit_infos[oso_idx].oso_symbol_vendor;
+        if (oso_symbol_vendor && oso_symbol_vendor->GetSymbolFile())
+        {
+            SymbolFileDWARF *oso_dwarf = (SymbolFileDWARF *)oso_symbol_vendor->GetSymbolFile();
+            if (oso_dwarf->ResolveDeferredMethods (decl_context, name.c_str()))
+                return;
+        }
+    }
+}
+
+void
+SymbolFileDWARFDebugMap::FindExternalLexicalDecls (void *baton,
+                                                   const clang::DeclContext *decl_context,
+                                                   bool (*isKindWeWant)(clang::Decl::Kind),
+                                                   llvm::SmallVectorImpl <clang::Decl *> *results)
+{
+    if (decl_context->getDeclKind() != clang::Decl::CXXRecord)
+        return;
+    if (isKindWeWant && !isKindWeWant (clang::Decl::CXXMethod))
+        return;
+
+    SymbolFileDWARFDebugMap *symbol_file_dwarf = (SymbolFileDWARFDebugMap *)baton;
+    const size_t num_oso_idxs = symbol_file_dwarf->m_compile_unit_infos.size();
+    for (size_t oso_idx = 0; oso_idx < num_oso_idxs; ++oso_idx)
+    {
+        SymbolVendor *oso_symbol_vendor = symbol_file_dwarf->m_compile_unit_infos[oso_idx].oso_symbol_vendor;
+        if (oso_symbol_vendor && oso_symbol_vendor->GetSymbolFile())
+        {
+            SymbolFileDWARF *oso_dwarf = (SymbolFileDWARF *)oso_symbol_vendor->GetSymbolFile();
+            if (oso_dwarf->ResolveDeferredMethods (decl_context, NULL))
+                return;
+        }
+    }
+}
+
 clang::DeclContext*
 SymbolFileDWARFDebugMap::GetClangDeclContextContainingTypeUID (lldb::user_id_t type_uid)
 {
@@ -13,6 +13,9 @@
 
 #include <vector>
 #include <bitset>
+
+#include "clang/AST/ExternalASTSource.h"
+
 #include "lldb/Symbol/SymbolFile.h"
 
 #include "UniqueDWARFASTType.h"
@@ -81,6 +84,8 @@ public:
                            const lldb_private::ConstString &name,
                            const lldb_private::ClangNamespaceDecl *parent_namespace_decl);
 
+    virtual uint32_t        GetNumTypesParsed () const;
+    virtual uint32_t        GetNumTypesCompleted () const;
 
     //------------------------------------------------------------------
     // ClangASTContext callbacks for external source lookups.
@@ -91,6 +96,18 @@ public:
     static void
     CompleteObjCInterfaceDecl (void *baton, clang::ObjCInterfaceDecl *);
 
+    static void
+    FindExternalVisibleDeclsByName (void *baton,
+                                    const clang::DeclContext *DC,
+                                    clang::DeclarationName Name,
+                                    llvm::SmallVectorImpl <clang::NamedDecl *> *results);
+
+    static void
+    FindExternalLexicalDecls (void *baton,
+                              const clang::DeclContext *DC,
+                              bool (*isKindWeWant)(clang::Decl::Kind),
+                              llvm::SmallVectorImpl <clang::Decl *> *results);
+
     //------------------------------------------------------------------
     // PluginInterface protocol
     //------------------------------------------------------------------
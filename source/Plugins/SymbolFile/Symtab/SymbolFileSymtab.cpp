@@ -84,6 +84,13 @@ SymbolFileSymtab::CalculateAbilities ()
     uint32_t abilities = 0;
     if (m_obj_file)
     {
+        // A file that answers name lookups from a hash table only has its
+        // exported symbols: no source file symbols, so no compile units or
+        // indexes to build, just code and data. Don't parse the symbol
+        // table to find that out, every module is probed at load time.
+        if (m_obj_file->HasSymbolNameLookupTable())
+            return Labels | GlobalVariables;
+
         const Symtab *symtab = m_obj_file->GetSymtab();
         if (symtab)
         {
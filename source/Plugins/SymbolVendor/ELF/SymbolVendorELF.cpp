@@ -0,0 +1,163 @@
+//===-- SymbolVendorELF.cpp -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "SymbolVendorELF.h"
+
+#include "lldb/Core/Module.h"
+#include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Core/Timer.h"
+#include "lldb/Host/Symbols.h"
+#include "lldb/Symbol/ObjectFile.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+//----------------------------------------------------------------------
+// SymbolVendorELF constructor
+//----------------------------------------------------------------------
+SymbolVendorELF::SymbolVendorELF(Module *module) :
+    SymbolVendor(module)
+{
+}
+
+//----------------------------------------------------------------------
+// Destructor
+//----------------------------------------------------------------------
+SymbolVendorELF::~SymbolVendorELF()
+{
+}
+
+static void
+ReplaceDebugSectionsWithExecutableSections (ObjectFile *exec_objfile, ObjectFile *debug_objfile)
+{
+    // The sections in a debug file made by "objcopy --only-keep-debug" have
+    // the same indexes as in the executable, but everything except the debug
+    // information is SHT_NOBITS. Use the executable's sections so that
+    // addresses from the debug file slide with the loaded image.
+    SectionList *exec_section_list = exec_objfile->GetSectionList();
+    SectionList *debug_section_list = debug_objfile->GetSectionList();
+    if (exec_section_list && debug_section_list)
+    {
+        const uint32_t num_exec_sections = exec_section_list->GetSize();
+        uint32_t exec_sect_idx;
+        for (exec_sect_idx = 0; exec_sect_idx < num_exec_sections; ++exec_sect_idx)
+        {
+            SectionSP exec_sect_sp(exec_section_list->GetSectionAtIndex(exec_sect_idx));
+            if (exec_sect_sp.get() && exec_sect_sp->GetFileSize() > 0)
+            {
+                if (debug_section_list->ReplaceSection(exec_sect_sp->GetID(), exec_sect_sp, 0) == false)
+                    debug_section_list->AddSection(exec_sect_sp);
+            }
+        }
+    }
+}
+
+void
+SymbolVendorELF::Initialize()
+{
+    PluginManager::RegisterPlugin (GetPluginNameStatic(),
+                                   GetPluginDescriptionStatic(),
+                                   CreateInstance);
+}
+
+void
+SymbolVendorELF::Terminate()
+{
+    PluginManager::UnregisterPlugin (CreateInstance);
+}
+
+
+const char *
+SymbolVendorELF::GetPluginNameStatic()
+{
+    return "symbol-vendor.elf";
+}
+
+const char *
+SymbolVendorELF::GetPluginDescriptionStatic()
+{
+    return "Symbol vendor for ELF that looks for separate debug files by build ID.";
+}
+
+
+
+//----------------------------------------------------------------------
+// CreateInstance
+//
+// Only returns a symbol vendor when a separate debug file with the
+// executable's build ID exists, otherwise the default symbol vendor is
+// used.
+//----------------------------------------------------------------------
+SymbolVendor*
+SymbolVendorELF::CreateInstance(Module* module)
+{
+    ObjectFile *obj_file = module->GetObjectFile();
+    if (obj_file == NULL)
+        return NULL;
+
+    // Only ELF files carry a GNU build ID
+    static ConstString g_elf_plugin_name ("object-file.elf");
+    if (ConstString(obj_file->GetShortPluginName()) != g_elf_plugin_name)
+        return NULL;
+
+    const lldb_private::UUID &module_uuid = module->GetUUID();
+    if (!module_uuid.IsValid())
+        return NULL;
+
+    Timer scoped_timer (__PRETTY_FUNCTION__,
+                        "SymbolVendorELF::CreateInstance (module = %s/%s)",
+                        module->GetFileSpec().GetDirectory().AsCString(),
+                        module->GetFileSpec().GetFilename().AsCString());
+
+    FileSpec debug_fspec (Symbols::LocateExecutableSymbolFile (&obj_file->GetFileSpec(),
+                                                               &module->GetArchitecture(),
+                                                               &module_uuid));
+    if (!debug_fspec)
+        return NULL;
+
+    ObjectFileSP debug_objfile_sp (ObjectFile::FindPlugin(module, &debug_fspec, 0, debug_fspec.GetByteSize()));
+    if (!debug_objfile_sp)
+        return NULL;
+
+    // Make sure the debug file belongs to this executable
+    lldb_private::UUID debug_uuid;
+    if (!debug_objfile_sp->GetUUID(&debug_uuid) || debug_uuid != module_uuid)
+        return NULL;
+
+    ReplaceDebugSectionsWithExecutableSections (obj_file, debug_objfile_sp.get());
+
+    SymbolVendorELF* symbol_vendor = new SymbolVendorELF(module);
+    symbol_vendor->AddSymbolFileRepresentation(debug_objfile_sp);
+    return symbol_vendor;
+}
+
+
+
+//------------------------------------------------------------------
+// PluginInterface protocol
+//------------------------------------------------------------------
+const char *
+SymbolVendorELF::GetPluginName()
+{
+    return "SymbolVendorELF";
+}
+
+const char *
+SymbolVendorELF::GetShortPluginName()
+{
+    return GetPluginNameStatic();
+}
+
+uint32_t
+SymbolVendorELF::GetPluginVersion()
+{
+    return 1;
+}
+
@@ -125,6 +125,8 @@ public:
 
     bool find_first_non_prologue_insn (Address &address);
 
+    bool relocate_instruction (addr_t insn_addr, addr_t scratch_addr, DisplacedInstruction &displaced_insn);
+
 private:
     enum { kMaxInstructionByteSize = 32 };
 
@@ -825,6 +827,175 @@ AssemblyParse_x86::find_first_non_prologue_insn (Address &address)
 
 
 
+// Returns true if the one byte opcode "op" is followed by a ModRM byte.
+static bool
+one_byte_opcode_has_modrm (uint8_t op)
+{
+    if (op < 0x40)
+        return (op & 0x07) < 0x04;
+    if (op >= 0x80 && op <= 0x8f)
+        return true;
+    if (op >= 0xd8 && op <= 0xdf)
+        return true;
+    switch (op)
+    {
+        case 0x62: case 0x63: case 0x69: case 0x6b:
+        case 0xc0: case 0xc1: case 0xc6: case 0xc7:
+        case 0xd0: case 0xd1: case 0xd2: case 0xd3:
+        case 0xf6: case 0xf7: case 0xfe: case 0xff:
+            return true;
+    }
+    return false;
+}
+
+// Returns true if the two byte opcode "0x0f op" is followed by a ModRM byte.
+static bool
+two_byte_opcode_has_modrm (uint8_t op)
+{
+    if (op >= 0x30 && op <= 0x37)
+        return false;
+    if (op >= 0x80 && op <= 0x8f)
+        return false;
+    if (op >= 0xc8 && op <= 0xcf)
+        return false;
+    switch (op)
+    {
+        case 0x05: case 0x06: case 0x07: case 0x08: case 0x09:
+        case 0x0b: case 0x0e: case 0x77:
+        case 0xa0: case 0xa1: case 0xa2: case 0xa8: case 0xa9: case 0xaa:
+            return false;
+    }
+    return true;
+}
+
+// Copy the instruction at insn_addr into displaced_insn so it can be executed
+// at scratch_addr.  RIP-relative memory operands are rebased so they still
+// refer to the original data; relative branches and calls are flagged so the
+// caller can rebase the PC (and the pushed return address) after the step.
+// Instructions that trap or transfer control across segments are refused.
+
+bool
+AssemblyParse_x86::relocate_instruction (addr_t insn_addr, addr_t scratch_addr, DisplacedInstruction &displaced_insn)
+{
+    Address insn_address (NULL, insn_addr);
+    int insn_len;
+    if (!instruction_length (insn_address, insn_len) || insn_len <= 0 || insn_len > DisplacedInstruction::kMaxByteSize)
+        return false;
+
+    Error error;
+    const bool prefer_file_cache = false;
+    uint8_t *b = displaced_insn.bytes;
+    if (m_target.ReadMemory (insn_address, prefer_file_cache, b, insn_len, error) != insn_len)
+        return false;
+
+    displaced_insn.orig_addr = insn_addr;
+    displaced_insn.scratch_addr = scratch_addr;
+    displaced_insn.byte_size = insn_len;
+    displaced_insn.pc_relative_branch = false;
+    displaced_insn.pushes_return_addr = false;
+
+    // Skip the legacy prefixes and, for x86_64, the REX prefix
+    int i = 0;
+    while (i < insn_len)
+    {
+        const uint8_t prefix = b[i];
+        if (prefix == 0x26 || prefix == 0x2e || prefix == 0x36 || prefix == 0x3e ||
+            prefix == 0x64 || prefix == 0x65 || prefix == 0x66 || prefix == 0x67 ||
+            prefix == 0xf0 || prefix == 0xf2 || prefix == 0xf3)
+            ++i;
+        else
+            break;
+    }
+    if (m_cpu == k_x86_64 && i < insn_len && (b[i] & 0xf0) == 0x40)
+        ++i;
+    if (i >= insn_len)
+        return false;
+
+    const uint8_t op = b[i++];
+    int modrm_idx = -1;
+    if (op == 0x0f)
+    {
+        if (i >= insn_len)
+            return false;
+        const uint8_t op2 = b[i++];
+        if (op2 >= 0x80 && op2 <= 0x8f)         // jcc rel32
+            displaced_insn.pc_relative_branch = true;
+        if (op2 == 0x38 || op2 == 0x3a)         // three byte opcodes always have a ModRM
+        {
+            ++i;
+            modrm_idx = i;
+        }
+        else if (two_byte_opcode_has_modrm (op2))
+            modrm_idx = i;
+    }
+    else
+    {
+        switch (op)
+        {
+            case 0xcc: case 0xcd: case 0xce: case 0xf1:     // int3, int n, into, int1
+            case 0x9a: case 0xea:                           // far call, far jmp
+            case 0xca: case 0xcb: case 0xcf:                // far ret, iret
+            case 0xc4: case 0xc5:                           // VEX prefixes (or les/lds)
+                return false;
+            case 0x62:                                      // EVEX prefix in 64 bit mode
+                if (m_cpu == k_x86_64)
+                    return false;
+                break;
+            case 0xe8:                                      // call rel32
+                displaced_insn.pushes_return_addr = true;
+                displaced_insn.pc_relative_branch = true;
+                break;
+            case 0xe9: case 0xeb:                           // jmp rel32, jmp rel8
+            case 0xe0: case 0xe1: case 0xe2: case 0xe3:     // loop*, jcxz
+                displaced_insn.pc_relative_branch = true;
+                break;
+            default:
+                if (op >= 0x70 && op <= 0x7f)               // jcc rel8
+                    displaced_insn.pc_relative_branch = true;
+                break;
+        }
+        if (one_byte_opcode_has_modrm (op))
+            modrm_idx = i;
+    }
+
+    if (modrm_idx < 0)
+        return true;
+    if (modrm_idx >= insn_len)
+        return false;
+
+    const uint8_t modrm = b[modrm_idx];
+    const uint8_t mod = modrm >> 6;
+    const uint8_t reg = (modrm >> 3) & 0x7;
+    const uint8_t rm = modrm & 0x7;
+
+    if (op == 0xff)
+    {
+        if (reg == 3 || reg == 5)                   // far indirect call/jmp
+            return false;
+        if (reg == 2)                               // near indirect call
+            displaced_insn.pushes_return_addr = true;
+    }
+
+    // Only x86_64 has RIP-relative addressing: mod == 0, rm == 5, followed by a disp32
+    if (m_cpu == k_x86_64 && mod == 0 && rm == 5)
+    {
+        const int disp_idx = modrm_idx + 1;
+        if (disp_idx + 4 > insn_len)
+            return false;
+        const int64_t disp = (int32_t) extract_4 (b + disp_idx);
+        const int64_t new_disp = disp + (int64_t)(insn_addr - scratch_addr);
+        if (new_disp < INT32_MIN || new_disp > INT32_MAX)
+            return false;
+        const uint32_t new_disp32 = (uint32_t) new_disp;
+        b[disp_idx]     = new_disp32 & 0xff;
+        b[disp_idx + 1] = (new_disp32 >> 8) & 0xff;
+        b[disp_idx + 2] = (new_disp32 >> 16) & 0xff;
+        b[disp_idx + 3] = (new_disp32 >> 24) & 0xff;
+    }
+    return true;
+}
+
+
 //-----------------------------------------------------------------------------------------------
 //  UnwindAssemblyParser_x86 method definitions 
 //-----------------------------------------------------------------------------------------------
@@ -861,6 +1032,14 @@ UnwindAssembly_x86::FirstNonPrologueInsn (AddressRange& func, Target& target, Th
     return asm_parse.find_first_non_prologue_insn (first_non_prologue_insn);
 }
 
+bool
+UnwindAssembly_x86::GetDisplacedInstruction (Target& target, addr_t insn_addr, addr_t scratch_addr, DisplacedInstruction &displaced_insn)
+{
+    AddressRange insn_range (insn_addr, DisplacedInstruction::kMaxByteSize);
+    AssemblyParse_x86 asm_parse(target, NULL, m_cpu, insn_range);
+    return asm_parse.relocate_instruction (insn_addr, scratch_addr, displaced_insn);
+}
+
 UnwindAssembly *
 UnwindAssembly_x86::CreateInstance (const ArchSpec &arch)
 {
@@ -36,6 +36,12 @@ public:
                           lldb_private::Thread* thread, 
                           lldb_private::Address& first_non_prologue_insn);
 
+    virtual bool
+    GetDisplacedInstruction (lldb_private::Target& target,
+                             lldb::addr_t insn_addr,
+                             lldb::addr_t scratch_addr,
+                             lldb_private::DisplacedInstruction &displaced_insn);
+
     static lldb_private::UnwindAssembly *
     CreateInstance (const lldb_private::ArchSpec &arch);
 
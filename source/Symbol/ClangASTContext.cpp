@@ -3232,6 +3232,51 @@ ClangASTContext::GetFieldAtIndex (clang::ASTContext *ast,
     return NULL;
 }
 
+clang_type_t
+ClangASTContext::GetTemplateArgumentType (clang::ASTContext *ast, 
+                                          clang_type_t clang_type,
+                                          uint32_t idx)
+{
+    if (clang_type == NULL)
+        return NULL;
+    
+    QualType qual_type(QualType::getFromOpaquePtr(clang_type));
+    const clang::Type::TypeClass type_class = qual_type->getTypeClass();
+    switch (type_class)
+    {
+        case clang::Type::Record:
+            if (GetCompleteQualType (ast, qual_type))
+            {
+                const CXXRecordDecl *cxx_record_decl = qual_type->getAsCXXRecordDecl();
+                if (cxx_record_decl)
+                {
+                    const ClassTemplateSpecializationDecl *template_decl = dyn_cast<ClassTemplateSpecializationDecl>(cxx_record_decl);
+                    if (template_decl)
+                    {
+                        const TemplateArgumentList &template_args = template_decl->getTemplateArgs();
+                        if (idx < template_args.size() && template_args[idx].getKind() == TemplateArgument::Type)
+                            return template_args[idx].getAsType().getAsOpaquePtr();
+                    }
+                }
+            }
+            break;
+            
+        case clang::Type::Typedef:
+            return ClangASTContext::GetTemplateArgumentType (ast, 
+                                                             cast<TypedefType>(qual_type)->getDecl()->getUnderlyingType().getAsOpaquePtr(),
+                                                             idx);
+            
+        case clang::Type::Elaborated:
+            return ClangASTContext::GetTemplateArgumentType (ast, 
+                                                             cast<ElaboratedType>(qual_type)->getNamedType().getAsOpaquePtr(),
+                                                             idx);
+            
+        default:
+            break;
+    }
+    return NULL;
+}
+
 
 // If a pointer to a pointee type (the clang_type arg) says that it has no 
 // children, then we either need to trust it, or override it and return a 
@@ -121,6 +121,29 @@ ClangExternalASTSourceCallbacks::FindExternalVisibleDeclsByName
     return DeclContext::lookup_result();
 }
 
+clang::ExternalLoadResult
+ClangExternalASTSourceCallbacks::FindExternalLexicalDecls
+(
+    const clang::DeclContext *decl_ctx,
+    bool (*isKindWeWant)(clang::Decl::Kind),
+    llvm::SmallVectorImpl<clang::Decl*> &decls
+)
+{
+    if (m_callback_find_lexical)
+    {
+        // The callback may add the declarations to the context itself, in
+        // which case there is nothing left for clang to splice in.
+        m_callback_find_lexical (m_callback_baton, decl_ctx, isKindWeWant, &decls);
+        if (decls.empty())
+            return clang::ELR_AlreadyLoaded;
+        return clang::ELR_Success;
+    }
+
+    // This is used to support iterating through an entire lexical context,
+    // which isn't something the debugger should ever need to do.
+    return clang::ELR_Failure;
+}
+
 void
 ClangExternalASTSourceCallbacks::CompleteType (TagDecl *tag_decl)
 {
@@ -10,6 +10,7 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
 #include <list>
 
 #include "lldb/Core/Log.h"
@@ -36,6 +37,11 @@ DWARFCallFrameInfo::DWARFCallFrameInfo(ObjectFile& objfile, SectionSP& section,
     m_cfi_data_initialized (false),
     m_fde_index (),
     m_fde_index_initialized (false),
+    m_eh_frame_hdr_data (),
+    m_eh_frame_hdr_addr (LLDB_INVALID_ADDRESS),
+    m_eh_frame_hdr_table_offset (0),
+    m_eh_frame_hdr_fde_count (0),
+    m_eh_frame_hdr_initialized (false),
     m_is_eh_frame (is_eh_frame)
 {
 }
@@ -51,7 +57,7 @@ DWARFCallFrameInfo::GetAddressRange (Address addr, AddressRange &range)
     FDEEntry fde_entry;
     if (GetFDEEntryByAddress (addr, fde_entry) == false)
         return false;
-    range = fde_entry.bounds;
+    range = AddressRange (fde_entry.start, fde_entry.size, m_objfile.GetSectionList());
     return true;
 }
 
@@ -69,33 +75,52 @@ DWARFCallFrameInfo::GetFDEEntryByAddress (Address addr, FDEEntry& fde_entry)
 {
     if (m_section.get() == NULL || m_section->IsEncrypted())
         return false;
-    GetFDEIndex();
 
-    struct FDEEntry searchfde;
-    searchfde.bounds = AddressRange (addr, 1);
+    const addr_t file_addr = addr.GetFileAddress();
+    if (file_addr == LLDB_INVALID_ADDRESS)
+        return false;
+
+    // .eh_frame_hdr lists every FDE in .eh_frame, so if we have it its
+    // answer is final and we never need to build our own index.
+    if (GetEHFrameHdr())
+        return GetFDEEntryFromEHFrameHdr (file_addr, fde_entry);
 
-    std::vector<FDEEntry>::const_iterator idx;
-    if (m_fde_index.size() == 0)
+    GetFDEIndex();
+
+    if (m_fde_index.empty())
         return false;
 
-    idx = std::lower_bound (m_fde_index.begin(), m_fde_index.end(), searchfde);
-    if (idx == m_fde_index.end())
-    {
-        --idx;
-    }
-    if (idx != m_fde_index.begin() && idx->bounds.GetBaseAddress().GetOffset() != addr.GetOffset())
-    {
-       --idx;
-    }
-    if (idx->bounds.ContainsFileAddress (addr))
+    FDEEntry search_fde;
+    search_fde.start = file_addr;
+
+    // Find the last entry that starts at or before "file_addr"
+    std::vector<FDEEntry>::const_iterator pos = std::upper_bound (m_fde_index.begin(), m_fde_index.end(), search_fde);
+    if (pos == m_fde_index.begin())
+        return false;
+    --pos;
+    if (pos->Contains (file_addr))
     {
-        fde_entry = *idx;
+        fde_entry = *pos;
         return true;
     }
-
     return false;
 }
 
+void
+DWARFCallFrameInfo::GetCFIData ()
+{
+    if (m_cfi_data_initialized == false)
+    {
+        LogSP log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+        if (log)
+        { 
+            log->Printf ("Reading eh_frame information for %s", m_objfile.GetFileSpec().GetFilename().GetCString());
+        }
+        m_section->ReadSectionDataFromObjectFile (&m_objfile, m_cfi_data);
+        m_cfi_data_initialized = true;
+    }
+}
+
 const DWARFCallFrameInfo::CIE*
 DWARFCallFrameInfo::GetCIE(dw_offset_t cie_offset)
 {
@@ -109,7 +134,20 @@ DWARFCallFrameInfo::GetCIE(dw_offset_t cie_offset)
 
         return pos->second.get();
     }
-    return NULL;
+
+    // When FDEs are found through .eh_frame_hdr the section is never
+    // scanned, so CIEs are discovered as the FDEs that use them are.
+    GetCFIData();
+    uint32_t offset = cie_offset;
+    if (!m_cfi_data.ValidOffsetForDataOfSize (offset, CFI_HEADER_SIZE))
+        return NULL;
+    m_cfi_data.GetU32 (&offset);
+    const dw_offset_t cie_id = m_cfi_data.GetU32 (&offset);
+    if ((m_is_eh_frame && cie_id != 0ul) || (!m_is_eh_frame && cie_id != 0xfffffffful))
+        return NULL;
+    CIESP cie_sp (ParseCIE (cie_offset));
+    m_cie_map[cie_offset] = cie_sp;
+    return cie_sp.get();
 }
 
 DWARFCallFrameInfo::CIESP
@@ -117,11 +155,7 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
 {
     CIESP cie_sp(new CIE(cie_offset));
     dw_offset_t offset = cie_offset;
-    if (m_cfi_data_initialized == false)
-    {
-        m_section->ReadSectionDataFromObjectFile (&m_objfile, m_cfi_data);
-        m_cfi_data_initialized = true;
-    }
+    GetCFIData();
     const uint32_t length = m_cfi_data.GetU32(&offset);
     const dw_offset_t cie_id = m_cfi_data.GetU32(&offset);
     const dw_offset_t end_offset = cie_offset + length + 4;
@@ -274,6 +308,44 @@ DWARFCallFrameInfo::ParseCIE (const dw_offset_t cie_offset)
     return cie_sp;
 }
 
+// Read the function bounds out of the FDE at "fde_offset".  Returns false
+// if the entry is a CIE or its CIE can't be found.
+
+bool
+DWARFCallFrameInfo::ParseFDEBounds (dw_offset_t fde_offset, FDEEntry& fde_entry)
+{
+    GetCFIData();
+    dw_offset_t offset = fde_offset;
+    if (!m_cfi_data.ValidOffsetForDataOfSize (offset, CFI_HEADER_SIZE))
+        return false;
+    m_cfi_data.GetU32 (&offset);
+    const dw_offset_t cie_id = m_cfi_data.GetU32 (&offset);
+    if (m_is_eh_frame ? cie_id == 0 : cie_id == UINT32_MAX)
+        return false;
+
+    // eh_frame CIE ids are relative to the FDE, debug_frame ones are not
+    const dw_offset_t cie_offset = m_is_eh_frame ? fde_offset + 4 - cie_id : cie_id;
+    const CIE *cie = GetCIE (cie_offset);
+    if (cie == NULL)
+    {
+        fprintf (stderr, 
+                 "error: unable to find CIE at 0x%8.8llx for cie_id = 0x%8.8llx for entry at 0x%8.8llx.\n", 
+                 (uint64_t)cie_offset,
+                 (uint64_t)cie_id,
+                 (uint64_t)fde_offset);
+        return false;
+    }
+
+    const lldb::addr_t pc_rel_addr = m_section->GetFileAddress();
+    const lldb::addr_t text_addr = LLDB_INVALID_ADDRESS;
+    const lldb::addr_t data_addr = LLDB_INVALID_ADDRESS;
+
+    fde_entry.start = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding, pc_rel_addr, text_addr, data_addr);
+    fde_entry.size = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding & DW_EH_PE_MASK_ENCODING, pc_rel_addr, text_addr, data_addr);
+    fde_entry.offset = fde_offset;
+    return true;
+}
+
 // Scan through the eh_frame or debug_frame section looking for FDEs and noting the start/end addresses
 // of the functions and a pointer back to the function's FDE for later expansion.
 // Internalize CIEs as we come across them.
@@ -286,19 +358,10 @@ DWARFCallFrameInfo::GetFDEIndex ()
     if (m_fde_index_initialized)
         return;
 
+    GetCFIData();
 
     dw_offset_t offset = 0;
-    if (m_cfi_data_initialized == false)
-    {
-        LogSP log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
-        if (log)
-        { 
-            log->Printf ("Reading eh_frame information for %s", m_objfile.GetFileSpec().GetFilename().GetCString());
-        }
-        m_section->ReadSectionDataFromObjectFile (&m_objfile, m_cfi_data);
-        m_cfi_data_initialized = true;
-    }
-    while (m_cfi_data.ValidOffsetForDataOfSize (offset, 8))
+    while (m_cfi_data.ValidOffsetForDataOfSize (offset, CFI_HEADER_SIZE))
     {
         const dw_offset_t current_entry = offset;
         uint32_t len = m_cfi_data.GetU32 (&offset);
@@ -312,35 +375,107 @@ DWARFCallFrameInfo::GetFDEIndex ()
             continue;
         }
 
-        const dw_offset_t cie_offset = current_entry + 4 - cie_id;
-        const CIE *cie = GetCIE (cie_offset);
-        if (cie)
-        {
-            const lldb::addr_t pc_rel_addr = m_section->GetFileAddress();
-            const lldb::addr_t text_addr = LLDB_INVALID_ADDRESS;
-            const lldb::addr_t data_addr = LLDB_INVALID_ADDRESS;
-
-            lldb::addr_t addr = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding, pc_rel_addr, text_addr, data_addr);
-            lldb::addr_t length = m_cfi_data.GetGNUEHPointer(&offset, cie->ptr_encoding & DW_EH_PE_MASK_ENCODING, pc_rel_addr, text_addr, data_addr);
-            FDEEntry fde;
-            fde.bounds = AddressRange (addr, length, m_objfile.GetSectionList());
-            fde.offset = current_entry;
+        FDEEntry fde;
+        if (ParseFDEBounds (current_entry, fde))
             m_fde_index.push_back(fde);
-        }
-        else
-        {
-            fprintf (stderr, 
-                     "error: unable to find CIE at 0x%8.8x for cie_id = 0x%8.8x for entry at 0x%8.8x.\n", 
-                     cie_offset,
-                     cie_id,
-                     current_entry);
-        }
         offset = next_entry;
     }
     std::sort (m_fde_index.begin(), m_fde_index.end());
     m_fde_index_initialized = true;
 }
 
+// Locate the .eh_frame_hdr binary search table that describes our
+// .eh_frame, if there is one.  We only use it when the table entries are
+// the fixed size 4 byte data relative encoding every linker emits, so we
+// can binary search it in place without decoding it.
+
+bool
+DWARFCallFrameInfo::GetEHFrameHdr ()
+{
+    if (m_eh_frame_hdr_initialized)
+        return m_eh_frame_hdr_fde_count > 0;
+    m_eh_frame_hdr_initialized = true;
+
+    if (!m_is_eh_frame)
+        return false;
+
+    SectionList *section_list = m_objfile.GetSectionList();
+    if (section_list == NULL)
+        return false;
+
+    static ConstString g_sect_name_eh_frame_hdr (".eh_frame_hdr");
+    SectionSP hdr_section_sp (section_list->FindSectionByName (g_sect_name_eh_frame_hdr));
+    if (!hdr_section_sp || hdr_section_sp->IsEncrypted())
+        return false;
+
+    DataExtractor hdr_data;
+    if (hdr_section_sp->MemoryMapSectionDataFromObjectFile (&m_objfile, hdr_data) == 0)
+        return false;
+
+    const lldb::addr_t hdr_addr = hdr_section_sp->GetFileAddress();
+    uint32_t offset = 0;
+    if (!hdr_data.ValidOffsetForDataOfSize (offset, 4))
+        return false;
+    const uint8_t version = hdr_data.GetU8 (&offset);
+    const uint8_t eh_frame_ptr_enc = hdr_data.GetU8 (&offset);
+    const uint8_t fde_count_enc = hdr_data.GetU8 (&offset);
+    const uint8_t table_enc = hdr_data.GetU8 (&offset);
+    if (version != 1 || fde_count_enc == DW_EH_PE_omit || table_enc != (DW_EH_PE_datarel | DW_EH_PE_sdata4))
+        return false;
+
+    const lldb::addr_t eh_frame_addr = hdr_data.GetGNUEHPointer (&offset, eh_frame_ptr_enc, hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+    if (eh_frame_addr != m_section->GetFileAddress())
+        return false;
+
+    const uint64_t fde_count = hdr_data.GetGNUEHPointer (&offset, fde_count_enc, hdr_addr, LLDB_INVALID_ADDRESS, hdr_addr);
+    if (fde_count == 0 || fde_count > UINT32_MAX / 8 || !hdr_data.ValidOffsetForDataOfSize (offset, fde_count * 8))
+        return false;
+
+    m_eh_frame_hdr_data = hdr_data;
+    m_eh_frame_hdr_addr = hdr_addr;
+    m_eh_frame_hdr_table_offset = offset;
+    m_eh_frame_hdr_fde_count = fde_count;
+
+    LogSP log(GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    if (log)
+        log->Printf ("Using .eh_frame_hdr table with %u FDEs for %s", 
+                     m_eh_frame_hdr_fde_count, 
+                     m_objfile.GetFileSpec().GetFilename().GetCString());
+    return true;
+}
+
+bool
+DWARFCallFrameInfo::GetFDEEntryFromEHFrameHdr (lldb::addr_t file_addr, FDEEntry& fde_entry)
+{
+    // Each table entry is a pair of signed 4 byte values relative to the
+    // start of .eh_frame_hdr: the function start address and the FDE address,
+    // sorted by function start address.
+    uint32_t lo = 0;
+    uint32_t hi = m_eh_frame_hdr_fde_count;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t offset = m_eh_frame_hdr_table_offset + mid * 8;
+        const lldb::addr_t start = m_eh_frame_hdr_addr + (int32_t)m_eh_frame_hdr_data.GetU32 (&offset);
+        if (start <= file_addr)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0)
+        return false;
+
+    uint32_t offset = m_eh_frame_hdr_table_offset + (lo - 1) * 8 + 4;
+    const lldb::addr_t fde_addr = m_eh_frame_hdr_addr + (int32_t)m_eh_frame_hdr_data.GetU32 (&offset);
+    const lldb::addr_t eh_frame_addr = m_section->GetFileAddress();
+    if (fde_addr < eh_frame_addr || fde_addr - eh_frame_addr >= m_section->GetByteSize())
+        return false;
+
+    if (!ParseFDEBounds (fde_addr - eh_frame_addr, fde_entry))
+        return false;
+    return fde_entry.Contains (file_addr);
+}
+
 bool
 DWARFCallFrameInfo::FDEToUnwindPlan (dw_offset_t offset, Address startaddr, UnwindPlan& unwind_plan)
 {
@@ -349,11 +484,7 @@ DWARFCallFrameInfo::FDEToUnwindPlan (dw_offset_t offset, Address startaddr, Unwi
     if (m_section.get() == NULL || m_section->IsEncrypted())
         return false;
 
-    if (m_cfi_data_initialized == false)
-    {
-        m_section->ReadSectionDataFromObjectFile (&m_objfile, m_cfi_data);
-        m_cfi_data_initialized = true;
-    }
+    GetCFIData();
 
     uint32_t length = m_cfi_data.GetU32 (&offset);
     dw_offset_t cie_offset = m_cfi_data.GetU32 (&offset);
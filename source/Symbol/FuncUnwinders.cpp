@@ -9,6 +9,8 @@
 
 #include "lldb/Core/AddressRange.h"
 #include "lldb/Core/Address.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/StreamString.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/ObjectFile.h"
@@ -114,8 +116,29 @@ FuncUnwinders::GetUnwindPlanAtNonCallSite (Thread& thread)
     {
         m_tried_unwind_at_non_call_site = true;
         m_unwind_plan_non_call_site_sp.reset (new UnwindPlan (lldb::eRegisterKindGeneric));
-        if (!m_assembly_profiler->GetNonCallSiteUnwindPlanFromAssembly (m_range, thread, *m_unwind_plan_non_call_site_sp))
-            m_unwind_plan_non_call_site_sp.reset();
+        // Profiling the assembly is expensive, see if an earlier session
+        // already did it for this function.
+        const char *plan_origin = "cached";
+        if (!m_unwind_table.GetCachedNonCallSiteUnwindPlan (m_range, *m_unwind_plan_non_call_site_sp))
+        {
+            plan_origin = "profiled";
+            if (m_assembly_profiler->GetNonCallSiteUnwindPlanFromAssembly (m_range, thread, *m_unwind_plan_non_call_site_sp))
+                m_unwind_table.CacheNonCallSiteUnwindPlan (m_range, *m_unwind_plan_non_call_site_sp);
+            else
+                m_unwind_plan_non_call_site_sp.reset();
+        }
+
+        LogSP log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+        if (log && log->GetVerbose() && m_unwind_plan_non_call_site_sp)
+        {
+            const addr_t func_load_addr = m_range.GetBaseAddress().GetLoadAddress (&thread.GetProcess().GetTarget());
+            StreamString strm;
+            m_unwind_plan_non_call_site_sp->Dump (strm, &thread, func_load_addr);
+            log->Printf ("Using %s non call site UnwindPlan for function at file address 0x%llx:\n%s",
+                         plan_origin,
+                         (uint64_t)m_range.GetBaseAddress().GetFileAddress(),
+                         strm.GetData());
+        }
     }
     return m_unwind_plan_non_call_site_sp;
 }
@@ -412,6 +412,22 @@ LineTable::FineLineEntriesForFileIndex (uint32_t file_idx,
     return num_added;
 }
 
+void
+LineTable::GetLineIndexForFileIndex (uint32_t file_idx, LineIndex &line_index) const
+{
+    line_index.clear();
+    const size_t count = m_entries.size();
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        // Skip line table rows that terminate the previous row (is_terminal_entry is non-zero)
+        if (m_entries[idx].is_terminal_entry)
+            continue;
+
+        if (m_entries[idx].file_idx == file_idx)
+            line_index.push_back (std::make_pair (m_entries[idx].line, (uint32_t)idx));
+    }
+    std::sort (line_index.begin(), line_index.end());
+}
 
 void
 LineTable::Dump (Stream *s, Target *target, Address::DumpStyle style, Address::DumpStyle fallback_style, bool show_line_ranges)
@@ -12,6 +12,7 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/RegularExpression.h"
 #include "lldb/Core/Timer.h"
+#include "lldb/Host/Host.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
@@ -26,9 +27,12 @@ Symtab::Symtab(ObjectFile *objfile) :
     m_symbols (),
     m_addr_indexes (),
     m_name_to_index (),
+    m_regex_index (),
+    m_symbol_attrs (),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_addr_indexes_computed (false),
-    m_name_indexes_computed (false)
+    m_name_indexes_computed (false),
+    m_symbol_columns_computed (false)
 {
 }
 
@@ -49,7 +53,13 @@ Symtab::Resize(uint32_t count)
 {
     // Clients should grab the mutex from this symbol table and lock it manually
     // when calling this function to avoid performance issues.
+    m_name_to_index.Clear();
+    m_addr_indexes.clear();
+    m_regex_index.Clear();
+    ClearSymbolColumns();
     m_symbols.resize (count);
+    m_addr_indexes_computed = false;
+    m_name_indexes_computed = false;
     return &m_symbols[0];
 }
 
@@ -61,6 +71,8 @@ Symtab::AddSymbol(const Symbol& symbol)
     uint32_t symbol_idx = m_symbols.size();
     m_name_to_index.Clear();
     m_addr_indexes.clear();
+    m_regex_index.Clear();
+    ClearSymbolColumns();
     m_symbols.push_back(symbol);
     m_addr_indexes_computed = false;
     m_name_indexes_computed = false;
@@ -325,6 +337,38 @@ Symtab::InitNameIndexes()
     }
 }
 
+//----------------------------------------------------------------------
+// InitRegexIndex
+//----------------------------------------------------------------------
+void
+Symtab::InitRegexIndex()
+{
+    // Protected function, no need to lock mutex...
+    const size_t count = m_symbols.size();
+    if (m_regex_index.IsEmpty() && count >= RegularExpressionIndex::GetMinimumStringCount())
+    {
+        Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+        // Index the same name the regex searches match against
+        m_regex_index.Reserve (count);
+        for (uint32_t i = 0; i < count; ++i)
+            m_regex_index.Append (i, m_symbols[i].GetMangled().GetName().AsCString());
+        m_regex_index.Finalize ();
+    }
+}
+
+//----------------------------------------------------------------------
+// Fill in "candidates" with the indexes of the symbols whose names need
+// to be checked against "regex", in increasing order. Returns false if
+// every symbol needs to be checked.
+//----------------------------------------------------------------------
+bool
+Symtab::GetRegexCandidates (const RegularExpression &regex, std::vector<uint32_t>& candidates)
+{
+    // Protected function, no need to lock mutex...
+    InitRegexIndex ();
+    return m_regex_index.FindCandidates (regex, candidates);
+}
+
 void
 Symtab::AppendSymbolNamesToMap (const IndexCollection &indexes, 
                                 bool add_demangled,
@@ -372,11 +416,20 @@ Symtab::AppendSymbolIndexesWithType (SymbolType symbol_type, std::vector<uint32_
 
     const uint32_t count = std::min<uint32_t> (m_symbols.size(), end_index);
 
-    for (uint32_t i = start_idx; i < count; ++i)
+    if (symbol_type == eSymbolTypeAny)
     {
-        if (symbol_type == eSymbolTypeAny || m_symbols[i].GetType() == symbol_type)
+        for (uint32_t i = start_idx; i < count; ++i)
             indexes.push_back(i);
     }
+    else
+    {
+        InitSymbolColumns();
+        for (uint32_t i = start_idx; i < count; ++i)
+        {
+            if (CheckSymbolType(m_symbol_attrs[i], symbol_type))
+                indexes.push_back(i);
+        }
+    }
 
     return indexes.size() - prev_size;
 }
@@ -390,9 +443,10 @@ Symtab::AppendSymbolIndexesWithTypeAndFlagsValue (SymbolType symbol_type, uint32
 
     const uint32_t count = std::min<uint32_t> (m_symbols.size(), end_index);
 
+    InitSymbolColumns();
     for (uint32_t i = start_idx; i < count; ++i)
     {
-        if ((symbol_type == eSymbolTypeAny || m_symbols[i].GetType() == symbol_type) && m_symbols[i].GetFlags() == flags_value)
+        if (CheckSymbolType(m_symbol_attrs[i], symbol_type) && m_symbols[i].GetFlags() == flags_value)
             indexes.push_back(i);
     }
 
@@ -408,11 +462,12 @@ Symtab::AppendSymbolIndexesWithType (SymbolType symbol_type, Debug symbol_debug_
 
     const uint32_t count = std::min<uint32_t> (m_symbols.size(), end_index);
 
+    InitSymbolColumns();
     for (uint32_t i = start_idx; i < count; ++i)
     {
-        if (symbol_type == eSymbolTypeAny || m_symbols[i].GetType() == symbol_type)
+        if (CheckSymbolType(m_symbol_attrs[i], symbol_type))
         {
-            if (CheckSymbolAtIndex(i, symbol_debug_type, symbol_visibility))
+            if (CheckSymbolBits(m_symbol_attrs[i], symbol_debug_type, symbol_visibility))
                 indexes.push_back(i);
         }
     }
@@ -439,16 +494,18 @@ struct SymbolSortInfo
 namespace {
     struct SymbolIndexComparator {
         const std::vector<Symbol>& symbols;
-        SymbolIndexComparator(const std::vector<Symbol>& s) : symbols(s) { }
+        const std::vector<addr_t>& file_addrs;
+        SymbolIndexComparator(const std::vector<Symbol>& s, const std::vector<addr_t>& a) : symbols(s), file_addrs(a) { }
         bool operator()(uint32_t index_a, uint32_t index_b) {
-            addr_t value_a;
-            addr_t value_b;
-            if (symbols[index_a].GetValue().GetSection() == symbols[index_b].GetValue().GetSection()) {
-                value_a = symbols[index_a].GetValue ().GetOffset();
-                value_b = symbols[index_b].GetValue ().GetOffset();
-            } else {
-                value_a = symbols[index_a].GetValue ().GetFileAddress();
-                value_b = symbols[index_b].GetValue ().GetFileAddress();
+            addr_t value_a = file_addrs[index_a];
+            addr_t value_b = file_addrs[index_b];
+            if (value_a == LLDB_INVALID_ADDRESS || value_b == LLDB_INVALID_ADDRESS) {
+                // A section without a file address, symbols in the same
+                // section can still be ordered by their offsets.
+                if (symbols[index_a].GetValue().GetSection() == symbols[index_b].GetValue().GetSection()) {
+                    value_a = symbols[index_a].GetValue ().GetOffset();
+                    value_b = symbols[index_b].GetValue ().GetOffset();
+                }
             }
 
             if (value_a == value_b) {
@@ -468,6 +525,56 @@ namespace {
     };
 }
 
+namespace {
+    // Sorting the address indexes of a large symbol table is split into runs
+    // that are sorted on separate threads and then merged.
+    struct SymbolIndexSort {
+        SymbolIndexSort (std::vector<uint32_t>& i, const std::vector<Symbol>& s, const std::vector<addr_t>& a, size_t n) :
+            mutex (Mutex::eMutexTypeNormal),
+            indexes (i),
+            symbols (s),
+            file_addrs (a),
+            run_starts (),
+            next_run (0)
+        {
+            for (size_t run = 0; run < n; ++run)
+                run_starts.push_back ((indexes.size() * run) / n);
+            run_starts.push_back (indexes.size());
+        }
+
+        Mutex mutex;
+        std::vector<uint32_t>& indexes;
+        const std::vector<Symbol>& symbols;
+        const std::vector<addr_t>& file_addrs;
+        std::vector<size_t> run_starts;
+        size_t next_run;
+    };
+
+    // Don't bother with threads unless each one gets a reasonable amount
+    // of work.
+    const size_t g_min_indexes_per_sort_thread = 64 * 1024;
+}
+
+static lldb::thread_result_t
+SortSymbolIndexesThread (lldb::thread_arg_t arg)
+{
+    SymbolIndexSort *sort = (SymbolIndexSort *)arg;
+    while (1)
+    {
+        size_t run;
+        {
+            Mutex::Locker locker (sort->mutex);
+            run = sort->next_run++;
+        }
+        if (run + 1 >= sort->run_starts.size())
+            break;
+        std::stable_sort (sort->indexes.begin() + sort->run_starts[run],
+                          sort->indexes.begin() + sort->run_starts[run + 1],
+                          SymbolIndexComparator(sort->symbols, sort->file_addrs));
+    }
+    return NULL;
+}
+
 void
 Symtab::SortSymbolIndexesByValue (std::vector<uint32_t>& indexes, bool remove_duplicates) const
 {
@@ -478,11 +585,61 @@ Symtab::SortSymbolIndexesByValue (std::vector<uint32_t>& indexes, bool remove_du
     if (indexes.size() <= 1)
         return;
 
+    // Look up the file address of each symbol once instead of on every
+    // comparison. The addresses are only kept while sorting since they
+    // would double the memory a symbol table needs.
+    std::vector<addr_t> file_addrs (m_symbols.size(), LLDB_INVALID_ADDRESS);
+    for (std::vector<uint32_t>::const_iterator pos = indexes.begin(), end = indexes.end(); pos != end; ++pos)
+        file_addrs[*pos] = m_symbols[*pos].GetValue().GetFileAddress();
+
     // Sort the indexes in place using std::stable_sort.
     // NOTE: The use of std::stable_sort instead of std::sort here is strictly for performance,
     // not correctness.  The indexes vector tends to be "close" to sorted, which the
     // stable sort handles better.
-    std::stable_sort(indexes.begin(), indexes.end(), SymbolIndexComparator(m_symbols));
+    const size_t num_threads = std::min<size_t> (Host::GetNumberCPUS(), indexes.size() / g_min_indexes_per_sort_thread);
+    if (num_threads <= 1)
+    {
+        std::stable_sort(indexes.begin(), indexes.end(), SymbolIndexComparator(m_symbols, file_addrs));
+    }
+    else
+    {
+        // Sort one run per thread, the calling thread is one of the workers,
+        // then merge neighboring runs until one sorted run is left. The
+        // merges are stable so the result is the same as a single sort.
+        SymbolIndexSort sort (indexes, m_symbols, file_addrs, num_threads);
+        std::vector<lldb::thread_t> threads;
+        for (size_t i = 1; i < num_threads; ++i)
+        {
+            char thread_name[64];
+            ::snprintf (thread_name, sizeof(thread_name), "<lldb.symtab.sort-%zu>", i);
+            lldb::thread_t thread = Host::ThreadCreate (thread_name, SortSymbolIndexesThread, &sort, NULL);
+            if (IS_VALID_LLDB_HOST_THREAD(thread))
+                threads.push_back (thread);
+        }
+        SortSymbolIndexesThread (&sort);
+        for (size_t i = 0; i < threads.size(); ++i)
+            Host::ThreadJoin (threads[i], NULL, NULL);
+
+        std::vector<size_t> &run_starts = sort.run_starts;
+        while (run_starts.size() > 2)
+        {
+            std::vector<size_t> merged_starts;
+            size_t run;
+            for (run = 0; run + 2 < run_starts.size(); run += 2)
+            {
+                std::inplace_merge (indexes.begin() + run_starts[run],
+                                    indexes.begin() + run_starts[run + 1],
+                                    indexes.begin() + run_starts[run + 2],
+                                    SymbolIndexComparator(m_symbols, file_addrs));
+                merged_starts.push_back (run_starts[run]);
+            }
+            // An odd run out is merged on the next pass
+            if (run + 1 < run_starts.size())
+                merged_starts.push_back (run_starts[run]);
+            merged_starts.push_back (indexes.size());
+            run_starts.swap (merged_starts);
+        }
+    }
 
     // Remove any duplicates if requested
     if (remove_duplicates)
@@ -577,10 +734,13 @@ Symtab::AppendSymbolIndexesMatchingRegExAndType (const RegularExpression &regexp
     Mutex::Locker locker (m_mutex);
 
     uint32_t prev_size = indexes.size();
-    uint32_t sym_end = m_symbols.size();
+    std::vector<uint32_t> candidates;
+    const bool use_candidates = GetRegexCandidates (regexp, candidates);
+    const uint32_t sym_end = use_candidates ? candidates.size() : m_symbols.size();
 
-    for (int i = 0; i < sym_end; i++)
+    for (uint32_t pos = 0; pos < sym_end; pos++)
     {
+        const uint32_t i = use_candidates ? candidates[pos] : pos;
         if (symbol_type == eSymbolTypeAny || m_symbols[i].GetType() == symbol_type)
         {
             const char *name = m_symbols[i].GetMangled().GetName().AsCString();
@@ -601,10 +761,13 @@ Symtab::AppendSymbolIndexesMatchingRegExAndType (const RegularExpression &regexp
     Mutex::Locker locker (m_mutex);
 
     uint32_t prev_size = indexes.size();
-    uint32_t sym_end = m_symbols.size();
+    std::vector<uint32_t> candidates;
+    const bool use_candidates = GetRegexCandidates (regexp, candidates);
+    const uint32_t sym_end = use_candidates ? candidates.size() : m_symbols.size();
 
-    for (int i = 0; i < sym_end; i++)
+    for (uint32_t pos = 0; pos < sym_end; pos++)
     {
+        const uint32_t i = use_candidates ? candidates[pos] : pos;
         if (symbol_type == eSymbolTypeAny || m_symbols[i].GetType() == symbol_type)
         {
             if (CheckSymbolAtIndex(i, symbol_debug_type, symbol_visibility) == false)
@@ -627,12 +790,13 @@ Symtab::FindSymbolWithType (SymbolType symbol_type, Debug symbol_debug_type, Vis
 {
     Mutex::Locker locker (m_mutex);
 
+    InitSymbolColumns();
     const size_t count = m_symbols.size();
     for (uint32_t idx = start_idx; idx < count; ++idx)
     {
-        if (symbol_type == eSymbolTypeAny || m_symbols[idx].GetType() == symbol_type)
+        if (CheckSymbolType(m_symbol_attrs[idx], symbol_type))
         {
-            if (CheckSymbolAtIndex(idx, symbol_debug_type, symbol_visibility))
+            if (CheckSymbolBits(m_symbol_attrs[idx], symbol_debug_type, symbol_visibility))
             {
                 start_idx = idx;
                 return &m_symbols[idx];
@@ -814,12 +978,13 @@ Symtab::InitAddressIndexes()
 #else
         // The new way adds all symbols with valid addresses that are section
         // offset.
-        const_iterator begin = m_symbols.begin();
-        const_iterator end = m_symbols.end();
-        for (const_iterator pos = m_symbols.begin(); pos != end; ++pos)
+        InitSymbolColumns();
+        const uint32_t num_symbols = m_symbols.size();
+        m_addr_indexes.reserve (num_symbols + 1);
+        for (uint32_t i = 0; i < num_symbols; ++i)
         {
-            if (pos->GetAddressRangePtr())
-                m_addr_indexes.push_back (std::distance(begin, pos));
+            if (m_symbol_attrs[i] & eSymbolBitAddress)
+                m_addr_indexes.push_back (i);
         }
 #endif
         SortSymbolIndexesByValue (m_addr_indexes, false);
@@ -827,6 +992,39 @@ Symtab::InitAddressIndexes()
     }
 }
 
+void
+Symtab::InitSymbolColumns () const
+{
+    // Protected function, no need to lock mutex...
+    if (m_symbol_columns_computed)
+        return;
+    m_symbol_columns_computed = true;
+
+    const size_t num_symbols = m_symbols.size();
+    m_symbol_attrs.resize (num_symbols);
+    for (size_t i = 0; i < num_symbols; ++i)
+    {
+        const Symbol &symbol = m_symbols[i];
+        assert ((symbol.GetType() & ~eSymbolTypeMask) == 0);
+        uint8_t attrs = symbol.GetType();
+        if (symbol.IsDebug())
+            attrs |= eSymbolBitDebug;
+        if (symbol.IsExternal())
+            attrs |= eSymbolBitExternal;
+        if (symbol.GetAddressRangePtr())
+            attrs |= eSymbolBitAddress;
+        m_symbol_attrs[i] = attrs;
+    }
+}
+
+void
+Symtab::ClearSymbolColumns ()
+{
+    // Release the memory, the columns are rebuilt on demand
+    std::vector<uint8_t>().swap (m_symbol_attrs);
+    m_symbol_columns_computed = false;
+}
+
 size_t
 Symtab::CalculateSymbolSize (Symbol *symbol)
 {
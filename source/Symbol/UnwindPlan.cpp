@@ -9,7 +9,10 @@
 
 #include "lldb/Symbol/UnwindPlan.h"
 
+#include <string.h>
+
 #include "lldb/Core/ConstString.h"
+#include "lldb/Core/DataExtractor.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/Thread.h"
@@ -187,6 +190,74 @@ UnwindPlan::Row::Dump (Stream& s, const UnwindPlan* unwind_plan, Thread* thread,
     s.EOL();
 }
 
+bool
+UnwindPlan::Row::Encode (Stream& s) const
+{
+    s.PutHex64 (m_offset);
+    s.PutHex32 (m_cfa_reg_num);
+    s.PutHex32 (m_cfa_offset);
+    s.PutHex32 (m_register_locations.size());
+    for (collection::const_iterator pos = m_register_locations.begin (); pos != m_register_locations.end (); ++pos)
+    {
+        const RegisterLocation &reg_loc = pos->second;
+        uint32_t value = 0;
+        switch (reg_loc.GetLocationType())
+        {
+            case RegisterLocation::unspecified:
+            case RegisterLocation::undefined:
+            case RegisterLocation::same:
+                break;
+            case RegisterLocation::atCFAPlusOffset:
+            case RegisterLocation::isCFAPlusOffset:
+                value = reg_loc.GetOffset();
+                break;
+            case RegisterLocation::inOtherRegister:
+                value = reg_loc.GetRegisterNumber();
+                break;
+            default:
+                return false;
+        }
+        s.PutHex32 (pos->first);
+        s.PutHex8 (reg_loc.GetLocationType());
+        s.PutHex32 (value);
+    }
+    return true;
+}
+
+bool
+UnwindPlan::Row::Decode (const DataExtractor& data, uint32_t *offset_ptr)
+{
+    Clear();
+    if (!data.ValidOffsetForDataOfSize (*offset_ptr, 20))
+        return false;
+    m_offset = data.GetU64 (offset_ptr);
+    m_cfa_reg_num = data.GetU32 (offset_ptr);
+    m_cfa_offset = data.GetU32 (offset_ptr);
+    const uint32_t num_registers = data.GetU32 (offset_ptr);
+    for (uint32_t i = 0; i < num_registers; ++i)
+    {
+        if (!data.ValidOffsetForDataOfSize (*offset_ptr, 9))
+            return false;
+        const uint32_t reg_num = data.GetU32 (offset_ptr);
+        const uint8_t type = data.GetU8 (offset_ptr);
+        const uint32_t value = data.GetU32 (offset_ptr);
+        RegisterLocation reg_loc;
+        switch (type)
+        {
+            case RegisterLocation::unspecified:     reg_loc.SetUnspecified(); break;
+            case RegisterLocation::undefined:       reg_loc.SetUndefined(); break;
+            case RegisterLocation::same:            reg_loc.SetSame(); break;
+            case RegisterLocation::atCFAPlusOffset: reg_loc.SetAtCFAPlusOffset (value); break;
+            case RegisterLocation::isCFAPlusOffset: reg_loc.SetIsCFAPlusOffset (value); break;
+            case RegisterLocation::inOtherRegister: reg_loc.SetInRegister (value); break;
+            default:
+                return false;
+        }
+        m_register_locations[reg_num] = reg_loc;
+    }
+    return true;
+}
+
 UnwindPlan::Row::Row() :
     m_offset(0),
     m_cfa_reg_num(0),
@@ -413,6 +484,83 @@ UnwindPlan::Dump (Stream& s, Thread *thread, lldb::addr_t base_addr) const
     }
 }
 
+bool
+UnwindPlan::Encode (Stream& s, const Address& func_base) const
+{
+    const addr_t func_file_addr = func_base.GetFileAddress();
+    if (func_file_addr == LLDB_INVALID_ADDRESS)
+        return false;
+
+    s.PutHex32 (m_register_kind);
+    s.PutCString (m_source_name.IsEmpty() ? "" : m_source_name.GetCString());
+
+    const addr_t range_file_addr = m_plan_valid_address_range.GetBaseAddress().GetFileAddress();
+    if (range_file_addr != LLDB_INVALID_ADDRESS && m_plan_valid_address_range.GetByteSize() > 0)
+    {
+        s.PutHex8 (1);
+        s.PutHex64 (range_file_addr - func_file_addr);
+        s.PutHex64 (m_plan_valid_address_range.GetByteSize());
+    }
+    else
+    {
+        s.PutHex8 (0);
+    }
+
+    s.PutHex32 (m_row_list.size());
+    for (collection::const_iterator pos = m_row_list.begin(); pos != m_row_list.end(); ++pos)
+    {
+        if (!pos->Encode (s))
+            return false;
+    }
+    return true;
+}
+
+bool
+UnwindPlan::Decode (const DataExtractor& data, uint32_t *offset_ptr, const Address& func_base)
+{
+    Clear();
+    if (!data.ValidOffsetForDataOfSize (*offset_ptr, 4))
+        return false;
+    m_register_kind = (RegisterKind)data.GetU32 (offset_ptr);
+    // Make sure the source name is terminated inside "data" before
+    // handing it to GetCStr() which doesn't check.
+    const uint32_t name_offset = *offset_ptr;
+    const char *source_name = (const char *)data.PeekData (name_offset, 1);
+    if (source_name == NULL || ::memchr (source_name, '\0', data.GetByteSize() - name_offset) == NULL)
+        return false;
+    data.GetCStr (offset_ptr);
+    if (!data.ValidOffsetForDataOfSize (*offset_ptr, 1))
+        return false;
+    if (source_name[0])
+        m_source_name.SetCString (source_name);
+
+    if (data.GetU8 (offset_ptr))
+    {
+        if (!data.ValidOffsetForDataOfSize (*offset_ptr, 16))
+            return false;
+        const addr_t range_offset = data.GetU64 (offset_ptr);
+        const addr_t range_size = data.GetU64 (offset_ptr);
+        Address range_base (func_base);
+        range_base.SetOffset (range_base.GetOffset() + range_offset);
+        SetPlanValidAddressRange (AddressRange (range_base, range_size));
+    }
+
+    if (!data.ValidOffsetForDataOfSize (*offset_ptr, 4))
+        return false;
+    const uint32_t num_rows = data.GetU32 (offset_ptr);
+    for (uint32_t i = 0; i < num_rows; ++i)
+    {
+        Row row;
+        if (!row.Decode (data, offset_ptr))
+        {
+            Clear();
+            return false;
+        }
+        m_row_list.push_back (row);
+    }
+    return true;
+}
+
 void
 UnwindPlan::SetSourceName (const char *source)
 {
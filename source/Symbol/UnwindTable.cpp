@@ -9,14 +9,26 @@
 
 #include "lldb/Symbol/UnwindTable.h"
 
+#include <errno.h>
 #include <stdio.h>
+#include <sys/stat.h>
 
+#include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Core/UUID.h"
+#include "lldb/Host/Endian.h"
+#include "lldb/Host/File.h"
+#include "lldb/Host/FileSpec.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Target/Target.h"
 #include "lldb/Target/UnwindAssembly.h"
 
 // There is one UnwindTable object per ObjectFile.
@@ -31,7 +43,13 @@ UnwindTable::UnwindTable (ObjectFile& objfile) :
     m_unwinds (),
     m_initialized (false),
     m_assembly_profiler (NULL),
-    m_eh_frame (NULL)
+    m_eh_frame (NULL),
+    m_cache_mutex (Mutex::eMutexTypeNormal),
+    m_cache_loaded (false),
+    m_cache_dir (),
+    m_cache_path (),
+    m_cache_data_sp (),
+    m_cached_plans ()
 {
 }
 
@@ -126,3 +144,169 @@ UnwindTable::GetEHFrameInfo ()
     Initialize();
     return m_eh_frame;
 }
+
+//----------------------------------------------------------------------
+// Unwind plan cache file format (all values in host byte order):
+//
+//  uint32_t magic ('UWPC')
+//  uint32_t version
+//  records, each of which is:
+//      uint32_t length of the rest of the record
+//      uint64_t function file address
+//      uint64_t function byte size
+//      UnwindPlan::Encode() data
+//
+// Records are only ever appended, so if the same function shows up more
+// than once the last record wins.  A truncated trailing record (from a
+// session that died mid-write) is ignored.
+//----------------------------------------------------------------------
+static const uint32_t k_unwind_cache_magic = 0x55575043;
+static const uint32_t k_unwind_cache_version = 1;
+static const uint32_t k_unwind_cache_header_size = 8;
+static const uint32_t k_unwind_cache_record_header_size = 20;
+
+// Stop appending to a cache file once it gets this big
+static const uint64_t k_unwind_cache_max_file_size = 16 * 1024 * 1024;
+
+// Must be called with m_cache_mutex locked. Returns true if this
+// ObjectFile can use the cache at all.
+bool
+UnwindTable::LoadUnwindPlanCache ()
+{
+    // The cache directory is a setting that can change at any time, so
+    // start over whenever it does.
+    const std::string cache_dir (Target::GetUnwindPlanCachePath());
+    if (m_cache_loaded && cache_dir == m_cache_dir)
+        return !m_cache_path.empty();
+    m_cache_loaded = true;
+    m_cache_dir = cache_dir;
+    m_cache_path.clear();
+    m_cache_data_sp.reset();
+    m_cached_plans.clear();
+
+    // An empty path (the default) disables the cache
+    if (cache_dir.empty())
+        return false;
+
+    UUID uuid;
+    if (!m_object_file.GetUUID (&uuid) || !uuid.IsValid())
+        return false;
+
+    if (::mkdir (cache_dir.c_str(), 0755) != 0 && errno != EEXIST)
+        return false;
+
+    char uuid_cstr[64];
+    if (uuid.GetAsCString (uuid_cstr, sizeof(uuid_cstr)) == NULL)
+        return false;
+
+    m_cache_path = cache_dir;
+    m_cache_path.append ("/");
+    m_cache_path.append (uuid_cstr);
+    m_cache_path.append (".unwind");
+
+    FileSpec cache_file (m_cache_path.c_str(), false);
+    if (!cache_file.Exists())
+        return true;
+
+    m_cache_data_sp = cache_file.ReadFileContents ();
+    if (!m_cache_data_sp || m_cache_data_sp->GetByteSize() < k_unwind_cache_header_size)
+        return true;
+
+    DataExtractor data (m_cache_data_sp, lldb::endian::InlHostByteOrder(), 8);
+    uint32_t offset = 0;
+    if (data.GetU32 (&offset) != k_unwind_cache_magic || data.GetU32 (&offset) != k_unwind_cache_version)
+    {
+        // Written by an incompatible lldb or on a host with a different
+        // byte order, don't use anything in it.
+        m_cache_data_sp.reset();
+        return true;
+    }
+
+    while (data.ValidOffsetForDataOfSize (offset, k_unwind_cache_record_header_size))
+    {
+        const uint32_t record_length = data.GetU32 (&offset);
+        if (record_length < 16 || !data.ValidOffsetForDataOfSize (offset, record_length))
+            break;
+        const uint32_t record_end = offset + record_length;
+        const addr_t func_file_addr = data.GetU64 (&offset);
+        CachedUnwindPlan cached_plan;
+        cached_plan.byte_size = data.GetU64 (&offset);
+        cached_plan.data_offset = offset;
+        cached_plan.data_length = record_end - offset;
+        m_cached_plans[func_file_addr] = cached_plan;
+        offset = record_end;
+    }
+
+    LogSP log (GetLogIfAllCategoriesSet (LIBLLDB_LOG_UNWIND));
+    if (log)
+        log->Printf ("Loaded %zu cached unwind plans from %s", m_cached_plans.size(), m_cache_path.c_str());
+    return true;
+}
+
+bool
+UnwindTable::GetCachedNonCallSiteUnwindPlan (const AddressRange& range, UnwindPlan& unwind_plan)
+{
+    Mutex::Locker locker (m_cache_mutex);
+    if (!LoadUnwindPlanCache () || !m_cache_data_sp)
+        return false;
+
+    CachedUnwindPlanMap::const_iterator pos = m_cached_plans.find (range.GetBaseAddress().GetFileAddress());
+    if (pos == m_cached_plans.end() || pos->second.byte_size != range.GetByteSize())
+        return false;
+
+    DataExtractor data (m_cache_data_sp, lldb::endian::InlHostByteOrder(), 8);
+    uint32_t offset = pos->second.data_offset;
+    if (!unwind_plan.Decode (data, &offset, range.GetBaseAddress())
+        || offset != pos->second.data_offset + pos->second.data_length)
+    {
+        unwind_plan.Clear();
+        return false;
+    }
+    return true;
+}
+
+void
+UnwindTable::CacheNonCallSiteUnwindPlan (const AddressRange& range, const UnwindPlan& unwind_plan)
+{
+    Mutex::Locker locker (m_cache_mutex);
+    if (!LoadUnwindPlanCache ())
+        return;
+
+    const addr_t func_file_addr = range.GetBaseAddress().GetFileAddress();
+    if (func_file_addr == LLDB_INVALID_ADDRESS)
+        return;
+
+    if (FileSpec (m_cache_path.c_str(), false).GetByteSize() >= k_unwind_cache_max_file_size)
+        return;
+
+    StreamString plan_strm (Stream::eBinary, 8, lldb::endian::InlHostByteOrder());
+    if (!unwind_plan.Encode (plan_strm, range.GetBaseAddress()))
+        return;
+
+    StreamString record_strm (Stream::eBinary, 8, lldb::endian::InlHostByteOrder());
+    File cache_file;
+    // Whoever creates the file writes the header
+    if (cache_file.Open (m_cache_path.c_str(), 
+                         File::eOpenOptionWrite | File::eOpenOptionCanCreateNewOnly, 
+                         File::ePermissionsUserRW).Success())
+    {
+        record_strm.PutHex32 (k_unwind_cache_magic);
+        record_strm.PutHex32 (k_unwind_cache_version);
+    }
+    else if (cache_file.Open (m_cache_path.c_str(), 
+                              File::eOpenOptionWrite | File::eOpenOptionAppend, 
+                              File::ePermissionsUserRW).Fail())
+    {
+        return;
+    }
+
+    record_strm.PutHex32 (16 + plan_strm.GetSize());
+    record_strm.PutHex64 (func_file_addr);
+    record_strm.PutHex64 (range.GetByteSize());
+    record_strm.Write (plan_strm.GetData(), plan_strm.GetSize());
+
+    // Write the whole record at once so concurrent sessions appending to
+    // the same file don't interleave their records.
+    size_t num_bytes = record_strm.GetSize();
+    cache_file.Write (record_strm.GetData(), num_bytes);
+}
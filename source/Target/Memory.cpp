@@ -155,6 +155,56 @@ MemoryCache::Read (addr_t addr,
     return dst_len - bytes_left;
 }
 
+// Fill in the cache lines covering [addr, addr + size) that aren't cached
+// yet. Each run of missing lines is read from the process with a single
+// read and then split up into lines. Only whole lines are cached, so a
+// short read leaves the rest for Read() to fetch (and report errors for).
+size_t
+MemoryCache::Prefetch (addr_t addr, size_t size, Error &error)
+{
+    if (size == 0)
+        return 0;
+    
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    const addr_t end_addr = addr + size - 1;
+    const addr_t prefetch_start_addr = addr - (addr % cache_line_byte_size);
+    const addr_t prefetch_end_addr = end_addr - (end_addr % cache_line_byte_size) + cache_line_byte_size;
+    size_t bytes_cached = 0;
+    
+    Mutex::Locker locker (m_cache_mutex);
+    addr_t curr_addr = prefetch_start_addr;
+    while (curr_addr < prefetch_end_addr)
+    {
+        if (m_cache.find (curr_addr) != m_cache.end())
+        {
+            curr_addr += cache_line_byte_size;
+            continue;
+        }
+        
+        addr_t run_end_addr = curr_addr + cache_line_byte_size;
+        while (run_end_addr < prefetch_end_addr && m_cache.find (run_end_addr) == m_cache.end())
+            run_end_addr += cache_line_byte_size;
+        
+        DataBufferHeap run_buffer (run_end_addr - curr_addr, 0);
+        const size_t process_bytes_read = m_process.ReadMemoryFromInferior (curr_addr, 
+                                                                            run_buffer.GetBytes(), 
+                                                                            run_buffer.GetByteSize(), 
+                                                                            error);
+        const size_t num_lines = process_bytes_read / cache_line_byte_size;
+        for (size_t i = 0; i < num_lines; ++i)
+        {
+            m_cache[curr_addr + i * cache_line_byte_size] = DataBufferSP (new DataBufferHeap (run_buffer.GetBytes() + i * cache_line_byte_size, 
+                                                                                             cache_line_byte_size));
+        }
+        bytes_cached += num_lines * cache_line_byte_size;
+        
+        if (process_bytes_read != run_buffer.GetByteSize())
+            break;
+        curr_addr = run_end_addr;
+    }
+    return bytes_cached;
+}
+
 
 
 AllocatedBlock::AllocatedBlock (lldb::addr_t addr, 
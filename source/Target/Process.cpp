@@ -9,6 +9,9 @@
 
 #include "lldb/Target/Process.h"
 
+// C++ Includes
+#include <algorithm>
+
 #include "lldb/lldb-private-log.h"
 
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
@@ -36,6 +39,7 @@
 #include "lldb/Target/TargetList.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadPlan.h"
+#include "lldb/Target/UnwindAssembly.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -759,7 +763,11 @@ Process::Process(Target &target, Listener &listener) :
     m_image_tokens (),
     m_listener (listener),
     m_breakpoint_site_list (),
+    m_bp_site_batch_depth (0),
+    m_bp_sites_to_enable (),
+    m_bp_sites_to_remove (),
     m_dynamic_checkers_ap (),
+    m_displaced_step_assembly_ap (),
     m_unix_signals (),
     m_abi_sp (),
     m_process_input_reader (),
@@ -1486,6 +1494,22 @@ Process::DisableAllBreakpointSites ()
     m_breakpoint_site_list.SetEnabledForAll (false);
 }
 
+Error
+Process::RemoveAllBreakpointSitesFromMemory ()
+{
+    BreakpointSiteCollection bp_sites;
+    const BreakpointSiteList::collection *site_map = m_breakpoint_site_list.GetMap();
+    BreakpointSiteList::collection::const_iterator pos, end = site_map->end();
+    for (pos = site_map->begin(); pos != end; ++pos)
+    {
+        if (pos->second->IsEnabled())
+            bp_sites.push_back (pos->second.get());
+    }
+    if (bp_sites.empty())
+        return Error();
+    return DisableBreakpoints (bp_sites);
+}
+
 Error
 Process::ClearBreakpointSiteByID (lldb::user_id_t break_id)
 {
@@ -1556,7 +1580,15 @@ Process::CreateBreakpointSite (BreakpointLocationSP &owner, bool use_hardware)
             bp_site_sp.reset (new BreakpointSite (&m_breakpoint_site_list, owner, load_addr, LLDB_INVALID_THREAD_ID, use_hardware));
             if (bp_site_sp)
             {
-                if (EnableBreakpoint (bp_site_sp.get()).Success())
+                if (m_bp_site_batch_depth > 0)
+                {
+                    // The site will be inserted along with all the other
+                    // new sites when the batch ends.
+                    m_bp_sites_to_enable.push_back (bp_site_sp);
+                    owner->SetBreakpointSite (bp_site_sp);
+                    return m_breakpoint_site_list.Add (bp_site_sp);
+                }
+                else if (EnableBreakpoint (bp_site_sp.get()).Success())
                 {
                     owner->SetBreakpointSite (bp_site_sp);
                     return m_breakpoint_site_list.Add (bp_site_sp);
@@ -1575,6 +1607,13 @@ Process::RemoveOwnerFromBreakpointSite (lldb::user_id_t owner_id, lldb::user_id_
     uint32_t num_owners = bp_site_sp->RemoveOwner (owner_id, owner_loc_id);
     if (num_owners == 0)
     {
+        if (m_bp_site_batch_depth > 0)
+        {
+            // Leave the site in the list until the batch ends in case
+            // another location is added at the same address.
+            m_bp_sites_to_remove.push_back (bp_site_sp);
+            return;
+        }
         DisableBreakpoint(bp_site_sp.get());
         m_breakpoint_site_list.RemoveByAddress(bp_site_sp->GetLoadAddress());
     }
@@ -1596,7 +1635,7 @@ Process::RemoveBreakpointOpcodesFromBuffer (addr_t bp_addr, size_t size, uint8_t
     {
         for (idx = 0; (bp_sp = bp_sites_in_range.GetByIndex(idx)); ++idx)
         {
-            if (bp_sp->GetType() == BreakpointSite::eSoftware)
+            if (bp_sp->GetType() == BreakpointSite::eSoftware && bp_sp->IsEnabled())
             {
                 if (bp_sp->IntersectsRange(bp_addr, size, &intersect_addr, &intersect_size, &opcode_offset))
                 {
@@ -1796,6 +1835,373 @@ Process::DisableSoftwareBreakpoint (BreakpointSite *bp_site)
 
 }
 
+Error
+Process::EnableBreakpoints (const BreakpointSiteCollection &bp_sites)
+{
+    Error error;
+    BreakpointSiteCollection::const_iterator pos, end = bp_sites.end();
+    for (pos = bp_sites.begin(); pos != end; ++pos)
+    {
+        if ((*pos)->IsEnabled())
+            continue;
+        Error site_error (EnableBreakpoint (*pos));
+        if (site_error.Fail() && error.Success())
+            error = site_error;
+    }
+    return error;
+}
+
+Error
+Process::DisableBreakpoints (const BreakpointSiteCollection &bp_sites)
+{
+    Error error;
+    BreakpointSiteCollection::const_iterator pos, end = bp_sites.end();
+    for (pos = bp_sites.begin(); pos != end; ++pos)
+    {
+        if (!(*pos)->IsEnabled())
+            continue;
+        Error site_error (DisableBreakpoint (*pos));
+        if (site_error.Fail() && error.Success())
+            error = site_error;
+    }
+    return error;
+}
+
+// Software breakpoints that are enabled or disabled as a group are split
+// into runs whose opcodes all live in the same page of memory.
+static const addr_t g_bp_batch_page_size = 4096;
+
+// Reads memory without replacing the breakpoint traps that are in it so
+// the bytes can be patched and written straight back.
+static size_t
+ReadRawMemory (Process &process, addr_t addr, uint8_t *buf, size_t size, Error &error)
+{
+    size_t bytes_read = 0;
+    while (bytes_read < size)
+    {
+        const size_t curr_size = size - bytes_read;
+        const size_t curr_bytes_read = process.DoReadMemory (addr + bytes_read,
+                                                             buf + bytes_read,
+                                                             curr_size,
+                                                             error);
+        bytes_read += curr_bytes_read;
+        if (curr_bytes_read == curr_size || curr_bytes_read == 0)
+            break;
+    }
+    return bytes_read;
+}
+
+static bool
+BreakpointSiteAddressLessThan (BreakpointSite *lhs, BreakpointSite *rhs)
+{
+    return lhs->GetLoadAddress() < rhs->GetLoadAddress();
+}
+
+// Returns the index one past the last site in the run starting at
+// "start_idx". All sites in the run start in the same page and none of
+// their opcodes overlap.
+static size_t
+GetBreakpointSiteBatchEnd (const Process::BreakpointSiteCollection &sorted_sites, size_t start_idx)
+{
+    const size_t num_sites = sorted_sites.size();
+    const addr_t page_addr = sorted_sites[start_idx]->GetLoadAddress() & ~(g_bp_batch_page_size - 1);
+    size_t end_idx = start_idx + 1;
+    for (; end_idx < num_sites; ++end_idx)
+    {
+        const BreakpointSite *prev_site = sorted_sites[end_idx - 1];
+        const addr_t addr = sorted_sites[end_idx]->GetLoadAddress();
+        if ((addr & ~(g_bp_batch_page_size - 1)) != page_addr)
+            break;
+        if (addr < prev_site->GetLoadAddress() + prev_site->GetByteSize())
+            break;
+    }
+    return end_idx;
+}
+
+Error
+Process::EnableSoftwareBreakpoints (const BreakpointSiteCollection &bp_sites)
+{
+    Error error;
+    LogSP log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    // Fill in the trap opcodes and weed out the sites we can't batch
+    BreakpointSiteCollection sorted_sites;
+    sorted_sites.reserve (bp_sites.size());
+    BreakpointSiteCollection::const_iterator pos, end = bp_sites.end();
+    for (pos = bp_sites.begin(); pos != end; ++pos)
+    {
+        BreakpointSite *bp_site = *pos;
+        if (bp_site->IsEnabled())
+            continue;
+        if (bp_site->GetLoadAddress() == LLDB_INVALID_ADDRESS ||
+            GetSoftwareBreakpointTrapOpcode (bp_site) == 0 ||
+            bp_site->GetTrapOpcodeBytes() == NULL)
+        {
+            // Let the single site code path report the error
+            Error site_error (EnableSoftwareBreakpoint (bp_site));
+            if (site_error.Fail() && error.Success())
+                error = site_error;
+            continue;
+        }
+        sorted_sites.push_back (bp_site);
+    }
+    std::sort (sorted_sites.begin(), sorted_sites.end(), BreakpointSiteAddressLessThan);
+
+    std::vector<uint8_t> memory;
+    std::vector<uint8_t> verify_memory;
+    const size_t num_sites = sorted_sites.size();
+    size_t start_idx = 0;
+    while (start_idx < num_sites)
+    {
+        const size_t end_idx = GetBreakpointSiteBatchEnd (sorted_sites, start_idx);
+        const addr_t batch_addr = sorted_sites[start_idx]->GetLoadAddress();
+        const BreakpointSite *last_site = sorted_sites[end_idx - 1];
+        const size_t batch_size = last_site->GetLoadAddress() + last_site->GetByteSize() - batch_addr;
+
+        if (log)
+            log->Printf ("Process::EnableSoftwareBreakpoints () enabling %llu sites in [0x%llx-0x%llx)",
+                         (uint64_t)(end_idx - start_idx),
+                         (uint64_t)batch_addr,
+                         (uint64_t)(batch_addr + batch_size));
+
+        // Read the original memory once, save the original opcodes and
+        // patch in the traps
+        Error batch_error;
+        memory.resize (batch_size);
+        if (ReadRawMemory (*this, batch_addr, &memory[0], batch_size, batch_error) != batch_size)
+        {
+            // Fall back to enabling each site on its own so the sites that
+            // can be enabled still are
+            for (size_t i = start_idx; i < end_idx; ++i)
+            {
+                Error site_error (EnableSoftwareBreakpoint (sorted_sites[i]));
+                if (site_error.Fail() && error.Success())
+                    error = site_error;
+            }
+            start_idx = end_idx;
+            continue;
+        }
+        verify_memory = memory;
+        for (size_t i = start_idx; i < end_idx; ++i)
+        {
+            BreakpointSite *bp_site = sorted_sites[i];
+            const size_t offset = bp_site->GetLoadAddress() - batch_addr;
+            ::memcpy (bp_site->GetSavedOpcodeBytes(), &memory[offset], bp_site->GetByteSize());
+            ::memcpy (&memory[offset], bp_site->GetTrapOpcodeBytes(), bp_site->GetByteSize());
+        }
+
+        if (WriteMemoryPrivate (batch_addr, &memory[0], batch_size, batch_error) != batch_size)
+        {
+            // Put back whatever we might have partially written
+            WriteMemoryPrivate (batch_addr, &verify_memory[0], batch_size, batch_error);
+            if (error.Success())
+                error.SetErrorString("Unable to write breakpoint trap to memory.");
+            start_idx = end_idx;
+            continue;
+        }
+
+        if (ReadRawMemory (*this, batch_addr, &verify_memory[0], batch_size, batch_error) != batch_size)
+        {
+            if (error.Success())
+                error.SetErrorString("Unable to read memory to verify breakpoint trap.");
+            start_idx = end_idx;
+            continue;
+        }
+
+        for (size_t i = start_idx; i < end_idx; ++i)
+        {
+            BreakpointSite *bp_site = sorted_sites[i];
+            const size_t offset = bp_site->GetLoadAddress() - batch_addr;
+            if (::memcmp (bp_site->GetTrapOpcodeBytes(), &verify_memory[offset], bp_site->GetByteSize()) == 0)
+            {
+                bp_site->SetEnabled(true);
+                bp_site->SetType (BreakpointSite::eSoftware);
+            }
+            else
+            {
+                if (log)
+                    log->Printf ("Process::EnableSoftwareBreakpoints (site_id = %d) addr = 0x%llx -- FAILED: failed to verify the breakpoint trap in memory.",
+                                 bp_site->GetID(),
+                                 (uint64_t)bp_site->GetLoadAddress());
+                if (error.Success())
+                    error.SetErrorString("failed to verify the breakpoint trap in memory.");
+            }
+        }
+        start_idx = end_idx;
+    }
+    return error;
+}
+
+Error
+Process::DisableSoftwareBreakpoints (const BreakpointSiteCollection &bp_sites)
+{
+    Error error;
+    LogSP log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+
+    BreakpointSiteCollection sorted_sites;
+    sorted_sites.reserve (bp_sites.size());
+    BreakpointSiteCollection::const_iterator pos, end = bp_sites.end();
+    for (pos = bp_sites.begin(); pos != end; ++pos)
+    {
+        BreakpointSite *bp_site = *pos;
+        if (!bp_site->IsEnabled())
+            continue;
+        if (bp_site->IsHardware() || bp_site->GetByteSize() == 0)
+        {
+            Error site_error (DisableSoftwareBreakpoint (bp_site));
+            if (site_error.Fail() && error.Success())
+                error = site_error;
+            continue;
+        }
+        sorted_sites.push_back (bp_site);
+    }
+    std::sort (sorted_sites.begin(), sorted_sites.end(), BreakpointSiteAddressLessThan);
+
+    std::vector<uint8_t> memory;
+    std::vector<uint8_t> verify_memory;
+    const size_t num_sites = sorted_sites.size();
+    size_t start_idx = 0;
+    while (start_idx < num_sites)
+    {
+        const size_t end_idx = GetBreakpointSiteBatchEnd (sorted_sites, start_idx);
+        const addr_t batch_addr = sorted_sites[start_idx]->GetLoadAddress();
+        const BreakpointSite *last_site = sorted_sites[end_idx - 1];
+        const size_t batch_size = last_site->GetLoadAddress() + last_site->GetByteSize() - batch_addr;
+
+        if (log)
+            log->Printf ("Process::DisableSoftwareBreakpoints () disabling %llu sites in [0x%llx-0x%llx)",
+                         (uint64_t)(end_idx - start_idx),
+                         (uint64_t)batch_addr,
+                         (uint64_t)(batch_addr + batch_size));
+
+        Error batch_error;
+        memory.resize (batch_size);
+        if (ReadRawMemory (*this, batch_addr, &memory[0], batch_size, batch_error) != batch_size)
+        {
+            if (error.Success())
+                error.SetErrorString("Unable to read memory that should contain the breakpoint trap.");
+            start_idx = end_idx;
+            continue;
+        }
+
+        // Restore the saved opcodes for the traps that are still in memory.
+        // If a trap is no longer there we still verify below in case the
+        // original opcode has already been restored.
+        for (size_t i = start_idx; i < end_idx; ++i)
+        {
+            BreakpointSite *bp_site = sorted_sites[i];
+            const size_t offset = bp_site->GetLoadAddress() - batch_addr;
+            if (::memcmp (&memory[offset], bp_site->GetTrapOpcodeBytes(), bp_site->GetByteSize()) == 0)
+                ::memcpy (&memory[offset], bp_site->GetSavedOpcodeBytes(), bp_site->GetByteSize());
+        }
+
+        if (WriteMemoryPrivate (batch_addr, &memory[0], batch_size, batch_error) != batch_size)
+        {
+            if (error.Success())
+                error.SetErrorString("Memory write failed when restoring original opcode.");
+            start_idx = end_idx;
+            continue;
+        }
+
+        verify_memory.resize (batch_size);
+        if (ReadRawMemory (*this, batch_addr, &verify_memory[0], batch_size, batch_error) != batch_size)
+        {
+            if (error.Success())
+                error.SetErrorString("Failed to read memory to verify that breakpoint trap was restored.");
+            start_idx = end_idx;
+            continue;
+        }
+
+        for (size_t i = start_idx; i < end_idx; ++i)
+        {
+            BreakpointSite *bp_site = sorted_sites[i];
+            const size_t offset = bp_site->GetLoadAddress() - batch_addr;
+            if (::memcmp (bp_site->GetSavedOpcodeBytes(), &verify_memory[offset], bp_site->GetByteSize()) == 0)
+            {
+                bp_site->SetEnabled(false);
+            }
+            else
+            {
+                if (log)
+                    log->Printf ("Process::DisableSoftwareBreakpoints (site_id = %d) addr = 0x%llx -- FAILED: failed to restore original opcode.",
+                                 bp_site->GetID(),
+                                 (uint64_t)bp_site->GetLoadAddress());
+                if (error.Success())
+                    error.SetErrorString("Failed to restore original opcode.");
+            }
+        }
+        start_idx = end_idx;
+    }
+    return error;
+}
+
+void
+Process::BeginBreakpointSiteBatch ()
+{
+    ++m_bp_site_batch_depth;
+}
+
+Error
+Process::EndBreakpointSiteBatch ()
+{
+    Error error;
+    if (m_bp_site_batch_depth == 0 || --m_bp_site_batch_depth > 0)
+        return error;
+
+    std::vector<BreakpointSiteSP> sites_to_enable;
+    std::vector<BreakpointSiteSP> sites_to_remove;
+    sites_to_enable.swap (m_bp_sites_to_enable);
+    sites_to_remove.swap (m_bp_sites_to_remove);
+    std::vector<BreakpointSiteSP>::iterator pos, end;
+
+    // Remove the sites that lost all their owners first. A site may have
+    // picked up a new owner since, in which case it stays.
+    BreakpointSiteCollection bp_sites;
+    for (pos = sites_to_remove.begin(), end = sites_to_remove.end(); pos != end; ++pos)
+    {
+        if ((*pos)->GetNumberOfOwners() == 0 && (*pos)->IsEnabled())
+            bp_sites.push_back (pos->get());
+    }
+    if (!bp_sites.empty())
+        error = DisableBreakpoints (bp_sites);
+    for (pos = sites_to_remove.begin(), end = sites_to_remove.end(); pos != end; ++pos)
+    {
+        if ((*pos)->GetNumberOfOwners() == 0)
+            m_breakpoint_site_list.RemoveByAddress ((*pos)->GetLoadAddress());
+    }
+
+    // Now insert all the new sites that still have owners
+    bp_sites.clear();
+    for (pos = sites_to_enable.begin(), end = sites_to_enable.end(); pos != end; ++pos)
+    {
+        if ((*pos)->GetNumberOfOwners() > 0 && !(*pos)->IsEnabled())
+            bp_sites.push_back (pos->get());
+    }
+    if (!bp_sites.empty())
+    {
+        Error enable_error (EnableBreakpoints (bp_sites));
+        if (enable_error.Fail() && error.Success())
+            error = enable_error;
+    }
+
+    // Sites that couldn't be inserted are taken away from their owners just
+    // like CreateBreakpointSite() does when it fails to enable a site.
+    for (pos = sites_to_enable.begin(), end = sites_to_enable.end(); pos != end; ++pos)
+    {
+        BreakpointSiteSP bp_site_sp (*pos);
+        if (bp_site_sp->IsEnabled() || bp_site_sp->GetNumberOfOwners() == 0)
+            continue;
+        std::vector<BreakpointLocationSP> owners;
+        const uint32_t num_owners = bp_site_sp->GetNumberOfOwners();
+        for (uint32_t i = 0; i < num_owners; ++i)
+            owners.push_back (bp_site_sp->GetOwnerAtIndex (i));
+        for (uint32_t i = 0; i < num_owners; ++i)
+            owners[i]->ClearBreakpointSite();
+        m_breakpoint_site_list.RemoveByAddress (bp_site_sp->GetLoadAddress());
+    }
+    return error;
+}
+
 // Comment out line below to disable memory caching
 #define ENABLE_MEMORY_CACHING
 // Uncomment to verify memory caching works after making changes to caching code
@@ -1854,6 +2260,16 @@ Process::ReadMemory (addr_t addr, void *buf, size_t size, Error &error)
 
 #endif  // #else for #if defined (ENABLE_MEMORY_CACHING)
 
+size_t
+Process::PrefetchMemory (addr_t addr, size_t size, Error &error)
+{
+#if defined (ENABLE_MEMORY_CACHING)
+    return m_memory_cache.Prefetch (addr, size, error);
+#else
+    return 0;
+#endif
+}
+
 
 size_t
 Process::ReadCStringFromMemory (addr_t addr, char *dst, size_t dst_max_len, Error &result_error)
@@ -2138,6 +2554,49 @@ Process::AllocateMemory(size_t size, uint32_t permissions, Error &error)
 #endif
 }
 
+bool
+Process::PrepareDisplacedStep (addr_t insn_addr, DisplacedInstruction &displaced_insn)
+{
+    if (!SupportsDisplacedStepping())
+        return false;
+
+    if (m_displaced_step_assembly_ap.get() == NULL)
+    {
+        m_displaced_step_assembly_ap.reset (UnwindAssembly::FindPlugin (GetTarget().GetArchitecture()));
+        if (m_displaced_step_assembly_ap.get() == NULL)
+            return false;
+    }
+
+    Error error;
+    const uint32_t permissions = ePermissionsReadable | ePermissionsWritable | ePermissionsExecutable;
+    const addr_t scratch_addr = AllocateMemory (DisplacedInstruction::kMaxByteSize, permissions, error);
+    if (scratch_addr == LLDB_INVALID_ADDRESS)
+        return false;
+
+    if (m_displaced_step_assembly_ap->GetDisplacedInstruction (GetTarget(), insn_addr, scratch_addr, displaced_insn))
+    {
+        if (WriteMemory (scratch_addr, displaced_insn.bytes, displaced_insn.byte_size, error) == displaced_insn.byte_size)
+        {
+            LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_STEP));
+            if (log)
+                log->Printf ("Process::PrepareDisplacedStep (insn_addr = 0x%llx) => scratch_addr = 0x%llx, byte_size = %u", 
+                             (uint64_t)insn_addr, 
+                             (uint64_t)scratch_addr,
+                             displaced_insn.byte_size);
+            return true;
+        }
+    }
+    DeallocateMemory (scratch_addr);
+    return false;
+}
+
+void
+Process::ReleaseDisplacedStep (const DisplacedInstruction &displaced_insn)
+{
+    if (displaced_insn.scratch_addr != LLDB_INVALID_ADDRESS)
+        DeallocateMemory (displaced_insn.scratch_addr);
+}
+
 bool
 Process::CanJIT ()
 {
@@ -2760,7 +3219,15 @@ Process::Detach ()
 
     if (error.Success())
     {
-        DisableAllBreakpointSites();
+        // The process keeps running after we detach, so restore the
+        // original opcodes with one batched write.
+        Error remove_error (RemoveAllBreakpointSitesFromMemory());
+        if (remove_error.Fail())
+        {
+            LogSP log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+            if (log)
+                log->Printf ("Process::Detach() failed to remove breakpoint sites: %s", remove_error.AsCString());
+        }
         error = DoDetach(); 
         if (error.Success())
         {
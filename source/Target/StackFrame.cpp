@@ -1171,10 +1171,9 @@ StackFrame::DumpUsingSettingsFormat (Stream *strm)
     GetSymbolContext(eSymbolContextEverything);
     ExecutionContext exe_ctx;
     CalculateExecutionContext(exe_ctx);
-    const char *end = NULL;
     StreamString s;
-    const char *frame_format = m_thread.GetProcess().GetTarget().GetDebugger().GetFrameFormat();
-    if (frame_format && Debugger::FormatPrompt (frame_format, &m_sc, &exe_ctx, NULL, s, &end))
+    const CompiledFormatString &frame_format = m_thread.GetProcess().GetTarget().GetDebugger().GetCompiledFrameFormat();
+    if (Debugger::FormatPrompt (frame_format, &m_sc, &exe_ctx, NULL, s))
     {
         strm->Write(s.GetData(), s.GetSize());
     }
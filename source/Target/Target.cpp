@@ -64,6 +64,12 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
     m_scratch_ast_source_ap (NULL),
     m_ast_importer_ap (NULL),
     m_persistent_variables (),
+    m_user_expression_cache (),
+    m_user_expression_cache_generation (0),
+    m_user_expression_cache_mutex (Mutex::eMutexTypeNormal),
+    m_modules_generation (0),
+    m_num_expressions_interpreted (0),
+    m_num_expressions_jited (0),
     m_source_manager(*this),
     m_stop_hooks (),
     m_stop_hook_next_id (0),
@@ -118,6 +124,13 @@ Target::DeleteCurrentProcess ()
 {
     if (m_process_sp.get())
     {
+        // The JIT compiled code of cached expressions lives in the process
+        UserExpressionCache stale_expressions;
+        {
+            Mutex::Locker locker (m_user_expression_cache_mutex);
+            stale_expressions.swap (m_user_expression_cache);
+        }
+
         m_section_load_list.Clear();
         if (m_process_sp->IsAlive())
             m_process_sp->Destroy();
@@ -798,6 +811,7 @@ void
 Target::SetExecutableModule (ModuleSP& executable_sp, bool get_dependent_files)
 {
     m_images.Clear();
+    ++m_modules_generation;
     m_scratch_ast_context_ap.reset();
     m_scratch_ast_source_ap.reset();
     m_ast_importer_ap.reset();
@@ -869,6 +883,7 @@ Target::SetArchitecture (const ArchSpec &arch_spec)
         m_arch = arch_spec;
         ModuleSP executable_sp = GetExecutableModule ();
         m_images.Clear();
+        ++m_modules_generation;
         m_scratch_ast_context_ap.reset();
         m_scratch_ast_source_ap.reset();
         m_ast_importer_ap.reset();
@@ -927,6 +942,7 @@ Target::ModuleUpdated (ModuleSP &old_module_sp, ModuleSP &new_module_sp)
 void
 Target::ModulesDidLoad (ModuleList &module_list)
 {
+    ++m_modules_generation;
     m_breakpoint_list.UpdateBreakpoints (module_list, true);
     // TODO: make event data that packages up the module_list
     BroadcastEvent (eBroadcastBitModulesLoaded, NULL);
@@ -935,6 +951,7 @@ Target::ModulesDidLoad (ModuleList &module_list)
 void
 Target::ModulesDidUnload (ModuleList &module_list)
 {
+    ++m_modules_generation;
     m_breakpoint_list.UpdateBreakpoints (module_list, false);
 
     // Remove the images from the target image list
@@ -1417,6 +1434,16 @@ Target::SetDefaultArchitecture (const ArchSpec& arch)
         static_cast<Target::SettingsController *>(settings_controller_sp.get())->GetArchitecture () = arch;
 }
 
+std::string
+Target::GetUnwindPlanCachePath ()
+{
+    lldb::UserSettingsControllerSP settings_controller_sp (GetSettingsController());
+
+    if (settings_controller_sp)
+        return static_cast<Target::SettingsController *>(settings_controller_sp.get())->GetUnwindPlanCachePath ();
+    return std::string();
+}
+
 Target *
 Target::GetTargetFromContexts (const ExecutionContext *exe_ctx_ptr, const SymbolContext *sc_ptr)
 {
@@ -1456,6 +1483,57 @@ Target::GetExpressionPrefixContentsAsCString ()
     return NULL;
 }
 
+// The number of compiled expressions the cache keeps.  Each one holds on
+// to its JIT compiled code in the process.
+static const size_t g_max_cached_user_expressions = 64;
+
+ClangUserExpression::ClangUserExpressionSP
+Target::TakeCachedUserExpression (const std::string &key)
+{
+    ClangUserExpression::ClangUserExpressionSP expr_sp;
+    // Expressions compiled against an earlier module list may refer to
+    // code and data that has moved.  They are destroyed after the lock is
+    // released, since freeing their code can require running the process.
+    UserExpressionCache stale_expressions;
+    Mutex::Locker locker (m_user_expression_cache_mutex);
+    if (m_user_expression_cache_generation != m_modules_generation)
+    {
+        stale_expressions.swap (m_user_expression_cache);
+        m_user_expression_cache_generation = m_modules_generation;
+        return expr_sp;
+    }
+    UserExpressionCache::iterator pos = m_user_expression_cache.find (key);
+    if (pos != m_user_expression_cache.end())
+    {
+        expr_sp = pos->second;
+        m_user_expression_cache.erase (pos);
+    }
+    return expr_sp;
+}
+
+void
+Target::AddCachedUserExpression (const std::string &key, const ClangUserExpression::ClangUserExpressionSP &expr_sp)
+{
+    ClangUserExpression::ClangUserExpressionSP evicted_expr_sp;
+    Mutex::Locker locker (m_user_expression_cache_mutex);
+    if (m_user_expression_cache_generation != m_modules_generation)
+        return;
+    UserExpressionCache::iterator pos = m_user_expression_cache.find (key);
+    if (pos != m_user_expression_cache.end())
+    {
+        evicted_expr_sp = pos->second;
+        pos->second = expr_sp;
+        return;
+    }
+    if (m_user_expression_cache.size() >= g_max_cached_user_expressions)
+    {
+        pos = m_user_expression_cache.begin();
+        evicted_expr_sp = pos->second;
+        m_user_expression_cache.erase (pos);
+    }
+    m_user_expression_cache[key] = expr_sp;
+}
+
 ExecutionResults
 Target::EvaluateExpression
 (
@@ -1994,7 +2072,8 @@ Target::StopHook::GetDescription (Stream *s, lldb::DescriptionLevel level) const
 
 Target::SettingsController::SettingsController () :
     UserSettingsController ("target", Debugger::GetSettingsController()),
-    m_default_architecture ()
+    m_default_architecture (),
+    m_unwind_plan_cache_path ()
 {
     m_default_settings.reset (new TargetInstanceSettings (*this, false,
                                                           InstanceSettings::GetDefaultName().AsCString()));
@@ -2016,6 +2095,7 @@ Target::SettingsController::CreateInstanceSettings (const char *instance_name)
 
 
 #define TSC_DEFAULT_ARCH        "default-arch"
+#define TSC_UNWIND_CACHE_PATH   "unwind-plan-cache-path"
 #define TSC_EXPR_PREFIX         "expr-prefix"
 #define TSC_PREFER_DYNAMIC      "prefer-dynamic-value"
 #define TSC_SKIP_PROLOGUE       "skip-prologue"
@@ -2023,6 +2103,7 @@ Target::SettingsController::CreateInstanceSettings (const char *instance_name)
 #define TSC_MAX_CHILDREN        "max-children-count"
 #define TSC_MAX_STRLENSUMMARY   "max-string-summary-length"
 #define TSC_PLATFORM_AVOID      "breakpoints-use-platform-avoid-list"
+#define TSC_FAST_STEPPING       "use-fast-stepping"
 #define TSC_RUN_ARGS            "run-args"
 #define TSC_ENV_VARS            "env-vars"
 #define TSC_INHERIT_ENV         "inherit-env"
@@ -2040,6 +2121,13 @@ GetSettingNameForDefaultArch ()
     return g_const_string;
 }
 
+static const ConstString &
+GetSettingNameForUnwindPlanCachePath ()
+{
+    static ConstString g_const_string (TSC_UNWIND_CACHE_PATH);
+    return g_const_string;
+}
+
 static const ConstString &
 GetSettingNameForExpressionPrefix ()
 {
@@ -2089,6 +2177,13 @@ GetSettingNameForPlatformAvoid ()
     return g_const_string;
 }
 
+static const ConstString &
+GetSettingNameForFastStepping ()
+{
+    static ConstString g_const_string (TSC_FAST_STEPPING);
+    return g_const_string;
+}
+
 const ConstString &
 GetSettingNameForRunArgs ()
 {
@@ -2159,6 +2254,10 @@ Target::SettingsController::SetGlobalVariable (const ConstString &var_name,
         if (!m_default_architecture.IsValid())
             err.SetErrorStringWithFormat ("'%s' is not a valid architecture or triple.", value);
     }
+    else if (var_name == GetSettingNameForUnwindPlanCachePath())
+    {
+        UserSettingsController::UpdateStringVariable (op, m_unwind_plan_cache_path, value, err);
+    }
     return true;
 }
 
@@ -2175,6 +2274,12 @@ Target::SettingsController::GetGlobalVariable (const ConstString &var_name,
             value.AppendString (m_default_architecture.GetArchitectureName());
         return true;
     }
+    else if (var_name == GetSettingNameForUnwindPlanCachePath())
+    {
+        if (!m_unwind_plan_cache_path.empty())
+            value.AppendString (m_unwind_plan_cache_path.c_str());
+        return true;
+    }
     else
         err.SetErrorStringWithFormat ("unrecognized variable name '%s'", var_name.AsCString());
 
@@ -2200,6 +2305,7 @@ TargetInstanceSettings::TargetInstanceSettings
     m_max_children_display(256),
     m_max_strlen_length(1024),
     m_breakpoints_use_platform_avoid (true, true),
+    m_use_fast_stepping (true, true),
     m_run_args (),
     m_env_vars (),
     m_input_path (),
@@ -2238,6 +2344,7 @@ TargetInstanceSettings::TargetInstanceSettings (const TargetInstanceSettings &rh
     m_max_children_display (rhs.m_max_children_display),
     m_max_strlen_length (rhs.m_max_strlen_length),
     m_breakpoints_use_platform_avoid (rhs.m_breakpoints_use_platform_avoid),
+    m_use_fast_stepping (rhs.m_use_fast_stepping),
     m_run_args (rhs.m_run_args),
     m_env_vars (rhs.m_env_vars),
     m_input_path (rhs.m_input_path),
@@ -2271,6 +2378,7 @@ TargetInstanceSettings::operator= (const TargetInstanceSettings &rhs)
         m_max_children_display = rhs.m_max_children_display;
         m_max_strlen_length = rhs.m_max_strlen_length;
         m_breakpoints_use_platform_avoid = rhs.m_breakpoints_use_platform_avoid;
+        m_use_fast_stepping = rhs.m_use_fast_stepping;
         m_run_args = rhs.m_run_args;
         m_env_vars = rhs.m_env_vars;
         m_input_path = rhs.m_input_path;
@@ -2414,6 +2522,10 @@ TargetInstanceSettings::UpdateInstanceSettingsVariable (const ConstString &var_n
     {
         err = UserSettingsController::UpdateBooleanOptionValue (value, op, m_breakpoints_use_platform_avoid);
     }
+    else if (var_name == GetSettingNameForFastStepping ())
+    {
+        err = UserSettingsController::UpdateBooleanOptionValue (value, op, m_use_fast_stepping);
+    }
     else if (var_name == GetSettingNameForRunArgs())
     {
         UserSettingsController::UpdateStringArrayVariable (op, index_value, m_run_args, value, err);
@@ -2515,6 +2627,13 @@ TargetInstanceSettings::GetInstanceSettingsValue (const SettingEntry &entry,
         else
             value.AppendString ("false");
     }
+    else if (var_name == GetSettingNameForFastStepping())
+    {
+        if (m_use_fast_stepping)
+            value.AppendString ("true");
+        else
+            value.AppendString ("false");
+    }
     else if (var_name == GetSettingNameForRunArgs())
     {
         if (m_run_args.GetArgumentCount() > 0)
@@ -2655,6 +2774,7 @@ Target::SettingsController::global_settings_table[] =
     // var-name           var-type           default      enum  init'd hidden help-text
     // =================  ================== ===========  ====  ====== ====== =========================================================================
     { TSC_DEFAULT_ARCH  , eSetVarTypeString , NULL      , NULL, false, false, "Default architecture to choose, when there's a choice." },
+    { TSC_UNWIND_CACHE_PATH, eSetVarTypeString, NULL    , NULL, false, false, "Directory in which to save unwind plans made by profiling function assembly, so later sessions can reuse them. Empty (the default) disables the cache." },
     { NULL              , eSetVarTypeNone   , NULL      , NULL, false, false, NULL }
 };
 
@@ -2670,6 +2790,7 @@ Target::SettingsController::instance_settings_table[] =
     { TSC_MAX_CHILDREN      , eSetVarTypeInt    , "256"         , NULL,                  true,  false, "Maximum number of children to expand in any level of depth." },
     { TSC_MAX_STRLENSUMMARY , eSetVarTypeInt    , "1024"        , NULL,                  true,  false, "Maximum number of characters to show when using %s in summary strings." },
     { TSC_PLATFORM_AVOID    , eSetVarTypeBoolean, "true"        , NULL,                  false, false, "Consult the platform module avoid list when setting non-module specific breakpoints." },
+    { TSC_FAST_STEPPING     , eSetVarTypeBoolean, "true"        , NULL,                  false, false, "Step over source lines by running to breakpoints on branch instructions rather than single stepping every instruction." },
     { TSC_RUN_ARGS          , eSetVarTypeArray  , NULL          , NULL,                  false,  false,  "A list containing all the arguments to be passed to the executable when it is run." },
     { TSC_ENV_VARS          , eSetVarTypeDictionary, NULL       , NULL,                  false,  false,  "A list of all the environment variables to be passed to the executable's environment, and their values." },
     { TSC_INHERIT_ENV       , eSetVarTypeBoolean, "true"        , NULL,                  false,  false,  "Inherit the environment from the process that is running LLDB." },
@@ -1019,15 +1019,12 @@ Thread::DumpUsingSettingsFormat (Stream &strm, uint32_t frame_idx)
         }
     }
 
-    const char *thread_format = GetProcess().GetTarget().GetDebugger().GetThreadFormat();
-    assert (thread_format);
-    const char *end = NULL;
+    const CompiledFormatString &thread_format = GetProcess().GetTarget().GetDebugger().GetCompiledThreadFormat();
     Debugger::FormatPrompt (thread_format, 
                             frame_sp ? &frame_sc : NULL,
                             &exe_ctx, 
                             NULL,
-                            strm, 
-                            &end);
+                            strm);
 }
 
 lldb::ThreadSP
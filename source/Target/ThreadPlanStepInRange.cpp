@@ -84,6 +84,10 @@ ThreadPlanStepInRange::PlanExplainsStop ()
         switch (reason)
         {
         case eStopReasonBreakpoint:
+            // Hitting our own next branch breakpoint is part of stepping
+            if (NextRangeBreakpointExplainsStop (stop_info_sp))
+                break;
+            // Fall through
         case eStopReasonWatchpoint:
         case eStopReasonSignal:
         case eStopReasonException:
@@ -112,6 +116,8 @@ ThreadPlanStepInRange::ShouldStop (Event *event_ptr)
         log->Printf("ThreadPlanStepInRange reached %s.", s.GetData());
     }
 
+    ClearNextBranchBreakpoint();
+
     if (IsPlanComplete())
         return true;
         
@@ -24,6 +24,12 @@ using namespace lldb_private;
 
 //----------------------------------------------------------------------
 // ThreadPlanStepOverBreakpoint: Single steps over a breakpoint bp_site_sp at the pc.
+//
+// If the process supports it, the instruction under the breakpoint is
+// relocated into scratch memory and stepped there ("displaced stepping"),
+// so the breakpoint stays inserted and the other threads don't need to be
+// stopped. Otherwise the breakpoint is removed for the duration of the
+// step and all other threads are held.
 //----------------------------------------------------------------------
 
 ThreadPlanStepOverBreakpoint::ThreadPlanStepOverBreakpoint (Thread &thread) :
@@ -34,21 +40,48 @@ ThreadPlanStepOverBreakpoint::ThreadPlanStepOverBreakpoint (Thread &thread) :
                             // first in the thread plan stack when stepping
                             // over a breakpoint
     m_breakpoint_addr (LLDB_INVALID_ADDRESS),
-    m_auto_continue(false)
+    m_auto_continue(false),
+    m_displaced (false),
+    m_displaced_pc_set (false)
 
 {
     m_breakpoint_addr = m_thread.GetRegisterContext()->GetPC();
     m_breakpoint_site_id =  m_thread.GetProcess().GetBreakpointSiteList().FindIDByAddress (m_breakpoint_addr);
+    m_displaced_insn.scratch_addr = LLDB_INVALID_ADDRESS;
+    // The scratch copy is made when we are about to run, so we only pay for
+    // it if we actually do.
+    m_displaced = m_thread.GetProcess().SupportsDisplacedStepping();
 }
 
 ThreadPlanStepOverBreakpoint::~ThreadPlanStepOverBreakpoint ()
 {
+    // If we get discarded before the displaced step was finished, don't
+    // leave the PC inside the scratch copy and give the scratch memory back.
+    if (m_displaced_insn.scratch_addr != LLDB_INVALID_ADDRESS)
+    {
+        Process &process = m_thread.GetProcess();
+        if (process.IsAlive())
+        {
+            if (m_displaced_pc_set)
+            {
+                RegisterContext *reg_ctx = m_thread.GetRegisterContext().get();
+                const addr_t pc_addr = reg_ctx ? reg_ctx->GetPC() : LLDB_INVALID_ADDRESS;
+                if (pc_addr >= m_displaced_insn.scratch_addr && 
+                    pc_addr < m_displaced_insn.scratch_addr + m_displaced_insn.byte_size)
+                    reg_ctx->SetPC (m_breakpoint_addr);
+            }
+            process.ReleaseDisplacedStep (m_displaced_insn);
+        }
+        m_displaced_insn.scratch_addr = LLDB_INVALID_ADDRESS;
+    }
 }
 
 void
 ThreadPlanStepOverBreakpoint::GetDescription (Stream *s, lldb::DescriptionLevel level)
 {
     s->Printf("Single stepping past breakpoint site %llu at 0x%llx", m_breakpoint_site_id, (uint64_t)m_breakpoint_addr);
+    if (m_displaced && level == eDescriptionLevelVerbose)
+        s->Printf(" (displaced to 0x%llx)", (uint64_t)m_displaced_insn.scratch_addr);
 }
 
 bool
@@ -72,7 +105,12 @@ ThreadPlanStepOverBreakpoint::ShouldStop (Event *event_ptr)
 bool
 ThreadPlanStepOverBreakpoint::StopOthers ()
 {
-    return true;
+    // The breakpoint stays inserted while we step a displaced copy of the
+    // instruction, so the other threads can't run past it. This gets asked
+    // before WillResume, so the copy has to be in place by now: if it can't
+    // be made we fall back to removing the breakpoint and the other threads
+    // must be held.
+    return !PrepareDisplacedStepIfNeeded ();
 }
 
 StateType
@@ -88,9 +126,14 @@ ThreadPlanStepOverBreakpoint::WillResume (StateType resume_state, bool current_p
 
     if (current_plan)
     {
-        BreakpointSiteSP bp_site_sp (m_thread.GetProcess().GetBreakpointSiteList().FindByAddress (m_breakpoint_addr));
-        if (bp_site_sp  && bp_site_sp->IsEnabled())
-            m_thread.GetProcess().DisableBreakpoint (bp_site_sp.get());
+        // ThreadList::WillResume asked StopOthers, which normally made the
+        // copy already; this only does work if we are resumed without it.
+        if (!PrepareDisplacedStepIfNeeded ())
+        {
+            BreakpointSiteSP bp_site_sp (m_thread.GetProcess().GetBreakpointSiteList().FindByAddress (m_breakpoint_addr));
+            if (bp_site_sp  && bp_site_sp->IsEnabled())
+                m_thread.GetProcess().DisableBreakpoint (bp_site_sp.get());
+        }
     }
     return true;
 }
@@ -98,17 +141,107 @@ ThreadPlanStepOverBreakpoint::WillResume (StateType resume_state, bool current_p
 bool
 ThreadPlanStepOverBreakpoint::WillStop ()
 {
+    if (m_displaced)
+    {
+        // If we are stopping before the displaced instruction got to run, put
+        // the PC back on the breakpoint so nobody sees the scratch address.
+        if (m_displaced_pc_set && m_thread.GetRegisterContext()->GetPC() == m_displaced_insn.scratch_addr)
+        {
+            m_thread.GetRegisterContext()->SetPC (m_breakpoint_addr);
+            m_thread.GetProcess().ReleaseDisplacedStep (m_displaced_insn);
+            m_displaced_insn.scratch_addr = LLDB_INVALID_ADDRESS;
+            m_displaced_pc_set = false;
+        }
+        return true;
+    }
+
     BreakpointSiteSP bp_site_sp (m_thread.GetProcess().GetBreakpointSiteList().FindByAddress (m_breakpoint_addr));
     if (bp_site_sp)
         m_thread.GetProcess().EnableBreakpoint (bp_site_sp.get());
     return true;
 }
 
+//----------------------------------------------------------------------
+// Make the displaced copy of the instruction and point the PC at it, if
+// the process supports it and that hasn't been done yet. Returns true if
+// the thread will step the displaced copy, false if the breakpoint has to
+// be removed instead.
+//----------------------------------------------------------------------
+bool
+ThreadPlanStepOverBreakpoint::PrepareDisplacedStepIfNeeded ()
+{
+    if (m_displaced && !m_displaced_pc_set)
+    {
+        // The scratch copy is made the first time we resume, and again if
+        // we gave it back because we stopped before the step ran.
+        if (m_displaced_insn.scratch_addr == LLDB_INVALID_ADDRESS)
+            m_displaced = m_thread.GetProcess().PrepareDisplacedStep (m_breakpoint_addr, m_displaced_insn);
+        if (m_displaced)
+            m_displaced_pc_set = m_thread.GetRegisterContext()->SetPC (m_displaced_insn.scratch_addr);
+        if (!m_displaced_pc_set)
+        {
+            if (m_displaced_insn.scratch_addr != LLDB_INVALID_ADDRESS)
+                m_thread.GetProcess().ReleaseDisplacedStep (m_displaced_insn);
+            m_displaced_insn.scratch_addr = LLDB_INVALID_ADDRESS;
+            m_displaced = false;
+        }
+    }
+    return m_displaced;
+}
+
+void
+ThreadPlanStepOverBreakpoint::FinishDisplacedStep ()
+{
+    RegisterContext *reg_ctx = m_thread.GetRegisterContext().get();
+    Process &process = m_thread.GetProcess();
+    const addr_t orig_addr = m_displaced_insn.orig_addr;
+    const addr_t scratch_addr = m_displaced_insn.scratch_addr;
+
+    // Relative branches computed their target from the scratch address, and
+    // anything else that fell through is still inside the scratch copy.
+    addr_t pc_addr = reg_ctx->GetPC();
+    if (m_displaced_insn.pc_relative_branch ||
+        (pc_addr >= scratch_addr && pc_addr <= scratch_addr + m_displaced_insn.byte_size))
+    {
+        pc_addr = pc_addr - scratch_addr + orig_addr;
+        if (process.GetAddressByteSize() == 4)
+            pc_addr &= 0xffffffffull;
+        reg_ctx->SetPC (pc_addr);
+    }
+
+    // Calls pushed a return address inside the scratch copy
+    if (m_displaced_insn.pushes_return_addr)
+    {
+        Error error;
+        process.WritePointerToMemory (reg_ctx->GetSP(), orig_addr + m_displaced_insn.byte_size, error);
+    }
+
+    process.ReleaseDisplacedStep (m_displaced_insn);
+    m_displaced_insn.scratch_addr = LLDB_INVALID_ADDRESS;
+    m_displaced_pc_set = false;
+}
+
 bool
 ThreadPlanStepOverBreakpoint::MischiefManaged ()
 {
     lldb::addr_t pc_addr = m_thread.GetRegisterContext()->GetPC();
 
+    if (m_displaced)
+    {
+        // If the PC is still at the start of the scratch copy, we didn't
+        // get a chance to run yet.
+        if (!m_displaced_pc_set || pc_addr == m_displaced_insn.scratch_addr)
+            return false;
+
+        FinishDisplacedStep ();
+
+        LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_STEP));
+        if (log)
+            log->Printf("Completed displaced step over breakpoint plan, pc = 0x%llx.", (uint64_t)m_thread.GetRegisterContext()->GetPC());
+        ThreadPlan::MischiefManaged ();
+        return true;
+    }
+
     if (pc_addr == m_breakpoint_addr)
     {
         // If we are still at the PC of our breakpoint, then for some reason we didn't
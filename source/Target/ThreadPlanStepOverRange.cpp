@@ -75,6 +75,8 @@ ThreadPlanStepOverRange::PlanExplainsStop ()
         switch (reason)
         {
         case eStopReasonBreakpoint:
+            // We do explain our own next branch breakpoint
+            return NextRangeBreakpointExplainsStop (stop_info_sp);
         case eStopReasonWatchpoint:
         case eStopReasonSignal:
         case eStopReasonException:
@@ -99,6 +101,8 @@ ThreadPlanStepOverRange::ShouldStop (Event *event_ptr)
                    m_thread.GetProcess().GetTarget().GetArchitecture().GetAddressByteSize());
         log->Printf("ThreadPlanStepOverRange reached %s.", s.GetData());
     }
+
+    ClearNextBranchBreakpoint();
     
     // If we're still in the range, keep going.
     if (InRange())
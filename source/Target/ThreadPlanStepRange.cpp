@@ -15,6 +15,9 @@
 // Project includes
 
 #include "lldb/lldb-private-log.h"
+#include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Breakpoint/BreakpointSite.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Symbol/Function.h"
@@ -22,6 +25,7 @@
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
 #include "lldb/Target/StopInfo.h"
+#include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 
 using namespace lldb;
@@ -42,6 +46,8 @@ ThreadPlanStepRange::ThreadPlanStepRange (ThreadPlanKind kind,
     ThreadPlan (kind, name, thread, eVoteNoOpinion, eVoteNoOpinion),
     m_addr_context (addr_context),
     m_address_ranges (),
+    m_instruction_ranges (),
+    m_next_branch_bp_sp (),
     m_stop_others (stop_others),
     m_stack_depth (0),
     m_stack_id (),
@@ -55,6 +61,7 @@ ThreadPlanStepRange::ThreadPlanStepRange (ThreadPlanKind kind,
 
 ThreadPlanStepRange::~ThreadPlanStepRange ()
 {
+    ClearNextBranchBreakpoint();
 }
 
 bool
@@ -81,6 +88,14 @@ ThreadPlanStepRange::AddRange(const AddressRange &new_range)
     // condense the ranges if they overlap, though I don't think it is likely
     // to be very important.
     m_address_ranges.push_back (new_range);
+    m_instruction_ranges.push_back (DisassemblerSP());
+}
+
+void
+ThreadPlanStepRange::ClearRanges ()
+{
+    m_address_ranges.clear();
+    m_instruction_ranges.clear();
 }
 
 void
@@ -150,7 +165,7 @@ ThreadPlanStepRange::InRange ()
                     // But we probably don't want to be in the middle of a line range, so in that case reset the stepping
                     // range to the line we've stepped into the middle of and continue.
                     m_addr_context = new_context;
-                    m_address_ranges.clear();
+                    ClearRanges();
                     AddRange(m_addr_context.line_entry.range);
                     ret_value = true;
                     if (log)
@@ -272,9 +287,142 @@ ThreadPlanStepRange::WillStop ()
 StateType
 ThreadPlanStepRange::GetPlanRunState ()
 {
+    // If there is a branch ahead of us in the range we can run to it,
+    // otherwise we have to single step.
+    if (SetNextBranchBreakpoint())
+        return eStateRunning;
     return eStateStepping;
 }
 
+InstructionList *
+ThreadPlanStepRange::GetInstructionsForAddress (lldb::addr_t addr, size_t &range_index, size_t &insn_offset)
+{
+    Target &target = m_thread.GetProcess().GetTarget();
+    size_t num_ranges = m_address_ranges.size();
+    for (size_t i = 0; i < num_ranges; i++)
+    {
+        if (m_address_ranges[i].ContainsLoadAddress (addr, &target))
+        {
+            if (!m_instruction_ranges[i])
+            {
+                ExecutionContext exe_ctx (&m_thread.GetProcess());
+                m_instruction_ranges[i] = Disassembler::DisassembleRange (target.GetArchitecture(), 
+                                                                          NULL, 
+                                                                          exe_ctx, 
+                                                                          m_address_ranges[i]);
+            }
+            if (!m_instruction_ranges[i])
+                return NULL;
+
+            // If we aren't at the start of an instruction we're probably lost,
+            // so don't try anything fancy.
+            InstructionList &instructions = m_instruction_ranges[i]->GetInstructionList();
+            const uint32_t idx = instructions.GetIndexOfInstructionAtLoadAddress (addr, target);
+            if (idx == UINT32_MAX)
+                return NULL;
+            range_index = i;
+            insn_offset = idx;
+            return &instructions;
+        }
+    }
+    return NULL;
+}
+
+bool
+ThreadPlanStepRange::SetNextBranchBreakpoint ()
+{
+    if (m_next_branch_bp_sp)
+        return true;
+
+    Target &target = m_thread.GetProcess().GetTarget();
+    if (!target.GetUseFastStepping())
+        return false;
+
+    // We need to be sure the disassembler flags every instruction that can
+    // leave straight line code, which we only are for x86 so far.
+    switch (target.GetArchitecture().GetMachine())
+    {
+    case llvm::Triple::x86:
+    case llvm::Triple::x86_64:
+        break;
+    default:
+        return false;
+    }
+
+    lldb::addr_t cur_addr = m_thread.GetRegisterContext()->GetPC();
+    size_t range_index;
+    size_t pc_index;
+    InstructionList *instructions = GetInstructionsForAddress (cur_addr, range_index, pc_index);
+    if (instructions == NULL)
+        return false;
+
+    // Run to the next branch, or to the last instruction in the range if
+    // there are none, and single step from there.
+    uint32_t branch_index = instructions->GetIndexOfNextBranchInstruction (pc_index);
+    if (branch_index == UINT32_MAX)
+        branch_index = instructions->GetSize() - 1;
+
+    // Not worth a breakpoint if we'd only save a single step
+    if (branch_index <= pc_index + 1)
+        return false;
+
+    Address run_to_address (instructions->GetInstructionAtIndex (branch_index)->GetAddress());
+    m_next_branch_bp_sp = target.CreateBreakpoint (run_to_address, true);
+    if (!m_next_branch_bp_sp)
+        return false;
+
+    if (m_next_branch_bp_sp->GetNumResolvedLocations() == 0)
+    {
+        ClearNextBranchBreakpoint();
+        return false;
+    }
+    m_next_branch_bp_sp->SetThreadID (m_thread.GetID());
+
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_STEP));
+    if (log)
+        log->Printf ("Step range plan running from 0x%llx to branch breakpoint %d at 0x%llx, skipping %u instructions.",
+                     cur_addr,
+                     m_next_branch_bp_sp->GetID(),
+                     run_to_address.GetLoadAddress (&target),
+                     branch_index - (uint32_t)pc_index);
+    return true;
+}
+
+void
+ThreadPlanStepRange::ClearNextBranchBreakpoint ()
+{
+    if (m_next_branch_bp_sp)
+    {
+        LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_STEP));
+        if (log)
+            log->Printf ("Removing next branch breakpoint: %d.", m_next_branch_bp_sp->GetID());
+        m_thread.GetProcess().GetTarget().RemoveBreakpointByID (m_next_branch_bp_sp->GetID());
+        m_next_branch_bp_sp.reset();
+    }
+}
+
+bool
+ThreadPlanStepRange::NextRangeBreakpointExplainsStop (lldb::StopInfoSP stop_info_sp)
+{
+    if (!m_next_branch_bp_sp || !stop_info_sp)
+        return false;
+
+    BreakpointSiteSP bp_site_sp (m_thread.GetProcess().GetBreakpointSiteList().FindByID (stop_info_sp->GetValue()));
+    if (!bp_site_sp || !bp_site_sp->IsBreakpointAtThisSite (m_next_branch_bp_sp->GetID()))
+        return false;
+
+    // If a user breakpoint is at the same place, let it explain the stop.
+    // Other internal breakpoints are fine, they are probably other stepping
+    // plans stepping through the same code.
+    const uint32_t num_owners = bp_site_sp->GetNumberOfOwners();
+    for (uint32_t i = 0; i < num_owners; i++)
+    {
+        if (!bp_site_sp->GetOwnerAtIndex(i)->GetBreakpoint().IsInternal())
+            return false;
+    }
+    return true;
+}
+
 bool
 ThreadPlanStepRange::MischiefManaged ()
 {
@@ -298,6 +446,7 @@ ThreadPlanStepRange::MischiefManaged ()
 
     if (done)
     {
+        ClearNextBranchBreakpoint();
         LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_STEP));
         if (log)
             log->Printf("Completed step through range plan.");
@@ -39,3 +39,12 @@ UnwindAssembly::UnwindAssembly (const ArchSpec &arch) :
 UnwindAssembly::~UnwindAssembly ()
 {
 }
+
+bool
+UnwindAssembly::GetDisplacedInstruction (Target& target,
+                                         lldb::addr_t insn_addr,
+                                         lldb::addr_t scratch_addr,
+                                         DisplacedInstruction &displaced_insn)
+{
+    return false;
+}
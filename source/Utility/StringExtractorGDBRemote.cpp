@@ -79,6 +79,36 @@ StringExtractorGDBRemote::GetServerPacketType () const
     case 'A':
         return eServerPacketType_A;
             
+    case '?':
+        if (packet_size == 1) return eServerPacketType_stop_reason;
+        break;
+
+    case 'c':   return eServerPacketType_c;
+    case 'C':   return eServerPacketType_C;
+    case 'D':   return eServerPacketType_D;
+    case 'g':   return eServerPacketType_g;
+    case 'G':   return eServerPacketType_G;
+    case 'H':   return eServerPacketType_H;
+    case 'k':
+        if (packet_size == 1) return eServerPacketType_k;
+        break;
+    case 'm':   return eServerPacketType_m;
+    case 'M':   return eServerPacketType_M;
+    case 'p':   return eServerPacketType_p;
+    case 'P':   return eServerPacketType_P;
+    case 's':   return eServerPacketType_s;
+    case 'S':   return eServerPacketType_S;
+    case 'x':   return eServerPacketType_x;
+    case 'X':   return eServerPacketType_X;
+    case 'z':   return eServerPacketType_z;
+    case 'Z':   return eServerPacketType_Z;
+
+    case 'v':
+        if (PACKET_MATCHES ("vCont?"))                          return eServerPacketType_vCont_actions;
+        if (PACKET_STARTS_WITH ("vCont;"))                      return eServerPacketType_vCont;
+        if (PACKET_STARTS_WITH ("vAttach;"))                    return eServerPacketType_vAttach;
+        break;
+
     case 'Q':
         switch (packet_cstr[1])
         {
@@ -86,6 +116,10 @@ StringExtractorGDBRemote::GetServerPacketType () const
             if (PACKET_STARTS_WITH ("QEnvironment:"))           return eServerPacketType_QEnvironment; 
             break;
 
+        case 'T':
+            if (PACKET_MATCHES ("QThreadSuffixSupported"))      return eServerPacketType_QThreadSuffixSupported;
+            break;
+
         case 'S':
             if (PACKET_MATCHES ("QStartNoAckMode"))             return eServerPacketType_QStartNoAckMode;
             else if (PACKET_STARTS_WITH ("QSetDisableASLR:"))   return eServerPacketType_QSetDisableASLR;
@@ -102,10 +136,12 @@ StringExtractorGDBRemote::GetServerPacketType () const
         {
         case 's':
             if (PACKET_MATCHES ("qsProcessInfo"))               return eServerPacketType_qsProcessInfo;
+            if (PACKET_MATCHES ("qsThreadInfo"))                return eServerPacketType_qsThreadInfo;
             break;
 
         case 'f':
             if (PACKET_STARTS_WITH ("qfProcessInfo"))           return eServerPacketType_qfProcessInfo;
+            if (PACKET_MATCHES ("qfThreadInfo"))                return eServerPacketType_qfThreadInfo;
             break;
 
         case 'C':
@@ -129,8 +165,17 @@ StringExtractorGDBRemote::GetServerPacketType () const
             if (PACKET_STARTS_WITH ("qProcessInfoPID:"))        return eServerPacketType_qProcessInfoPID;
             break;
 
+        case 'R':
+            if (PACKET_STARTS_WITH ("qRegisterInfo"))           return eServerPacketType_qRegisterInfo;
+            break;
+
         case 'S':
             if (PACKET_STARTS_WITH ("qSpeedTest:"))             return eServerPacketType_qSpeedTest;
+            if (PACKET_MATCHES ("qShlibInfoAddr"))              return eServerPacketType_qShlibInfoAddr;
+            break;
+
+        case 'T':
+            if (PACKET_STARTS_WITH ("qThreadStopInfo"))         return eServerPacketType_qThreadStopInfo;
             break;
 
         case 'U':
@@ -180,3 +225,23 @@ StringExtractorGDBRemote::GetError ()
     }
     return 0;
 }
+
+size_t
+StringExtractorGDBRemote::GetEscapedBinaryData (void *dst_void, size_t dst_len)
+{
+    uint8_t *dst = (uint8_t *)dst_void;
+    size_t bytes_extracted = 0;
+    while (bytes_extracted < dst_len && GetBytesLeft ())
+    {
+        char ch = m_packet[m_index++];
+        if (ch == 0x7d)
+        {
+            // The next byte was escaped by XOR'ing it with 0x20
+            if (GetBytesLeft () == 0)
+                break;
+            ch = m_packet[m_index++] ^ 0x20;
+        }
+        dst[bytes_extracted++] = ch;
+    }
+    return bytes_extracted;
+}
@@ -63,7 +63,36 @@ public:
         eServerPacketType_QSetSTDOUT,
         eServerPacketType_QSetSTDERR,
         eServerPacketType_QSetWorkingDir,
-        eServerPacketType_QStartNoAckMode
+        eServerPacketType_QStartNoAckMode,
+        eServerPacketType_QThreadSuffixSupported,
+
+        // Process debugging packets
+        eServerPacketType_stop_reason, // '?'
+        eServerPacketType_c,
+        eServerPacketType_C,
+        eServerPacketType_D,
+        eServerPacketType_g,
+        eServerPacketType_G,
+        eServerPacketType_H,
+        eServerPacketType_k,
+        eServerPacketType_m,
+        eServerPacketType_M,
+        eServerPacketType_p,
+        eServerPacketType_P,
+        eServerPacketType_s,
+        eServerPacketType_S,
+        eServerPacketType_x,
+        eServerPacketType_X,
+        eServerPacketType_z,
+        eServerPacketType_Z,
+        eServerPacketType_qfThreadInfo,
+        eServerPacketType_qsThreadInfo,
+        eServerPacketType_qRegisterInfo,
+        eServerPacketType_qShlibInfoAddr,
+        eServerPacketType_qThreadStopInfo,
+        eServerPacketType_vAttach,
+        eServerPacketType_vCont,
+        eServerPacketType_vCont_actions // vCont?
     };
     
     ServerPacketType
@@ -98,6 +127,12 @@ public:
     // digits. Otherwise the error encoded in XX is returned.
     uint8_t
     GetError();
+
+    // Decode binary data from the current file position to the end of the
+    // packet, undoing the '}' escapes used by the 'x' and 'X' packets.
+    // Returns the number of bytes stored in "dst".
+    size_t
+    GetEscapedBinaryData (void *dst, size_t dst_len);
 };
 
 #endif  // utility_StringExtractorGDBRemote_h_
@@ -55,6 +55,7 @@
 #include "Plugins/DynamicLoader/POSIX-DYLD/DynamicLoaderPOSIXDYLD.h"
 #include "Plugins/Platform/Linux/PlatformLinux.h"
 #include "Plugins/Process/Linux/ProcessLinux.h"
+#include "Plugins/SymbolVendor/ELF/SymbolVendorELF.h"
 #endif
 
 #if defined (__FreeBSD__)
@@ -62,6 +63,7 @@
 #include "Plugins/Platform/FreeBSD/PlatformFreeBSD.h"
 #include "Plugins/Process/POSIX/ProcessPOSIX.h"
 #include "Plugins/Process/FreeBSD/ProcessFreeBSD.h"
+#include "Plugins/SymbolVendor/ELF/SymbolVendorELF.h"
 #endif
 
 #include "Plugins/Platform/gdb-server/PlatformRemoteGDBServer.h"
@@ -124,11 +126,13 @@ lldb_private::Initialize ()
         PlatformLinux::Initialize();
         ProcessLinux::Initialize();
         DynamicLoaderPOSIXDYLD::Initialize();
+        SymbolVendorELF::Initialize();
 #endif
 #if defined (__FreeBSD__)
         PlatformFreeBSD::Initialize();
         ProcessFreeBSD::Initialize();
         DynamicLoaderPOSIXDYLD::Initialize();
+        SymbolVendorELF::Initialize();
 #endif
         //----------------------------------------------------------------------
         // Platform agnostic plugins
@@ -196,12 +200,14 @@ lldb_private::Terminate ()
     PlatformLinux::Terminate();
     ProcessLinux::Terminate();
     DynamicLoaderPOSIXDYLD::Terminate();
+    SymbolVendorELF::Terminate();
 #endif
 
 #if defined (__FreeBSD__)
     PlatformFreeBSD::Terminate();
     ProcessFreeBSD::Terminate();
     DynamicLoaderPOSIXDYLD::Terminate();
+    SymbolVendorELF::Terminate();
 #endif
     
     DynamicLoaderStatic::Terminate();
@@ -0,0 +1,57 @@
+"""Time how quickly lldb emulates the ARM and Thumb instructions in the
+arm_emulation test suite, checking along the way that every one of them
+still emulates correctly."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ARMEmulationThroughputBench(BenchBase):
+
+    mydir = os.path.join("benchmarks", "arm_emulation")
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.test_dir = os.path.join(os.getcwd(), os.pardir, os.pardir, "arm_emulation", "new-test-files")
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+
+    @benchmarks_test
+    def test_arm_emulation_throughput(self):
+        """Emulate every ARM test instruction repeatedly."""
+        print
+        self.run_emulations('-arm.dat', self.count)
+        print "ARM emulation benchmark:", self.stopwatch
+
+    @benchmarks_test
+    def test_thumb_emulation_throughput(self):
+        """Emulate every Thumb test instruction repeatedly."""
+        print
+        self.run_emulations('-thumb.dat', self.count)
+        print "Thumb emulation benchmark:", self.stopwatch
+
+    def run_emulations(self, suffix, count):
+        test_files = [os.path.join(self.test_dir, f) for f in os.listdir(self.test_dir) if suffix in f]
+        self.assertTrue(len(test_files) > 0, "No emulation test files found")
+
+        insn = lldb.SBInstruction()
+        self.stopwatch.reset()
+        for i in range(count):
+            with self.stopwatch:
+                for test_file in test_files:
+                    stream = lldb.SBStream()
+                    success = insn.TestEmulation(stream, test_file)
+                    if not success:
+                        print stream.GetData()
+                    self.assertTrue(success, 'Emulation test %s failed.' % os.path.basename(test_file))
+
+        if self.TraceOn():
+            print "%d instructions per iteration" % len(test_files)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -33,6 +33,76 @@ class RepeatedExprsCase(BenchBase):
         print "gdb benchmark:", self.stopwatch
         print "lldb_avg/gdb_avg: %f" % (self.lldb_avg/self.gdb_avg)
 
+    @benchmarks_test
+    def test_compiled_exprs_lldb(self):
+        """Test repeated expressions that lldb has to compile, comparing the first evaluation against later ones."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        first_stopwatch = self.run_lldb_compiled_exprs(self.exe_name, self.count)
+        print "lldb first evaluation benchmark:", first_stopwatch
+        print "lldb repeated evaluation benchmark:", self.stopwatch
+        print "repeated_avg/first_avg: %f" % (self.stopwatch.avg()/first_stopwatch.avg())
+
+    def run_lldb_compiled_exprs(self, exe_name, count):
+        """Returns the stopwatch for the first evaluation; self.stopwatch times the rest."""
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbExec, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+        # Unlike the member accesses above, these can't be evaluated as
+        # variable paths, so they go through the expression parser and JIT.
+        # Only the first evaluation has to compile them.
+        expr_cmd1 = 'expr ptr[j]->point.x + ptr[j]->point.y'
+        expr_cmd2 = 'expr ptr[j]->point.x * ptr[j]->id'
+
+        first_stopwatch = Stopwatch()
+        with first_stopwatch:
+            child.sendline(expr_cmd1)
+            child.expect_exact(prompt)
+            child.sendline(expr_cmd2)
+            child.expect_exact(prompt)
+        child.sendline('process continue')
+        child.expect_exact(prompt)
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        for i in range(count):
+            with self.stopwatch:
+                child.sendline(expr_cmd1)
+                child.expect_exact(prompt)
+                child.sendline(expr_cmd2)
+                child.expect_exact(prompt)
+            child.sendline('process continue')
+            child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        if self.TraceOn():
+            print "lldb compiled expression benchmark:", str(self.stopwatch)
+        self.child = None
+        return first_stopwatch
+
     def run_lldb_repeated_exprs(self, exe_name, count):
         exe = os.path.join(os.getcwd(), exe_name)
 
@@ -0,0 +1,136 @@
+"""Test the gdb-remote packet transport speed using 'process plugin packet speed-test'."""
+
+import os, sys
+import random
+import json
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+
+class PacketSpeedBench(BenchBase):
+
+    mydir = os.path.join("benchmarks", "packet_speed")
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        if lldb.bmExecutable:
+            self.exe = lldb.bmExecutable
+        else:
+            self.exe = self.lldbHere
+        if lldb.bmBreakpointSpec:
+            self.break_spec = lldb.bmBreakpointSpec
+        else:
+            self.break_spec = '-n main'
+
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 1000
+
+    @benchmarks_test
+    def test_packet_speed(self):
+        """Test the round trip latencies of the gdb-remote packet transport."""
+        print
+        results = self.run_packet_speed_bench(self.exe, self.break_spec, self.count)
+        self.print_results(results)
+
+    @benchmarks_test
+    def test_platform_packet_speed(self):
+        """Test the round trip latencies to an lldb-platform on the loopback interface."""
+        platform = os.path.join(os.path.dirname(self.lldbHere), 'lldb-platform')
+        if not os.path.exists(platform):
+            self.skipTest("lldb-platform was not found next to '%s'" % self.lldbHere)
+        print
+        results = self.run_platform_packet_speed_bench(platform, self.count)
+        self.print_results(results)
+
+    def print_results(self, results):
+        for result in results:
+            print "%(packet)s(send=%(send_size)u, recv=%(recv_size)u): p50=%(p50_nsec)u ns, p99=%(p99_nsec)u ns, max=%(max_nsec)u ns" % result
+
+    def check_results(self, output, count):
+        results = json.loads(output[output.index('{'):output.rindex('}') + 1])['packet_speed_test']
+        self.assertTrue(len(results) > 0)
+        for result in results:
+            self.assertTrue(result['count'] == count)
+            self.assertTrue(result['min_nsec'] <= result['p50_nsec'] <= result['p99_nsec'] <= result['max_nsec'])
+        return results
+
+    def run_packet_speed_bench(self, exe, break_spec, count):
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbHere, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        # Set our breakpoint.
+        child.sendline('breakpoint set %s' % break_spec)
+        child.expect_exact(prompt)
+
+        # Run the target and expect it to be stopped due to breakpoint.
+        child.sendline('run') # Aka 'process launch'.
+        child.expect_exact(prompt)
+
+        child.sendline('process plugin packet speed-test --json --count %d' % count)
+        child.expect_exact(prompt)
+        results = self.check_results(child.before, count)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+        return results
+
+    def run_platform_packet_speed_bench(self, platform, count):
+        # Serve the platform on the loopback interface.
+        port = 12000 + random.randint(0, 3999)
+        server = pexpect.spawn('%s --listen localhost:%d' % (platform, port))
+        server.expect('Listening for a connection')
+
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        self.child = pexpect.spawn('%s %s' % (self.lldbHere, self.lldbOption))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.sendline('platform select remote-gdb-server')
+        child.expect_exact(prompt)
+        child.sendline('platform connect connect://localhost:%d' % port)
+        child.expect_exact(prompt)
+
+        child.sendline('platform plugin packet speed-test --json --count %d' % count)
+        child.expect_exact(prompt)
+        results = self.check_results(child.before, count)
+
+        child.sendline('platform disconnect')
+        child.expect_exact(prompt)
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+        self.child = None
+        server.close(force=True)
+        return results
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
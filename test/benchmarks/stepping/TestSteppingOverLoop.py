@@ -0,0 +1,103 @@
+"""Test the speed of stepping over a source line that contains a tight loop."""
+
+import os, sys
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+
+class SteppingOverLoopBench(BenchBase):
+
+    mydir = os.path.join("benchmarks", "stepping")
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 10
+
+    @benchmarks_test
+    def test_stepping_over_loop(self):
+        """Test stepping over a line with a tight loop, with and without fast stepping."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        for use_fast_stepping in ['false', 'true']:
+            stops = self.run_stepping_over_loop_bench(self.exe_name, self.count, use_fast_stepping)
+            print "lldb stepping over loop benchmark (use-fast-stepping=%s): %s" % (use_fast_stepping, self.stopwatch)
+            print "stops per step over (use-fast-stepping=%s): %d" % (use_fast_stepping, stops)
+
+    def run_stepping_over_loop_bench(self, exe_name, count, use_fast_stepping):
+        """Returns the number of times the stepping plan stopped while stepping over the loop once."""
+        exe = os.path.join(os.getcwd(), exe_name)
+        log_file = os.path.join(os.getcwd(), 'step-%s.log' % use_fast_stepping)
+        if os.path.exists(log_file):
+            os.remove(log_file)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbExec, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('settings set target.use-fast-stepping %s' % use_fast_stepping)
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        # Count the stops for one step over the loop with step logging on,
+        # each stop logs one "reached" line.
+        child.sendline('next')
+        child.expect_exact(prompt)
+        child.sendline('log enable -f %s lldb step' % log_file)
+        child.expect_exact(prompt)
+        child.sendline('next')
+        child.expect_exact(prompt)
+        child.sendline('log disable lldb step')
+        child.expect_exact(prompt)
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        for i in range(count):
+            child.sendline('process continue')
+            child.expect_exact(prompt)
+            child.sendline('next')
+            child.expect_exact(prompt)
+            with self.stopwatch:
+                # Step over the loop.
+                child.sendline('next')
+                child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        self.child = None
+
+        stops = 0
+        with open(log_file, 'r') as f:
+            for line in f:
+                if 'ThreadPlanStepOverRange reached' in line:
+                    stops += 1
+        return stops
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,21 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int main (int argc, char const *argv[])
+{
+    unsigned long total = 0;
+    for (int iteration = 0; iteration < 100000; ++iteration)
+    {
+        total += iteration; // Set breakpoint here.
+        for (int i = 0; i < 1000; ++i) total += (i ^ iteration) & 0xff; // Step over this loop.
+    }
+    printf ("total = %lu\n", total);
+    return 0;
+}
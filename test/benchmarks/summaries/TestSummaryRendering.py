@@ -0,0 +1,84 @@
+"""Test the throughput of rendering string summaries with 'frame variable'."""
+
+import os, sys
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+
+class SummaryRenderingBench(BenchBase):
+
+    mydir = os.path.join("benchmarks", "summaries")
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+
+    @benchmarks_test
+    def test_summary_rendering(self):
+        """Test the time it takes to print 1000 structs that have string summaries."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_summary_rendering_bench(self.exe_name, self.count)
+        print "lldb summary rendering benchmark:", self.stopwatch
+        print "summaries per second: %f" % (1000.0 / self.stopwatch.avg())
+
+    def run_summary_rendering_bench(self, exe_name, count):
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbExec, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        # Summaries with format descriptors, scopes and escapes, so all of
+        # the format string features get exercised.
+        child.sendline('type summary add --summary-string "(${var.x%x}, ${var.y})" Point')
+        child.expect_exact(prompt)
+        child.sendline('type summary add --summary-string "id = ${var.id}{, name = ${var.name%s}}\\tpoint = ${var.point}" Data')
+        child.expect_exact(prompt)
+        child.sendline('settings set target.max-children-count 1000')
+        child.expect_exact(prompt)
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        for i in range(count):
+            with self.stopwatch:
+                child.sendline('frame variable data')
+                child.expect_exact(prompt)
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
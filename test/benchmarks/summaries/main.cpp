@@ -0,0 +1,33 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+struct Point {
+    int x;
+    int y;
+};
+
+struct Data {
+    int id;
+    Point point;
+    const char *name;
+};
+
+int main(int argc, char const *argv[]) {
+    Data data[1000];
+    for (int i = 0; i < 1000; ++i) {
+        data[i].id = i;
+        data[i].point.x = i;
+        data[i].point.y = i+1;
+        data[i].name = "data";
+    }
+
+    printf("Finished populating data.\n"); // Set breakpoint here.
+    return 0;
+}
@@ -0,0 +1,92 @@
+"""Test how long it takes to stop and resume an inferior with many threads."""
+
+import os, sys
+import unittest2
+import lldb
+import pexpect
+from lldbbench import *
+
+class ManyThreadsStopBench(BenchBase):
+
+    mydir = os.path.join("benchmarks", "threads")
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.source = 'main.cpp'
+        self.line_to_break = line_number(self.source, '// Set breakpoint here.')
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 20
+
+    @benchmarks_test
+    def test_many_threads_stop(self):
+        """Test continuing to a breakpoint, and stepping off it, while 100 other threads spin."""
+        self.buildDefault()
+        self.exe_name = 'a.out'
+
+        print
+        self.run_many_threads_stop_bench(self.exe_name, self.count)
+        print "lldb continue to breakpoint with 101 threads:", self.continue_stopwatch
+        print "lldb step off breakpoint with 101 threads:", self.step_stopwatch
+
+    def run_many_threads_stop_bench(self, exe_name, count):
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        # Set self.child_prompt, which is "(lldb) ".
+        self.child_prompt = '(lldb) '
+        prompt = self.child_prompt
+
+        # So that the child gets torn down after the test.
+        self.child = pexpect.spawn('%s %s %s' % (self.lldbExec, self.lldbOption, exe))
+        child = self.child
+
+        # Turn on logging for what the child sends back.
+        if self.TraceOn():
+            child.logfile_read = sys.stdout
+
+        child.expect_exact(prompt)
+        child.sendline('breakpoint set -f %s -l %d' % (self.source, self.line_to_break))
+        child.expect_exact(prompt)
+        child.sendline('run')
+        child.expect_exact(prompt)
+
+        # Every thread must be stopped and listed at each stop.
+        child.sendline('thread list')
+        child.expect_exact(prompt)
+        self.assertTrue(child.before.count('thread #') == 101,
+                        "Expected the main thread and 100 spinning threads")
+
+        # Each continue stops all 100 spinning threads again.  Each step
+        # off the breakpoint runs the stepping thread alone while the others
+        # stay suspended, which must not leave the stop waiting on them.
+        self.continue_stopwatch = Stopwatch()
+        self.step_stopwatch = Stopwatch()
+        for i in range(count):
+            with self.continue_stopwatch:
+                child.sendline('process continue')
+                child.expect_exact(prompt)
+            with self.step_stopwatch:
+                child.sendline('thread step-inst')
+                child.expect_exact(prompt)
+
+        child.sendline('thread list')
+        child.expect_exact(prompt)
+        self.assertTrue(child.before.count('thread #') == 101,
+                        "All threads should still be traced after %d stops" % (2 * count))
+
+        child.sendline('quit')
+        try:
+            self.child.expect(pexpect.EOF)
+        except:
+            pass
+
+        # The test is about to end and if we come to here, the child process has
+        # been terminated.  Mark it so.
+        self.child = None
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
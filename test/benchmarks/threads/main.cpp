@@ -0,0 +1,48 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <pthread.h>
+#include <stdio.h>
+
+#define NUM_THREADS 100
+
+static volatile int g_running = 1;
+static volatile unsigned g_spins[NUM_THREADS];
+
+static void *
+spin (void *arg)
+{
+    volatile unsigned *spins = (volatile unsigned *)arg;
+    while (g_running)
+        ++*spins;
+    return NULL;
+}
+
+static int
+stop_here (int i)
+{
+    return i + 1; // Set breakpoint here.
+}
+
+int
+main (int argc, char const *argv[])
+{
+    pthread_t threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; ++i)
+        ::pthread_create (&threads[i], NULL, spin, (void *)&g_spins[i]);
+
+    int sum = 0;
+    for (int i = 0; i < 1000000; ++i)
+        sum = stop_here (sum);
+
+    g_running = 0;
+    for (int i = 0; i < NUM_THREADS; ++i)
+        ::pthread_join (threads[i], NULL);
+    printf ("sum = %d\n", sum);
+    return 0;
+}
@@ -0,0 +1,92 @@
+"""
+Test expressions that the IR interpreter evaluates without running the inferior.
+"""
+
+import os
+import unittest2
+import lldb
+import lldbutil
+from lldbtest import *
+
+class ExprInterpreterTestCase(TestBase):
+
+    mydir = os.path.join("expression_command", "interpreter")
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break for main.c.
+        self.line = line_number('main.c',
+                                '// Please test these expressions while stopped at this line:')
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    def test_with_dsym(self):
+        """Test integer, floating-point, and conditional expressions."""
+        self.buildDsym()
+        self.interpreted_exprs()
+
+    def test_with_dwarf(self):
+        """Test integer, floating-point, and conditional expressions."""
+        self.buildDwarf()
+        self.interpreted_exprs()
+
+    def interpreted_exprs(self):
+        """Test integer, floating-point, and conditional expressions."""
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: file ='main.c', line = %d" %
+                        self.line)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # Signed and unsigned division, remainders, and shifts.
+        self.expect("expression i / 2",
+            substrs = ['(int)', '= -3'])
+        self.expect("expression i % 3",
+            substrs = ['(int)', '= -1'])
+        self.expect("expression i >> 1",
+            substrs = ['(int)', '= -4'])
+        self.expect("expression u >> 2",
+            substrs = ['(unsigned int)', '= 25'])
+        self.expect("expression (i & 0xf) | 0x10",
+            substrs = ['(int)', '= 25'])
+        self.expect("expression i ^ 1",
+            substrs = ['(int)', '= -8'])
+        self.expect("expression (long long)i",
+            substrs = ['(long long)', '= -7'])
+
+        # Comparisons, short-circuit operators, and the conditional operator.
+        self.expect("expression i < 0 && u > 50",
+            substrs = ['(int)', '= 1'])
+        self.expect("expression i < 0 ? u : 0u",
+            substrs = ['(unsigned int)', '= 100'])
+
+        # Floating point arithmetic, comparisons, and conversions.
+        self.expect("expression f * 2",
+            substrs = ['(float)', '= 5'])
+        self.expect("expression d + f",
+            substrs = ['(double)', '= 1.25'])
+        self.expect("expression f > d",
+            substrs = ['(int)', '= 1'])
+        self.expect("expression (int)(d * 4)",
+            substrs = ['(int)', '= -5'])
+
+        # Structure members read from the inferior.
+        self.expect("expression p.x * p.x + p.y * p.y",
+            substrs = ['(int)', '= 25'])
+
+        # An expression that fails after writing to the inferior is not run
+        # again in the JIT, so the write happens once and the division by
+        # zero never reaches the inferior.
+        self.expect("expression (i = 5) / (int)(u - u)", error=True,
+            substrs = ["modified the process's memory"])
+        self.expect("expression i",
+            substrs = ['(int)', '= 5'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
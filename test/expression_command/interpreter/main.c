@@ -0,0 +1,24 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+struct point
+{
+    int x;
+    int y;
+};
+
+int main (int argc, char const *argv[])
+{
+    int i = -7;
+    unsigned int u = 100;
+    float f = 2.5f;
+    double d = -1.25;
+    struct point p = { 3, 4 };
+    return 0; // Please test these expressions while stopped at this line:
+}
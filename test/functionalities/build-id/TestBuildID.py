@@ -0,0 +1,74 @@
+"""
+Test that ELF modules get their UUID from the GNU build ID note, that copies
+of the same file keep their own modules and that modules are found by UUID.
+"""
+
+import os, re, shutil
+import subprocess
+import unittest2
+import lldb
+from lldbtest import *
+
+class BuildIDTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "build-id")
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @python_api_test
+    def test_with_dwarf(self):
+        """Test that the module UUID is the build ID and that modules are found by UUID."""
+        self.buildDwarf()
+        self.build_id_uuid()
+
+    def build_id_uuid(self):
+        """Compare the module UUID against the build ID reported by readelf."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        try:
+            notes = subprocess.Popen(["readelf", "-n", exe], stdout=subprocess.PIPE).communicate()[0]
+        except OSError:
+            self.skipTest("readelf not available")
+        match = re.search("Build ID: ([0-9a-fA-F]+)", notes)
+        if not match:
+            self.skipTest("a.out has no build ID note")
+        build_id = match.group(1).lower()
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        module = target.GetModuleAtIndex(0)
+        self.assertTrue(module.IsValid())
+
+        uuid = module.GetUUIDString()
+        self.assertTrue(uuid, "a.out should have a UUID")
+        self.assertTrue(uuid.replace("-", "").lower() == build_id,
+                        "UUID %s should match build ID %s" % (uuid, build_id))
+
+        # A copy of a.out in another directory has the same build ID, but it
+        # was asked for by path, so it gets a module of its own.
+        copy_dir = os.path.join(os.getcwd(), "copy")
+        if not os.path.isdir(copy_dir):
+            os.mkdir(copy_dir)
+        self.addTearDownHook(lambda: shutil.rmtree(copy_dir))
+        copy_exe = os.path.join(copy_dir, "a.out")
+        shutil.copy(exe, copy_exe)
+
+        copy_target = self.dbg.CreateTarget(copy_exe)
+        self.assertTrue(copy_target, VALID_TARGET)
+        copy_module = copy_target.GetModuleAtIndex(0)
+        self.assertTrue(copy_module.GetUUIDString() == uuid)
+        self.assertTrue(copy_module.GetFileSpec().GetDirectory() == copy_dir,
+                        "a file found by path should not be swapped for one from another directory")
+
+        # A lookup by UUID alone is satisfied by a module that is already
+        # loaded with that UUID.
+        uuid_target = self.dbg.CreateTarget("")
+        self.assertTrue(uuid_target, VALID_TARGET)
+        uuid_module = uuid_target.AddModule(None, None, uuid)
+        self.assertTrue(uuid_module.IsValid(), "a module should be found by its UUID")
+        self.assertTrue(uuid_module.GetUUIDString() == uuid)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,97 @@
+"""
+Test the built-in synthetic children for libstdc++ containers.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class StlNativeDataFormatterTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "data-formatter", "data-formatter-stl-native")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    def test_with_dsym_and_run_command(self):
+        """Test the native std::vector, std::list and std::map formatters."""
+        self.buildDsym()
+        self.data_formatter_commands()
+
+    def test_with_dwarf_and_run_command(self):
+        """Test the native std::vector, std::list and std::map formatters."""
+        self.buildDwarf()
+        self.data_formatter_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break at.
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def data_formatter_commands(self):
+        """Test that libstdc++ containers show their elements as children."""
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.cpp -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: file ='main.cpp', line = %d, locations = 1" %
+                        self.line)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        # This is the function to remove the custom formats in order to have a
+        # clean slate for the next test case.
+        def cleanup():
+            self.runCmd('type synth clear', check=False)
+
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        # The built-in providers are native, not Python classes
+        self.expect("type synth list",
+                    substrs = ['libstdc++ std::vector synthetic children',
+                               'libstdc++ std::list synthetic children',
+                               'libstdc++ std::map synthetic children'])
+
+        self.expect("frame variable numbers",
+                    substrs = ['[0] = 0',
+                               '[1] = 11',
+                               '[4] = 44'])
+        self.expect("frame variable numbers[3]",
+                    substrs = ['33'])
+
+        self.expect("frame variable numbers_list",
+                    substrs = ['[0] = 0',
+                               '[2] = 6',
+                               '[4] = 12'])
+        self.expect("frame variable numbers_list", matching=False,
+                    substrs = ['[5]'])
+
+        # std::map children come out in key order
+        self.expect("frame variable names",
+                    substrs = ['[0] = {',
+                               'first = 1',
+                               'second = "one"',
+                               '[2] = {',
+                               'first = 3',
+                               'second = "three"'])
+
+        # A Python provider in the default category overrides the built-in one
+        self.runCmd("type synth add -l gnu_libstdcpp.StdVectorSynthProvider -x \"^(std::)?vector<.+>$\"")
+        self.expect("frame variable numbers",
+                    substrs = ['[0] = 0',
+                               '[4] = 44'])
+        self.expect("type synth list",
+                    substrs = ['Python class gnu_libstdcpp.StdVectorSynthProvider'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,35 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::vector<int> int_vect;
+typedef std::list<int> int_list;
+typedef std::map<int, std::string> int_string_map;
+
+int main()
+{
+    int_vect numbers;
+    int_list numbers_list;
+    int_string_map names;
+
+    for (int i = 0; i < 5; i++)
+    {
+        numbers.push_back(i * 11);
+        numbers_list.push_back(i * 3);
+    }
+    names[3] = "three";
+    names[1] = "one";
+    names[2] = "two";
+
+    return 0; // Set break point at this line.
+}
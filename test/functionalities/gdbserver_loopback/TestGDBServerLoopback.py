@@ -0,0 +1,94 @@
+"""
+Test debugging a process through lldb-gdbserver over a loopback connection.
+"""
+
+import os
+import unittest2
+import lldb
+import pexpect
+from lldbtest import *
+
+class GDBServerLoopbackTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "gdbserver_loopback")
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_with_dwarf_and_run_command(self):
+        """Test breakpoints, stepping and memory access through lldb-gdbserver."""
+        self.buildDwarf()
+        self.gdbserver_loopback()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside bump().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def gdbserver_loopback(self):
+        """Launch a.out under lldb-gdbserver and debug it with 'process connect'."""
+        if not self.lldbExec:
+            self.skipTest("lldb executable not known")
+        gdbserver = os.path.join(os.path.dirname(self.lldbExec), "lldb-gdbserver")
+        if not os.path.exists(gdbserver):
+            self.skipTest("lldb-gdbserver not built")
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # Start the stub with the inferior stopped at its first instruction.
+        server = pexpect.spawn('%s localhost:12346 %s' % (gdbserver, exe))
+        if self.TraceOn():
+            server.logfile_read = sys.stdout
+
+        def shutdown_server():
+            server.close()
+        self.addTearDownHook(shutdown_server)
+
+        server.expect_exact('Listening for a connection on localhost:12346')
+
+        self.runCmd("process connect connect://localhost:12346")
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: file ='main.c', line = %d, locations = 1" %
+                        self.line)
+
+        self.runCmd("continue", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        # Expedited registers and memory reads give us the frame and globals.
+        self.expect("frame variable amount", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) amount = 1'])
+        self.expect("expression g_counter", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['= 1'])
+
+        # Writing memory goes through the stub as well.
+        self.runCmd("expression g_counter = 10")
+
+        # Continuing steps over the breakpoint and stops at the next hit.
+        self.runCmd("continue", RUN_SUCCEEDED)
+        self.expect("frame variable amount", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) amount = 2'])
+        self.expect("expression g_counter", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['= 12'])
+
+        # Single step by instruction.
+        self.runCmd("thread step-inst")
+        self.expect("thread list", "Process should be stopped after the step",
+            substrs = ['stopped'])
+
+        self.runCmd("breakpoint delete 1")
+        self.runCmd("continue")
+        self.expect("process status",
+            substrs = ['exited with status = 0'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
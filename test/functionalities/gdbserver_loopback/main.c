@@ -0,0 +1,28 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int g_counter = 0;
+
+int
+bump (int amount)
+{
+    g_counter += amount;
+    return g_counter; // Set break point at this line.
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int i;
+    for (i = 1; i <= 3; ++i)
+        bump (i);
+    printf ("g_counter = %d\n", g_counter);
+    return 0;
+}
@@ -0,0 +1,98 @@
+"""
+Test that symbols of a stripped shared library are found through its
+.gnu.hash section, and that PLT trampolines still come from the symbol table.
+"""
+
+import os
+import unittest2
+import lldb
+from lldbtest import *
+
+class GNUHashTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "gnu-hash")
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_breakpoint_by_name(self):
+        """Test setting a breakpoint on a code symbol found through .gnu.hash."""
+        self.buildDefault()
+        self.breakpoint_by_name()
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_step_through_trampoline(self):
+        """Test stepping through a PLT trampoline into a stripped library."""
+        self.buildDefault()
+        self.step_through_trampoline()
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    def test_data_symbol(self):
+        """Test evaluating a data symbol found through .gnu.hash."""
+        self.buildDefault()
+        self.data_symbol()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def run_to_main_line(self):
+        """Launch a.out and stop at the call into the stripped library."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line, BREAKPOINT_CREATED,
+            startstr = "Breakpoint created")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+    def breakpoint_by_name(self):
+        """The library has no .symtab, so the name is resolved through the
+        hashed code symbol lookup once the library is loaded."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.runCmd("breakpoint set -n gnuhash_function")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        self.expect("thread backtrace", "Stopped in the stripped library",
+            substrs = ['libgnuhash.so`gnuhash_function'])
+
+        self.expect("breakpoint list -f", BREAKPOINT_HIT_ONCE,
+            substrs = [' resolved, hit count = 1'])
+
+    def step_through_trampoline(self):
+        """The call goes through the PLT trampoline in a.out, which is found
+        in its symbol table, to the code symbol in the library, which is
+        found through the hash table."""
+        self.run_to_main_line()
+
+        self.runCmd("thread step-in")
+
+        self.expect("thread backtrace", "Stepped into the stripped library",
+            substrs = ['libgnuhash.so`gnuhash_function'])
+
+    def data_symbol(self):
+        """The library has no debug info, so the variable comes from its
+        data symbol."""
+        self.run_to_main_line()
+
+        self.expect("expression *(int *)&gnuhash_data", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['= 42'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,7 @@
+int gnuhash_data = 42;
+
+int
+gnuhash_function (int value)
+{
+    return value + gnuhash_data;
+}
@@ -0,0 +1,11 @@
+#include <stdio.h>
+
+extern int gnuhash_function (int value);
+
+int
+main (int argc, char const *argv[])
+{
+    int result = gnuhash_function (argc); // Set break point at this line.
+    printf ("result = %d\n", result);
+    return 0;
+}
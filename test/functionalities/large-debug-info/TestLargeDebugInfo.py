@@ -0,0 +1,173 @@
+"""
+Test that a .debug_info section larger than 4GB is parsed with 64 bit offsets.
+
+The test writes a sparse ELF file whose .debug_info section is a little over
+4GB, so it takes almost no disk space. The section is mostly padding compile
+units. The first unit defines 'first_int'. The last unit starts 4 bytes
+before the 4GB mark, so the rest of its header and its DIEs lie past 2^32.
+It defines 'second_int'.
+"""
+
+import os, struct
+import unittest2
+import lldb
+from lldbtest import *
+
+# DWARF constants used by the generated debug info
+DW_TAG_compile_unit = 0x11
+DW_TAG_base_type = 0x24
+DW_AT_name = 0x03
+DW_AT_byte_size = 0x0b
+DW_AT_language = 0x13
+DW_AT_encoding = 0x3e
+DW_FORM_data1 = 0x0b
+DW_FORM_string = 0x08
+DW_ATE_signed = 0x05
+DW_LANG_C89 = 0x01
+
+# Where the compile units start in .debug_info
+PADDING_UNIT_SIZE = 256 * 1024 * 1024
+LAST_UNIT_OFFSET = 2**32 - 4
+UNIT_OFFSETS = range(0, LAST_UNIT_OFFSET, PADDING_UNIT_SIZE) + [LAST_UNIT_OFFSET]
+
+# File layout of the generated ELF file
+SECTION_HEADERS_OFFSET = 64
+SHSTRTAB_OFFSET = 512
+DEBUG_ABBREV_OFFSET = 1024
+DEBUG_INFO_OFFSET = 4096
+
+class LargeDebugInfoTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "large-debug-info")
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @python_api_test
+    def test_large_debug_info(self):
+        """Test parsing a .debug_info section that is larger than 4GB."""
+        self.large_debug_info()
+
+    def debug_abbrev(self):
+        """Return the contents of .debug_abbrev."""
+        return (struct.pack("<BBB", 1, DW_TAG_compile_unit, 1) +
+                struct.pack("<BB", DW_AT_name, DW_FORM_string) +
+                struct.pack("<BB", DW_AT_language, DW_FORM_data1) +
+                struct.pack("<BB", 0, 0) +
+                struct.pack("<BBB", 2, DW_TAG_base_type, 0) +
+                struct.pack("<BB", DW_AT_name, DW_FORM_string) +
+                struct.pack("<BB", DW_AT_encoding, DW_FORM_data1) +
+                struct.pack("<BB", DW_AT_byte_size, DW_FORM_data1) +
+                struct.pack("<BB", 0, 0) +
+                struct.pack("<B", 0))
+
+    def compile_unit(self, unit_size, name, base_type=None):
+        """Return a compile unit of unit_size bytes, header included, named
+        name. Only its DIEs are returned, the caller leaves the rest of the
+        unit as zero padding."""
+        dies = struct.pack("<B", 1) + name + "\0" + struct.pack("<B", DW_LANG_C89)
+        if base_type:
+            (type_name, byte_size) = base_type
+            dies += struct.pack("<B", 2) + type_name + "\0" + struct.pack("<BB", DW_ATE_signed, byte_size)
+        dies += struct.pack("<B", 0)
+        if unit_size is None:
+            unit_size = 11 + len(dies)
+        # Version 2 header: length, version, abbrev offset and address size.
+        return struct.pack("<IHIB", unit_size - 4, 2, 0, 8) + dies
+
+    def write_elf_file(self, path):
+        """Write a sparse x86_64 ELF file with the large .debug_info section
+        and return the size of that section."""
+        units = []
+        for (i, offset) in enumerate(UNIT_OFFSETS):
+            if i == 0:
+                unit = self.compile_unit(UNIT_OFFSETS[1] - offset, "first.c", ("first_int", 4))
+            elif offset == LAST_UNIT_OFFSET:
+                unit = self.compile_unit(None, "second.c", ("second_int", 8))
+            else:
+                unit = self.compile_unit(UNIT_OFFSETS[i + 1] - offset, "padding.c")
+            units.append((offset, unit))
+        debug_info_size = LAST_UNIT_OFFSET + len(units[-1][1])
+
+        abbrev = self.debug_abbrev()
+        shstrtab = "\0.debug_abbrev\0.debug_info\0.shstrtab\0"
+        SHT_PROGBITS = 1
+        SHT_STRTAB = 3
+        section_headers = [
+            (0, 0, 0, 0),
+            (shstrtab.index(".debug_abbrev"), SHT_PROGBITS, DEBUG_ABBREV_OFFSET, len(abbrev)),
+            (shstrtab.index(".debug_info"), SHT_PROGBITS, DEBUG_INFO_OFFSET, debug_info_size),
+            (shstrtab.index(".shstrtab"), SHT_STRTAB, SHSTRTAB_OFFSET, len(shstrtab)),
+        ]
+
+        with open(path, "wb") as f:
+            # ELF64 little endian header for an x86_64 executable.
+            f.write("\x7fELF" + struct.pack("<BBBB", 2, 1, 1, 0) + "\0" * 8)
+            f.write(struct.pack("<HHIQQQIHHHHHH",
+                                2,                      # e_type = ET_EXEC
+                                62,                     # e_machine = EM_X86_64
+                                1,                      # e_version
+                                0,                      # e_entry
+                                0,                      # e_phoff
+                                SECTION_HEADERS_OFFSET, # e_shoff
+                                0,                      # e_flags
+                                64,                     # e_ehsize
+                                56,                     # e_phentsize
+                                0,                      # e_phnum
+                                64,                     # e_shentsize
+                                len(section_headers),   # e_shnum
+                                len(section_headers) - 1)) # e_shstrndx
+            f.seek(SECTION_HEADERS_OFFSET)
+            for (name, sh_type, offset, size) in section_headers:
+                f.write(struct.pack("<IIQQQQIIQQ", name, sh_type, 0, 0, offset, size, 0, 0, 1, 0))
+            f.seek(SHSTRTAB_OFFSET)
+            f.write(shstrtab)
+            f.seek(DEBUG_ABBREV_OFFSET)
+            f.write(abbrev)
+            # Only the start of each unit is written, the padding is left
+            # as holes in the file.
+            for (offset, unit) in units:
+                f.seek(DEBUG_INFO_OFFSET + offset)
+                f.write(unit)
+        return debug_info_size
+
+    def large_debug_info(self):
+        """Look up types from a sparse ELF file with a >4GB .debug_info."""
+        exe = os.path.join(os.getcwd(), "large-debug-info.elf")
+        self.addTearDownHook(lambda: os.path.exists(exe) and os.remove(exe))
+        debug_info_size = self.write_elf_file(exe)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        module = target.GetModuleAtIndex(0)
+        self.assertTrue(module, "The ELF file should have a module")
+
+        # The section sizes and offsets in the ELF file are 64 bits wide.
+        debug_info = module.FindSection(".debug_info")
+        self.assertTrue(debug_info and debug_info.GetByteSize() == debug_info_size,
+                        "Expected a %u byte .debug_info section" % debug_info_size)
+
+        # The header of the last unit straddles 2^32.
+        error = lldb.SBError()
+        data = debug_info.GetSectionData(LAST_UNIT_OFFSET, 11)
+        self.assertTrue(data.GetUnsignedInt16(error, 4) == 2 and error.Success(),
+                        "The version of the last unit should be read from past 2^32")
+        self.assertTrue(data.GetUnsignedInt8(error, 10) == 8 and error.Success(),
+                        "The address size of the last unit should be read from past 2^32")
+
+        # The units are walked with 64 bit offsets, so the first unit is
+        # found and nothing that lies past 2^32 wraps around onto it.
+        first_int = module.FindFirstType("first_int")
+        self.assertTrue(first_int and first_int.GetByteSize() == 4,
+                        "'first_int' should be a 4 byte type")
+
+        # DIE offsets are 64 bits wide, so the DIEs of the last unit, which
+        # lie past 2^32, are found too.
+        second_int = module.FindFirstType("second_int")
+        self.assertTrue(second_int and second_int.GetByteSize() == 8,
+                        "'second_int' should be an 8 byte type")
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,128 @@
+"""
+Test that unwind plans made by profiling a function's assembly are saved in
+the directory named by target.unwind-plan-cache-path and that a later
+session reloads the same plans from there instead of profiling again.
+"""
+
+import os, re, shutil
+import unittest2
+import lldb
+import lldbutil
+from lldbtest import *
+
+class UnwindPlanCacheTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "unwind-plan-cache")
+
+    @unittest2.skipUnless(sys.platform.startswith("linux"), "requires Linux")
+    @python_api_test
+    def test_with_dwarf(self):
+        """Test that a profiled unwind plan is reloaded unchanged from the cache."""
+        self.buildDwarf()
+        self.unwind_plan_cache()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside leaf().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def stop_and_unwind(self, log_file):
+        """Run to the breakpoint in leaf(), unwind the stack with the unwind
+        log enabled and return the (function, pc, sp) of every frame."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        self.runCmd("log enable -v -f %s lldb unwind" % log_file)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint and breakpoint.GetNumLocations() == 1,
+                        VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, os.getcwd())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread, "There should be a thread stopped due to breakpoint")
+
+        frames = []
+        for i in range(thread.GetNumFrames()):
+            frame = thread.GetFrameAtIndex(i)
+            frames.append((frame.GetFunctionName(), frame.GetPC(), frame.GetSP()))
+
+        self.runCmd("log disable lldb unwind")
+
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        # Drop a.out from the shared module list so the next session gets
+        # a new ObjectFile, and with it a new UnwindTable.
+        lldb.SBDebugger.MemoryPressureDetected()
+        return frames
+
+    def non_call_site_plans(self, log_file):
+        """Return a map of (origin, file address) to the UnwindPlan dump for
+        each non call site plan mentioned in the unwind log."""
+        with open(log_file, "r") as f:
+            log = f.read()
+        plans = {}
+        for match in re.finditer(r"Using (cached|profiled) non call site UnwindPlan for function at file address (0x[0-9a-fA-F]+):\n(.*?)\n\n", log, re.DOTALL):
+            plans[(match.group(1), match.group(2))] = match.group(3)
+        return plans
+
+    def unwind_plan_cache(self):
+        """Profile leaf() in one session and reload its plan in the next."""
+        cache_dir = os.path.join(os.getcwd(), "unwind-cache")
+        if os.path.isdir(cache_dir):
+            shutil.rmtree(cache_dir)
+        self.addTearDownHook(lambda: shutil.rmtree(cache_dir, ignore_errors=True))
+
+        # The cache is off unless the setting names a directory.
+        self.expect("settings show target.unwind-plan-cache-path",
+            substrs = ["target.unwind-plan-cache-path (string) = "])
+        self.runCmd("settings set target.unwind-plan-cache-path " + cache_dir)
+        self.addTearDownHook(lambda: self.runCmd("settings set -r target.unwind-plan-cache-path"))
+
+        first_log = os.path.join(os.getcwd(), "unwind-first.log")
+        second_log = os.path.join(os.getcwd(), "unwind-second.log")
+        for log_file in (first_log, second_log):
+            if os.path.exists(log_file):
+                os.remove(log_file)
+            self.addTearDownHook(lambda log_file=log_file: os.path.exists(log_file) and os.remove(log_file))
+
+        # First session: leaf()'s plan comes from the assembly profiler and
+        # gets written to the cache.
+        first_frames = self.stop_and_unwind(first_log)
+        self.assertTrue(len(first_frames) >= 3 and first_frames[0][0] == "leaf",
+                        "Expected to stop in leaf(), got %s" % str(first_frames))
+
+        cache_files = [name for name in os.listdir(cache_dir) if name.endswith(".unwind")]
+        self.assertTrue(len(cache_files) == 1,
+                        "Expected one cache file in %s, found %s" % (cache_dir, str(cache_files)))
+
+        first_plans = self.non_call_site_plans(first_log)
+        profiled = dict((addr, plan) for ((origin, addr), plan) in first_plans.items() if origin == "profiled")
+        self.assertTrue(len(profiled) > 0, "The first session should profile at least one function")
+
+        # Second session: the same functions are unwound with the plans
+        # loaded from the cache, and the stack comes out the same.
+        second_frames = self.stop_and_unwind(second_log)
+        self.assertTrue(second_frames == first_frames,
+                        "Unwinding with cached plans gave %s, expected %s" % (str(second_frames), str(first_frames)))
+
+        second_plans = self.non_call_site_plans(second_log)
+        for (addr, plan) in profiled.items():
+            self.assertFalse(("profiled", addr) in second_plans,
+                             "Function at %s should not be profiled again" % addr)
+            self.assertTrue(("cached", addr) in second_plans,
+                            "Function at %s should use the cached plan" % addr)
+            self.assertTrue(second_plans[("cached", addr)] == plan,
+                            "Cached plan for %s differs:\n%s\nexpected:\n%s" % (addr, second_plans[("cached", addr)], plan))
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
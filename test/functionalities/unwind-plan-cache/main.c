@@ -0,0 +1,32 @@
+//===-- main.c --------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <stdio.h>
+
+int
+leaf (int a, int b)
+{
+    int sum = a + b;
+    return sum * 2; // Set break point at this line.
+}
+
+int
+middle (int n)
+{
+    int values[8];
+    int i;
+    for (i = 0; i < 8; ++i)
+        values[i] = leaf (n, i);
+    return values[n & 7];
+}
+
+int main (int argc, char const *argv[])
+{
+    printf ("%d\n", middle (argc));
+    return 0;
+}
@@ -0,0 +1,75 @@
+"""
+Tests that C++ classes whose methods are added on demand keep their layout
+and that expressions still find every method.
+"""
+
+from lldbtest import *
+
+class CPPLazyMethodsTestCase(TestBase):
+    
+    mydir = os.path.join("lang", "cpp", "lazy-methods")
+    
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    def test_with_dsym_and_run_command(self):
+        """Test classes whose methods are added on demand"""
+        self.buildDsym()
+        self.lazy_method_commands()
+
+    def test_with_dwarf_and_run_command(self):
+        """Test classes whose methods are added on demand"""
+        self.buildDwarf()
+        self.lazy_method_commands()
+
+    def setUp(self):
+        TestBase.setUp(self)
+        self.line = line_number('main.cpp', '// Break at this line')
+    
+    def lazy_method_commands(self):
+        """Test classes whose methods are added on demand"""
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.cpp -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+                    startstr = "Breakpoint created: 1: file ='main.cpp', line = %d, locations = 1" % self.line)
+
+        self.runCmd("process launch", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list",
+                    STOPPED_DUE_TO_BREAKPOINT,
+                    substrs = ['stopped', 'stop reason = breakpoint'])
+
+        # Displaying the variables only needs the fields and the virtual
+        # methods, which decide where the fields are.
+        self.expect("frame variable d.m_base d.m_value",
+                    substrs = ['m_base = 1', 'm_value = 7'])
+
+        self.expect("frame variable t",
+                    substrs = ['a = 3'])
+
+        # Pod is POD, so Tail doesn't reuse its tail padding.
+        self.expect("expression -- sizeof(Tail)",
+                    substrs = ['$0 = 12'])
+
+        # The methods that were left out are found when they are called.
+        self.expect("expression -- d.twice()",
+                    startstr = "(int) $1 = 14")
+
+        self.expect("expression -- Derived::five()",
+                    startstr = "(int) $2 = 5")
+
+        self.expect("expression -- t.sum()",
+                    startstr = "(int) $3 = 7")
+
+        # Both overloads are found, including the one that isn't virtual.
+        self.expect("expression -- d.get(1)",
+                    startstr = "(int) $4 = 8")
+
+        self.expect("expression -- d.get(1, 2)",
+                    startstr = "(int) $5 = 10")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
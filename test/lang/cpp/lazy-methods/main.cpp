@@ -0,0 +1,54 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include <stdio.h>
+
+class Base
+{
+public:
+    virtual ~Base () {}
+    virtual int get (int i) { return i; }
+    int m_base;
+};
+
+class Derived : public Base
+{
+public:
+    Derived () : m_value (7) { m_base = 1; }
+    virtual int get (int i) { return i + m_value; }
+    int get (int i, int j) { return i + j + m_value; }
+    int twice () { return m_value * 2; }
+    static int five () { return 5; }
+    int m_value;
+};
+
+// Pod stays POD with its method, so Tail can't reuse its tail padding.
+struct Pod
+{
+    int sum () const { return a + b; }
+    int a;
+    char b;
+};
+
+struct Tail : public Pod
+{
+    char c;
+};
+
+int
+main (int argc, char const *argv[])
+{
+    Derived d;
+    Tail t;
+    t.a = 3;
+    t.b = 4;
+    t.c = 5;
+    printf ("%d %d %d\n", d.get (1), d.get (1, 2), d.twice () + Derived::five () + t.sum ()); // Break at this line
+    return 0;
+}
@@ -80,6 +80,19 @@ class ValueAPITestCase(TestBase):
         self.assertTrue(g_table.GetNumChildren() == 2, VALID_VARIABLE)
         self.DebugSBValue(g_table)
 
+        # Get global variable 'g_big_array' and reach for its last element
+        # without touching any of the others.
+        list = target.FindGlobalVariables('g_big_array', 1)
+        g_big_array = list.GetValueAtIndex(0)
+        self.assertTrue(g_big_array, VALID_VARIABLE)
+        self.assertTrue(g_big_array.GetNumChildren() == 300000, VALID_VARIABLE)
+        last = g_big_array.GetChildAtIndex(299999)
+        self.assertTrue(last, VALID_VARIABLE)
+        self.assertTrue(last.GetName() == '[299999]')
+        self.assertTrue(last.GetValueAsUnsigned(0) == 299999)
+        self.assertTrue(g_big_array.GetChildAtIndex(0).GetValueAsUnsigned(1) == 0)
+        self.assertFalse(g_big_array.GetChildAtIndex(300000))
+
         fmt = lldbutil.BasicFormatter()
         cvf = lldbutil.ChildVisitingFormatter(indent_child=2)
         rdf = lldbutil.RecursiveDecentFormatter(indent_child=2)
@@ -28,11 +28,15 @@ const char *weekdays[5] = { "Monday",
 
 const char **g_table[2] = { days_of_week, weekdays };
 
+// Large enough that its children are stored in many separate pages.
+int g_big_array[300000];
+
 int main (int argc, char const *argv[])
 {
     int i;
     int *my_int_ptr = &g_my_int;
     printf("my_int_ptr points to location %p\n", my_int_ptr);
+    g_big_array[299999] = 299999;
     const char **str_ptr = days_of_week;
     for (i = 0; i < 7; ++i)
         printf("%s\n", str_ptr[i]); // Break at this line
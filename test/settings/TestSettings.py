@@ -239,6 +239,7 @@ class SettingsCommandTestCase(TestBase):
                                  "use-external-editor (boolean) = ",
                                  "auto-confirm (boolean) = ",
                                  "target.default-arch (string) =",
+                                 "target.unwind-plan-cache-path (string) =",
                                  "target.expr-prefix (string) = ",
                                  "target.run-args (array) =",
                                  "target.env-vars (dictionary) =",
@@ -7,6 +7,8 @@ o test_display_source_python:
   Test display of source using the SBSourceManager API.
 o test_modify_source_file_while_debugging:
   Test the caching mechanism of the source manager.
+o test_change_source_map_and_display_source:
+  Test that cached source files are keyed on the remapped path.
 """
 
 import unittest2
@@ -40,6 +42,11 @@ class SourceManagerTestCase(TestBase):
         self.buildDefault()
         self.modify_source_file_while_debugging()
 
+    def test_change_source_map_and_display_source(self):
+        """Test that changing target.source-map displays the newly mapped file."""
+        self.buildDefault()
+        self.change_source_map_and_display_source()
+
     def display_source_python(self):
         """Display source using the SBSourceManager API."""
         exe = os.path.join(os.getcwd(), "a.out")
@@ -107,6 +114,37 @@ class SourceManagerTestCase(TestBase):
         self.expect("list -n main", SOURCE_DISPLAYED_CORRECTLY,
             substrs = ['Hello world'])
 
+    def change_source_map_and_display_source(self):
+        """Test that changing target.source-map displays the newly mapped file."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # Move main.c out of the way and put a different copy of it in
+        # each of two directories.
+        main_c = "main.c"
+        with open(main_c, 'r') as f:
+            original_content = f.read()
+        os.rename(main_c, main_c + ".orig")
+        self.addTearDownHook(lambda: os.rename(main_c + ".orig", main_c))
+        for (dir, greeting) in [("first", "Hello first"), ("second", "Hello second")]:
+            if not os.path.isdir(dir):
+                os.mkdir(dir)
+                self.addTearDownHook(lambda dir=dir: os.rmdir(dir))
+            path = os.path.join(dir, main_c)
+            with open(path, 'w') as f:
+                f.write(original_content.replace('Hello world', greeting, 1))
+            self.addTearDownHook(lambda path=path: os.remove(path))
+
+        self.runCmd("settings set target.source-map %s %s" % (os.getcwd(), os.path.join(os.getcwd(), "first")))
+        self.expect("list -n main", SOURCE_DISPLAYED_CORRECTLY,
+            substrs = ['Hello first'])
+
+        # The file displayed for the first mapping is still in the source
+        # cache, but it must not be used for the second mapping.
+        self.runCmd("settings set target.source-map %s %s" % (os.getcwd(), os.path.join(os.getcwd(), "second")))
+        self.expect("list -n main", SOURCE_DISPLAYED_CORRECTLY,
+            substrs = ['Hello second'])
+
     def modify_source_file_while_debugging(self):
         """Modify a source file while debugging the executable."""
         exe = os.path.join(os.getcwd(), "a.out")
@@ -186,6 +186,7 @@ RNBRemote::CreatePacketTable  ()
 //  t.push_back (Packet (pass_signals_to_inferior,      &RNBRemote::HandlePacket_UNIMPLEMENTED, NULL, "QPassSignals:", "Specify which signals are passed to the inferior"));
     t.push_back (Packet (allocate_memory,               &RNBRemote::HandlePacket_AllocateMemory, NULL, "_M", "Allocate memory in the inferior process."));
     t.push_back (Packet (deallocate_memory,             &RNBRemote::HandlePacket_DeallocateMemory, NULL, "_m", "Deallocate memory in the inferior process."));
+    t.push_back (Packet (set_multiple_breakpoints,      &RNBRemote::HandlePacket_QMultiBreakpoint, NULL, "QMultiBreakpoint:", "Insert or remove multiple breakpoints with a single packet."));
     t.push_back (Packet (memory_region_info,            &RNBRemote::HandlePacket_MemoryRegionInfo, NULL, "qMemoryRegionInfo", "Return size and attributes of a memory region that contains the given address"));
 
 }
@@ -2839,6 +2840,127 @@ RNBRemote::HandlePacket_T (const char *p)
 }
 
 
+bool
+RNBRemote::InsertBreakpoint (nub_addr_t addr, uint32_t byte_size, bool hardware)
+{
+    // gdb can send multiple Z packets for the same address and
+    // these calls must be ref counted.
+    BreakpointMapIter pos = m_breakpoints.find(addr);
+    if (pos != m_breakpoints.end())
+    {
+        // We do already have a breakpoint at this address, increment
+        // its reference count
+        pos->second.Retain();
+        return true;
+    }
+
+    // We do NOT already have a breakpoint at this address, So lets
+    // create one.
+    nub_break_t break_id = DNBBreakpointSet (m_ctx.ProcessID(), addr, byte_size, hardware);
+    if (NUB_BREAK_ID_IS_VALID(break_id))
+    {
+        // We successfully created a breakpoint, now lets full out
+        // a ref count structure with the breakID and add it to our
+        // map.
+        Breakpoint rnbBreakpoint(break_id);
+        m_breakpoints[addr] = rnbBreakpoint;
+        return true;
+    }
+    return false;
+}
+
+bool
+RNBRemote::RemoveBreakpoint (nub_addr_t addr)
+{
+    // gdb can send multiple z packets for the same address and
+    // these calls must be ref counted.
+    BreakpointMapIter pos = m_breakpoints.find(addr);
+    if (pos == m_breakpoints.end())
+        return false;
+
+    // We currently have a breakpoint at address ADDR. Decrement
+    // its reference count, and it that count is now zero we
+    // can clear the breakpoint.
+    pos->second.Release();
+    if (pos->second.RefCount() == 0)
+    {
+        if (!DNBBreakpointClear (m_ctx.ProcessID(), pos->second.BreakID()))
+            return false;
+        m_breakpoints.erase(pos);
+    }
+    // else we still have references to this breakpoint don't delete
+    // it, just decrementing the reference count is enough.
+    return true;
+}
+
+/* `QMultiBreakpoint:<op>;<addr>,<kind>;<addr>,<kind>;...'
+   Insert or remove a number of breakpoints with a single packet. <op>
+   is one of "Z0", "Z1", "z0" or "z1" and has the same meaning as the
+   corresponding Z/z packet, addresses and kinds are hex encoded.
+   The reply is "OK" if every operation succeeded, otherwise it is "R"
+   followed by one character per breakpoint in packet order: '1' if the
+   operation succeeded for that address and '0' if it failed.  A
+   malformed packet gets an error reply and changes no breakpoint.  */
+
+rnb_err_t
+RNBRemote::HandlePacket_QMultiBreakpoint (const char *p)
+{
+    if (!m_ctx.HasValidProcessID())
+        return SendPacket ("E15");
+
+    p += sizeof ("QMultiBreakpoint:") - 1;
+
+    const char packet_cmd = *p++;
+    const char break_type = *p++;
+    if ((packet_cmd != 'Z' && packet_cmd != 'z') || (break_type != '0' && break_type != '1'))
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid operation in QMultiBreakpoint packet");
+
+    // Parse the whole packet before changing any breakpoint so a malformed
+    // packet gets an error reply without leaving some of its breakpoints
+    // inserted or removed.
+    std::vector<std::pair<nub_addr_t, uint32_t> > breakpoints;
+    while (*p == ';')
+    {
+        ++p;
+        char *c = NULL;
+        errno = 0;
+        nub_addr_t addr = strtoull (p, &c, 16);
+        if (errno != 0 && addr == 0)
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid address in QMultiBreakpoint packet");
+        p = c;
+        if (*p++ != ',')
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Comma separator missing in QMultiBreakpoint packet");
+        errno = 0;
+        uint32_t byte_size = strtoul (p, &c, 16);
+        if (errno != 0 && byte_size == 0)
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in QMultiBreakpoint packet");
+        p = c;
+        breakpoints.push_back (std::make_pair (addr, byte_size));
+    }
+
+    if (*p != '\0')
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Semicolon separator missing in QMultiBreakpoint packet");
+
+    std::string results;
+    bool all_succeeded = true;
+    for (size_t i = 0; i < breakpoints.size(); ++i)
+    {
+        bool success;
+        if (packet_cmd == 'Z')
+            success = InsertBreakpoint (breakpoints[i].first, breakpoints[i].second, break_type == '1');
+        else
+            success = RemoveBreakpoint (breakpoints[i].first);
+        if (!success)
+            all_succeeded = false;
+        results.push_back (success ? '1' : '0');
+    }
+
+    if (all_succeeded)
+        return SendPacket ("OK");
+    results.insert (0, 1, 'R');
+    return SendPacket (results);
+}
+
 rnb_err_t
 RNBRemote::HandlePacket_z (const char *p)
 {
@@ -2877,39 +2999,11 @@ RNBRemote::HandlePacket_z (const char *p)
             case '0':   // set software breakpoint
             case '1':   // set hardware breakpoint
             {
-                // gdb can send multiple Z packets for the same address and
-                // these calls must be ref counted.
                 bool hardware = (break_type == '1');
-
-                // Check if we currently have a breakpoint already set at this address
-                BreakpointMapIter pos = m_breakpoints.find(addr);
-                if (pos != m_breakpoints.end())
-                {
-                    // We do already have a breakpoint at this address, increment
-                    // its reference count and return OK
-                    pos->second.Retain();
+                if (InsertBreakpoint (addr, byte_size, hardware))
                     return SendPacket ("OK");
-                }
-                else
-                {
-                    // We do NOT already have a breakpoint at this address, So lets
-                    // create one.
-                    nub_break_t break_id = DNBBreakpointSet (pid, addr, byte_size, hardware);
-                    if (NUB_BREAK_ID_IS_VALID(break_id))
-                    {
-                        // We successfully created a breakpoint, now lets full out
-                        // a ref count structure with the breakID and add it to our
-                        // map.
-                        Breakpoint rnbBreakpoint(break_id);
-                        m_breakpoints[addr] = rnbBreakpoint;
-                        return SendPacket ("OK");
-                    }
-                    else
-                    {
-                        // We failed to set the software breakpoint
-                        return SendPacket ("E09");
-                    }
-                }
+                // We failed to set the breakpoint
+                return SendPacket ("E09");
             }
                 break;
 
@@ -2970,40 +3064,11 @@ RNBRemote::HandlePacket_z (const char *p)
             case '0':   // remove software breakpoint
             case '1':   // remove hardware breakpoint
             {
-                // gdb can send multiple z packets for the same address and
-                // these calls must be ref counted.
-                BreakpointMapIter pos = m_breakpoints.find(addr);
-                if (pos != m_breakpoints.end())
-                {
-                    // We currently have a breakpoint at address ADDR. Decrement
-                    // its reference count, and it that count is now zero we
-                    // can clear the breakpoint.
-                    pos->second.Release();
-                    if (pos->second.RefCount() == 0)
-                    {
-                        if (DNBBreakpointClear (pid, pos->second.BreakID()))
-                        {
-                            m_breakpoints.erase(pos);
-                            return SendPacket ("OK");
-                        }
-                        else
-                        {
-                            return SendPacket ("E08");
-                        }
-                    }
-                    else
-                    {
-                        // We still have references to this breakpoint don't
-                        // delete it, just decrementing the reference count
-                        // is enough.
-                        return SendPacket ("OK");
-                    }
-                }
-                else
-                {
-                    // We don't know about any breakpoints at this address
-                    return SendPacket ("E08");
-                }
+                if (RemoveBreakpoint (addr))
+                    return SendPacket ("OK");
+                // We don't know about any breakpoints at this address or
+                // we failed to clear it
+                return SendPacket ("E08");
             }
                 break;
 
@@ -109,6 +109,7 @@ public:
         memory_region_info,             // 'qMemoryRegionInfo:'
         allocate_memory,                // '_M'
         deallocate_memory,              // '_m'
+        set_multiple_breakpoints,       // 'QMultiBreakpoint:'
 
         unknown_type,
     } PacketEnum;
@@ -185,6 +186,7 @@ public:
     rnb_err_t HandlePacket_g (const char *p);
     rnb_err_t HandlePacket_G (const char *p);
     rnb_err_t HandlePacket_z (const char *p);
+    rnb_err_t HandlePacket_QMultiBreakpoint (const char *p);
     rnb_err_t HandlePacket_T (const char *p);
     rnb_err_t HandlePacket_p (const char *p);
     rnb_err_t HandlePacket_P (const char *p);
@@ -281,6 +283,12 @@ protected:
     nub_thread_t
     ExtractThreadIDFromThreadSuffix (const char *p);
 
+    bool
+    InsertBreakpoint (nub_addr_t addr, uint32_t byte_size, bool hardware);
+
+    bool
+    RemoveBreakpoint (nub_addr_t addr);
+
     // gdb can send multiple Z/z packets for the same address and
     // these calls must be ref counted.
     struct Breakpoint
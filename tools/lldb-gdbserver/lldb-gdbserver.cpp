@@ -0,0 +1,234 @@
+//===-- lldb-gdbserver.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// C Includes
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// C++ Includes
+
+// Other libraries and framework includes
+#include "lldb/Core/Error.h"
+#include "lldb/Core/ConnectionFileDescriptor.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/StreamFile.h"
+#include "GDBRemoteCommunicationServer.h"
+#include "Plugins/Process/gdb-remote/ProcessGDBRemoteLog.h"
+using namespace lldb;
+using namespace lldb_private;
+
+//----------------------------------------------------------------------
+// option descriptors for getopt_long()
+//----------------------------------------------------------------------
+
+int g_debug = 0;
+int g_verbose = 0;
+
+static struct option g_long_options[] =
+{
+    { "debug",              no_argument,        &g_debug,           1   },
+    { "verbose",            no_argument,        &g_verbose,         1   },
+    { "log-file",           required_argument,  NULL,               'l' },
+    { "log-flags",          required_argument,  NULL,               'f' },
+    { "attach",             required_argument,  NULL,               'a' },
+    { NULL,                 0,                  NULL,               0   }
+};
+
+//----------------------------------------------------------------------
+// Watch for signals
+//----------------------------------------------------------------------
+int g_sigpipe_received = 0;
+void
+signal_handler(int signo)
+{
+    switch (signo)
+    {
+    case SIGPIPE:
+        g_sigpipe_received = 1;
+        break;
+    }
+}
+
+static void
+display_usage (const char *progname)
+{
+    fprintf(stderr, "Usage:\n  %s [--log-file log-file-path] [--log-flags flags] HOST:PORT "
+            "[--attach PID | PROGRAM [ARG1 ARG2 ...]]\n", progname);
+}
+
+static int
+RunServer (const char *listen_host_port, lldb::pid_t attach_pid, int argc, char *argv[])
+{
+    Error error;
+    GDBRemoteCommunicationServer gdb_server (false);
+#if defined (__linux__)
+    gdb_server.SetProcessPluginName ("plugin.process.linux");
+#endif
+
+    if (attach_pid != LLDB_INVALID_PROCESS_ID)
+    {
+        error = gdb_server.AttachToProcess (attach_pid);
+    }
+    else
+    {
+        ProcessLaunchInfo &launch_info = gdb_server.GetProcessLaunchInfo();
+        launch_info.GetExecutableFile().SetFile (argv[0], true);
+        for (int i = 0; i < argc; ++i)
+            launch_info.GetArguments().AppendArgument (argv[i]);
+        launch_info.GetFlags().Set (eLaunchFlagDebug);
+        error = gdb_server.LaunchProcess ();
+    }
+
+    if (error.Fail())
+    {
+        fprintf (stderr, "error: %s\n", error.AsCString());
+        return 1;
+    }
+
+    std::auto_ptr<ConnectionFileDescriptor> conn_ap(new ConnectionFileDescriptor());
+    if (conn_ap.get())
+    {
+        std::string connect_url ("listen://");
+        connect_url.append(listen_host_port);
+
+        printf ("Listening for a connection on %s...\n", listen_host_port);
+        fflush (stdout);
+        if (conn_ap->Connect(connect_url.c_str(), &error) == eConnectionStatusSuccess)
+        {
+            printf ("Connection established.\n");
+            fflush (stdout);
+            gdb_server.SetConnection (conn_ap.release());
+        }
+    }
+
+    if (gdb_server.IsConnected())
+    {
+        // After we connected, we need to get an initial ack from...
+        if (gdb_server.HandshakeWithClient(&error))
+        {
+            bool interrupt = false;
+            bool done = false;
+            while (!done)
+            {
+                // An interrupt while the process is already stopped needs
+                // no action.
+                interrupt = false;
+                error.Clear();
+                if (!gdb_server.GetPacketAndSendResponse (UINT32_MAX, error, interrupt, done))
+                    break;
+            }
+
+            if (error.Fail())
+            {
+                fprintf(stderr, "error: %s\n", error.AsCString());
+            }
+        }
+        else
+        {
+            fprintf(stderr, "error: handshake with client failed\n");
+        }
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------
+// main
+//----------------------------------------------------------------------
+int
+main (int argc, char *argv[])
+{
+    const char *progname = argv[0];
+    signal (SIGPIPE, signal_handler);
+    int long_option_index = 0;
+    StreamSP log_stream_sp;
+    Args log_args;
+    lldb::pid_t attach_pid = LLDB_INVALID_PROCESS_ID;
+    int ch;
+    Debugger::Initialize();
+
+    // Stop option processing at the first argument that isn't an option so
+    // the inferior's own options are passed through untouched.
+    while ((ch = getopt_long(argc, argv, "+l:f:a:", g_long_options, &long_option_index)) != -1)
+    {
+        switch (ch)
+        {
+        case 0:   // Any optional that auto set themselves will return 0
+            break;
+
+        case 'l': // Set Log File
+            if (optarg && optarg[0])
+            {
+                if ((strcasecmp(optarg, "stdout") == 0) || (strcmp(optarg, "/dev/stdout") == 0))
+                {
+                    log_stream_sp.reset (new StreamFile (stdout, false));
+                }
+                else if ((strcasecmp(optarg, "stderr") == 0) || (strcmp(optarg, "/dev/stderr") == 0))
+                {
+                    log_stream_sp.reset (new StreamFile (stderr, false));
+                }
+                else
+                {
+                    FILE *log_file = fopen(optarg, "w");
+                    if (log_file)
+                    {
+                        setlinebuf(log_file);
+                        log_stream_sp.reset (new StreamFile (log_file, true));
+                    }
+                    else
+                    {
+                        const char *errno_str = strerror(errno);
+                        fprintf (stderr, "Failed to open log file '%s' for writing: errno = %i (%s)", optarg, errno, errno_str ? errno_str : "unknown error");
+                    }
+                }
+            }
+            break;
+
+        case 'f': // Log Flags
+            if (optarg && optarg[0])
+                log_args.AppendArgument(optarg);
+            break;
+
+        case 'a': // Attach to a process
+            if (optarg && optarg[0])
+                attach_pid = Args::StringToUInt32 (optarg, LLDB_INVALID_PROCESS_ID, 0);
+            break;
+        }
+    }
+
+    if (log_stream_sp)
+    {
+        if (log_args.GetArgumentCount() == 0)
+            log_args.AppendArgument("default");
+        ProcessGDBRemoteLog::EnableLog (log_stream_sp, 0,log_args, log_stream_sp.get());
+    }
+
+    // Skip any options we consumed with getopt_long
+    argc -= optind;
+    argv += optind;
+
+    if (argc < 1 || (argc < 2 && attach_pid == LLDB_INVALID_PROCESS_ID))
+    {
+        display_usage (progname);
+        Debugger::Terminate();
+        return 1;
+    }
+
+    const char *listen_host_port = argv[0];
+    ++argv;
+    --argc;
+
+    const int result = RunServer (listen_host_port, attach_pid, argc, argv);
+    Debugger::Terminate();
+    return result;
+}